@@ -0,0 +1,641 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     codecbenchmain.cpp
+    \brief    End-to-end encoder and decoder benchmark on synthetic content
+
+    A deterministic 8-bit 4:2:0 test sequence is generated internally, encoded with each of the selected standard
+    configurations and decoded again. Encoder and decoder each run in a child process of their own where available, so
+    that the peak memory and the stage profile are those of a single stage. The encoding time, decoding time, peak
+    memory and the MD5 of the bitstream are reported per configuration; the MD5 is the regression check, it must not
+    change for optimisations that are meant to be bit-exact.
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define CODEC_BENCH_FORK 1
+#else
+#define CODEC_BENCH_FORK 0
+#endif
+
+#include "EncoderLib/EncLibCommon.h"
+#include "EncApp.h"
+#include "DecApp.h"
+#include "CommonLib/StageProfiler.h"
+#include "libmd5/MD5.h"
+#include "Utilities/program_options_lite.h"
+
+//! \ingroup CodecBenchApp
+//! \{
+
+namespace po = ProgramOptionsLite;
+
+// ====================================================================================================================
+// Synthetic test sequence
+// ====================================================================================================================
+
+static uint32_t hashNoise(uint32_t x, uint32_t y, uint32_t seed)
+{
+  uint32_t h = x * 0x8da6b343u ^ y * 0xd8163841u ^ seed * 0xcb1ab31fu;
+  h ^= h >> 15;
+  h *= 0x2c1b3c6du;
+  h ^= h >> 12;
+  h *= 0x297a2d39u;
+  h ^= h >> 15;
+  return h;
+}
+
+static uint8_t clipSample(int value)
+{
+  return uint8_t(std::min(std::max(value, 0), 255));
+}
+
+/// luma sample of frame t. The left half is natural-looking content (a moving sinusoidal pattern on a gradient with
+/// temporal noise), the top right quarter is screen content (scrolling glyphs on a flat background and a moving flat
+/// rectangle) and the bottom right quarter is a panning high-frequency texture.
+static uint8_t syntheticLuma(int x, int y, int t, int width, int height)
+{
+  const double pi = 3.14159265358979323846;
+
+  if (x < width / 2)
+  {
+    const double wave = 48.0 * std::sin(2.0 * pi * (x + 2 * t) / 64.0) * std::cos(2.0 * pi * (y - t) / 48.0);
+    const int    ramp = 64 + (96 * y) / height;
+    const int    noise = int(hashNoise(x, y, t) % 9) - 4;
+    return clipSample(ramp + int(std::lround(wave)) + noise);
+  }
+  if (y < height / 2)
+  {
+    const int rectX = width / 2 + (3 * t) % std::max(1, width / 2 - 24);
+    const int rectY = 8 + t % std::max(1, height / 2 - 32);
+    if (x >= rectX && x < rectX + 24 && y >= rectY && y < rectY + 16)
+    {
+      return 90;
+    }
+    // 8x8 glyph cells scrolling upwards by one line per frame, with a one sample gap between glyphs
+    const int scrolledY = y + t;
+    const int cellX = x / 8, cellY = scrolledY / 8, bitX = x % 8, bitY = scrolledY % 8;
+    if (bitX == 7 || bitY == 7 || (hashNoise(cellX, cellY, 1) & 3) == 0)
+    {
+      return 235;
+    }
+    const uint32_t glyph = hashNoise(cellX, cellY, 2);
+    return ((glyph >> (bitY * 5 + bitX % 5)) & 1) ? 16 : 235;
+  }
+  return clipSample(128 + int(hashNoise(x + t, y, 3) % 97) - 48);
+}
+
+/// chroma samples of frame t, slow gradients with a moving edge
+static uint8_t syntheticChroma(int compIdx, int x, int y, int t, int width, int height)
+{
+  if (compIdx == 1)
+  {
+    return clipSample(96 + (64 * x) / width + t);
+  }
+  return clipSample((x + t) % (width / 2 + 1) < width / 4 ? 100 + (32 * y) / height : 160);
+}
+
+static bool writeSyntheticSequence(const std::string &fileName, int width, int height, int frames)
+{
+  std::ofstream file(fileName, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  std::vector<uint8_t> plane(size_t(width) * height);
+  for (int t = 0; t < frames; t++)
+  {
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        plane[size_t(y) * width + x] = syntheticLuma(x, y, t, width, height);
+      }
+    }
+    file.write((const char *) plane.data(), size_t(width) * height);
+    for (int compIdx = 1; compIdx < 3; compIdx++)
+    {
+      for (int y = 0; y < height / 2; y++)
+      {
+        for (int x = 0; x < width / 2; x++)
+        {
+          plane[size_t(y) * (width / 2) + x] = syntheticChroma(compIdx, x, y, t, width / 2, height / 2);
+        }
+      }
+      file.write((const char *) plane.data(), size_t(width / 2) * (height / 2));
+    }
+  }
+  return bool(file);
+}
+
+// ====================================================================================================================
+// Stage execution
+// ====================================================================================================================
+
+enum class StageStatus : int
+{
+  OK,
+  FAILED,
+  MISMATCH,
+};
+
+struct StageResult
+{
+  StageStatus status    = StageStatus::FAILED;
+  double      seconds   = 0.0;
+  int         peakRssKB = -1;
+};
+
+static int peakRssKB()
+{
+#ifdef __linux
+  FILE *file = fopen("/proc/self/status", "r");
+  if (file == nullptr)
+  {
+    return -1;
+  }
+  int  result = -1;
+  char line[128];
+  while (fgets(line, sizeof(line), file) != nullptr)
+  {
+    if (strncmp(line, "VmHWM:", 6) == 0)
+    {
+      result = atoi(line + 6);
+      break;
+    }
+  }
+  fclose(file);
+  return result;
+#else
+  return -1;
+#endif
+}
+
+/// runs a stage in a child process with its output redirected to logFile, or in-process where fork is not available
+static StageResult runStage(const std::string &logFile, const std::function<StageResult()> &stage)
+{
+#if CODEC_BENCH_FORK
+  fflush(stdout);
+  fflush(stderr);
+
+  int fd[2];
+  if (pipe(fd) != 0)
+  {
+    return StageResult();
+  }
+  const pid_t pid = fork();
+  if (pid < 0)
+  {
+    close(fd[0]);
+    close(fd[1]);
+    return StageResult();
+  }
+  if (pid == 0)
+  {
+    close(fd[0]);
+    if (freopen(logFile.c_str(), "w", stdout) != nullptr)
+    {
+      dup2(fileno(stdout), fileno(stderr));
+    }
+    const StageResult result = stage();
+    fflush(stdout);
+    fflush(stderr);
+    const bool written = write(fd[1], &result, sizeof(result)) == sizeof(result);
+    close(fd[1]);
+    _exit(written ? EXIT_SUCCESS : EXIT_FAILURE);
+  }
+
+  close(fd[1]);
+  StageResult result;
+  if (read(fd[0], &result, sizeof(result)) != sizeof(result))
+  {
+    // the child crashed or was killed before reporting
+    result = StageResult();
+  }
+  close(fd[0]);
+  int status = 0;
+  waitpid(pid, &status, 0);
+  return result;
+#else
+  return stage();
+#endif
+}
+
+class ArgList
+{
+public:
+  void add(const std::string &arg) { m_args.push_back(arg); }
+  void addSplit(const std::string &args)
+  {
+    std::istringstream stream(args);
+    std::string        arg;
+    while (stream >> arg)
+    {
+      m_args.push_back(arg);
+    }
+  }
+
+  int    argc() const { return int(m_args.size()); }
+  char **argv()
+  {
+    m_argv.clear();
+    for (std::string &arg: m_args)
+    {
+      m_argv.push_back(&arg[0]);
+    }
+    m_argv.push_back(nullptr);
+    return m_argv.data();
+  }
+
+private:
+  std::vector<std::string> m_args;
+  std::vector<char *>      m_argv;
+};
+
+static StageResult runEncoder(ArgList &args, const std::string &profileFile)
+{
+  StageResult result;
+
+  initROM();
+
+  std::fstream bitstream;
+  EncLibCommon encLibCommon;
+  EncApp      *encApp = new EncApp(bitstream, &encLibCommon);
+  encApp->create();
+
+  bool parsed = false;
+  try
+  {
+    parsed = encApp->parseCfg(args.argc(), args.argv());
+  }
+  catch (po::ParseFailure &e)
+  {
+    std::cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << std::endl;
+  }
+  if (!parsed || encApp->getMaxLayers() != 1)
+  {
+    encApp->destroy();
+    delete encApp;
+    destroyROM();
+    return result;
+  }
+  encApp->createLib(0);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  bool       success   = true;
+  try
+  {
+    bool eos = false;
+    while (!eos)
+    {
+      bool keepLoop = true;
+      while (keepLoop)
+      {
+        keepLoop = encApp->encodePrep(eos);
+      }
+      keepLoop = true;
+      while (keepLoop)
+      {
+        keepLoop = encApp->encode();
+      }
+    }
+  }
+  catch (Exception &e)
+  {
+    std::cerr << e.what() << std::endl;
+    success = false;
+  }
+  catch (const std::bad_alloc &e)
+  {
+    std::cout << "Memory allocation failed: " << e.what() << std::endl;
+    success = false;
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+  result.status  = success ? StageStatus::OK : StageStatus::FAILED;
+
+#if ENABLE_STAGE_PROFILING
+  if (success && !profileFile.empty())
+  {
+    StageProfiler::writeReport(profileFile);
+  }
+#endif
+
+  encApp->destroyLib();
+  encApp->destroy();
+  delete encApp;
+  destroyROM();
+
+  result.peakRssKB = peakRssKB();
+  return result;
+}
+
+static StageResult runDecoder(ArgList &args)
+{
+  StageResult result;
+
+  DecApp *decApp = new DecApp;
+  if (!decApp->parseCfg(args.argc(), args.argv()))
+  {
+    delete decApp;
+    return result;
+  }
+
+  const auto startTime = std::chrono::steady_clock::now();
+  try
+  {
+    result.status = decApp->decode() == 0 ? StageStatus::OK : StageStatus::MISMATCH;
+  }
+  catch (Exception &e)
+  {
+    std::cerr << e.what() << std::endl;
+    result.status = StageStatus::FAILED;
+  }
+  catch (const std::bad_alloc &e)
+  {
+    std::cout << "Memory allocation failed: " << e.what() << std::endl;
+    result.status = StageStatus::FAILED;
+  }
+  result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+  delete decApp;
+
+  result.peakRssKB = peakRssKB();
+  return result;
+}
+
+static bool fileMD5(const std::string &fileName, std::string &digestString, size_t &numBytes)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  MD5                        md5;
+  std::vector<unsigned char> buffer(1 << 16);
+  numBytes = 0;
+  while (file)
+  {
+    file.read((char *) buffer.data(), buffer.size());
+    const std::streamsize count = file.gcount();
+    if (count > 0)
+    {
+      md5.update(buffer.data(), unsigned(count));
+      numBytes += size_t(count);
+    }
+  }
+  unsigned char digest[MD5_DIGEST_STRING_LENGTH];
+  md5.finalize(digest);
+  digestString.clear();
+  for (uint32_t i = 0; i < MD5_DIGEST_STRING_LENGTH; i++)
+  {
+    char hex[3];
+    snprintf(hex, sizeof(hex), "%02x", digest[i]);
+    digestString += hex;
+  }
+  return true;
+}
+
+static const char *statusName(StageStatus status)
+{
+  switch (status)
+  {
+  case StageStatus::OK:       return "OK";
+  case StageStatus::MISMATCH: return "MISMATCH";
+  default:                    return "FAILED";
+  }
+}
+
+// ====================================================================================================================
+// Main function
+// ====================================================================================================================
+
+int main(int argc, char *argv[])
+{
+  fprintf(stdout, "\n");
+  fprintf(stdout, "VVCSoftware: VTM Codec Benchmark Version %s ", VTM_VERSION);
+  fprintf(stdout, NVM_ONOS);
+  fprintf(stdout, NVM_COMPILEDBY);
+  fprintf(stdout, NVM_BITS);
+
+  bool        doHelp = false;
+  int         width  = 416;
+  int         height = 240;
+  int         frames = 8;
+  int         qp     = 32;
+  int         frameRate = 30;
+  std::string cfgDir;
+  std::string configs;
+  std::string outputDir;
+  std::string encoderArgs;
+  std::string decoderArgs;
+  std::string resultFile;
+  std::string simd;
+
+  po::Options opts;
+  // clang-format off
+  opts.addOptions()
+  ("help",        doHelp,      false,                                            "this help text")
+  ("Width",       width,       416,                                              "width of the synthetic test sequence, a multiple of 8")
+  ("Height",      height,      240,                                              "height of the synthetic test sequence, a multiple of 8")
+  ("Frames",      frames,      8,                                                "number of frames to encode")
+  ("QP",          qp,          32,                                               "quantisation parameter")
+  ("FrameRate",   frameRate,   30,                                               "frame rate signalled to the encoder")
+  ("CfgDir",      cfgDir,      std::string("cfg"),                               "directory of the encoder configuration files")
+  ("Configs",     configs,     std::string("intra,lowdelay,lowdelay_P,randomaccess"), "comma separated list of configurations, <name> selects <CfgDir>/encoder_<name>_vtm.cfg")
+  ("OutputDir",   outputDir,   std::string("."),                                 "directory for the test sequence, bitstreams, logs and profiles")
+  ("EncoderArgs", encoderArgs, std::string(""),                                  "additional encoder options, appended to the command line of every encoding")
+  ("DecoderArgs", decoderArgs, std::string(""),                                  "additional decoder options, appended to the command line of every decoding")
+  ("ResultFile",  resultFile,  std::string(""),                                  "append the results as CSV to this file")
+  ("SIMD",        simd,        std::string(""),                                  "SIMD extension to use (SCALAR, SSE41, SSE42, AVX, AVX2, AVX512), default: highest supported by the CPU")
+  ;
+  // clang-format on
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  po::scanArgv(opts, argc, (const char **) argv, err);
+#if ENABLE_SIMD_OPT
+  fprintf(stdout, "[SIMD=%s] ", read_x86_extension(simd));
+#endif
+#if ENABLE_TRACING
+  fprintf(stdout, "[ENABLE_TRACING] ");
+#endif
+#if ENABLE_STAGE_PROFILING
+  fprintf(stdout, "[ENABLE_STAGE_PROFILING] ");
+#endif
+  fprintf(stdout, "\n\n");
+  if (doHelp || err.is_errored)
+  {
+    po::doHelp(std::cout, opts);
+    return doHelp ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  if (width <= 0 || height <= 0 || width % 8 != 0 || height % 8 != 0 || frames <= 0)
+  {
+    fprintf(stderr, "The sequence size must be a positive multiple of 8 and at least one frame must be encoded\n");
+    return EXIT_FAILURE;
+  }
+
+  std::vector<std::string> configNames;
+  {
+    std::istringstream stream(configs);
+    std::string        name;
+    while (std::getline(stream, name, ','))
+    {
+      if (!name.empty())
+      {
+        configNames.push_back(name);
+      }
+    }
+  }
+
+  const std::string prefix   = outputDir + "/";
+  const std::string yuvFile  = prefix + "synthetic_" + std::to_string(width) + "x" + std::to_string(height) + ".yuv";
+  if (!writeSyntheticSequence(yuvFile, width, height, frames))
+  {
+    fprintf(stderr, "Cannot write the test sequence %s\n", yuvFile.c_str());
+    return EXIT_FAILURE;
+  }
+  fprintf(stdout, "Test sequence: %s, %dx%d 4:2:0 8-bit, %d frames, QP %d\n\n", yuvFile.c_str(), width, height, frames,
+          qp);
+
+  struct ConfigResult
+  {
+    std::string name;
+    StageResult enc;
+    StageResult dec;
+    size_t      numBytes = 0;
+    std::string md5;
+  };
+  std::vector<ConfigResult> results;
+
+  for (const std::string &name: configNames)
+  {
+    ConfigResult result;
+    result.name = name;
+
+    const std::string bitstreamFile = prefix + name + ".vvc";
+    std::string       encProfileFile;
+    std::string       decProfileFile;
+#if ENABLE_STAGE_PROFILING
+    encProfileFile = prefix + name + "_enc_profile.json";
+    decProfileFile = prefix + name + "_dec_profile.json";
+#endif
+
+    fprintf(stdout, "%-14s encoding ...", name.c_str());
+    ArgList encArgs;
+    encArgs.add("CodecBenchApp");
+    encArgs.add("-c");
+    encArgs.add(cfgDir + "/encoder_" + name + "_vtm.cfg");
+    encArgs.add("--InputFile=" + yuvFile);
+    encArgs.add("--BitstreamFile=" + bitstreamFile);
+    encArgs.add("--SourceWidth=" + std::to_string(width));
+    encArgs.add("--SourceHeight=" + std::to_string(height));
+    encArgs.add("--InputBitDepth=8");
+    encArgs.add("--FrameRate=" + std::to_string(frameRate));
+    encArgs.add("--FramesToBeEncoded=" + std::to_string(frames));
+    encArgs.add("--QP=" + std::to_string(qp));
+    encArgs.add("--SEIDecodedPictureHash=1");
+    encArgs.addSplit(encoderArgs);
+    result.enc = runStage(prefix + name + "_enc.log", [&]() { return runEncoder(encArgs, encProfileFile); });
+
+    if (result.enc.status == StageStatus::OK && fileMD5(bitstreamFile, result.md5, result.numBytes))
+    {
+      fprintf(stdout, " decoding ...");
+      ArgList decArgs;
+      decArgs.add("CodecBenchApp");
+      decArgs.add("--BitstreamFile=" + bitstreamFile);
+#if ENABLE_STAGE_PROFILING
+      decArgs.add("--ProfileReportFile=" + decProfileFile);
+#endif
+      decArgs.addSplit(decoderArgs);
+      result.dec = runStage(prefix + name + "_dec.log", [&]() { return runDecoder(decArgs); });
+    }
+    else
+    {
+      result.enc.status = StageStatus::FAILED;
+    }
+    fprintf(stdout, " %s\n", statusName(result.enc.status == StageStatus::OK ? result.dec.status : result.enc.status));
+    results.push_back(result);
+  }
+
+  fprintf(stdout, "\n%-14s %6s %9s %9s %9s %9s %9s %9s %9s  %-32s %s\n", "Config", "Frames", "Enc s", "Enc fps",
+          "Enc MiB", "Dec s", "Dec fps", "Dec MiB", "kbps", "Bitstream MD5", "Decode");
+  bool allOk = true;
+  for (const ConfigResult &result: results)
+  {
+    const bool   encOk  = result.enc.status == StageStatus::OK;
+    const bool   decOk  = encOk && result.dec.status == StageStatus::OK;
+    const double kbps   = encOk ? 8.0 * result.numBytes * frameRate / frames / 1000.0 : 0.0;
+    fprintf(stdout, "%-14s %6d %9.3f %9.2f %9.1f %9.3f %9.2f %9.1f %9.2f  %-32s %s\n", result.name.c_str(), frames,
+            result.enc.seconds, encOk ? frames / result.enc.seconds : 0.0, result.enc.peakRssKB / 1024.0,
+            result.dec.seconds, decOk ? frames / result.dec.seconds : 0.0, result.dec.peakRssKB / 1024.0, kbps,
+            encOk ? result.md5.c_str() : "-", statusName(encOk ? result.dec.status : result.enc.status));
+    allOk &= decOk;
+  }
+#if ENABLE_STAGE_PROFILING
+  fprintf(stdout, "\nStage profiles written to %s<config>_enc_profile.json and %s<config>_dec_profile.json\n",
+          prefix.c_str(), prefix.c_str());
+#endif
+
+  if (!resultFile.empty())
+  {
+    FILE *file = fopen(resultFile.c_str(), "a");
+    if (file == nullptr)
+    {
+      fprintf(stderr, "Cannot open the result file %s\n", resultFile.c_str());
+      return EXIT_FAILURE;
+    }
+    for (const ConfigResult &result: results)
+    {
+      fprintf(file, "%s,%d,%d,%d,%d,%.3f,%d,%.3f,%d,%zu,%s,%s\n", result.name.c_str(), width, height, frames, qp,
+              result.enc.seconds, result.enc.peakRssKB, result.dec.seconds, result.dec.peakRssKB, result.numBytes,
+              result.md5.c_str(), statusName(result.enc.status == StageStatus::OK ? result.dec.status : result.enc.status));
+    }
+    fclose(file);
+  }
+
+  return allOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+//! \}
@@ -48,6 +48,8 @@
 #include "CommonLib/CodingStatistics.h"
 #endif
 #include "CommonLib/dtrace_codingstruct.h"
+#include "CommonLib/ParallelFor.h"
+#include "CommonLib/StageProfiler.h"
 
 //! \ingroup DecoderApp
 //! \{
@@ -163,6 +165,9 @@ uint32_t DecApp::decode()
   bool openedPostFile = false;
   setShutterFilterFlag(!m_shutterIntervalPostFileName.empty());   // not apply shutter interval SEI processing if filename is not specified.
   m_cDecLib.setShutterFilterFlag(getShutterFilterFlag());
+  m_cDecLib.setFilmGrainNumThreads(resolveNumThreads(m_SEIFGSNumThreads));
+  m_cDecLib.setLeanPicBuffers(m_leanPicBuffers);
+  m_outputWriter.start(m_asyncOutputQueueSize);
 
   bool isEosPresentInPu = false;
   bool isEosPresentInLastPu = false;
@@ -519,6 +524,7 @@ uint32_t DecApp::decode()
             }
             m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].open(reconFileName, true, layerOutputBitDepth,
                                                            layerOutputBitDepth, bitDepths);   // write mode
+            m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setRescaleNumThreads(resolveNumThreads(m_rescaleNumThreads));
           }
         }
         // update file bitdepth shift if recon bitdepth changed between sequences
@@ -529,6 +535,7 @@ uint32_t DecApp::decode()
           int bitdepthShift = m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].getBitdepthShift(channelType);
           if (fileBitdepth + bitdepthShift != reconBitdepth)
           {
+            m_outputWriter.flush();
             m_cVideoIOYuvReconFile[nalu.m_nuhLayerId].setBitdepthShift(channelType, reconBitdepth - fileBitdepth);
           }
         }
@@ -553,6 +560,7 @@ uint32_t DecApp::decode()
           {
             m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].open(SEIFGSFileName, true, layerOutputBitDepth,
                                                            layerOutputBitDepth, bitDepths);   // write mode
+            m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].setRescaleNumThreads(resolveNumThreads(m_rescaleNumThreads));
           }
         }
         // update file bitdepth shift if recon bitdepth changed between sequences
@@ -565,6 +573,7 @@ uint32_t DecApp::decode()
             int bitdepthShift = m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].getBitdepthShift(channelType);
             if (fileBitdepth + bitdepthShift != reconBitdepth)
             {
+              m_outputWriter.flush();
               m_videoIOYuvSEIFGSFile[nalu.m_nuhLayerId].setBitdepthShift(channelType, reconBitdepth - fileBitdepth);
             }
           }
@@ -589,6 +598,7 @@ uint32_t DecApp::decode()
           {
             m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].open(SEICTIFileName, true, layerOutputBitDepth,
                                                             layerOutputBitDepth, bitDepths);   // write mode
+            m_cVideoIOYuvSEICTIFile[nalu.m_nuhLayerId].setRescaleNumThreads(resolveNumThreads(m_rescaleNumThreads));
           }
         }
       }
@@ -869,6 +879,13 @@ uint32_t DecApp::decode()
   // get the number of checksum errors
   uint32_t nRet = m_cDecLib.getNumberOfChecksumErrorsDetected();
 
+#if ENABLE_STAGE_PROFILING
+  if( !m_profileReportFile.empty() )
+  {
+    StageProfiler::writeReport( m_profileReportFile );
+  }
+#endif
+
   // delete buffers
   m_cDecLib.deletePicBuffer();
   // destroy internal classes
@@ -952,6 +969,8 @@ void DecApp::xCreateDecLib()
 
 void DecApp::xDestroyDecLib()
 {
+  m_outputWriter.stop();
+
   if( !m_reconFileName.empty() )
   {
     for( auto & recFile : m_cVideoIOYuvReconFile )
@@ -1077,6 +1096,7 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
 
           if (display)
           {
+            m_outputWriter.flush();
             m_cVideoIOYuvReconFile[pcPicTop->layerId].write(
               pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(), m_outputColourSpaceConvert,
               false,   // TODO: m_packedYUVMode,
@@ -1139,9 +1159,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           }
           else
           {
-            m_cVideoIOYuvReconFile[pcPic->layerId].write(
-              pcPic->getRecoBuf().get(COMPONENT_Y).width, pcPic->getRecoBuf().get(COMPONENT_Y).height,
-              pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
+            m_outputWriter.write(
+              m_cVideoIOYuvReconFile[pcPic->layerId], pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
               conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
               conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
               conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc),
@@ -1163,9 +1182,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           }
           else
           {
-            m_videoIOYuvSEIFGSFile[pcPic->layerId].write(
-              pcPic->getRecoBuf().get(COMPONENT_Y).width, pcPic->getRecoBuf().get(COMPONENT_Y).height,
-              pcPic->getDisplayBufFG(), m_outputColourSpaceConvert, m_packedYUVMode,
+            m_outputWriter.write(
+              m_videoIOYuvSEIFGSFile[pcPic->layerId], pcPic->getDisplayBufFG(), m_outputColourSpaceConvert, m_packedYUVMode,
               conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
               conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
               conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc),
@@ -1208,9 +1226,8 @@ void DecApp::xWriteOutput( PicList* pcListPic, uint32_t tId )
           }
           else
           {
-            m_cVideoIOYuvSEICTIFile[pcPic->layerId].write(
-              pcPic->getRecoBuf().get(COMPONENT_Y).width, pcPic->getRecoBuf().get(COMPONENT_Y).height,
-              pcPic->getDisplayBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
+            m_outputWriter.write(
+              m_cVideoIOYuvSEICTIFile[pcPic->layerId], pcPic->getDisplayBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
               conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
               conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
               conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc),
@@ -1285,6 +1302,7 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
             const Window &conf = pcPicTop->getConformanceWindow();
             const bool    isTff   = pcPicTop->topField;
 
+            m_outputWriter.flush();
             m_cVideoIOYuvReconFile[pcPicTop->layerId].write(
               pcPicTop->getRecoBuf(), pcPicBottom->getRecoBuf(), m_outputColourSpaceConvert,
               false,   // TODO: m_packedYUVMode,
@@ -1358,9 +1376,8 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
             }
             else
             {
-              m_cVideoIOYuvReconFile[pcPic->layerId].write(
-                pcPic->getRecoBuf().get(COMPONENT_Y).width, pcPic->getRecoBuf().get(COMPONENT_Y).height,
-                pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
+              m_outputWriter.write(
+                m_cVideoIOYuvReconFile[pcPic->layerId], pcPic->getRecoBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
                 conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
                 conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
                 conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc),
@@ -1382,9 +1399,8 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
             }
             else
             {
-              m_videoIOYuvSEIFGSFile[pcPic->layerId].write(
-                pcPic->getRecoBuf().get(COMPONENT_Y).width, pcPic->getRecoBuf().get(COMPONENT_Y).height,
-                pcPic->getDisplayBufFG(), m_outputColourSpaceConvert, m_packedYUVMode,
+              m_outputWriter.write(
+                m_videoIOYuvSEIFGSFile[pcPic->layerId], pcPic->getDisplayBufFG(), m_outputColourSpaceConvert, m_packedYUVMode,
                 conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
                 conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
                 conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc),
@@ -1426,9 +1442,8 @@ void DecApp::xFlushOutput( PicList* pcListPic, const int layerId )
             }
             else
             {
-              m_cVideoIOYuvSEICTIFile[pcPic->layerId].write(
-                pcPic->getRecoBuf().get(COMPONENT_Y).width, pcPic->getRecoBuf().get(COMPONENT_Y).height,
-                pcPic->getDisplayBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
+              m_outputWriter.write(
+                m_cVideoIOYuvSEICTIFile[pcPic->layerId], pcPic->getDisplayBuf(), m_outputColourSpaceConvert, m_packedYUVMode,
                 conf.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
                 conf.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
                 conf.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc),
@@ -98,6 +98,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("SEIColourRemappingInfoFilename", m_colourRemapSEIFileName,         std::string(""), "Colour Remapping YUV output file name. If empty, no remapping is applied (ignore SEI message)\n")
   ("SEICTIFilename",            m_SEICTIFileName,                      std::string(""), "CTI YUV output file name. If empty, no Colour Transform is applied (ignore SEI message)\n")
   ("SEIFGSFilename",            m_SEIFGSFileName,                      std::string(""), "FGS YUV output file name. If empty, no film grain is applied (ignore SEI message)\n")
+  ("SEIFGSNumThreads",          m_SEIFGSNumThreads,                    1,          "Number of threads used for film grain synthesis (0: use all available hardware threads)")
   ("SEIAnnotatedRegionsInfoFilename", m_annotatedRegionsSEIFileName,   std::string(""), "Annotated regions output file name. If empty, no object information will be saved (ignore SEI message)\n")
   ("SEIObjectMaskInfosFilename", m_objectMaskInfoSEIFileName,          std::string(""), "Object mask information output file name. If empty, no object mask information will be saved (ignore SEI message)\n")
   ("OutputDecodedSEIMessagesFilename", m_outputDecodedSEIMessagesFilename, std::string(""), "When non empty, output decoded SEI messages to the indicated file. If file is '-', then output to stdout\n")
@@ -106,6 +107,7 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
 #endif
   ("ClipOutputVideoToRec709Range",      m_clipOutputVideoToRec709Range,  false,   "If true then clip output video to the Rec. 709 Range on saving")
   ("PYUV",                      m_packedYUVMode,                       false,      "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.")
+  ("AsyncOutputQueueSize",      m_asyncOutputQueueSize,                0,          "Number of output pictures buffered for writing YUV files in a background thread (0: write synchronously)")
 #if ENABLE_TRACING
   ("TraceChannelsList",         bTracingChannelsList,                  false,      "List all available tracing channels")
   ("TraceRule",                 sTracingRule,                          std::string(""), "Tracing rule (ex: \"D_CABAC:poc==8\" or \"D_REC_CB_LUMA:poc==8\")")
@@ -132,6 +134,11 @@ bool DecAppCfg::parseCfg( int argc, char* argv[] )
   ("UpscaledOutputWidth",      m_upscaledOutputWidth,                  0,          "Forced upscaled output width (override SPS)" )
   ("UpscaledOutputHeight",     m_upscaledOutputHeight,                 0,          "Forced upscaled output height (override SPS)" )
   ("UpscaleFilterForDisplay",  m_upscaleFilterForDisplay,              1,          "Filters used for upscaling reconstruction to full resolution (2: ECM 12 - tap luma and 6 - tap chroma MC filters, 1 : Alternative 12 - tap luma and 6 - tap chroma filters, 0 : VVC 8 - tap luma and 4 - tap chroma MC filters)")
+  ("RescaleNumThreads",        m_rescaleNumThreads,                    1,          "Number of threads used for upscaling output pictures (0: use all available hardware threads)")
+#if ENABLE_STAGE_PROFILING
+  ("ProfileReportFile",        m_profileReportFile,                    std::string(""), "Write the per-picture and per-sequence stage profile to this file (CSV for a .csv extension, JSON otherwise)")
+#endif
+  ("LeanPictureBuffers",       m_leanPicBuffers,                       false,      "Reduce the picture buffer memory: no RPR picture margin unless RPR is enabled, and release the motion field of pictures no longer used for reference")
 #if JVET_AJ0151_DSC_SEI
   ("KeyStoreDir",              m_keyStoreDir,            std::string("keystore/pub"),    "Directory for locally stored public keys for verifying digitally signed content")
   ("TrustStoreDir",            m_trustStoreDir,          std::string("keystore/ca"),     "Directory for locally stored trusted CA certificates")
@@ -274,6 +281,7 @@ DecAppCfg::DecAppCfg()
   , m_colourRemapSEIFileName()
   , m_SEICTIFileName()
   , m_SEIFGSFileName()
+  , m_SEIFGSNumThreads(1)
   , m_annotatedRegionsSEIFileName()
   , m_objectMaskInfoSEIFileName()
   , m_targetDecLayerIdSet()
@@ -283,6 +291,7 @@ DecAppCfg::DecAppCfg()
 #endif
   , m_clipOutputVideoToRec709Range(false)
   , m_packedYUVMode(false)
+  , m_asyncOutputQueueSize(0)
   , m_statMode(0)
   , m_mctsCheck(false)
 {
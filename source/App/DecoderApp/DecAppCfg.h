@@ -77,6 +77,7 @@ protected:
   std::string   m_colourRemapSEIFileName;             ///< output Colour Remapping file name
   std::string   m_SEICTIFileName;                     ///< output Recon with CTI file name
   std::string   m_SEIFGSFileName;                     ///< output file name for reconstructed sequence with film grain
+  int           m_SEIFGSNumThreads;                   ///< number of threads used for film grain synthesis
   std::string   m_annotatedRegionsSEIFileName;        ///< annotated regions file name
   std::string   m_objectMaskInfoSEIFileName;          ///< object mask information file name
   std::vector<int> m_targetDecLayerIdSet;             ///< set of LayerIds to be included in the sub-bitstream extraction process.
@@ -89,6 +90,7 @@ protected:
 
   bool m_clipOutputVideoToRec709Range;   ///< If true, clip the output video to the Rec 709 range on saving.
   bool          m_packedYUVMode;                      ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
+  int           m_asyncOutputQueueSize;               ///< number of output pictures queued for writing in a background thread (0: synchronous)
   std::string   m_cacheCfgFile;                       ///< Config file of cache model
   int           m_statMode;                           ///< Config statistic mode (0 - bit stat, 1 - tool stat, 3 - both)
   bool          m_mctsCheck;
@@ -101,6 +103,11 @@ protected:
   int           m_upscaledOutputWidth;
   int           m_upscaledOutputHeight;
   int           m_upscaleFilterForDisplay;
+  int           m_rescaleNumThreads;                  ///< number of threads used for upscaling output pictures
+  bool          m_leanPicBuffers;                     ///< free picture buffers that are only needed for reference
+#if ENABLE_STAGE_PROFILING
+  std::string   m_profileReportFile;                  ///< output file of the stage profiler report
+#endif
   int           m_targetSubPicIdx;                    ///< Specify which subpicture shall be write to output, using subpicture index
 #if JVET_AJ0151_DSC_SEI
   std::string   m_keyStoreDir;
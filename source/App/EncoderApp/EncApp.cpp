@@ -45,6 +45,7 @@
 #include "EncApp.h"
 #include "EncoderLib/AnnexBwrite.h"
 #include "EncoderLib/EncLibCommon.h"
+#include "CommonLib/ParallelFor.h"
 
 //! \ingroup EncoderApp
 //! \{
@@ -55,6 +56,8 @@
 
 EncApp::EncApp(std::fstream &bitStream, EncLibCommon *encLibCommon) : m_cEncLib(encLibCommon), m_bitstream(bitStream)
 {
+  m_renditionSource = nullptr;
+  m_renditionIdx    = 0;
   m_frameRcvd      = 0;
   m_totalBytes = 0;
   m_essentialBytes = 0;
@@ -269,6 +272,10 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setPrintMSSSIM                                       ( m_printMSSSIM );
   m_cEncLib.setPrintWPSNR                                        ( m_printWPSNR );
   m_cEncLib.setPrintHightPrecEncTime(m_printHighPrecEncTime);
+  m_cEncLib.setMetricNumThreads(m_metricNumThreads);
+  m_cEncLib.setFastMetrics(m_fastMetrics);
+  m_cEncLib.setRescaleNumThreads(resolveNumThreads(m_rescaleNumThreads));
+  m_cEncLib.setLeanPicBuffers(m_leanPicBuffers);
   m_cEncLib.setCabacZeroWordPaddingEnabled                       ( m_cabacZeroWordPaddingEnabled );
 
   m_cEncLib.setFrameRate(m_frameRate);
@@ -854,6 +861,9 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setMergeRdCandQuotaSubBlk                            ( m_mergeRdCandQuotaSubBlk);
   m_cEncLib.setMergeRdCandQuotaCiip                              ( m_mergeRdCandQuotaCiip );
   m_cEncLib.setMergeRdCandQuotaGpm                               ( m_mergeRdCandQuotaGpm );
+  m_cEncLib.setMergeNumThreads                                   ( resolveNumThreads(m_mergeNumThreads) );
+  m_cEncLib.setSplitNumThreads                                   ( resolveNumThreads(m_splitNumThreads) );
+  m_cEncLib.setTileNumThreads                                    ( resolveNumThreads(m_tileNumThreads) );
   m_cEncLib.setUsePbIntraFast                                    ( m_usePbIntraFast );
   m_cEncLib.setUseAMaxBT                                         ( m_useAMaxBT );
   m_cEncLib.setUseE0023FastEnc                                   ( m_e0023FastEnc );
@@ -884,6 +894,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setDisableFastDecisionTT                             (m_disableFastDecisionTT);
 
   m_cEncLib.setUseMttSkip                                        (m_useMttSkip);
+  m_cEncLib.setFastPartitionDecision                             (m_fastPartitionDecision);
   // set internal bit-depth and constants
   for (const auto channelType: { ChannelType::LUMA, ChannelType::CHROMA })
   {
@@ -1076,6 +1087,7 @@ void EncApp::xInitLibCfg( int layerIdx )
   m_cEncLib.setFilmGrainCharactersticsSEIBlendingModeID          ((uint8_t)m_fgcSEIBlendingModeID);
   m_cEncLib.setFilmGrainCharactersticsSEILog2ScaleFactor         ((uint8_t)m_fgcSEILog2ScaleFactor);
   m_cEncLib.setFilmGrainAnalysisEnabled                          (m_fgcSEIAnalysisEnabled);
+  m_cEncLib.setFilmGrainAnalysisNumThreads                       (m_fgcSEIAnalysisNumThreads);
   m_cEncLib.setFilmGrainExternalMask                             (m_fgcSEIExternalMask);
   m_cEncLib.setFilmGrainExternalDenoised                         (m_fgcSEIExternalDenoised);
   m_cEncLib.setFilmGrainTemporalFilterPastRefs(m_fgcSEITemporalFilterPastRefs);
@@ -1437,6 +1449,8 @@ void EncApp::xInitLibCfg( int layerIdx )
     m_cEncLib.setCpbSaturationEnabled(m_rcCpbSaturationEnabled);
     m_cEncLib.setCpbSize(m_rcCpbSize);
     m_cEncLib.setInitialCpbFullness(m_rcInitialCpbFullness);
+    m_cEncLib.setRCPass(m_rcPass);
+    m_cEncLib.setRCStatsFileName(m_rcStatsFileName);
   }
   m_cEncLib.setCostMode                                          ( m_costMode );
   m_cEncLib.setTSRCdisableLL                                     ( m_TSRCdisableLL );
@@ -1667,24 +1681,27 @@ void EncApp::xInitLibCfg( int layerIdx )
 
 void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
 {
-  // Video I/O
-  m_cVideoIOYuvInputFile.open(m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth,
-                              m_internalBitDepth);   // read  mode
+  // Video I/O, renditions read the input through a SharedYuvReader
+  if (m_numRenditions == 1)
+  {
+    m_cVideoIOYuvInputFile.open(m_inputFileName, false, m_inputBitDepth, m_msbExtendedBitDepth,
+                                m_internalBitDepth);   // read  mode
 #if EXTENSION_360_VIDEO
-  m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_inputFileWidth, m_inputFileHeight, m_inputChromaFormatIDC);
+    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_inputFileWidth, m_inputFileHeight, m_inputChromaFormatIDC);
 #else
-  const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
-  if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
-  {
-    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidthBeforeScale, m_sourceHeightBeforeScale,
-                                      m_inputChromaFormatIDC);
-  }
-  else
-  {
-    m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidth - m_sourcePadding[0],
-                                      sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
-  }
+    const int sourceHeight = m_isField ? m_iSourceHeightOrg : m_sourceHeight;
+    if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidthBeforeScale, m_sourceHeightBeforeScale,
+                                        m_inputChromaFormatIDC);
+    }
+    else
+    {
+      m_cVideoIOYuvInputFile.skipFrames(m_frameSkip, m_sourceWidth - m_sourcePadding[0],
+                                        sourceHeight - m_sourcePadding[1], m_inputChromaFormatIDC);
+    }
 #endif
+  }
   if (!m_reconFileName.empty())
   {
     if (m_packedYUVMode
@@ -1724,6 +1741,8 @@ void EncApp::xCreateLib( std::list<PelUnitBuf*>& recBufList, const int layerId )
         m_frameRate, m_internalBitDepth[ChannelType::LUMA], m_chromaFormatIdc, m_chromaSampleLocType);
     }
     m_cVideoIOYuvReconFile.open( reconFileName, true, m_outputBitDepth, m_outputBitDepth, m_internalBitDepth );  // write mode
+    m_cVideoIOYuvReconFile.setRescaleNumThreads(m_cEncLib.getRescaleNumThreads());
+    m_outputWriter.start(m_asyncOutputQueueSize);
   }
 
   if (m_ShutterFilterEnable && !m_shutterIntervalPreFileName.empty())
@@ -1744,6 +1763,7 @@ void EncApp::xDestroyLib()
 {
   // Video I/O
   m_cVideoIOYuvInputFile.close();
+  m_outputWriter.stop();
   m_cVideoIOYuvReconFile.close();
   if (m_ShutterFilterEnable && !m_shutterIntervalPreFileName.empty())
   {
@@ -1845,9 +1865,69 @@ void EncApp::createLib( const int layerIdx )
   }
 }
 
+void EncApp::openRenditionSource( SharedYuvReader& source ) const
+{
+  const bool scaled = m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0;
+  const int  width  = scaled ? m_sourceWidthBeforeScale : m_sourceWidth - m_sourcePadding[0];
+  const int  height = scaled ? m_sourceHeightBeforeScale : m_sourceHeight - m_sourcePadding[1];
+
+  source.open(m_inputFileName, m_inputBitDepth, m_msbExtendedBitDepth, m_internalBitDepth, m_inputChromaFormatIDC,
+              m_chromaFormatIdc, width, height, m_inputColourSpaceConvert, m_clipInputVideoToRec709Range, m_frameSkip,
+              m_temporalSubsampleRatio, m_numRenditions, m_renditionQueueSize);
+}
+
+void EncApp::setRenditionSource( SharedYuvReader* source, const int renditionIdx, const EncApp& primary )
+{
+  // the input pictures are read and converted once, so everything that affects them must be the same
+  const bool scaled        = m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0;
+  const bool primaryScaled = primary.m_sourceScalingRatioHor != 1.0 || primary.m_sourceScalingRatioVer != 1.0;
+  const int  width         = scaled ? m_sourceWidthBeforeScale : m_sourceWidth - m_sourcePadding[0];
+  const int  height        = scaled ? m_sourceHeightBeforeScale : m_sourceHeight - m_sourcePadding[1];
+  const int  primaryWidth  = primaryScaled ? primary.m_sourceWidthBeforeScale : primary.m_sourceWidth - primary.m_sourcePadding[0];
+  const int  primaryHeight = primaryScaled ? primary.m_sourceHeightBeforeScale : primary.m_sourceHeight - primary.m_sourcePadding[1];
+
+  CHECK(m_numRenditions != primary.m_numRenditions, "Renditions must be the same for all renditions");
+  CHECK(m_inputFileName != primary.m_inputFileName, "All renditions must use the same InputFile");
+  CHECK(width != primaryWidth || height != primaryHeight, "All renditions must use the same input picture size");
+  CHECK(m_inputBitDepth != primary.m_inputBitDepth || m_msbExtendedBitDepth != primary.m_msbExtendedBitDepth
+          || m_internalBitDepth != primary.m_internalBitDepth,
+        "All renditions must use the same input, MSB-extended and internal bit depths");
+  CHECK(m_inputChromaFormatIDC != primary.m_inputChromaFormatIDC || m_chromaFormatIdc != primary.m_chromaFormatIdc,
+        "All renditions must use the same input and internal chroma formats");
+  CHECK(m_inputColourSpaceConvert != primary.m_inputColourSpaceConvert
+          || m_clipInputVideoToRec709Range != primary.m_clipInputVideoToRec709Range,
+        "All renditions must use the same input colour space conversion");
+  CHECK(m_frameSkip != primary.m_frameSkip || m_temporalSubsampleRatio != primary.m_temporalSubsampleRatio
+          || m_framesToBeEncoded != primary.m_framesToBeEncoded,
+        "All renditions must use the same FrameSkip, TemporalSubsampleRatio and FramesToBeEncoded");
+  CHECK(renditionIdx != 0 && m_bitstreamFileName == primary.m_bitstreamFileName,
+        "Each rendition requires its own BitstreamFile");
+#if EXTENSION_360_VIDEO
+  CHECK(m_ext360->isEnabled(), "Renditions do not support 360 video");
+#endif
+
+  m_renditionSource = source;
+  m_renditionIdx    = renditionIdx;
+}
+
+void EncApp::finishRenditionSource()
+{
+  if (m_renditionSource != nullptr)
+  {
+    m_renditionSource->finish(m_renditionIdx);
+  }
+}
+
 void EncApp::destroyLib()
 {
-  printf( "\nLayerId %2d", m_cEncLib.getLayerId() );
+  if (m_renditionSource != nullptr)
+  {
+    printf( "\nRendition %2d (%s)", m_renditionIdx, m_bitstreamFileName.c_str() );
+  }
+  else
+  {
+    printf( "\nLayerId %2d", m_cEncLib.getLayerId() );
+  }
 
   m_cEncLib.printSummary( m_isField );
 
@@ -1924,9 +2004,16 @@ bool EncApp::encodePrep( bool& eos )
 #else
   if (m_sourceScalingRatioHor != 1.0 || m_sourceScalingRatioVer != 1.0)
   {
-    int noPadding[2] = { 0 };
-    m_cVideoIOYuvInputFile.read(*m_orgPicBeforeScale, *m_trueOrgPicBeforeScale, ipCSC, noPadding, m_inputChromaFormatIDC,
-                                m_clipInputVideoToRec709Range);
+    if (m_renditionSource != nullptr)
+    {
+      m_renditionSource->read(m_renditionIdx, *m_orgPicBeforeScale);
+    }
+    else
+    {
+      int noPadding[2] = { 0 };
+      m_cVideoIOYuvInputFile.read(*m_orgPicBeforeScale, *m_trueOrgPicBeforeScale, ipCSC, noPadding,
+                                  m_inputChromaFormatIDC, m_clipInputVideoToRec709Range);
+    }
     int w0 = m_sourceWidthBeforeScale;
     int h0 = m_sourceHeightBeforeScale;
     int w1 = m_orgPic->get(COMPONENT_Y).width - m_sourcePadding[0];
@@ -1940,9 +2027,17 @@ bool EncApp::encodePrep( bool& eos )
     bool useLumaFilter = downsampling;
     Picture::rescalePicture(scalingRatio, *m_orgPicBeforeScale, Window(), *m_orgPic, conformanceWindow1,
                             m_inputChromaFormatIDC, m_internalBitDepth, useLumaFilter, downsampling,
-                            m_horCollocatedChromaFlag != 0, m_verCollocatedChromaFlag != 0);
+                            m_horCollocatedChromaFlag != 0, m_verCollocatedChromaFlag != 0, false, 0,
+                            m_cEncLib.getRescaleNumThreads());
     m_trueOrgPic->copyFrom(*m_orgPic);
   }
+  else if (m_renditionSource != nullptr)
+  {
+    if (m_renditionSource->read(m_renditionIdx, *m_orgPic))
+    {
+      m_trueOrgPic->copyFrom(*m_orgPic);
+    }
+  }
   else
   {
     m_cVideoIOYuvInputFile.read(*m_orgPic, *m_trueOrgPic, ipCSC, m_sourcePadding, m_inputChromaFormatIDC,
@@ -1957,7 +2052,8 @@ bool EncApp::encodePrep( bool& eos )
     (m_isField && (m_frameRcvd == (m_framesToBeEncoded >> 1))) || (!m_isField && (m_frameRcvd == m_framesToBeEncoded));
 
   // if end of file (which is only detected on a read failure) flush the encoder of any queued pictures
-  if( m_cVideoIOYuvInputFile.isEof() )
+  const bool inputEof = m_renditionSource != nullptr ? m_renditionSource->isEof(m_renditionIdx) : m_cVideoIOYuvInputFile.isEof();
+  if( inputEof )
   {
     m_flush = true;
     eos = true;
@@ -2017,8 +2113,8 @@ bool EncApp::encode()
     {
       xWriteOutput( m_numEncoded, m_recBufList );
     }
-    // temporally skip frames
-    if( m_temporalSubsampleRatio > 1 )
+    // temporally skip frames, the shared input of renditions skips them itself
+    if( m_temporalSubsampleRatio > 1 && m_renditionSource == nullptr )
     {
 #if EXTENSION_360_VIDEO
       m_cVideoIOYuvInputFile.skipFrames(m_temporalSubsampleRatio - 1, m_inputFileWidth, m_inputFileHeight,
@@ -2125,8 +2221,8 @@ void EncApp::xWriteOutput(int numEncoded, std::list<PelUnitBuf *> &recBufList)
         else
         {
           Window confWindowPPS = pps.getConformanceWindow();
-          m_cVideoIOYuvReconFile.write(
-            pcPicYuvRec->get(COMPONENT_Y).width, pcPicYuvRec->get(COMPONENT_Y).height, *pcPicYuvRec, ipCSC,
+          m_outputWriter.write(
+            m_cVideoIOYuvReconFile, *pcPicYuvRec, ipCSC,
             m_packedYUVMode, confWindowPPS.getWindowLeftOffset() * SPS::getWinUnitX(m_cEncLib.getChromaFormatIdc()),
             confWindowPPS.getWindowRightOffset() * SPS::getWinUnitX(m_cEncLib.getChromaFormatIdc()),
             confWindowPPS.getWindowTopOffset() * SPS::getWinUnitY(m_cEncLib.getChromaFormatIdc()),
@@ -43,6 +43,8 @@
 
 #include "EncoderLib/EncLib.h"
 #include "Utilities/VideoIOYuv.h"
+#include "Utilities/AsyncYuvWriter.h"
+#include "Utilities/SharedYuvReader.h"
 #include "CommonLib/NAL.h"
 #include "EncAppCfg.h"
 #if EXTENSION_360_VIDEO
@@ -71,11 +73,14 @@ private:
   EncLib            m_cEncLib;                    ///< encoder class
   VideoIOYuv        m_cVideoIOYuvInputFile;       ///< input YUV file
   VideoIOYuv        m_cVideoIOYuvReconFile;       ///< output reconstruction file
+  AsyncYuvWriter    m_outputWriter;               ///< background writer for the output reconstruction file
   VideoIOYuv        m_cTVideoIOYuvSIIPreFile;      ///< output pre-filtered file
   int               m_frameRcvd;   ///< number of received frames
   uint32_t          m_essentialBytes;
   uint32_t          m_totalBytes;
   std::fstream     &m_bitstream;
+  SharedYuvReader  *m_renditionSource;            ///< input shared with the other renditions, replaces the input file
+  int               m_renditionIdx;
 #if JVET_O0756_CALCULATE_HDRMETRICS
   std::chrono::duration<long long, std::ratio<1, 1000000000>> m_metricTime;
 #endif
@@ -121,8 +126,17 @@ public:
 
   void  outputAU( const AccessUnit& au );
 
+  int   getNumRenditions() const { return m_numRenditions; }
+  const std::string& getBitstreamFileName() const { return m_bitstreamFileName; }
+  void  openRenditionSource( SharedYuvReader& source ) const;   ///< open the shared input with the configuration of this rendition
+  void  setRenditionSource( SharedYuvReader* source, const int renditionIdx, const EncApp& primary );
+  void  finishRenditionSource();                                ///< stop reading from the shared input
+
 #if JVET_O0756_CALCULATE_HDRMETRICS
   std::chrono::duration<long long, std::ratio<1, 1000000000>> getMetricTime() const { return m_metricTime; };
+#endif
+#if ENABLE_STAGE_PROFILING
+  const std::string &getProfileReportFile() const { return m_profileReportFile; }
 #endif
   VPS * getVPS() { return m_cEncLib.getVPS(); }
   ChromaFormat getChromaFormatIDC() const { return m_cEncLib.getChromaFormatIdc(); }
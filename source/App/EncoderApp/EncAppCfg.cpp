@@ -95,6 +95,9 @@ EncAppCfg::EncAppCfg()
 , m_snrInternalColourSpace(false)
 , m_outputInternalColourSpace(false)
 , m_packedYUVMode(false)
+, m_asyncOutputQueueSize(0)
+, m_numRenditions(1)
+, m_renditionQueueSize(32)
 #if EXTENSION_360_VIDEO
 , m_ext360(*this)
 #endif
@@ -880,6 +883,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("PrintMSSSIM",                                     m_printMSSSIM,                                    false, "0 (default) do not print MS-SSIM scores, 1 = print MS-SSIM scores for each frame and for the whole sequence")
   ("PrintWPSNR",                                      m_printWPSNR,                                     false, "0 (default) do not print HDR-PQ based wPSNR, 1 = print HDR-PQ based wPSNR")
   ("PrintHighPrecEncTime",                            m_printHighPrecEncTime,                           false, "0 (default): print integer value of encoding time in seconds, 1: print floating-point value of encoding time")
+  ("MetricNumThreads",                                m_metricNumThreads,                                   1, "Number of background threads used to compute the PSNR, WPSNR and MS-SSIM metrics of each picture (0: use all available hardware threads)")
+  ("FastMetrics",                                     m_fastMetrics,                                    false, "Compute MS-SSIM with a separable filter and WPSNR per luma level, faster but not bit-exact with the default evaluation")
   ("CabacZeroWordPaddingEnabled",                     m_cabacZeroWordPaddingEnabled,                     true, "0 do not add conforming cabac-zero-words to bit streams, 1 (default) = add cabac-zero-words as required")
   ("ChromaFormatIDC,-cf",                             tmpChromaFormat,                                      0, "ChromaFormatIDC (400|420|422|444 or set 0 (default) for same as InputChromaFormat)")
   ("ConformanceWindowMode",                           m_conformanceWindowMode,                              1, "Window conformance mode (0: no window, 1:automatic padding (default), 2:padding parameters specified, 3:conformance window parameters specified")
@@ -903,6 +908,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("ClipInputVideoToRec709Range",                     m_clipInputVideoToRec709Range,                   false, "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_clipOutputVideoToRec709Range,                  false, "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
   ("PYUV",                                            m_packedYUVMode,                                  false, "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.")
+  ("AsyncOutputQueueSize",                            m_asyncOutputQueueSize,                               0, "Number of reconstructed pictures buffered for writing the ReconFile in a background thread (0: write synchronously)")
+  ("Renditions",                                      m_numRenditions,                                      1, "Number of renditions encoded in parallel from shared input pictures, options of rendition N are given after -rN")
+  ("RenditionQueueSize",                              m_renditionQueueSize,                                32, "Maximum number of input pictures buffered for renditions that lag behind")
   ("SummaryOutFilename",                              m_summaryOutFilename,                          std::string(), "Filename to use for producing summary output file. If empty, do not produce a file.")
   ("SummaryPicFilenameBase",                          m_summaryPicFilenameBase,                      std::string(), "Base filename to use for producing summary picture output files. The actual filenames used will have I.txt, P.txt and B.txt appended. If empty, do not produce a file.")
   ("SummaryVerboseness",                              m_summaryVerboseness,                                0u, "Specifies the level of the verboseness of the text output")
@@ -1159,11 +1167,15 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MergeRdCandQuotaSubBlk",                          m_mergeRdCandQuotaSubBlk,         NUM_AFF_MRG_SATD_CAND, "Quota of sub-block merge candidates in full RD checking")
   ("MergeRdCandQuotaCiip",                            m_mergeRdCandQuotaCiip,                               1, "Quota of CIIP merge candidates in full RD checking")
   ("MergeRdCandQuotaGpm",                             m_mergeRdCandQuotaGpm,        GEO_MAX_TRY_WEIGHTED_SATD, "Quota of GPM merge candidates in full RD checking")
+  ("MergeNumThreads",                                 m_mergeNumThreads,                                    1, "Number of threads used for the prediction and SATD of MMVD, affine and GPM merge candidates (0: use all available hardware threads)")
+  ("SplitNumThreads",                                 m_splitNumThreads,                                    1, "Number of threads used to evaluate the split modes of 64x64 CUs concurrently (1: off, 0: use all available hardware threads)")
+  ("TileNumThreads",                                  m_tileNumThreads,                                     1, "Number of threads used to compress the tiles and rectangular slices of a picture concurrently (1: off, 0: use all available hardware threads)")
   ("PBIntraFast",                                     m_usePbIntraFast,                                 false, "Fast assertion if the intra mode is probable")
   ("AMaxBT",                                          m_useAMaxBT,                                      false, "Adaptive maximal BT-size")
   ("E0023FastEnc",                                    m_e0023FastEnc,                                    true, "Fast encoding setting for QTBT (proposal E0023)")
   ("MTTSkipping",                                     m_useMttSkip,                                     false, "MTT split modes early termination")
   ("ContentBasedFastQtbt",                            m_contentBasedFastQtbt,                           false, "Signal based QTBT speed-up")
+  ("FastPartitionDecision",                           m_fastPartitionDecision,                              0, "Content-adaptive early split decision preset, 0: off, 1: fast, 2: faster, 3: fastest")
   ("UseNonLinearAlfLuma",                             m_useNonLinearAlfLuma,                             true, "Non-linear adaptive loop filters for Luma Channel")
   ("UseNonLinearAlfChroma",                           m_useNonLinearAlfChroma,                           true, "Non-linear adaptive loop filters for Chroma Channels")
   ("MaxNumAlfAlternativesChroma",                     m_maxNumAlfAlternativesChroma,
@@ -1393,6 +1405,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ( "RCCpbSaturation",                                m_rcCpbSaturationEnabled,                         false, "Rate control: enable target bits saturation to avoid CPB overflow and underflow" )
   ( "RCCpbSize",                                      m_rcCpbSize,                                         0u, "Rate control: CPB size" )
   ( "RCInitialCpbFullness",                           m_rcInitialCpbFullness,                             0.9, "Rate control: initial CPB fullness" )
+  ( "RCPass",                                         m_rcPass,                                             0, "Rate control: 0: single pass; 1: first pass, write statistics to RCStatsFile; 2: second pass, allocate bits from RCStatsFile" )
+  ( "RCStatsFile",                                    m_rcStatsFileName,                        std::string(""), "Rate control: statistics file of two-pass encoding" )
   ("CostMode",                                        m_costMode,                         COST_STANDARD_LOSSY, "Use alternative cost functions: choose between 'lossy', 'sequence_level_lossless', 'lossless' (which forces QP to " MACRO_TO_STRING(LOSSLESS_AND_MIXED_LOSSLESS_RD_COST_TEST_QP) ") and 'mixed_lossless_lossy' (which used QP'=" MACRO_TO_STRING(LOSSLESS_AND_MIXED_LOSSLESS_RD_COST_TEST_QP_PRIME) " for pre-estimates of transquant-bypass blocks).")
   ("TSRCdisableLL",                                   m_TSRCdisableLL,                                   true, "Disable TSRC for lossless coding" )
   ("RecalculateQPAccordingToLambda",                  m_recalculateQPAccordingToLambda,                 false, "Recalculate QP values according to lambda values. Do not suggest to be enabled in all intra case")
@@ -1616,6 +1630,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("SEIFGCCompModelPresentComp1",                     m_fgcSEICompModelPresent[1],                       false, "Specifies the presence of film grain modelling on colour component 1.")
   ("SEIFGCCompModelPresentComp2",                     m_fgcSEICompModelPresent[2],                       false, "Specifies the presence of film grain modelling on colour component 2.")
   ("SEIFGCAnalysisEnabled",                           m_fgcSEIAnalysisEnabled,                           false, "Control adaptive film grain parameter estimation - film grain analysis")
+  ("SEIFGCAnalysisNumThreads",                        m_fgcSEIAnalysisNumThreads,                            1, "Number of threads used for film grain analysis (0: use all available hardware threads)")
   ("SEIFGCExternalMask",                              m_fgcSEIExternalMask,                       std::string( "" ), "Read external file with mask for film grain analysis. If empty string, use internally calculated mask.")
   ("SEIFGCExternalDenoised",                          m_fgcSEIExternalDenoised,                   std::string( "" ), "Read external file with denoised sequence for film grain analysis. If empty string, use MCTF for denoising.")
   ("SEIFGCTemporalFilterPastRefs",                    m_fgcSEITemporalFilterPastRefs,          TF_DEFAULT_REFS, "Number of past references for temporal prefilter")
@@ -1833,6 +1848,11 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("UpscaledOutputWidth",                             m_upscaledOutputWidth,                        0, "Forced upscaled output width (override SPS)" )
   ("UpscaledOutputHeight",                            m_upscaledOutputHeight,                       0, "Forced upscaled output height (override SPS)" )
   ("UpscaleFilterForDisplay",                         m_upscaleFilterForDisplay,                    1, "Filters used for upscaling reconstruction to full resolution (2: ECM 12-tap luma and 6-tap chroma MC filters, 1: Alternative 12-tap luma and 6-tap chroma filters, 0: VVC 8-tap luma and 4-tap chroma MC filters)")
+  ("RescaleNumThreads",                               m_rescaleNumThreads,                          1, "Number of threads used for resampling the input, RPR and upscaled output pictures (0: use all available hardware threads)")
+#if ENABLE_STAGE_PROFILING
+  ("ProfileReportFile",                               m_profileReportFile,                      std::string(""), "Write the per-picture and per-sequence stage profile to this file (CSV for a .csv extension, JSON otherwise)")
+#endif
+  ("LeanPictureBuffers",                              m_leanPicBuffers,                         false, "Reduce the picture buffer memory: no RPR picture margin unless RPR is enabled, and release the original samples and motion field of pictures no longer used for reference")
   ( "MaxLayers",                                      m_maxLayers,                                  1, "Max number of layers" )
   ( "EnableOperatingPointInformation",                m_OPIEnabled,                             false, "Enables writing of Operating Point Information (OPI)" )
   ( "MaxTemporalLayer",                               m_maxTemporalLayer,                         500, "Maximum temporal layer to be signalled in OPI" )
@@ -4545,6 +4565,7 @@ bool EncAppCfg::xCheckParameter()
 
 
   xConfirmPara( m_useAMaxBT && !m_SplitConsOverrideEnabledFlag, "AMaxBt can only be used with PartitionConstriantsOverride enabled" );
+  xConfirmPara( m_fastPartitionDecision < 0 || m_fastPartitionDecision > 3, "FastPartitionDecision must be in the range 0 to 3" );
 
 
   xConfirmPara(m_bitstreamFileName.empty(), "A bitstream file name must be specified (BitstreamFile)");
@@ -4883,6 +4904,9 @@ bool EncAppCfg::xCheckParameter()
     || m_mergeRdCandQuotaCiip < 0 || m_mergeRdCandQuotaCiip > maxCandNum
     || m_mergeRdCandQuotaGpm < 0 || m_mergeRdCandQuotaGpm > maxCandNum,
     "MaxMergeRdCandNumReguar, MaxMergeRdCandNumReguarSmallBlk, MaxMergeRdCandNumSubBlk, MaxMergeRdCandNumCiip, and MaxMergeRdCandNumGpm must be between 0 and 15, inclusive");
+  xConfirmPara(m_mergeNumThreads < 0, "MergeNumThreads must not be negative");
+  xConfirmPara(m_splitNumThreads < 0, "SplitNumThreads must not be negative");
+  xConfirmPara(m_tileNumThreads < 0, "TileNumThreads must not be negative");
   if ( m_Affine == 0 )
   {
     m_maxNumAffineMergeCand = m_sbTmvpEnableFlag ? 1 : 0;
@@ -5718,10 +5742,13 @@ bool EncAppCfg::xCheckParameter()
                    "RCCpbSize should be smaller than or equal to Max CPB size according to tier and level");
       xConfirmPara(m_rcInitialCpbFullness > 1, "RCInitialCpbFullness should be smaller than or equal to 1");
     }
+    xConfirmPara(m_rcPass < 0 || m_rcPass > 2, "RCPass must be in the range of 0 to 2");
+    xConfirmPara(m_rcPass > 0 && m_rcStatsFileName.empty(), "Two-pass rate control requires RCStatsFile");
   }
   else
   {
     xConfirmPara(m_rcCpbSaturationEnabled != 0, "Target bits saturation cannot be processed without Rate control");
+    xConfirmPara(m_rcPass != 0, "Two-pass encoding cannot be processed without Rate control");
   }
 
   if (m_framePackingSEIEnabled)
@@ -5968,6 +5995,15 @@ bool EncAppCfg::xCheckParameter()
   }
   xConfirmPara( m_decodeBitstreams[0] == m_bitstreamFileName, "Debug bitstream and the output bitstream cannot be equal.\n" );
   xConfirmPara( m_decodeBitstreams[1] == m_bitstreamFileName, "Decode2 bitstream and the output bitstream cannot be equal.\n" );
+  xConfirmPara(m_numRenditions < 1, "Renditions must be at least 1");
+  xConfirmPara(m_renditionQueueSize < 1, "RenditionQueueSize must be at least 1");
+  if (m_numRenditions > 1)
+  {
+    xConfirmPara(m_maxLayers > 1, "Renditions cannot be combined with multi-layer coding");
+    xConfirmPara(m_isField, "Renditions do not support field coding");
+    xConfirmPara(m_fastForwardToPOC != -1, "Renditions do not support FastForwardToPOC");
+    xConfirmPara(!m_decodeBitstreams[0].empty() || !m_decodeBitstreams[1].empty(), "Renditions do not support DecodeBitstream");
+  }
   xConfirmPara(unsigned(m_LMChroma) > 1, "LMMode exceeds range (0 to 1)");
   if (m_gopBasedTemporalFilterEnabled)
   {
@@ -6173,6 +6209,11 @@ void EncAppCfg::xPrintParameter()
       msg(DETAILS, "CpbSize                                : %d\n", m_rcCpbSize);
       msg(DETAILS, "InitalCpbFullness                      : %.2f\n", m_rcInitialCpbFullness);
     }
+    if (m_rcPass > 0)
+    {
+      msg(DETAILS, "RCPass                                 : %d\n", m_rcPass);
+      msg(DETAILS, "RCStatsFile                            : %s\n", m_rcStatsFileName.c_str());
+    }
   }
 
 #if GDR_ENABLED
@@ -6338,6 +6379,9 @@ void EncAppCfg::xPrintParameter()
     m_maxMergeRdCandNumTotal, m_mergeRdCandQuotaRegular, m_mergeRdCandQuotaRegularSmallBlk);
   msg( VERBOSE, "MergeRdCandQuotaSubBlk:%d MergeRdCandQuotaCiip:%d MergeRdCandQuotaGpm:%d ",
     m_mergeRdCandQuotaSubBlk, m_mergeRdCandQuotaCiip, m_mergeRdCandQuotaGpm);
+  msg( VERBOSE, "MergeNumThreads:%d ", m_mergeNumThreads);
+  msg( VERBOSE, "SplitNumThreads:%d ", m_splitNumThreads);
+  msg( VERBOSE, "TileNumThreads:%d ", m_tileNumThreads);
   msg( VERBOSE, "PBIntraFast:%d ", m_usePbIntraFast );
   if( m_ImvMode ) msg( VERBOSE, "IMV4PelFast:%d ", m_Imv4PelFast );
   if (m_mtsMode)
@@ -6349,6 +6393,7 @@ void EncAppCfg::xPrintParameter()
   msg( VERBOSE, "AMaxBT:%d ", m_useAMaxBT );
   msg( VERBOSE, "E0023FastEnc:%d ", m_e0023FastEnc );
   msg( VERBOSE, "ContentBasedFastQtbt:%d ", m_contentBasedFastQtbt );
+  msg( VERBOSE, "FastPartitionDecision:%d ", m_fastPartitionDecision );
   msg( VERBOSE, "UseNonLinearAlfLuma:%d ", m_useNonLinearAlfLuma );
   msg( VERBOSE, "UseNonLinearAlfChroma:%d ", m_useNonLinearAlfChroma );
   msg( VERBOSE, "MaxNumAlfAlternativesChroma:%d ", m_maxNumAlfAlternativesChroma );
@@ -135,10 +135,20 @@ protected:
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
   bool      m_printHighPrecEncTime = false;
+  int       m_metricNumThreads;                               ///< number of threads used for the quality metrics of each picture
+  bool      m_fastMetrics;                                    ///< separable MS-SSIM and per luma level WPSNR accumulation
+  int       m_rescaleNumThreads;                              ///< number of threads used for resampling pictures
+  bool      m_leanPicBuffers;                                 ///< free picture buffers that are only needed for reference
+#if ENABLE_STAGE_PROFILING
+  std::string m_profileReportFile;                            ///< output file of the stage profiler report
+#endif
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_clipInputVideoToRec709Range;
   bool      m_clipOutputVideoToRec709Range;
   bool      m_packedYUVMode;                                  ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
+  int       m_asyncOutputQueueSize;                           ///< number of reconstructed pictures queued for writing in a background thread (0: synchronous)
+  int       m_numRenditions;                                  ///< number of renditions encoded in parallel from shared input pictures
+  int       m_renditionQueueSize;                             ///< maximum number of input pictures buffered for the renditions
 
   bool      m_gciPresentFlag;
   bool      m_bIntraOnlyConstraintFlag;
@@ -426,6 +436,7 @@ protected:
   unsigned m_log2MinCuSize;                                   ///< min. CU size log2
 
   bool      m_useMttSkip;
+  int       m_fastPartitionDecision;
   bool      m_useFastLCTU;
   bool      m_usePbIntraFast;
   bool      m_useAMaxBT;
@@ -436,6 +447,9 @@ protected:
   int       m_mergeRdCandQuotaSubBlk;
   int       m_mergeRdCandQuotaCiip;
   int       m_mergeRdCandQuotaGpm;
+  int       m_mergeNumThreads;                                ///< number of threads used for the SATD pass over merge candidates
+  int       m_splitNumThreads;                                ///< number of threads used to evaluate the split modes of 64x64 CUs
+  int       m_tileNumThreads;                                 ///< number of threads used to compress the tiles and slices of a picture
   bool      m_e0023FastEnc;
   bool      m_contentBasedFastQtbt;
   bool      m_useNonLinearAlfLuma;
@@ -583,6 +597,7 @@ protected:
   uint32_t  m_fgcSEILog2ScaleFactor;
   bool      m_fgcSEICompModelPresent[MAX_NUM_COMPONENT];
   bool      m_fgcSEIAnalysisEnabled;
+  int       m_fgcSEIAnalysisNumThreads;
   std::string m_fgcSEIExternalMask;
   std::string m_fgcSEIExternalDenoised;
   int       m_fgcSEITemporalFilterPastRefs;
@@ -946,6 +961,8 @@ protected:
   bool     m_rcCpbSaturationEnabled;   // enable target bits saturation to avoid CPB overflow and underflow
   uint32_t m_rcCpbSize;                // CPB size
   double   m_rcInitialCpbFullness;     // initial CPB fullness
+  int      m_rcPass;                   // 0: single pass; 1: first pass writing statistics; 2: second pass reading them
+  std::string m_rcStatsFileName;       // statistics file of two-pass rate control
 
   ScalingListMode m_useScalingListId;                         ///< using quantization matrix
   std::string m_scalingListFileName;                          ///< quantization matrix file name
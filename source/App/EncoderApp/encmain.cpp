@@ -39,10 +39,13 @@
 #include <iostream>
 #include <chrono>
 #include <ctime>
+#include <memory>
+#include <thread>
 
 #include "EncoderLib/EncLibCommon.h"
 #include "EncApp.h"
 #include "Utilities/program_options_lite.h"
+#include "CommonLib/StageProfiler.h"
 
 //! \ingroup EncoderApp
 //! \{
@@ -101,6 +104,71 @@ int getProcStatusValue(const char* key)
 }
 #endif
 
+/// encode all pictures with the given encoders, which read and encode each GOP in turn
+static bool encodeSequence( std::vector<EncApp*>& encApps )
+{
+  bool eos = false;
+
+  while( !eos )
+  {
+    // read GOP
+    bool keepLoop = true;
+    while( keepLoop )
+    {
+      for( auto & encApp : encApps )
+      {
+#ifndef _DEBUG
+        try
+        {
+#endif
+          keepLoop = encApp->encodePrep( eos );
+#ifndef _DEBUG
+        }
+        catch( Exception &e )
+        {
+          std::cerr << e.what() << std::endl;
+          return false;
+        }
+        catch( const std::bad_alloc &e )
+        {
+          std::cout << "Memory allocation failed: " << e.what() << std::endl;
+          return false;
+        }
+#endif
+      }
+    }
+
+    // encode GOP
+    keepLoop = true;
+    while( keepLoop )
+    {
+      for( auto & encApp : encApps )
+      {
+#ifndef _DEBUG
+        try
+        {
+#endif
+          keepLoop = encApp->encode();
+#ifndef _DEBUG
+        }
+        catch( Exception &e )
+        {
+          std::cerr << e.what() << std::endl;
+          return false;
+        }
+        catch( const std::bad_alloc &e )
+        {
+          std::cout << "Memory allocation failed: " << e.what() << std::endl;
+          return false;
+        }
+#endif
+      }
+    }
+  }
+
+  return true;
+}
+
 // ====================================================================================================================
 // Main function
 // ====================================================================================================================
@@ -126,12 +194,25 @@ int main(int argc, char* argv[])
 #endif
   fprintf( stdout, "\n" );
 
-  std::fstream bitstream;
-  EncLibCommon encLibCommon;
+  // layers share the bitstream and the picture buffer, renditions have their own
+  std::vector<std::unique_ptr<std::fstream>> bitstreams;
+  std::vector<std::unique_ptr<EncLibCommon>> encLibCommons;
+  bitstreams.push_back( std::make_unique<std::fstream>() );
+  encLibCommons.push_back( std::make_unique<EncLibCommon>() );
 
   std::vector<EncApp*> pcEncApp(1);
   bool resized = false;
   int layerIdx = 0;
+  int numRenditions = 1;
+
+  // the number of renditions decides whether -lx or -rx prefixes the options of one encoder
+  {
+    ProgramOptionsLite::Options opts;
+    opts.addOptions()("Renditions", numRenditions, 1, "")("c", ProgramOptionsLite::parseConfigFile, "");
+    ProgramOptionsLite::SilentReporter err;
+    ProgramOptionsLite::scanArgv(opts, argc, (const char**) argv, err);
+  }
+  const char encoderPrefix = numRenditions > 1 ? 'r' : 'l';
 
   initROM();
 
@@ -139,8 +220,13 @@ int main(int argc, char* argv[])
 
   do
   {
-    pcEncApp[layerIdx] = new EncApp( bitstream, &encLibCommon );
-    // create application encoder class per layer
+    if( numRenditions > 1 && layerIdx > 0 )
+    {
+      bitstreams.push_back( std::make_unique<std::fstream>() );
+      encLibCommons.push_back( std::make_unique<EncLibCommon>() );
+    }
+    pcEncApp[layerIdx] = new EncApp( *bitstreams.back(), encLibCommons.back().get() );
+    // create application encoder class per layer or rendition
     pcEncApp[layerIdx]->create();
 
     // parse configuration per layer
@@ -149,11 +235,12 @@ int main(int argc, char* argv[])
       int j = 0;
       for( int i = 0; i < argc; i++ )
       {
-        if( argv[i][0] == '-' && argv[i][1] == 'l' )
+        // options of one layer or rendition are given after -lx or -rx respectively
+        if( argv[i][0] == '-' && argv[i][1] == encoderPrefix )
         {
           if (argc <= i + 1)
           {
-            THROW("Command line parsing error: missing parameter after -lx\n");
+            THROW("Command line parsing error: missing parameter after " << argv[i] << "\n");
           }
           int numParams = 1; // count how many parameters are consumed
           // check for long parameters, which start with "--"
@@ -163,7 +250,7 @@ int main(int argc, char* argv[])
             // only short parameters have a second parameter for the value
             if (argc <= i + 2)
             {
-              THROW("Command line parsing error: missing parameter after -lx\n");
+              THROW("Command line parsing error: missing parameter after " << argv[i] << "\n");
             }
             numParams++;
           }
@@ -198,11 +285,13 @@ int main(int argc, char* argv[])
       return 1;
     }
 
-    pcEncApp[layerIdx]->createLib( layerIdx );
+    // renditions are independent single-layer streams, each of them is layer 0 of its own VPS
+    pcEncApp[layerIdx]->createLib( numRenditions > 1 ? 0 : layerIdx );
 
     if( !resized )
     {
-      pcEncApp.resize( pcEncApp[layerIdx]->getMaxLayers() );
+      CHECK(pcEncApp[layerIdx]->getNumRenditions() != numRenditions, "Renditions must not be set per rendition");
+      pcEncApp.resize( numRenditions > 1 ? numRenditions : pcEncApp[layerIdx]->getMaxLayers() );
       resized = true;
     }
 
@@ -211,7 +300,24 @@ int main(int argc, char* argv[])
 
   delete[] layerArgv;
 
-  if (layerIdx > 1)
+  // renditions take the pictures to be encoded from a single read of the input file, only the temporal filter of each
+  // rendition reads its reference pictures from the file itself
+  SharedYuvReader renditionSource;
+  if (numRenditions > 1)
+  {
+    pcEncApp[0]->openRenditionSource(renditionSource);
+    for (int i = 0; i < numRenditions; i++)
+    {
+      for (int j = 0; j < i; j++)
+      {
+        CHECK(pcEncApp[i]->getBitstreamFileName() == pcEncApp[j]->getBitstreamFileName(),
+              "Each rendition requires its own BitstreamFile");
+      }
+      pcEncApp[i]->setRenditionSource(&renditionSource, i, *pcEncApp[0]);
+    }
+  }
+
+  if (layerIdx > 1 && numRenditions == 1)
   {
     int nbLayersUsingAlf = 0;
     int totalUsedAPSIDs = 0;
@@ -284,65 +390,35 @@ int main(int argc, char* argv[])
   fprintf(stdout, " started @ %s", std::ctime(&startTime2) );
   clock_t startClock = clock();
 
-  // call encoding function per layer
-  bool eos = false;
-
-  while( !eos )
+  // call encoding function per layer, renditions are encoded in parallel
+  bool success = true;
+  if( numRenditions > 1 )
   {
-    // read GOP
-    bool keepLoop = true;
-    while( keepLoop )
+    std::vector<std::thread> threads;
+    std::vector<char>        renditionSuccess( numRenditions, 0 );
+    for( int i = 0; i < numRenditions; i++ )
     {
-      for( auto & encApp : pcEncApp )
-      {
-#ifndef _DEBUG
-        try
-        {
-#endif
-          keepLoop = encApp->encodePrep( eos );
-#ifndef _DEBUG
-        }
-        catch( Exception &e )
-        {
-          std::cerr << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-        catch( const std::bad_alloc &e )
-        {
-          std::cout << "Memory allocation failed: " << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-#endif
-      }
+      threads.emplace_back( [&, i]() {
+        std::vector<EncApp*> encApps( 1, pcEncApp[i] );
+        renditionSuccess[i] = encodeSequence( encApps );
+        pcEncApp[i]->finishRenditionSource();
+      } );
     }
-
-    // encode GOP
-    keepLoop = true;
-    while( keepLoop )
+    for( int i = 0; i < numRenditions; i++ )
     {
-      for( auto & encApp : pcEncApp )
-      {
-#ifndef _DEBUG
-        try
-        {
-#endif
-          keepLoop = encApp->encode();
-#ifndef _DEBUG
-        }
-        catch( Exception &e )
-        {
-          std::cerr << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-        catch( const std::bad_alloc &e )
-        {
-          std::cout << "Memory allocation failed: " << e.what() << std::endl;
-          return EXIT_FAILURE;
-        }
-#endif
-      }
+      threads[i].join();
+      success &= renditionSuccess[i] != 0;
     }
   }
+  else
+  {
+    success = encodeSequence( pcEncApp );
+  }
+  if( !success )
+  {
+    return EXIT_FAILURE;
+  }
+
   for( auto & encApp : pcEncApp )
   {
     if (encApp->getNNPostFilterEnabled())
@@ -351,6 +427,13 @@ int main(int argc, char* argv[])
     }
   }
 
+#if ENABLE_STAGE_PROFILING
+  if( !pcEncApp[0]->getProfileReportFile().empty() )
+  {
+    StageProfiler::writeReport( pcEncApp[0]->getProfileReportFile() );
+  }
+#endif
+
 #ifdef __linux
   int vm = getProcStatusValue("VmPeak:");
   int rm = getProcStatusValue("VmHWM:");
@@ -0,0 +1,1616 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     kernelbenchmain.cpp
+    \brief    Microbenchmark of the SIMD kernel tables
+
+    Every kernel is run through a table initialised with the scalar reference implementations and through a table
+    initialised for each x86 extension level supported by the CPU. The outputs must match bit-exactly, after which
+    both versions are timed on the same inputs.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Rom.h"
+#include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/TrQuant.h"
+#include "CommonLib/RdCost.h"
+#include "CommonLib/Buffer.h"
+#include "CommonLib/AffineGradientSearch.h"
+#include "CommonLib/AdaptiveLoopFilter.h"
+#include "CommonLib/CodingStructure.h"
+#include "program_options_lite.h"
+
+namespace po = ProgramOptionsLite;
+
+//! \ingroup KernelBenchApp
+//! \{
+
+#if ENABLE_SIMD_OPT && defined(TARGET_SIMD_X86)
+X86_VEXT _get_x86_extensions();
+
+// ====================================================================================================================
+// Test data
+// ====================================================================================================================
+
+static constexpr int BUF_MARGIN = 8;   // room for filter taps and out-of-bounds write detection around every block
+
+template<typename T> struct Plane
+{
+  Plane() = default;
+  Plane(int width, int height, int margin = BUF_MARGIN)
+    : stride(width + 2 * margin), data(size_t(height + 2 * margin) * (width + 2 * margin)), origin(margin * stride + margin)
+  {
+  }
+
+  T       *buf()       { return data.data() + origin; }
+  const T *buf() const { return data.data() + origin; }
+
+  bool operator==(const Plane &other) const { return data == other.data; }
+
+  ptrdiff_t      stride = 0;
+  std::vector<T> data;
+  ptrdiff_t      origin = 0;
+};
+
+class TestRng
+{
+public:
+  explicit TestRng(uint32_t seed) : m_gen(seed) {}
+
+  int uniform(int lo, int hi) { return std::uniform_int_distribution<int>(lo, hi)(m_gen); }
+
+  // Samples of a smooth gradient with noise on top, which is closer to natural content than white noise
+  template<typename T> void fillSamples(Plane<T> &plane, int bitDepth)
+  {
+    const int maxVal = (1 << bitDepth) - 1;
+    const int noise  = 1 << (bitDepth - 3);
+    const int width  = int(plane.stride);
+    const int height = int(plane.data.size() / plane.stride);
+    const int phase  = uniform(0, maxVal);
+
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        const int ramp               = (phase + (x * 3 + y * 5) * (1 << (bitDepth - 8))) % (maxVal + 1);
+        plane.data[y * width + x] = T(Clip3(0, maxVal, ramp + uniform(-noise, noise)));
+      }
+    }
+  }
+
+  // Samples at the internal precision of the interpolation filters, as fed to the bi-prediction kernels
+  void fillIntermediate(Plane<Pel> &plane, int bitDepth)
+  {
+    fillSamples(plane, bitDepth);
+    for (auto &v: plane.data)
+    {
+      v = Pel((v << IF_INTERNAL_FRAC_BITS(bitDepth)) - IF_INTERNAL_OFFS);
+    }
+  }
+
+  template<typename T> void fillRange(Plane<T> &plane, int lo, int hi)
+  {
+    for (auto &v: plane.data)
+    {
+      v = T(uniform(lo, hi));
+    }
+  }
+
+  template<typename T> void fillRange(std::vector<T> &vec, int lo, int hi)
+  {
+    for (auto &v: vec)
+    {
+      v = T(uniform(lo, hi));
+    }
+  }
+
+private:
+  std::mt19937 m_gen;
+};
+
+static ClpRng makeClpRng(int bitDepth)
+{
+  ClpRng clpRng;
+  clpRng.min = 0;
+  clpRng.max = (1 << bitDepth) - 1;
+  clpRng.bd  = bitDepth;
+  return clpRng;
+}
+
+// ====================================================================================================================
+// Kernel tables
+// ====================================================================================================================
+
+class TrQuantKernels : public TrQuant
+{
+public:
+  TrQuantKernels() { init(nullptr, MAX_TB_SIZEY, false, false, false, false); }
+
+  template<X86_VEXT vext> void initSimd() { _initX86<vext>(); }
+
+  FwdTrans *fwd(TransType type, int sizeIdx) const { return m_fwdTx[type][sizeIdx]; }
+  InvTrans *inv(TransType type, int sizeIdx) const { return m_invTx[type][sizeIdx]; }
+
+  FwdLfnst *fwdLfnst(int sizeIdx) const { return m_fwdLfnst[sizeIdx]; }
+  InvLfnst *invLfnst(int sizeIdx) const { return m_invLfnst[sizeIdx]; }
+};
+
+// One instance of every kernel table. RdCost keeps its table in a static member, so it is switched between the
+// scalar and the SIMD versions when a case is selected instead.
+struct KernelTables
+{
+  PelBufferOps         pelBufOps;
+  InterpolationFilter  interpolationFilter;
+  AffineGradientSearch affineGradientSearch;
+  AdaptiveLoopFilter   adaptiveLoopFilter;
+  TrQuantKernels       trQuant;
+  X86_VEXT             vext = SCALAR;
+
+  template<X86_VEXT ext> void initSimd()
+  {
+#if ENABLE_SIMD_OPT_BUFFER
+    pelBufOps._initPelBufOpsX86<ext>();
+#endif
+#if ENABLE_SIMD_OPT_MCIF
+    interpolationFilter._initInterpolationFilterX86<ext>();
+#endif
+#if ENABLE_SIMD_OPT_AFFINE_ME
+    affineGradientSearch._initAffineGradientSearchX86<ext>();
+#endif
+#if ENABLE_SIMD_OPT_ALF
+    adaptiveLoopFilter._initAdaptiveLoopFilterX86<ext>();
+#endif
+    trQuant.initSimd<ext>();
+    vext = ext;
+  }
+
+  void selectRdCost(RdCost &rdCost) const
+  {
+    rdCost.init();
+#if ENABLE_SIMD_OPT_DIST
+    switch (vext)
+    {
+    case AVX2:
+      rdCost._initRdCostX86<AVX2>();
+      break;
+    case AVX:
+      rdCost._initRdCostX86<AVX>();
+      break;
+    case SSE41:
+      rdCost._initRdCostX86<SSE41>();
+      break;
+    default:
+      break;
+    }
+#endif
+  }
+};
+
+// ====================================================================================================================
+// Benchmark cases
+// ====================================================================================================================
+
+struct KernelCase
+{
+  std::string name;
+  int         width;
+  int         height;
+  int         bitDepth;
+
+  std::function<void(int t)> select;   // optional, makes table t the active one for kernels with a static table
+  std::function<void(int t)> run;      // runs the kernel once from table t (0: scalar, 1: SIMD) into output t
+  std::function<bool()>      matches;  // compares the outputs of both runs
+};
+
+struct CaseContext
+{
+  KernelTables *tables[2];
+  RdCost       *rdCost;
+  int           width;
+  int           height;
+  int           bitDepth;
+  uint32_t      seed;
+
+  KernelCase make(const std::string &name) const { return KernelCase{ name, width, height, bitDepth, nullptr, nullptr, nullptr }; }
+};
+
+// Kernels of the tables without a case: calcBIOPar and calcBlkGradient of PelBufferOps and the CC-ALF filter have no
+// x86 versions, and ssimSumVer sums the SSIM values of the windows in a different order than the scalar version, so
+// its result is not bit-exact.
+
+static void addPelBufferOpsCases(const CaseContext &ctx, std::vector<KernelCase> &cases)
+{
+  KernelTables *const t[2] = { ctx.tables[0], ctx.tables[1] };
+
+  const int    w      = ctx.width;
+  const int    h      = ctx.height;
+  const int    bd     = ctx.bitDepth;
+  const ClpRng clpRng = makeClpRng(bd);
+
+  struct Data
+  {
+    Plane<Pel> src0, src1, dst[2], aux[2];
+    int64_t    sum[2][2];
+  };
+
+  auto init = [&](bool intermediate)
+  {
+    auto    d = std::make_shared<Data>();
+    TestRng rng(ctx.seed);
+    d->src0 = Plane<Pel>(w, h);
+    d->src1 = Plane<Pel>(w, h);
+    d->dst[0] = d->dst[1] = d->aux[0] = d->aux[1] = Plane<Pel>(w, h);
+    if (intermediate)
+    {
+      rng.fillIntermediate(d->src0, bd);
+      rng.fillIntermediate(d->src1, bd);
+    }
+    else
+    {
+      rng.fillSamples(d->src0, bd);
+      rng.fillSamples(d->src1, bd);
+    }
+    return d;
+  };
+
+  if (w % 4 == 0)
+  {
+    {
+      auto       d      = init(true);
+      const int  shift  = IF_INTERNAL_FRAC_BITS(bd) + 1;
+      const int  offset = (1 << (shift - 1)) + 2 * IF_INTERNAL_OFFS;
+      KernelCase c      = ctx.make("PelBufferOps.addAvg");
+      c.run             = [=](int i)
+      {
+        auto fn = w % 8 == 0 ? t[i]->pelBufOps.addAvg8 : t[i]->pelBufOps.addAvg4;
+        fn(d->src0.buf(), d->src0.stride, d->src1.buf(), d->src1.stride, d->dst[i].buf(), d->dst[i].stride, w, h,
+           shift, offset, clpRng);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+    {
+      auto    d = init(false);
+      TestRng rng(ctx.seed + 1);
+      rng.fillRange(d->src1, -(1 << (bd - 1)), (1 << (bd - 1)) - 1);
+      KernelCase c = ctx.make("PelBufferOps.reco");
+      c.run        = [=](int i)
+      {
+        auto fn = w % 8 == 0 ? t[i]->pelBufOps.reco8 : t[i]->pelBufOps.reco4;
+        fn(d->src0.buf(), d->src0.stride, d->src1.buf(), d->src1.stride, d->dst[i].buf(), d->dst[i].stride, w, h,
+           clpRng);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+    {
+      auto       d     = init(true);
+      const int  shift = IF_INTERNAL_FRAC_BITS(bd) + 5;
+      KernelCase c     = ctx.make("PelBufferOps.linTf");
+      c.run            = [=](int i)
+      {
+        auto fn = w % 8 == 0 ? t[i]->pelBufOps.linTf8 : t[i]->pelBufOps.linTf4;
+        fn(d->src0.buf(), d->src0.stride, d->dst[i].buf(), d->dst[i].stride, w, h, 37, shift, 3, clpRng, true);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+  }
+
+#if ENABLE_SIMD_OPT_BCW
+  // the BCW kernels have no scalar table entry, their reference is the generic code of AreaBuf, which is used as long
+  // as g_pelBufOP holds no SIMD versions (this tool never installs them). The 4 wide versions only handle width 4.
+  if ((w % 8 == 0 || w == 4) && g_pelBufOP.removeWeightHighFreq8 == nullptr && g_pelBufOP.removeHighFreq8 == nullptr)
+  {
+    {
+      auto         d         = init(false);
+      const int8_t bcwWeight = g_BcwWeights[1];
+      const Pel    minVal    = Pel(5 * clpRng.min - 4 * clpRng.max);
+      const Pel    maxVal    = Pel(5 * clpRng.max - 4 * clpRng.min);
+      KernelCase   c         = ctx.make("PelBufferOps.removeWeightHighFreq");
+      c.run                  = [=](int i)
+      {
+        // in-place kernel, every run starts from the same input
+        d->dst[i] = d->src0;
+        if (i == 0)
+        {
+          PelBuf(d->dst[i].buf(), d->dst[i].stride, w, h)
+            .removeWeightHighFreq(PelBuf(d->src1.buf(), d->src1.stride, w, h), false, clpRng, bcwWeight);
+        }
+        else
+        {
+          auto fn = w % 8 == 0 ? t[i]->pelBufOps.removeWeightHighFreq8 : t[i]->pelBufOps.removeWeightHighFreq4;
+          fn(d->dst[i].buf(), d->dst[i].stride, d->src1.buf(), d->src1.stride, w, h, bcwWeight, minVal, maxVal);
+        }
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+    {
+      auto       d = init(false);
+      KernelCase c = ctx.make("PelBufferOps.removeHighFreq");
+      c.run        = [=](int i)
+      {
+        d->dst[i] = d->src0;
+        if (i == 0)
+        {
+          PelBuf(d->dst[i].buf(), d->dst[i].stride, w, h)
+            .removeHighFreq(PelBuf(d->src1.buf(), d->src1.stride, w, h), false, clpRng);
+        }
+        else
+        {
+          auto fn = w % 8 == 0 ? t[i]->pelBufOps.removeHighFreq8 : t[i]->pelBufOps.removeHighFreq4;
+          fn(d->dst[i].buf(), d->dst[i].stride, d->src1.buf(), d->src1.stride, w, h);
+        }
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+  }
+#endif
+
+  {
+    auto       d = init(false);
+    KernelCase c = ctx.make("PelBufferOps.copyBuffer");
+    c.run        = [=](int i)
+    { t[i]->pelBufOps.copyBuffer(d->src0.buf(), d->src0.stride, d->dst[i].buf(), d->dst[i].stride, w, h); };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+  {
+    auto       d       = init(false);
+    const int  padSize = 2;
+    KernelCase c       = ctx.make("PelBufferOps.padding");
+    c.run              = [=](int i)
+    {
+      d->dst[i] = d->src0;
+      t[i]->pelBufOps.padding(d->dst[i].buf(), d->dst[i].stride, w, h, padSize);
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+
+  // BDOF works on sub-blocks of at most 16x16 luma samples, extended by one sample on each side
+  if ((w == 8 || w == 16) && (h == 8 || h == 16))
+  {
+    const int widthG  = w + 2 * BIO_EXTEND_SIZE;
+    const int heightG = h + 2 * BIO_EXTEND_SIZE;
+
+    struct GradData
+    {
+      Plane<Pel> src;
+      Plane<Pel> gradX[2], gradY[2];
+    };
+    auto    d = std::make_shared<GradData>();
+    TestRng rng(ctx.seed);
+    d->src = Plane<Pel>(widthG, heightG);
+    rng.fillIntermediate(d->src, bd);
+    d->gradX[0] = d->gradX[1] = d->gradY[0] = d->gradY[1] = Plane<Pel>(widthG, heightG, 0);
+
+    KernelCase c = ctx.make("PelBufferOps.bioGradFilter");
+    c.run        = [=](int i)
+    {
+      t[i]->pelBufOps.bioGradFilter(d->src.buf(), d->src.stride, widthG, heightG, widthG, d->gradX[i].buf(),
+                                    d->gradY[i].buf(), bd);
+    };
+    c.matches = [=]() { return d->gradX[0] == d->gradX[1] && d->gradY[0] == d->gradY[1]; };
+    cases.push_back(c);
+  }
+
+  // the BDOF sums over 6x6 windows and the final average of each 4x4 unit, on gradients derived from the predictions
+  if ((w == 8 || w == 16) && (h == 8 || h == 16))
+  {
+    const int widthG  = w + 2 * BIO_EXTEND_SIZE;
+    const int heightG = h + 2 * BIO_EXTEND_SIZE;
+
+    struct BioData
+    {
+      Plane<Pel>       src[2], gradX[2], gradY[2];
+      Plane<Pel>       dst[2];
+      std::vector<int> sums[2];
+    };
+    auto    d = std::make_shared<BioData>();
+    TestRng rng(ctx.seed);
+    for (int l = 0; l < 2; l++)
+    {
+      d->src[l] = Plane<Pel>(widthG, heightG);
+      rng.fillIntermediate(d->src[l], bd);
+      d->gradX[l] = d->gradY[l] = Plane<Pel>(widthG, heightG);
+      t[0]->pelBufOps.bioGradFilter(d->src[l].buf(), d->src[l].stride, widthG, heightG, d->gradX[l].stride,
+                                    d->gradX[l].buf(), d->gradY[l].buf(), bd);
+    }
+    d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+
+    const ptrdiff_t srcStride  = d->src[0].stride;
+    const ptrdiff_t gradStride = d->gradX[0].stride;
+    {
+      KernelCase c = ctx.make("PelBufferOps.calcBIOSums");
+      c.run        = [=](int i)
+      {
+        d->sums[i].assign(5 * (w >> 2) * (h >> 2), 0);
+        int *sums = d->sums[i].data();
+        for (int yu = 0; yu < (h >> 2); yu++)
+        {
+          for (int xu = 0; xu < (w >> 2); xu++, sums += 5)
+          {
+            const ptrdiff_t srcOffset  = (yu << 2) * srcStride + (xu << 2);
+            const ptrdiff_t gradOffset = (yu << 2) * gradStride + (xu << 2);
+            t[i]->pelBufOps.calcBIOSums(d->src[0].buf() + srcOffset, d->src[1].buf() + srcOffset,
+                                        d->gradX[0].buf() + gradOffset, d->gradX[1].buf() + gradOffset,
+                                        d->gradY[0].buf() + gradOffset, d->gradY[1].buf() + gradOffset, xu, yu,
+                                        srcStride, srcStride, int(gradStride), bd, &sums[0], &sums[1], &sums[2],
+                                        &sums[3], &sums[4]);
+          }
+        }
+      };
+      c.matches = [=]() { return d->sums[0] == d->sums[1]; };
+      cases.push_back(c);
+    }
+    {
+      const int  shift  = IF_INTERNAL_FRAC_BITS(bd) + 1;
+      const int  offset = (1 << (shift - 1)) + 2 * IF_INTERNAL_OFFS;
+      KernelCase c      = ctx.make("PelBufferOps.addBIOAvg4");
+      c.run             = [=](int i)
+      {
+        t[i]->pelBufOps.addBIOAvg4(d->src[0].buf() + srcStride + 1, srcStride, d->src[1].buf() + srcStride + 1,
+                                   srcStride, d->dst[i].buf(), d->dst[i].stride, d->gradX[0].buf() + gradStride + 1,
+                                   d->gradX[1].buf() + gradStride + 1, d->gradY[0].buf() + gradStride + 1,
+                                   d->gradY[1].buf() + gradStride + 1, gradStride, w, h, 5, -3, shift, offset,
+                                   clpRng);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+  }
+
+  // DMVR refines sub-blocks of at most 16x16 luma samples by up to DMVR_RANGE samples in each direction
+  if ((w == 8 || w == 16) && (h == 8 || h == 16))
+  {
+    const int refWidth  = w + NTAPS_LUMA - 1;
+    const int refHeight = h + NTAPS_LUMA - 1;
+
+    struct DmvrData
+    {
+      Plane<Pel> pred[2];
+      Plane<Pel> ref;
+      Plane<Pel> padded[2];
+      Distortion sad[2][DMVR_AREA];
+    };
+    auto    d = std::make_shared<DmvrData>();
+    TestRng rng(ctx.seed);
+    for (auto &pred: d->pred)
+    {
+      pred = Plane<Pel>(w + DMVR_SPAN - 1, h + DMVR_SPAN - 1);
+      rng.fillSamples(pred, bd);
+    }
+    d->ref = Plane<Pel>(refWidth, refHeight);
+    rng.fillSamples(d->ref, bd);
+    d->padded[0] = d->padded[1] = Plane<Pel>(refWidth, refHeight);
+
+    {
+      KernelCase c = ctx.make("PelBufferOps.dmvrIntegerSad");
+      c.run        = [=](int i)
+      {
+        const Pel *p0 = d->pred[0].buf() + DMVR_RANGE * d->pred[0].stride + DMVR_RANGE;
+        const Pel *p1 = d->pred[1].buf() + DMVR_RANGE * d->pred[1].stride + DMVR_RANGE;
+        t[i]->pelBufOps.dmvrIntegerSad(p0, d->pred[0].stride, p1, d->pred[1].stride, w, h, d->sad[i]);
+      };
+      c.matches = [=]() { return std::equal(d->sad[0], d->sad[0] + DMVR_AREA, d->sad[1]); };
+      cases.push_back(c);
+    }
+    {
+      KernelCase c = ctx.make("PelBufferOps.copyPadded");
+      c.run        = [=](int i)
+      {
+        t[i]->pelBufOps.copyPadded(d->ref.buf(), d->ref.stride, d->padded[i].buf(), d->padded[i].stride, refWidth,
+                                   refHeight, DMVR_RANGE);
+      };
+      c.matches = [=]() { return d->padded[0] == d->padded[1]; };
+      cases.push_back(c);
+    }
+  }
+
+  // PROF always runs on 4x4 affine sub-blocks
+  if (w == AFFINE_SUBBLOCK_SIZE && h == AFFINE_SUBBLOCK_SIZE)
+  {
+    constexpr int widthExt  = AFFINE_SUBBLOCK_SIZE + 2 * PROF_BORDER_EXT_W;
+    constexpr int heightExt = AFFINE_SUBBLOCK_SIZE + 2 * PROF_BORDER_EXT_H;
+
+    struct ProfData
+    {
+      Plane<Pel>       src;
+      Plane<Pel>       dst[2];
+      std::vector<int> dMvX, dMvY;
+    };
+    auto    d = std::make_shared<ProfData>();
+    TestRng rng(ctx.seed);
+    d->src = Plane<Pel>(widthExt, heightExt);
+    rng.fillIntermediate(d->src, bd);
+    d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+    d->dMvX.resize(w * h);
+    d->dMvY.resize(w * h);
+    rng.fillRange(d->dMvX, -31, 31);
+    rng.fillRange(d->dMvY, -31, 31);
+
+    for (const bool bi: { false, true })
+    {
+      const int  shift  = IF_INTERNAL_FRAC_BITS(bd);
+      const Pel  offset = Pel((1 << shift >> 1) + IF_INTERNAL_OFFS);
+      KernelCase c      = ctx.make(bi ? "PelBufferOps.applyPROF.bi" : "PelBufferOps.applyPROF");
+      c.run             = [=](int i)
+      {
+        t[i]->pelBufOps.applyPROF(d->dst[i].buf(), d->dst[i].stride,
+                                  d->src.buf() + PROF_BORDER_EXT_H * d->src.stride + PROF_BORDER_EXT_W, d->src.stride,
+                                  w, h, d->dMvX.data(), d->dMvY.data(), w, bi, shift, offset, clpRng);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+  }
+
+  // rounding of the PROF motion vector offsets, the reference is the scalar code of InterPrediction
+  if (w * h % 8 == 0)
+  {
+    struct RoundData
+    {
+      std::vector<int> src, dst[2];
+    };
+    auto    d = std::make_shared<RoundData>();
+    TestRng rng(ctx.seed);
+    d->src.resize(w * h);
+    rng.fillRange(d->src, -(1 << 12), 1 << 12);
+
+    const int  mvShift  = 7;
+    const int  dmvLimit = (1 << 5) - 1;
+    KernelCase c        = ctx.make("PelBufferOps.roundIntVector");
+    c.run               = [=](int i)
+    {
+      d->dst[i] = d->src;
+      if (t[i]->pelBufOps.roundIntVector == nullptr)
+      {
+        for (auto &v: d->dst[i])
+        {
+          Mv tmpMv(v, 0);
+          tmpMv >>= mvShift;
+          v = Clip3(-dmvLimit, dmvLimit, tmpMv.getHor());
+        }
+      }
+      else
+      {
+        t[i]->pelBufOps.roundIntVector(d->dst[i].data(), w * h, mvShift, dmvLimit);
+      }
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+
+  {
+    auto       d = init(false);
+    KernelCase c = ctx.make("PelBufferOps.sumAndSumSq");
+    c.run        = [=](int i)
+    { t[i]->pelBufOps.sumAndSumSq(d->src0.buf(), d->src0.stride, w, h, d->sum[i][0], d->sum[i][1]); };
+    c.matches = [=]() { return d->sum[0][0] == d->sum[1][0] && d->sum[0][1] == d->sum[1][1]; };
+    cases.push_back(c);
+  }
+  {
+    auto       d = init(false);
+    KernelCase c = ctx.make("PelBufferOps.sumSquaredDiff");
+    c.run        = [=](int i)
+    {
+      d->sum[i][0] =
+        int64_t(t[i]->pelBufOps.sumSquaredDiff(d->src0.buf(), d->src0.stride, d->src1.buf(), d->src1.stride, w, h));
+    };
+    c.matches = [=]() { return d->sum[0][0] == d->sum[1][0]; };
+    cases.push_back(c);
+  }
+  {
+    auto       d = init(false);
+    KernelCase c = ctx.make("PelBufferOps.fgsBlockSum");
+    c.run        = [=](int i) { d->sum[i][0] = t[i]->pelBufOps.fgsBlockSum(d->src0.buf(), d->src0.stride, w, h); };
+    c.matches    = [=]() { return d->sum[0][0] == d->sum[1][0]; };
+    cases.push_back(c);
+  }
+  {
+    struct GrainData
+    {
+      std::vector<int8_t> grain;
+      Plane<Pel>          dst[2];
+    };
+    auto    d = std::make_shared<GrainData>();
+    TestRng rng(ctx.seed);
+    d->grain.resize(w * h);
+    rng.fillRange(d->grain, -128, 127);
+    d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+
+    KernelCase c = ctx.make("PelBufferOps.fgsScaleGrain");
+    c.run        = [=](int i)
+    { t[i]->pelBufOps.fgsScaleGrain(d->dst[i].buf(), d->dst[i].stride, d->grain.data(), w, w, h, 181, 9); };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+  {
+    auto    d = init(false);
+    TestRng rng(ctx.seed + 1);
+    rng.fillRange(d->src1, -255, 255);
+    KernelCase c = ctx.make("PelBufferOps.fgsBlend");
+    c.run        = [=](int i)
+    {
+      d->dst[i] = d->src0;
+      t[i]->pelBufOps.fgsBlend(d->dst[i].buf(), d->dst[i].stride, d->src1.buf(), d->src1.stride, w, h, bd);
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+  {
+    auto       d = init(false);
+    KernelCase c = ctx.make("PelBufferOps.sobel3x3");
+    c.run        = [=](int i)
+    {
+      t[i]->pelBufOps.sobel3x3(d->src0.buf(), d->src0.stride, d->dst[i].buf(), d->aux[i].buf(), d->dst[i].stride, w,
+                               h);
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1] && d->aux[0] == d->aux[1]; };
+    cases.push_back(c);
+  }
+  {
+    auto    d = init(false);
+    TestRng rng(ctx.seed);
+    rng.fillRange(d->src0, 0, 1);
+    KernelCase c = ctx.make("PelBufferOps.morph3x3");
+    c.run        = [=](int i)
+    { t[i]->pelBufOps.morph3x3(d->src0.buf(), d->src0.stride, d->dst[i].buf(), d->dst[i].stride, w, h, 1); };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+
+  // horizontal moments of the (MS-)SSIM metric, computed in the same operation order as the scalar version
+  {
+    struct SsimData
+    {
+      std::vector<double> org, rec, taps, dst[2];
+    };
+    auto    d = std::make_shared<SsimData>();
+    TestRng rng(ctx.seed);
+    d->org.resize(w + SSIM_FILTER_SIZE - 1);
+    d->rec.resize(w + SSIM_FILTER_SIZE - 1);
+    for (size_t k = 0; k < d->org.size(); k++)
+    {
+      d->org[k] = rng.uniform(0, (1 << bd) - 1);
+      d->rec[k] = rng.uniform(0, (1 << bd) - 1);
+    }
+    for (int k = 0; k < SSIM_FILTER_SIZE; k++)
+    {
+      d->taps.push_back(std::exp(-0.5 * (k - SSIM_FILTER_SIZE / 2) * (k - SSIM_FILTER_SIZE / 2) / (1.5 * 1.5)));
+    }
+    d->dst[0] = d->dst[1] = std::vector<double>(5 * w);
+
+    KernelCase c = ctx.make("PelBufferOps.ssimMomentsHor");
+    c.run        = [=](int i)
+    { t[i]->pelBufOps.ssimMomentsHor(d->org.data(), d->rec.data(), w, d->taps.data(), d->dst[i].data(), w); };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+
+  // conversion between the rows of a YUV file (8 bit, or 16 bit little endian) and samples
+  for (const bool wide: { false, true })
+  {
+    const int bytesPerSample = wide ? 2 : 1;
+
+    struct FileData
+    {
+      std::vector<uint8_t> file, packed[2];
+      Plane<Pel>           samples, unpacked[2];
+    };
+    auto    d = std::make_shared<FileData>();
+    TestRng rng(ctx.seed);
+    d->file.resize(size_t(w) * h * bytesPerSample);
+    rng.fillRange(d->file, 0, 255);
+    for (size_t k = 1; wide && k < d->file.size(); k += 2)
+    {
+      d->file[k] &= (1 << (bd - 8)) - 1;
+    }
+    d->packed[0] = d->packed[1] = std::vector<uint8_t>(d->file.size());
+    d->samples = Plane<Pel>(w, h);
+    rng.fillSamples(d->samples, wide ? bd : 8);
+    d->unpacked[0] = d->unpacked[1] = Plane<Pel>(w, h);
+
+    {
+      KernelCase c = ctx.make(wide ? "PelBufferOps.unpackSamples16" : "PelBufferOps.unpackSamples8");
+      c.run        = [=](int i)
+      {
+        auto fn = wide ? t[i]->pelBufOps.unpackSamples16 : t[i]->pelBufOps.unpackSamples8;
+        for (int y = 0; y < h; y++)
+        {
+          fn(d->file.data() + y * w * bytesPerSample, d->unpacked[i].buf() + y * d->unpacked[i].stride, w);
+        }
+      };
+      c.matches = [=]() { return d->unpacked[0] == d->unpacked[1]; };
+      cases.push_back(c);
+    }
+    {
+      KernelCase c = ctx.make(wide ? "PelBufferOps.packSamples16" : "PelBufferOps.packSamples8");
+      c.run        = [=](int i)
+      {
+        auto fn = wide ? t[i]->pelBufOps.packSamples16 : t[i]->pelBufOps.packSamples8;
+        for (int y = 0; y < h; y++)
+        {
+          fn(d->samples.buf() + y * d->samples.stride, d->packed[i].data() + y * w * bytesPerSample, w);
+        }
+      };
+      c.matches = [=]() { return d->packed[0] == d->packed[1]; };
+      cases.push_back(c);
+    }
+  }
+
+  // bit depth conversion of the samples read from or written to a file
+  for (const int shift: { 2, -2 })
+  {
+    auto       d      = init(false);
+    const Pel  maxVal = Pel((1 << (bd + std::min(shift, 0))) - 1);
+    KernelCase c      = ctx.make(shift > 0 ? "PelBufferOps.scaleSamples.up" : "PelBufferOps.scaleSamples.down");
+    c.run             = [=](int i)
+    {
+      d->dst[i] = d->src0;
+      t[i]->pelBufOps.scaleSamples(d->dst[i].buf(), d->dst[i].stride, w, h, shift, 0, maxVal);
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+
+  {
+    auto       d = init(false);
+    KernelCase c = ctx.make("PelBufferOps.checksumRow");
+    c.run        = [=](int i)
+    {
+      uint32_t checksum = 0;
+      for (int y = 0; y < h; y++)
+      {
+        checksum += t[i]->pelBufOps.checksumRow(d->src0.buf() + y * d->src0.stride, w, uint8_t(y), bd > 8);
+      }
+      d->sum[i][0] = checksum;
+    };
+    c.matches = [=]() { return d->sum[0][0] == d->sum[1][0]; };
+    cases.push_back(c);
+  }
+
+  // reference picture resampling: the horizontal and vertical passes of Picture::sampleRateConv, downsampling by 1.5,
+  // and the horizontal pass of the scaled motion compensation with the interpolation filters, downsampling by 1.25
+  for (const int numTaps: { 8, 16 })
+  {
+    struct RescaleData
+    {
+      std::vector<Pel>          src;
+      std::vector<int>          srcPos;
+      std::vector<TFilterCoeff> coeff;
+      std::vector<int>          dst[2];
+    };
+    auto    d = std::make_shared<RescaleData>();
+    TestRng rng(ctx.seed);
+    d->srcPos.resize(w);
+    for (int x = 0; x < w; x++)
+    {
+      d->srcPos[x] = x * 3 / 2;
+    }
+    const int srcWidth = d->srcPos[w - 1] + numTaps + BUF_MARGIN;
+    d->src.resize(size_t(srcWidth) * h);
+    rng.fillRange(d->src, 0, (1 << bd) - 1);
+    d->coeff.resize(w * numTaps);
+    rng.fillRange(d->coeff, -16, 48);
+    d->dst[0] = d->dst[1] = std::vector<int>(w * h);
+
+    KernelCase c = ctx.make(numTaps == 8 ? "PelBufferOps.rescaleHor" : "PelBufferOps.rescaleHor.16");
+    c.run        = [=](int i)
+    {
+      for (int y = 0; y < h; y++)
+      {
+        t[i]->pelBufOps.rescaleHor(d->src.data() + y * srcWidth, d->srcPos.data(), d->coeff.data(), numTaps,
+                                   d->dst[i].data() + y * w, w);
+      }
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+  for (const int numTaps: { 8, 12 })
+  {
+    struct RescaleData
+    {
+      std::vector<int>          src;
+      std::vector<TFilterCoeff> coeff;
+      Plane<Pel>                dst[2];
+    };
+    auto    d = std::make_shared<RescaleData>();
+    TestRng rng(ctx.seed);
+    d->src.resize(size_t(w) * (h + numTaps - 1));
+    rng.fillRange(d->src, -(1 << (bd + 5)), (1 << (bd + 7)) - 1);
+    d->coeff.resize(numTaps);
+    rng.fillRange(d->coeff, -16, 48);
+    d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+
+    KernelCase c = ctx.make(numTaps == 8 ? "PelBufferOps.rescaleVer" : "PelBufferOps.rescaleVer.12");
+    c.run        = [=](int i)
+    {
+      const int *rows[16];
+      for (int y = 0; y < h; y++)
+      {
+        for (int k = 0; k < numTaps; k++)
+        {
+          rows[k] = d->src.data() + (y + k) * w;
+        }
+        t[i]->pelBufOps.rescaleVer(rows, d->coeff.data(), numTaps, d->dst[i].buf() + y * d->dst[i].stride, w, 14,
+                                   (1 << bd) - 1);
+      }
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+  for (const ComponentID compID: { COMPONENT_Y, COMPONENT_Cb })
+  {
+    const int numTaps = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+    const int numFrac = isLuma(compID) ? LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS
+                                       : CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS;
+
+    struct ScaledData
+    {
+      Plane<Pel>                src, dst[2];
+      std::vector<int>          srcPos;
+      std::vector<TFilterCoeff> coeff;
+    };
+    auto    d = std::make_shared<ScaledData>();
+    TestRng rng(ctx.seed);
+    d->srcPos.resize(w);
+    d->coeff.resize(w * numTaps);
+    for (int x = 0; x < w; x++)
+    {
+      const int pos = x * 5 * numFrac / 4;
+      d->srcPos[x]  = pos / numFrac;
+      InterpolationFilter::getScaledFilterCoeff(compID, pos % numFrac, InterpolationFilter::Filter::DEFAULT,
+                                                d->coeff.data() + x * numTaps);
+    }
+    d->src = Plane<Pel>(d->srcPos[w - 1] + numTaps, h);
+    rng.fillSamples(d->src, bd);
+    d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+
+    const int  shift  = IF_FILTER_PREC - IF_INTERNAL_FRAC_BITS(bd);
+    const int  offset = -IF_INTERNAL_OFFS * (1 << shift);
+    KernelCase c = ctx.make(isLuma(compID) ? "PelBufferOps.scaledFilterHor" : "PelBufferOps.scaledFilterHor.chroma");
+    c.run        = [=](int i)
+    {
+      t[i]->pelBufOps.scaledFilterHor(d->src.buf(), d->src.stride, d->srcPos.data(), d->coeff.data(), numTaps,
+                                      d->dst[i].buf(), d->dst[i].stride, w, h, shift, offset);
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+}
+
+static void addInterpolationFilterCases(const CaseContext &ctx, std::vector<KernelCase> &cases)
+{
+  KernelTables *const t[2] = { ctx.tables[0], ctx.tables[1] };
+
+  const int    w      = ctx.width;
+  const int    h      = ctx.height;
+  const int    bd     = ctx.bitDepth;
+  const ClpRng clpRng = makeClpRng(bd);
+
+  if (w % 4 != 0)
+  {
+    return;
+  }
+
+  struct Data
+  {
+    Plane<Pel> src, dst[2];
+  };
+
+  struct FilterCase
+  {
+    const char *name;
+    ComponentID compID;
+    bool        vertical;
+    bool        isFirst;
+    bool        isLast;
+    int         frac;
+  };
+
+  static const FilterCase filterCases[] = {
+    { "InterpolationFilter.lumaHor", COMPONENT_Y, false, true, false, 5 },
+    { "InterpolationFilter.lumaHorLast", COMPONENT_Y, false, true, true, 5 },
+    { "InterpolationFilter.lumaVer", COMPONENT_Y, true, false, true, 11 },
+    { "InterpolationFilter.lumaVerFirst", COMPONENT_Y, true, true, false, 11 },
+    { "InterpolationFilter.chromaHor", COMPONENT_Cb, false, true, false, 9 },
+    { "InterpolationFilter.chromaVer", COMPONENT_Cb, true, false, true, 23 },
+  };
+
+  for (const auto &fc: filterCases)
+  {
+    auto    d = std::make_shared<Data>();
+    TestRng rng(ctx.seed);
+    d->src = Plane<Pel>(w, h);
+    if (fc.isFirst)
+    {
+      rng.fillSamples(d->src, bd);
+    }
+    else
+    {
+      rng.fillIntermediate(d->src, bd);
+    }
+    d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+
+    KernelCase c = ctx.make(fc.name);
+    c.run        = [=](int i)
+    {
+      if (fc.vertical)
+      {
+        t[i]->interpolationFilter.filterVer(fc.compID, d->src.buf(), d->src.stride, d->dst[i].buf(), d->dst[i].stride,
+                                            w, h, fc.frac, fc.isFirst, fc.isLast, clpRng,
+                                            InterpolationFilter::Filter::DEFAULT);
+      }
+      else
+      {
+        t[i]->interpolationFilter.filterHor(fc.compID, d->src.buf(), d->src.stride, d->dst[i].buf(), d->dst[i].stride,
+                                            w, h, fc.frac, fc.isLast, clpRng, InterpolationFilter::Filter::DEFAULT);
+      }
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+}
+
+static void addRdCostCases(const CaseContext &ctx, std::vector<KernelCase> &cases)
+{
+  KernelTables *const t[2] = { ctx.tables[0], ctx.tables[1] };
+  RdCost             *rdCost = ctx.rdCost;
+
+  const int w  = ctx.width;
+  const int h  = ctx.height;
+  const int bd = ctx.bitDepth;
+
+  struct Data
+  {
+    Plane<Pel> org, cur;
+    Distortion dist[2];
+  };
+
+  static const std::pair<const char *, DFunc> distFuncs[] = {
+    { "RdCost.SSE", DFunc::SSE },
+    { "RdCost.SAD", DFunc::SAD },
+    { "RdCost.HAD", DFunc::HAD },
+    { "RdCost.MRSAD", DFunc::MRSAD },
+  };
+
+  for (const auto &df: distFuncs)
+  {
+    auto    d = std::make_shared<Data>();
+    TestRng rng(ctx.seed);
+    d->org = Plane<Pel>(w, h);
+    d->cur = Plane<Pel>(w, h);
+    rng.fillSamples(d->org, bd);
+    rng.fillSamples(d->cur, bd);
+
+    const DFunc distFunc = df.second;
+    KernelCase  c        = ctx.make(df.first);
+    c.select             = [=](int i) { t[i]->selectRdCost(*rdCost); };
+    c.run                = [=](int i)
+    {
+      const CPelBuf org(d->org.buf(), d->org.stride, w, h);
+      const CPelBuf cur(d->cur.buf(), d->cur.stride, w, h);
+      d->dist[i] = rdCost->getDistPart(org, cur, bd, COMPONENT_Y, distFunc);
+    };
+    c.matches = [=]() { return d->dist[0] == d->dist[1]; };
+    cases.push_back(c);
+  }
+}
+
+static void addTrQuantCases(const CaseContext &ctx, std::vector<KernelCase> &cases)
+{
+  KernelTables *const t[2] = { ctx.tables[0], ctx.tables[1] };
+
+  const int w  = ctx.width;
+  const int h  = ctx.height;
+  const int bd = ctx.bitDepth;
+
+  if (w < 4 || h < 4 || w > MAX_TB_SIZEY || h > MAX_TB_SIZEY)
+  {
+    return;
+  }
+
+  const int maxLog2TrDynamicRange = std::max<int>(15, bd + 6);
+  const int widthIdx              = floorLog2(w) - 1;
+  const int heightIdx             = floorLog2(h) - 1;
+
+  struct Data
+  {
+    std::vector<TCoeff> src, tmp, dst[2];
+  };
+
+  static const std::pair<const char *, TransType> trTypes[] = {
+    { "DCT2", TransType::DCT2 },
+    { "DST7", TransType::DST7 },
+    { "DCT8", TransType::DCT8 },
+  };
+
+  for (const auto &tt: trTypes)
+  {
+    const TransType trType = tt.second;
+    if (t[0]->trQuant.fwd(trType, widthIdx) == nullptr || t[0]->trQuant.fwd(trType, heightIdx) == nullptr)
+    {
+      continue;
+    }
+
+    const int skipWidth  = (trType != TransType::DCT2 && w == 32) ? 16 : std::max(w - MAX_NONZERO_TU_SIZE, 0);
+    const int skipHeight = (trType != TransType::DCT2 && h == 32) ? 16 : std::max(h - MAX_NONZERO_TU_SIZE, 0);
+
+    {
+      auto    d = std::make_shared<Data>();
+      TestRng rng(ctx.seed);
+      d->src.resize(w * h);
+      d->tmp.resize(w * h);
+      d->dst[0] = d->dst[1] = std::vector<TCoeff>(w * h);
+      rng.fillRange(d->src, -(1 << (bd - 1)), (1 << (bd - 1)) - 1);
+
+      const int matrixShift = g_transformMatrixShift[TRANSFORM_FORWARD];
+      const int shift1 = floorLog2(w) + bd + matrixShift - maxLog2TrDynamicRange + COM16_C806_TRANS_PREC;
+      const int shift2 = floorLog2(h) + matrixShift + COM16_C806_TRANS_PREC;
+
+      KernelCase c = ctx.make(std::string("TrQuant.fwd") + tt.first);
+      c.run        = [=](int i)
+      {
+        t[i]->trQuant.fwd(trType, widthIdx)(d->src.data(), d->tmp.data(), shift1, h, 0, skipWidth);
+        t[i]->trQuant.fwd(trType, heightIdx)(d->tmp.data(), d->dst[i].data(), shift2, w, skipWidth, skipHeight);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+    {
+      auto    d = std::make_shared<Data>();
+      TestRng rng(ctx.seed);
+      d->src.resize(w * h);
+      d->tmp.resize(w * h);
+      d->dst[0] = d->dst[1] = std::vector<TCoeff>(w * h);
+      for (int y = 0; y < h - skipHeight; y++)
+      {
+        for (int x = 0; x < w - skipWidth; x++)
+        {
+          d->src[y * w + x] = rng.uniform(-(1 << (bd - 2)), (1 << (bd - 2)) - 1);
+        }
+      }
+
+      const int    matrixShift = g_transformMatrixShift[TRANSFORM_INVERSE];
+      const int    shift1      = matrixShift + 1 + COM16_C806_TRANS_PREC;
+      const int    shift2      = (matrixShift + maxLog2TrDynamicRange - 1) - bd + COM16_C806_TRANS_PREC;
+      const TCoeff clipMin  = -(1 << maxLog2TrDynamicRange);
+      const TCoeff clipMax  = (1 << maxLog2TrDynamicRange) - 1;
+      const TCoeff pelMin   = std::numeric_limits<Pel>::min();
+      const TCoeff pelMax   = std::numeric_limits<Pel>::max();
+
+      KernelCase c = ctx.make(std::string("TrQuant.inv") + tt.first);
+      c.run        = [=](int i)
+      {
+        t[i]->trQuant.inv(trType, heightIdx)(d->src.data(), d->tmp.data(), shift1, w, skipWidth, skipHeight, clipMin,
+                                             clipMax);
+        t[i]->trQuant.inv(trType, widthIdx)(d->tmp.data(), d->dst[i].data(), shift2, h, 0, skipWidth, pelMin, pelMax);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+  }
+
+  // LFNST of the top-left 4x4 or 8x8 sub-block, with the reduced number of coefficients of 4x4 and 8x8 blocks
+  {
+    const int     sizeIdx     = w >= 8 && h >= 8 ? 1 : 0;
+    const int     trSize      = sizeIdx ? 48 : 16;
+    const int     zeroOutSize = w == h && (w == 4 || w == 8) ? 8 : 16;
+    const int8_t *trMat       = sizeIdx ? g_lfnst8x8[1][0][0] : g_lfnst4x4[1][0][0];
+
+    {
+      auto    d = std::make_shared<Data>();
+      TestRng rng(ctx.seed);
+      d->src.resize(trSize);
+      d->dst[0] = d->dst[1] = std::vector<TCoeff>(trSize);
+      rng.fillRange(d->src, -(1 << 15), (1 << 15) - 1);
+
+      KernelCase c = ctx.make("TrQuant.fwdLfnst");
+      c.run        = [=](int i) { t[i]->trQuant.fwdLfnst(sizeIdx)(d->src.data(), d->dst[i].data(), trMat, zeroOutSize); };
+      c.matches    = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+    {
+      auto    d = std::make_shared<Data>();
+      TestRng rng(ctx.seed);
+      d->src.resize(zeroOutSize);
+      d->dst[0] = d->dst[1] = std::vector<TCoeff>(trSize);
+      rng.fillRange(d->src, -(1 << 15), (1 << 15) - 1);
+
+      const TCoeff clipMin = -(1 << maxLog2TrDynamicRange);
+      const TCoeff clipMax = (1 << maxLog2TrDynamicRange) - 1;
+
+      KernelCase c = ctx.make("TrQuant.invLfnst");
+      c.run        = [=](int i)
+      {
+        t[i]->trQuant.invLfnst(sizeIdx)(d->src.data(), d->dst[i].data(), trMat, zeroOutSize, clipMin, clipMax);
+      };
+      c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+      cases.push_back(c);
+    }
+  }
+}
+
+static void addAffineGradientSearchCases(const CaseContext &ctx, std::vector<KernelCase> &cases)
+{
+  KernelTables *const t[2] = { ctx.tables[0], ctx.tables[1] };
+
+  const int w  = ctx.width;
+  const int h  = ctx.height;
+  const int bd = ctx.bitDepth;
+
+  // affine motion estimation only runs on blocks of at least 8x8 luma samples
+  if (w < 8 || h < 8)
+  {
+    return;
+  }
+
+  struct Data
+  {
+    Plane<Pel>       pred, resi;
+    std::vector<int> deriv[2][2];
+    int64_t          equalCoeff[2][7][7];
+  };
+
+  auto    d = std::make_shared<Data>();
+  TestRng rng(ctx.seed);
+  d->pred = Plane<Pel>(w, h);
+  d->resi = Plane<Pel>(w, h, 0);
+  rng.fillSamples(d->pred, bd);
+  rng.fillRange(d->resi, -(1 << (bd - 2)), (1 << (bd - 2)) - 1);
+  for (int i = 0; i < 2; i++)
+  {
+    d->deriv[i][0].resize(w * h);
+    d->deriv[i][1].resize(w * h);
+  }
+
+  {
+    KernelCase c = ctx.make("AffineGradientSearch.sobel");
+    c.run        = [=](int i)
+    {
+      t[i]->affineGradientSearch.m_HorizontalSobelFilter(d->pred.buf(), d->pred.stride, d->deriv[i][0].data(), w, w,
+                                                         h);
+      t[i]->affineGradientSearch.m_VerticalSobelFilter(d->pred.buf(), d->pred.stride, d->deriv[i][1].data(), w, w, h);
+    };
+    c.matches = [=]() { return d->deriv[0][0] == d->deriv[1][0] && d->deriv[0][1] == d->deriv[1][1]; };
+    cases.push_back(c);
+  }
+  {
+    KernelCase c = ctx.make("AffineGradientSearch.equalCoeff");
+    c.run        = [=](int i)
+    {
+      // derivatives come from the scalar reference so that both versions see the same input
+      int *deriv[2] = { d->deriv[0][0].data(), d->deriv[0][1].data() };
+      memset(d->equalCoeff[i], 0, sizeof(d->equalCoeff[i]));
+      t[i]->affineGradientSearch.m_EqualCoeffComputer(d->resi.buf(), d->resi.stride, deriv, w, d->equalCoeff[i], w, h,
+                                                      true);
+    };
+    c.matches = [=]() { return memcmp(d->equalCoeff[0], d->equalCoeff[1], sizeof(d->equalCoeff[0])) == 0; };
+    cases.push_back(c);
+  }
+}
+
+static void addAdaptiveLoopFilterCases(const CaseContext &ctx, std::vector<KernelCase> &cases)
+{
+  KernelTables *const t[2] = { ctx.tables[0], ctx.tables[1] };
+
+  const int w  = ctx.width;
+  const int h  = ctx.height;
+  const int bd = ctx.bitDepth;
+
+  // ALF processes CTUs in units of 8x8 luma samples, with the virtual boundary four rows above the CTU boundary
+  if (w % 8 != 0 || h % 8 != 0 || w > MAX_CU_SIZE || h > MAX_CU_SIZE)
+  {
+    return;
+  }
+  const int vbCtuHeight = MAX_CU_SIZE;
+  const int vbPos       = MAX_CU_SIZE - ALF_VB_POS_ABOVE_CTUROW_LUMA;
+  const int vbCtuHeightChroma = MAX_CU_SIZE / 2;
+  const int vbPosChroma       = MAX_CU_SIZE / 2 - ALF_VB_POS_ABOVE_CTUROW_CHMA;
+  const int blkSize     = AdaptiveLoopFilter::m_CLASSIFICATION_BLK_SIZE;
+
+  struct Data
+  {
+    Plane<Pel>                 src, dst[2];
+    std::vector<AlfClassifier> classData[2];
+    std::vector<AlfClassifier *> classRows[2];
+    std::vector<int>           laplacianData;
+    std::vector<int *>         laplacianRows;
+    int                      **laplacian[NUM_DIRECTIONS];
+    std::vector<AlfCoeff>      coeff;
+    std::vector<Pel>           clip;
+    XuPool                     xuPool;
+    std::unique_ptr<CodingStructure> cs;
+  };
+
+  auto    d = std::make_shared<Data>();
+  TestRng rng(ctx.seed);
+  d->src = Plane<Pel>(w, h);
+  rng.fillSamples(d->src, bd);
+  d->dst[0] = d->dst[1] = Plane<Pel>(w, h);
+  for (int i = 0; i < 2; i++)
+  {
+    d->classData[i].resize(w * h);
+    d->classRows[i].resize(h);
+    for (int y = 0; y < h; y++)
+    {
+      d->classRows[i][y] = d->classData[i].data() + y * w;
+    }
+  }
+
+  const int lapSize = blkSize + 8;
+  d->laplacianData.resize(NUM_DIRECTIONS * lapSize * lapSize);
+  d->laplacianRows.resize(NUM_DIRECTIONS * lapSize);
+  for (int dir = 0; dir < NUM_DIRECTIONS; dir++)
+  {
+    for (int y = 0; y < lapSize; y++)
+    {
+      d->laplacianRows[dir * lapSize + y] = d->laplacianData.data() + (dir * lapSize + y) * lapSize;
+    }
+    d->laplacian[dir] = d->laplacianRows.data() + dir * lapSize;
+  }
+
+  d->coeff.resize(MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF);
+  d->clip.resize(MAX_NUM_ALF_CLASSES * MAX_NUM_ALF_LUMA_COEFF);
+  rng.fillRange(d->coeff, -64, 63);
+  for (auto &v: d->clip)
+  {
+    const int clipIdx = rng.uniform(0, AdaptiveLoopFilter::MAX_ALF_NUM_CLIP_VALS - 1);
+    v                 = Pel(clipIdx == 0 ? 1 << bd : 1 << (bd - 1 - 2 * clipIdx));
+  }
+  d->cs.reset(new CodingStructure(d->xuPool));
+
+  {
+    KernelCase c = ctx.make("AdaptiveLoopFilter.classification");
+    c.run        = [=](int i)
+    {
+      const CPelBuf src(d->src.buf(), d->src.stride, w, h);
+      for (int y = 0; y < h; y += blkSize)
+      {
+        for (int x = 0; x < w; x += blkSize)
+        {
+          const Area blk(x, y, std::min(blkSize, w - x), std::min(blkSize, h - y));
+          t[i]->adaptiveLoopFilter.m_deriveClassificationBlk(d->classRows[i].data(), d->laplacian, src, blk, blk,
+                                                             bd + 4, vbCtuHeight, vbPos);
+        }
+      }
+    };
+    c.matches = [=]()
+    {
+      for (int k = 0; k < w * h; k++)
+      {
+        if (d->classData[0][k].classIdx != d->classData[1][k].classIdx
+            || d->classData[0][k].transposeIdx != d->classData[1][k].transposeIdx)
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+    cases.push_back(c);
+  }
+
+  for (int chroma = 0; chroma < 2; chroma++)
+  {
+    const ComponentID compID = chroma ? COMPONENT_Cb : COMPONENT_Y;
+    const ClpRng      clpRng = makeClpRng(bd);
+
+    KernelCase c = ctx.make(chroma ? "AdaptiveLoopFilter.filter5x5" : "AdaptiveLoopFilter.filter7x7");
+    c.run        = [=](int i)
+    {
+      // the classes come from the scalar reference so that both versions see the same input
+      const PelBuf      src(d->src.buf(), d->src.stride, w, h);
+      const PelBuf      dst(d->dst[i].buf(), d->dst[i].stride, w, h);
+      const CPelUnitBuf recSrc(ChromaFormat::_444, src, src, src);
+      const PelUnitBuf  recDst(ChromaFormat::_444, dst, dst, dst);
+      const Area        blk(0, 0, w, h);
+      auto filter = chroma ? t[i]->adaptiveLoopFilter.m_filter5x5Blk : t[i]->adaptiveLoopFilter.m_filter7x7Blk;
+      filter(d->classRows[0].data(), recDst, recSrc, blk, blk, compID, d->coeff.data(), d->clip.data(), clpRng, *d->cs,
+             chroma ? vbCtuHeightChroma : vbCtuHeight, chroma ? vbPosChroma : vbPos);
+    };
+    c.matches = [=]() { return d->dst[0] == d->dst[1]; };
+    cases.push_back(c);
+  }
+}
+
+static std::vector<KernelCase> createCases(KernelTables *tables[2], RdCost *rdCost, int width, int height, int bitDepth)
+{
+  CaseContext ctx{ { tables[0], tables[1] }, rdCost, width, height, bitDepth, uint32_t(width * 1000003 + height * 1009 + bitDepth) };
+
+  std::vector<KernelCase> cases;
+  addPelBufferOpsCases(ctx, cases);
+  addInterpolationFilterCases(ctx, cases);
+  addRdCostCases(ctx, cases);
+  addTrQuantCases(ctx, cases);
+  addAffineGradientSearchCases(ctx, cases);
+  addAdaptiveLoopFilterCases(ctx, cases);
+  return cases;
+}
+
+// ====================================================================================================================
+// Measurement
+// ====================================================================================================================
+
+// Returns the average time of one call in nanoseconds, repeating the call until at least minTimeMs have elapsed
+static double timeKernel(const std::function<void()> &fn, double minTimeMs)
+{
+  fn();
+
+  int64_t iterations = 1;
+  for (;;)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int64_t i = 0; i < iterations; i++)
+    {
+      fn();
+    }
+    const double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    if (elapsedMs >= minTimeMs || iterations >= (int64_t(1) << 32))
+    {
+      return elapsedMs * 1e6 / double(iterations);
+    }
+    iterations = elapsedMs > 0 ? std::max(2 * iterations, int64_t(1.2 * iterations * minTimeMs / elapsedMs))
+                               : 16 * iterations;
+  }
+}
+
+static const char *vextName(X86_VEXT vext)
+{
+  switch (vext)
+  {
+  case SSE41:  return "SSE41";
+  case SSE42:  return "SSE42";
+  case AVX:    return "AVX";
+  case AVX2:   return "AVX2";
+  case AVX512: return "AVX512";
+  default:     return "SCALAR";
+  }
+}
+
+// ====================================================================================================================
+// Main function
+// ====================================================================================================================
+
+int main(int argc, char *argv[])
+{
+  fprintf(stdout, "\n");
+  fprintf(stdout, "VVCSoftware: VTM Kernel Benchmark Version %s ", VTM_VERSION);
+  fprintf(stdout, NVM_ONOS);
+  fprintf(stdout, NVM_COMPILEDBY);
+  fprintf(stdout, NVM_BITS);
+  fprintf(stdout, "\n");
+
+  bool        doHelp   = false;
+  std::string filter;
+  std::string simd;
+  double      minTime  = 10.0;
+  bool        allSizes = false;
+  bool        checkOnly = false;
+
+  po::Options opts;
+  // clang-format off
+  opts.addOptions()
+  ("help",       doHelp,    false,           "this help text")
+  ("Filter",     filter,    std::string(""), "only run kernels whose name contains this string")
+  ("SIMD",       simd,      std::string(""), "highest SIMD extension to test (SSE41, AVX, AVX2), default: highest supported by the CPU")
+  ("MinTime",    minTime,   10.0,            "minimum measurement time per kernel and table in milliseconds")
+  ("AllSizes",   allSizes,  false,           "test all combinations of block widths and heights instead of square blocks only")
+  ("CheckOnly",  checkOnly, false,           "only compare the SIMD kernels against the scalar reference, without timing")
+  ;
+  // clang-format on
+
+  po::setDefaults(opts);
+  po::ErrorReporter err;
+  po::scanArgv(opts, argc, (const char **) argv, err);
+  if (doHelp || err.is_errored)
+  {
+    po::doHelp(std::cout, opts);
+    return doHelp ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  // Every table constructed from now on keeps the scalar reference implementations. The SIMD versions are installed
+  // explicitly per extension level below.
+  read_x86_extension_flags("SCALAR");
+
+  X86_VEXT maxVext = _get_x86_extensions();
+  if (!simd.empty())
+  {
+    const X86_VEXT levels[] = { SCALAR, SSE41, SSE42, AVX, AVX2, AVX512 };
+    bool           found    = false;
+    for (X86_VEXT level: levels)
+    {
+      if (simd == vextName(level))
+      {
+        maxVext = std::min(maxVext, level);
+        found   = true;
+      }
+    }
+    if (!found)
+    {
+      fprintf(stderr, "Unknown SIMD extension %s\n", simd.c_str());
+      return EXIT_FAILURE;
+    }
+  }
+  std::vector<X86_VEXT> vexts;
+  for (X86_VEXT level: { SSE41, AVX, AVX2 })
+  {
+    if (level <= maxVext)
+    {
+      vexts.push_back(level);
+    }
+  }
+  if (vexts.empty())
+  {
+    fprintf(stdout, "The CPU supports no SIMD extension, nothing to compare\n");
+    return EXIT_SUCCESS;
+  }
+
+  initROM();
+
+  int numMismatches = 0;
+  int numCases      = 0;
+
+#ifndef _DEBUG
+  try
+  {
+#endif
+    std::unique_ptr<KernelTables> scalarTables(new KernelTables);
+    std::unique_ptr<KernelTables> simdTables(new KernelTables);
+    KernelTables                 *tables[2] = { scalarTables.get(), simdTables.get() };
+    RdCost                        rdCost;
+
+    const int sizes[]     = { 4, 8, 16, 32, 64, 128 };
+    const int bitDepths[] = { 8, 10, 12 };
+
+    fprintf(stdout, "%-38s %9s %3s %-6s %12s %12s %8s  %s\n", "Kernel", "Size", "BD", "SIMD", "scalar[ns]", "simd[ns]",
+            "speedup", "check");
+
+    for (int width: sizes)
+    {
+      for (int height: sizes)
+      {
+        if (!allSizes && width != height)
+        {
+          continue;
+        }
+        for (int bitDepth: bitDepths)
+        {
+          std::vector<KernelCase> cases = createCases(tables, &rdCost, width, height, bitDepth);
+
+          for (auto &c: cases)
+          {
+            if (!filter.empty() && c.name.find(filter) == std::string::npos)
+            {
+              continue;
+            }
+
+            double scalarNs = 0;
+            for (X86_VEXT vext: vexts)
+            {
+              switch (vext)
+              {
+              case AVX2:
+                simdTables->initSimd<AVX2>();
+                break;
+              case AVX:
+                simdTables->initSimd<AVX>();
+                break;
+              default:
+                simdTables->initSimd<SSE41>();
+                break;
+              }
+              for (int i = 0; i < 2; i++)
+              {
+                if (c.select)
+                {
+                  c.select(i);
+                }
+                c.run(i);
+              }
+              const bool ok = c.matches();
+              numCases++;
+              numMismatches += ok ? 0 : 1;
+
+              double simdNs = 0;
+              if (!checkOnly)
+              {
+                if (scalarNs == 0)
+                {
+                  if (c.select)
+                  {
+                    c.select(0);
+                  }
+                  scalarNs = timeKernel([&]() { c.run(0); }, minTime);
+                }
+                if (c.select)
+                {
+                  c.select(1);
+                }
+                simdNs = timeKernel([&]() { c.run(1); }, minTime);
+              }
+
+              const std::string size = std::to_string(c.width) + "x" + std::to_string(c.height);
+              fprintf(stdout, "%-38s %9s %3d %-6s %12.1f %12.1f %7.2fx  %s\n", c.name.c_str(), size.c_str(),
+                      c.bitDepth, vextName(vext), scalarNs, simdNs, simdNs > 0 ? scalarNs / simdNs : 0.0,
+                      ok ? "OK" : "MISMATCH");
+              fflush(stdout);
+            }
+          }
+        }
+      }
+    }
+#ifndef _DEBUG
+  }
+  catch (Exception &e)
+  {
+    std::cerr << e.what() << std::endl;
+    destroyROM();
+    return EXIT_FAILURE;
+  }
+#endif
+
+  destroyROM();
+
+  fprintf(stdout, "\n%d of %d kernel comparisons mismatched the scalar reference\n", numMismatches, numCases);
+  return numMismatches == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+
+int main(int argc, char *argv[])
+{
+  fprintf(stdout, "The kernel benchmark needs a build with x86 SIMD optimisations enabled\n");
+  return EXIT_SUCCESS;
+}
+
+#endif
+
+//! \}
@@ -36,6 +36,7 @@
 */
 
 #include "AdaptiveLoopFilter.h"
+#include "StageProfiler.h"
 
 #include "CodingStructure.h"
 #include "Picture.h"
@@ -373,6 +374,7 @@ void AdaptiveLoopFilter::applyCcAlfFilter(CodingStructure& cs, ComponentID compI
 
 void AdaptiveLoopFilter::ALFProcess(CodingStructure& cs)
 {
+  PROFILE_STAGE( "ALF" );
 
   // set clipping range
   m_clpRngs = cs.slice->getClpRngs();
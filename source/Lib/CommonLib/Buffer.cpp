@@ -43,17 +43,20 @@
 #include "InterpolationFilter.h"
 
 void applyPROFCore(Pel *dst, ptrdiff_t dstStride, const Pel *src, ptrdiff_t srcStride, int width, int height,
-                   const Pel *gradX, const Pel *gradY, ptrdiff_t gradStride, const int *dMvX, const int *dMvY,
-                   ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset, const ClpRng &clpRng)
+                   const int *dMvX, const int *dMvY, ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset,
+                   const ClpRng &clpRng)
 {
-  int idx = 0;
-
   const int dILimit = 1 << std::max<int>(clpRng.bd + 1, 13);
+  const int shift1  = 6;
+
   for (int h = 0; h < height; h++)
   {
     for (int w = 0; w < width; w++)
     {
-      int32_t dI = dMvX[idx] * gradX[w] + dMvY[idx] * gradY[w];
+      const Pel gradX = (src[w + 1] >> shift1) - (src[w - 1] >> shift1);
+      const Pel gradY = (src[w + srcStride] >> shift1) - (src[w - srcStride] >> shift1);
+
+      int32_t dI = dMvX[w] * gradX + dMvY[w] * gradY;
       dI = Clip3(-dILimit, dILimit - 1, dI);
       dst[w] = src[w] + dI;
       if (!bi)
@@ -61,11 +64,9 @@ void applyPROFCore(Pel *dst, ptrdiff_t dstStride, const Pel *src, ptrdiff_t srcS
         dst[w] = (dst[w] + offset) >> shiftNum;
         dst[w] = ClipPel(dst[w], clpRng);
       }
-
-      idx++;
     }
-    gradX += gradStride;
-    gradY += gradStride;
+    dMvX += dMvStride;
+    dMvY += dMvStride;
     dst += dstStride;
     src += srcStride;
   }
@@ -274,6 +275,8 @@ PelBufferOps::PelBufferOps()
 
   copyBuffer = copyBufferCore;
   padding = paddingCore;
+  copyPadded     = copyPaddedCore;
+  dmvrIntegerSad = dmvrIntegerSadCore;
 #if ENABLE_SIMD_OPT_BCW
   removeWeightHighFreq8 = nullptr;
   removeWeightHighFreq4 = nullptr;
@@ -281,9 +284,33 @@ PelBufferOps::PelBufferOps()
   removeHighFreq4       = nullptr;
 #endif
 
-  profGradFilter = gradFilterCore <false>;
   applyPROF      = applyPROFCore;
   roundIntVector = nullptr;
+
+  fgsScaleGrain = fgsScaleGrainCore;
+  fgsBlockSum   = fgsBlockSumCore;
+  fgsBlend      = fgsBlendCore;
+
+  sobel3x3    = sobel3x3Core;
+  morph3x3    = morph3x3Core;
+  sumAndSumSq = sumAndSumSqCore;
+
+  unpackSamples8  = unpackSamples8Core;
+  unpackSamples16 = unpackSamples16Core;
+  packSamples8    = packSamples8Core;
+  packSamples16   = packSamples16Core;
+  scaleSamples    = scaleSamplesCore;
+
+  sumSquaredDiff = sumSquaredDiffCore;
+  ssimMomentsHor = ssimMomentsHorCore;
+  ssimSumVer     = ssimSumVerCore;
+
+  checksumRow = checksumRowCore;
+
+  rescaleHor = rescaleHorCore;
+  rescaleVer = rescaleVerCore;
+
+  scaledFilterHor = scaledFilterHorCore;
 }
 
 PelBufferOps g_pelBufOP = PelBufferOps();
@@ -297,6 +324,318 @@ void copyBufferCore(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dst
   }
 }
 
+void fgsScaleGrainCore(Pel *dst, ptrdiff_t dstStride, const int8_t *src, ptrdiff_t srcStride, int width, int height,
+                       int scale, int shift)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = (Pel) ((scale * src[x]) >> shift);
+    }
+    dst += dstStride;
+    src += srcStride;
+  }
+}
+
+uint32_t fgsBlockSumCore(const Pel *src, ptrdiff_t srcStride, int width, int height)
+{
+  uint32_t sum = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      sum += src[x];
+    }
+    src += srcStride;
+  }
+  return sum;
+}
+
+void fgsBlendCore(Pel *dst, ptrdiff_t dstStride, const Pel *grain, ptrdiff_t grainStride, int width, int height,
+                  int bitDepth)
+{
+  const int maxVal = (1 << bitDepth) - 1;
+  const int shift  = bitDepth - 8;
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      dst[x] = (Pel) Clip3(0, maxVal, ((int) grain[x] << shift) + (uint16_t) dst[x]);
+    }
+    dst += dstStride;
+    grain += grainStride;
+  }
+}
+
+// 3x3 Sobel operator, gradVer responds to horizontal edges and gradHor to vertical edges.
+// The source needs one valid sample of margin around the block.
+void sobel3x3Core(const Pel *src, ptrdiff_t srcStride, Pel *gradVer, Pel *gradHor, ptrdiff_t gradStride, int width,
+                  int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    const Pel *above = src - srcStride;
+    const Pel *below = src + srcStride;
+
+    for (int x = 0; x < width; x++)
+    {
+      gradVer[x] = (Pel) ((below[x - 1] + 2 * below[x] + below[x + 1]) - (above[x - 1] + 2 * above[x] + above[x + 1]));
+      gradHor[x] = (Pel) ((above[x + 1] + 2 * src[x + 1] + below[x + 1]) - (above[x - 1] + 2 * src[x - 1] + below[x - 1]));
+    }
+    src += srcStride;
+    gradVer += gradStride;
+    gradHor += gradStride;
+  }
+}
+
+// Sets a sample to matchVal if any sample of its 3x3 neighbourhood equals matchVal, copies it otherwise.
+// With matchVal at the maximum this is a binary dilation, with matchVal zero a binary erosion.
+void morph3x3Core(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                  Pel matchVal)
+{
+  for (int y = 0; y < height; y++)
+  {
+    const Pel *above = src - srcStride;
+    const Pel *below = src + srcStride;
+
+    for (int x = 0; x < width; x++)
+    {
+      bool match = false;
+      for (int k = -1; k <= 1; k++)
+      {
+        match |= above[x + k] == matchVal || src[x + k] == matchVal || below[x + k] == matchVal;
+      }
+      dst[x] = match ? matchVal : src[x];
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+void sumAndSumSqCore(const Pel *src, ptrdiff_t srcStride, int width, int height, int64_t &sum, int64_t &sumSq)
+{
+  sum   = 0;
+  sumSq = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      sum += src[x];
+      sumSq += src[x] * src[x];
+    }
+    src += srcStride;
+  }
+}
+
+// Conversion between file samples (8 bit, or 16 bit little endian) and Pel
+void unpackSamples8Core(const uint8_t *src, Pel *dst, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = src[x];
+  }
+}
+
+void unpackSamples16Core(const uint8_t *src, Pel *dst, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = Pel(src[2 * x + 0]) | (Pel(src[2 * x + 1]) << 8);
+  }
+}
+
+void packSamples8Core(const Pel *src, uint8_t *dst, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[x] = (uint8_t) src[x];
+  }
+}
+
+void packSamples16Core(const Pel *src, uint8_t *dst, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    dst[2 * x + 0] = (src[x] >> 0) & 0xff;
+    dst[2 * x + 1] = (src[x] >> 8) & 0xff;
+  }
+}
+
+// Multiplies by 2^shift for positive shift, divides with rounding and clips for negative shift
+void scaleSamplesCore(Pel *buf, ptrdiff_t stride, int width, int height, int shift, Pel minVal, Pel maxVal)
+{
+  if (shift > 0)
+  {
+    for (int y = 0; y < height; y++, buf += stride)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        buf[x] <<= shift;
+      }
+    }
+  }
+  else if (shift < 0)
+  {
+    const int shiftR   = -shift;
+    const Pel rounding = 1 << (shiftR - 1);
+
+    for (int y = 0; y < height; y++, buf += stride)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        buf[x] = Clip3(minVal, maxVal, Pel((buf[x] + rounding) >> shiftR));
+      }
+    }
+  }
+}
+
+uint64_t sumSquaredDiffCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                            int height)
+{
+  uint64_t sum = 0;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const int64_t diff = (int64_t) src0[x] - (int64_t) src1[x];
+      sum += uint64_t(diff * diff);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+  return sum;
+}
+
+// Separable 11-tap filtering for SSIM. The horizontal pass writes the five moment rows mu_org, mu_rec, org^2, rec^2
+// and org*rec, momentStride apart, for the windows starting at 0..width-1.
+void ssimMomentsHorCore(const double *org, const double *rec, int width, const double *taps, double *dst,
+                        ptrdiff_t dstStride)
+{
+  for (int x = 0; x < width; x++)
+  {
+    double muOrg = 0, muRec = 0, orgSqr = 0, recSqr = 0, orgRec = 0;
+    for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+    {
+      const double w = taps[i];
+      const double o = org[x + i];
+      const double r = rec[x + i];
+      muOrg += w * o;
+      muRec += w * r;
+      orgSqr += w * o * o;
+      recSqr += w * r * r;
+      orgRec += w * o * r;
+    }
+    dst[0 * dstStride + x] = muOrg;
+    dst[1 * dstStride + x] = muRec;
+    dst[2 * dstStride + x] = orgSqr;
+    dst[3 * dstStride + x] = recSqr;
+    dst[4 * dstStride + x] = orgRec;
+  }
+}
+
+// The vertical pass filters the moment rows of SSIM_FILTER_SIZE consecutive lines and returns the sum of the SSIM
+// values of the windows, the luminance term is only included on request.
+double ssimSumVerCore(const double *const *rows, ptrdiff_t momentStride, int width, const double *taps, double c1,
+                      double c2, bool useLuminance)
+{
+  double sum = 0;
+  for (int x = 0; x < width; x++)
+  {
+    double m[5] = { 0, 0, 0, 0, 0 };
+    for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+    {
+      for (int k = 0; k < 5; k++)
+      {
+        m[k] += taps[i] * rows[i][k * momentStride + x];
+      }
+    }
+    const double sigmaSqrOrg = m[2] - m[0] * m[0];
+    const double sigmaSqrRec = m[3] - m[1] * m[1];
+    const double sigmaOrgRec = m[4] - m[0] * m[1];
+
+    double ssim = (2.0 * sigmaOrgRec + c2) / (sigmaSqrOrg + sigmaSqrRec + c2);
+    if (useLuminance)
+    {
+      ssim *= (2.0 * m[0] * m[1] + c1) / (m[0] * m[0] + m[1] * m[1] + c1);
+    }
+    sum += ssim;
+  }
+  return sum;
+}
+
+// Row sum of the decoded picture hash checksum, each sample byte is XORed with the mask of its position
+uint32_t checksumRowCore(const Pel *src, int width, uint8_t rowMask, bool highByte)
+{
+  uint32_t checksum = 0;
+  for (int x = 0; x < width; x++)
+  {
+    const uint8_t xorMask = (x & 0xff) ^ (x >> 8) ^ rowMask;
+    checksum += (src[x] & 0xff) ^ xorMask;
+    if (highByte)
+    {
+      checksum += (src[x] >> 8) ^ xorMask;
+    }
+  }
+  return checksum;
+}
+
+// Horizontal pass of the picture resampling, output x filters numTaps samples from src + srcPos[x] with its own
+// coefficients coeff[x * numTaps ...]. The sums are not normalized.
+void rescaleHorCore(const Pel *src, const int *srcPos, const TFilterCoeff *coeff, int numTaps, int *dst, int width)
+{
+  for (int x = 0; x < width; x++)
+  {
+    const Pel          *s   = src + srcPos[x];
+    const TFilterCoeff *f   = coeff + x * numTaps;
+    int                 sum = 0;
+    for (int k = 0; k < numTaps; k++)
+    {
+      sum += f[k] * s[k];
+    }
+    dst[x] = sum;
+  }
+}
+
+// Vertical pass of the picture resampling, filters the rows src[0 ... numTaps - 1] of horizontal sums and normalizes
+void rescaleVerCore(const int *const *src, const TFilterCoeff *coeff, int numTaps, Pel *dst, int width, int shift,
+                    int maxVal)
+{
+  for (int x = 0; x < width; x++)
+  {
+    int sum = 0;
+    for (int k = 0; k < numTaps; k++)
+    {
+      sum += coeff[k] * src[k][x];
+    }
+    dst[x] = std::min<int>(std::max(0, (sum + (1 << (shift - 1))) >> shift), maxVal);
+  }
+}
+
+// First (horizontal) pass of the scaled reference motion compensation, every output column x filters numTaps samples
+// from src + srcPos[x] with its own coefficients coeff[x * numTaps ...]
+void scaledFilterHorCore(const Pel *src, ptrdiff_t srcStride, const int *srcPos, const TFilterCoeff *coeff, int numTaps,
+                         Pel *dst, ptrdiff_t dstStride, int width, int height, int shift, int offset)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      const Pel          *s   = src + srcPos[x];
+      const TFilterCoeff *f   = coeff + x * numTaps;
+      int                 sum = 0;
+      for (int k = 0; k < numTaps; k++)
+      {
+        sum += f[k] * s[k];
+      }
+      dst[x] = (sum + offset) >> shift;
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
 void paddingCore(Pel *ptr, ptrdiff_t stride, int width, int height, int padSize)
 {
   /*left and right padding*/
@@ -321,6 +660,61 @@ void paddingCore(Pel *ptr, ptrdiff_t stride, int width, int height, int padSize)
     memcpy(ptrTemp2 + i * stride, (ptrTemp2), numBytes);
   }
 }
+
+// copies a width x height block and replicates its border samples padSize times around it, equivalent to copyBuffer
+// followed by padding but in a single pass over the destination
+void copyPaddedCore(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                    int padSize)
+{
+  Pel *dstRow = dst;
+  for (int i = 0; i < height; i++)
+  {
+    memcpy(dstRow, src, width * sizeof(Pel));
+    for (int j = 1; j <= padSize; j++)
+    {
+      dstRow[-j]            = src[0];
+      dstRow[width - 1 + j] = src[width - 1];
+    }
+    src += srcStride;
+    dstRow += dstStride;
+  }
+
+  const int numBytes = (width + 2 * padSize) * sizeof(Pel);
+  const Pel *top     = dst - padSize;
+  const Pel *bottom  = dst + (height - 1) * dstStride - padSize;
+  for (int i = 1; i <= padSize; i++)
+  {
+    memcpy(dst - padSize - i * dstStride, top, numBytes);
+    memcpy(dst + (height - 1 + i) * dstStride - padSize, bottom, numBytes);
+  }
+}
+
+// DMVR integer search: SADs between src0 displaced by (h, v) and src1 displaced by (-h, -v) for all DMVR_AREA offsets
+// with |h|, |v| <= DMVR_RANGE, taken over the even rows only. sad[] is in raster order of the offsets, starting at
+// (-DMVR_RANGE, -DMVR_RANGE).
+void dmvrIntegerSadCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                        int height, Distortion sad[DMVR_AREA])
+{
+  for (int v = -DMVR_RANGE, idx = 0; v <= DMVR_RANGE; v++)
+  {
+    for (int h = -DMVR_RANGE; h <= DMVR_RANGE; h++, idx++)
+    {
+      const Pel *p0  = src0 + v * src0Stride + h;
+      const Pel *p1  = src1 - v * src1Stride - h;
+      Distortion sum = 0;
+      for (int y = 0; y < height; y += 2)
+      {
+        for (int x = 0; x < width; x++)
+        {
+          sum += abs(p0[x] - p1[x]);
+        }
+        p0 += 2 * src0Stride;
+        p1 += 2 * src1Stride;
+      }
+      sad[idx] = sum;
+    }
+  }
+}
 template<>
 void AreaBuf<Pel>::addWeightedAvg(const AreaBuf<const Pel> &other1, const AreaBuf<const Pel> &other2, const ClpRng& clpRng, const int8_t bcwIdx)
 {
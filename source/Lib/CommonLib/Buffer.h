@@ -91,6 +91,10 @@ struct PelBufferOps
   void(*calcBlkGradient)(int sx, int sy, int    *arraysGx2, int     *arraysGxGy, int     *arraysGxdI, int     *arraysGy2, int     *arraysGydI, int     &sGx2, int     &sGy2, int     &sGxGy, int     &sGxdI, int     &sGydI, int width, int height, int unitSize);
   void (*copyBuffer)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height);
   void (*padding)(Pel *dst, ptrdiff_t stride, int width, int height, int padSize);
+  void (*copyPadded)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                     int padSize);
+  void (*dmvrIntegerSad)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                         int height, Distortion sad[DMVR_AREA]);
 #if ENABLE_SIMD_OPT_BCW
   void (*removeWeightHighFreq8)(Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
                                 int height, int bcwWeight, const Pel minVal, const Pel maxVal);
@@ -101,18 +105,75 @@ struct PelBufferOps
   void (*removeHighFreq4)(Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
                           int height);
 #endif
-  void (*profGradFilter)(Pel *pSrc, ptrdiff_t srcStride, int width, int height, ptrdiff_t gradStride, Pel *gradX,
-                         Pel *gradY, const int bitDepth);
+  // computes the PROF gradients of src, which must have a border of one sample, and applies the offsets
   void (*applyPROF)(Pel *dst, ptrdiff_t dstStride, const Pel *src, ptrdiff_t srcStride, int width, int height,
-                    const Pel *gradX, const Pel *gradY, ptrdiff_t gradStride, const int *dMvX, const int *dMvY,
-                    ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset, const ClpRng &clpRng);
+                    const int *dMvX, const int *dMvY, ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset,
+                    const ClpRng &clpRng);
   void (*roundIntVector) (int* v, int size, unsigned int nShift, const int dmvLimit);
+  void (*fgsScaleGrain)(Pel *dst, ptrdiff_t dstStride, const int8_t *src, ptrdiff_t srcStride, int width, int height,
+                        int scale, int shift);
+  uint32_t (*fgsBlockSum)(const Pel *src, ptrdiff_t srcStride, int width, int height);
+  void (*fgsBlend)(Pel *dst, ptrdiff_t dstStride, const Pel *grain, ptrdiff_t grainStride, int width, int height,
+                   int bitDepth);
+  void (*sobel3x3)(const Pel *src, ptrdiff_t srcStride, Pel *gradVer, Pel *gradHor, ptrdiff_t gradStride, int width,
+                   int height);
+  void (*morph3x3)(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                   Pel matchVal);
+  void (*sumAndSumSq)(const Pel *src, ptrdiff_t srcStride, int width, int height, int64_t &sum, int64_t &sumSq);
+  void (*unpackSamples8)(const uint8_t *src, Pel *dst, int width);
+  void (*unpackSamples16)(const uint8_t *src, Pel *dst, int width);
+  void (*packSamples8)(const Pel *src, uint8_t *dst, int width);
+  void (*packSamples16)(const Pel *src, uint8_t *dst, int width);
+  void (*scaleSamples)(Pel *buf, ptrdiff_t stride, int width, int height, int shift, Pel minVal, Pel maxVal);
+  uint64_t (*sumSquaredDiff)(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                             int height);
+  void (*ssimMomentsHor)(const double *org, const double *rec, int width, const double *taps, double *dst,
+                         ptrdiff_t dstStride);
+  double (*ssimSumVer)(const double *const *rows, ptrdiff_t momentStride, int width, const double *taps, double c1,
+                       double c2, bool useLuminance);
+  uint32_t (*checksumRow)(const Pel *src, int width, uint8_t rowMask, bool highByte);
+  void (*rescaleHor)(const Pel *src, const int *srcPos, const TFilterCoeff *coeff, int numTaps, int *dst, int width);
+  void (*rescaleVer)(const int *const *src, const TFilterCoeff *coeff, int numTaps, Pel *dst, int width, int shift,
+                     int maxVal);
+  void (*scaledFilterHor)(const Pel *src, ptrdiff_t srcStride, const int *srcPos, const TFilterCoeff *coeff,
+                          int numTaps, Pel *dst, ptrdiff_t dstStride, int width, int height, int shift, int offset);
 };
 
 extern PelBufferOps g_pelBufOP;
 
 void paddingCore(Pel *ptr, ptrdiff_t stride, int width, int height, int padSize);
 void copyBufferCore(const Pel *src, ptrdiff_t srcStride, Pel *Dst, ptrdiff_t dstStride, int width, int height);
+void copyPaddedCore(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                    int padSize);
+void dmvrIntegerSadCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                        int height, Distortion sad[DMVR_AREA]);
+void fgsScaleGrainCore(Pel *dst, ptrdiff_t dstStride, const int8_t *src, ptrdiff_t srcStride, int width, int height,
+                       int scale, int shift);
+uint32_t fgsBlockSumCore(const Pel *src, ptrdiff_t srcStride, int width, int height);
+void fgsBlendCore(Pel *dst, ptrdiff_t dstStride, const Pel *grain, ptrdiff_t grainStride, int width, int height,
+                  int bitDepth);
+void sobel3x3Core(const Pel *src, ptrdiff_t srcStride, Pel *gradVer, Pel *gradHor, ptrdiff_t gradStride, int width,
+                  int height);
+void morph3x3Core(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                  Pel matchVal);
+void sumAndSumSqCore(const Pel *src, ptrdiff_t srcStride, int width, int height, int64_t &sum, int64_t &sumSq);
+void unpackSamples8Core(const uint8_t *src, Pel *dst, int width);
+void unpackSamples16Core(const uint8_t *src, Pel *dst, int width);
+void packSamples8Core(const Pel *src, uint8_t *dst, int width);
+void packSamples16Core(const Pel *src, uint8_t *dst, int width);
+void scaleSamplesCore(Pel *buf, ptrdiff_t stride, int width, int height, int shift, Pel minVal, Pel maxVal);
+uint64_t sumSquaredDiffCore(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                            int height);
+void     ssimMomentsHorCore(const double *org, const double *rec, int width, const double *taps, double *dst,
+                            ptrdiff_t dstStride);
+double   ssimSumVerCore(const double *const *rows, ptrdiff_t momentStride, int width, const double *taps, double c1,
+                        double c2, bool useLuminance);
+uint32_t checksumRowCore(const Pel *src, int width, uint8_t rowMask, bool highByte);
+void     rescaleHorCore(const Pel *src, const int *srcPos, const TFilterCoeff *coeff, int numTaps, int *dst, int width);
+void     rescaleVerCore(const int *const *src, const TFilterCoeff *coeff, int numTaps, Pel *dst, int width, int shift,
+                        int maxVal);
+void scaledFilterHorCore(const Pel *src, ptrdiff_t srcStride, const int *srcPos, const TFilterCoeff *coeff, int numTaps,
+                         Pel *dst, ptrdiff_t dstStride, int width, int height, int shift, int offset);
 
 template<typename T>
 struct AreaBuf : public Size
@@ -74,6 +74,7 @@ CodingStructure::CodingStructure(XuPool &xuPool)
   m_isDecomp.fill(nullptr);
 
   m_motionBuf     = nullptr;
+  m_colMotionBuf  = nullptr;
   picHeader = nullptr;
 
   features.resize( NUM_ENC_FEATURES );
@@ -95,9 +96,7 @@ void CodingStructure::destroy()
   m_orgr.destroy();
 
   destroyTemporaryCsData();
-
-  delete[] m_motionBuf;
-  m_motionBuf = nullptr;
+  destroyMotionBuf();
 }
 
 void CodingStructure::destroyTemporaryCsData()
@@ -136,6 +135,57 @@ void CodingStructure::destroyTemporaryCsData()
   m_numCUs = 0;
 }
 
+void CodingStructure::createMotionBuf()
+{
+  if (m_motionBuf == nullptr)
+  {
+    m_motionBuf = new MotionInfo[g_miScaling.scale(area.lumaSize()).area()];
+
+    delete[] m_colMotionBuf;
+    m_colMotionBuf = nullptr;
+  }
+}
+
+void CodingStructure::destroyMotionBuf()
+{
+  delete[] m_motionBuf;
+  m_motionBuf = nullptr;
+  delete[] m_colMotionBuf;
+  m_colMotionBuf = nullptr;
+}
+
+// Replaces the motion field of a completed picture by the subsampled field read when it is used as collocated
+// picture. Temporal MV prediction only reads the top-left 4x4 block of each 8x8 block.
+void CodingStructure::compactMotion()
+{
+  if (m_motionBuf == nullptr)
+  {
+    return;
+  }
+
+  const int      colShift  = COL_MOTION_LOG2_SIZE - MIN_CU_LOG2;
+  const unsigned stride    = g_miScaling.scaleHor(area.lwidth());
+  const unsigned miHeight  = g_miScaling.scaleVer(area.lheight());
+  const unsigned colStride = (stride + (1 << colShift) - 1) >> colShift;
+  const unsigned colHeight = (miHeight + (1 << colShift) - 1) >> colShift;
+
+  delete[] m_colMotionBuf;
+  m_colMotionBuf = new ColMotionInfo[colStride * colHeight];
+
+  for (unsigned y = 0; y < colHeight; y++)
+  {
+    const MotionInfo *src = m_motionBuf + (y << colShift) * stride;
+    ColMotionInfo    *dst = m_colMotionBuf + y * colStride;
+    for (unsigned x = 0; x < colStride; x++)
+    {
+      dst[x] = ColMotionInfo(src[x << colShift]);
+    }
+  }
+
+  delete[] m_motionBuf;
+  m_motionBuf = nullptr;
+}
+
 void CodingStructure::createTemporaryCsData(bool isPLTused)
 {
   createCoeffs(isPLTused);
@@ -1374,8 +1424,7 @@ void CodingStructure::createInternals(const UnitArea& _unit, const bool isTopLay
     createTemporaryCsData(isPLTused);
   }
 
-  unsigned _lumaAreaScaled = g_miScaling.scale( area.lumaSize() ).area();
-  m_motionBuf       = new MotionInfo[_lumaAreaScaled];
+  createMotionBuf();
   if (!isTopLayer)
   {
     initStructData();
@@ -1502,23 +1551,23 @@ void CodingStructure::rebindPicBufs()
 
   if (!picture->M_BUFS(0, PIC_RECONSTRUCTION).bufs.empty())
   {
-    m_reco.createFromBuf(picture->M_BUFS(0, PIC_RECONSTRUCTION));
+    m_reco.createFromBuf(picture->M_BUFS(0, PIC_RECONSTRUCTION).getBuf(area));
   }
   else
   {
     m_reco.destroy();
   }
-  if (!picture->M_BUFS(0, PIC_PREDICTION).bufs.empty())
+  if (!picture->getPredBuf().bufs.empty())
   {
-    m_pred.createFromBuf(picture->M_BUFS(0, PIC_PREDICTION));
+    m_pred.createFromBuf(picture->getPredBuf());
   }
   else
   {
     m_pred.destroy();
   }
-  if (!picture->M_BUFS(0, PIC_RESIDUAL).bufs.empty())
+  if (!picture->getResiBuf().bufs.empty())
   {
-    m_resi.createFromBuf(picture->M_BUFS(0, PIC_RESIDUAL));
+    m_resi.createFromBuf(picture->getResiBuf());
   }
   else
   {
@@ -1526,9 +1575,12 @@ void CodingStructure::rebindPicBufs()
   }
   if( pcv->isEncoder )
   {
-    if (!picture->M_BUFS(0, PIC_RESIDUAL).bufs.empty())
+    if (!picture->getResiBuf().bufs.empty())
     {
-      m_orgr.create(area.chromaFormat, area.blocks[0], pcv->maxCUWidth);
+      if (m_orgr.bufs.empty())
+      {
+        m_orgr.create(area.chromaFormat, area.blocks[0], pcv->maxCUWidth);
+      }
     }
     else
     {
@@ -2001,6 +2053,23 @@ const MotionInfo& CodingStructure::getMotionInfo( const Position& pos ) const
   return *( m_motionBuf + miPos.y * stride + miPos.x );
 }
 
+ColMotionInfo CodingStructure::getColMotionInfo(const Position &pos) const
+{
+  CHECKD(!area.Y().contains(pos), "Trying to access motion information outside of this coding structure");
+
+  if (m_colMotionBuf == nullptr)
+  {
+    // picture not completed through the regular path, e.g. a generated unavailable picture
+    return ColMotionInfo(getMotionInfo(pos));
+  }
+
+  const int      colShift  = COL_MOTION_LOG2_SIZE - MIN_CU_LOG2;
+  const unsigned colStride = (g_miScaling.scaleHor(area.lwidth()) + (1 << colShift) - 1) >> colShift;
+  const Position miPos     = g_miScaling.scale(pos - area.lumaPos());
+
+  return m_colMotionBuf[(miPos.y >> colShift) * colStride + (miPos.x >> colShift)];
+}
+
 
 // data accessors
        PelBuf     CodingStructure::getPredBuf(const CompArea &blk)           { return getBuf(blk,  PIC_PREDICTION); }
@@ -108,6 +108,9 @@ public:
   void destroy();
   void releaseIntermediateData();
   void destroyTemporaryCsData();
+  void createMotionBuf();
+  void destroyMotionBuf();
+  void compactMotion();
 
 #if GDR_ENABLED
   bool containRefresh(int begX, int endX) const;
@@ -138,6 +141,11 @@ public:
 
   void allocateVectorsAtPicLevel();
 
+  // the top level coding structure the units are coded into: picture->cs, or in the encoder the coding structure of
+  // a tile compressed by a tile worker, which only covers that tile
+  CodingStructure       &getTopLevelCS()       { return parent ? parent->getTopLevelCS() : *this; }
+  const CodingStructure &getTopLevelCS() const { return parent ? parent->getTopLevelCS() : *this; }
+
   // ---------------------------------------------------------------------------
   // global accessors
   // ---------------------------------------------------------------------------
@@ -273,7 +281,8 @@ private:
 
   int     m_offsets[ MAX_NUM_COMPONENT ];
 
-  MotionInfo *m_motionBuf;
+  MotionInfo    *m_motionBuf;
+  ColMotionInfo *m_colMotionBuf;
 
 public:
   CodingStructure *bestParent;
@@ -293,6 +302,7 @@ public:
 
   MotionInfo& getMotionInfo( const Position& pos );
   const MotionInfo& getMotionInfo( const Position& pos ) const;
+  ColMotionInfo getColMotionInfo(const Position &pos) const;
 
 
 public:
@@ -159,6 +159,7 @@ static constexpr int NOT_VALID =                                       -1;
 static constexpr int AMVP_MAX_NUM_CANDS =                               2; ///< AMVP: advanced motion vector prediction - max number of final candidates
 static constexpr int AMVP_MAX_NUM_CANDS_MEM =                           3; ///< AMVP: advanced motion vector prediction - max number of candidates
 static constexpr int AMVP_DECIMATION_FACTOR =                           2;
+static constexpr int COL_MOTION_LOG2_SIZE =                             3; ///< log2 of the block size of the motion kept for collocated pictures
 static constexpr int MRG_MAX_NUM_CANDS =                                6; ///< MERGE
 static constexpr int AFFINE_MRG_MAX_NUM_CANDS =                         5; ///< AFFINE MERGE
 static constexpr int IBC_MRG_MAX_NUM_CANDS =                            6; ///< IBC MERGE
@@ -562,6 +563,7 @@ static constexpr int BLK_8 =                                          8;
 static constexpr int BLK_16 =                                        16;
 static constexpr int BLK_32 =                                        32;
 static constexpr int BIT_DEPTH_8 =                                    8;
+static constexpr int SSIM_FILTER_SIZE =                              11;  ///< size of the Gaussian window of the (MS-)SSIM metric
 
 static constexpr int MSE_WEIGHT_FRAC_BITS = 16;
 static constexpr int MSE_WEIGHT_ONE       = 1 << MSE_WEIGHT_FRAC_BITS;
@@ -305,12 +305,14 @@ public:
   void copyFrom(const CtxStore<BinProbModel> &src)
   {
     checkInit();
+    journalRange(0, ContextSetCfg::NumberOfContexts);
     std::copy_n(reinterpret_cast<const char *>(src.m_ctx), sizeof(BinProbModel) * ContextSetCfg::NumberOfContexts,
                 reinterpret_cast<char *>(m_ctx));
   }
   void copyFrom(const CtxStore<BinProbModel> &src, const CtxSet &ctxSet)
   {
     checkInit();
+    journalRange(ctxSet.Offset, ctxSet.Size);
     std::copy_n(reinterpret_cast<const char *>(src.m_ctx + ctxSet.Offset), sizeof(BinProbModel) * ctxSet.Size,
                 reinterpret_cast<char *>(m_ctx + ctxSet.Offset));
   }
@@ -325,6 +327,44 @@ public:
 
   BinFracBits getFracBitsArray(unsigned ctxId) const { return m_ctx[ctxId].getFracBitsArray(); }
 
+  // Undo journal: while at least one journal mark is active, the state of each context is recorded
+  // before its first modification since the last mark or rollback, so that trial encodes can be
+  // undone by restoring only the touched contexts.
+  void journal(unsigned ctxId)
+  {
+    if (m_journalDepth > 0 && m_journalStamp[ctxId] != m_journalSerial)
+    {
+      m_journalStamp[ctxId] = m_journalSerial;
+      m_journal.push_back({ ctxId, m_ctx[ctxId] });
+    }
+  }
+  size_t journalMark()
+  {
+    checkInit();
+    m_journalDepth++;
+    nextJournalSerial();
+    return m_journal.size();
+  }
+  void journalRollback(size_t pos)
+  {
+    CHECKD(m_journalDepth == 0 || pos > m_journal.size(), "Invalid context journal position");
+    while (m_journal.size() > pos)
+    {
+      m_ctx[m_journal.back().ctxId] = m_journal.back().model;
+      m_journal.pop_back();
+    }
+    nextJournalSerial();
+  }
+  void journalRelease()
+  {
+    CHECKD(m_journalDepth == 0, "Context journal released without mark");
+    if (--m_journalDepth == 0)
+    {
+      m_journal.clear();
+    }
+    nextJournalSerial();
+  }
+
 private:
   inline void checkInit()
   {
@@ -335,10 +375,42 @@ private:
     m_ctxBuffer.resize(ContextSetCfg::NumberOfContexts);
     m_ctx = m_ctxBuffer.data();
   }
+  void journalRange(unsigned offset, unsigned size)
+  {
+    if (m_journalDepth > 0)
+    {
+      for (unsigned ctxId = offset; ctxId < offset + size; ctxId++)
+      {
+        journal(ctxId);
+      }
+    }
+  }
+  void nextJournalSerial()
+  {
+    if (m_journalStamp.empty())
+    {
+      m_journalStamp.resize(ContextSetCfg::NumberOfContexts, 0);
+    }
+    if (++m_journalSerial == 0)
+    {
+      std::fill(m_journalStamp.begin(), m_journalStamp.end(), 0);
+      m_journalSerial = 1;
+    }
+  }
+
+  struct JournalEntry
+  {
+    unsigned     ctxId;
+    BinProbModel model;
+  };
 
 private:
   std::vector<BinProbModel> m_ctxBuffer;
   BinProbModel             *m_ctx;
+  std::vector<JournalEntry> m_journal;
+  std::vector<uint32_t>     m_journalStamp;
+  uint32_t                  m_journalSerial{ 0 };
+  int                       m_journalDepth{ 0 };
 };
 
 
@@ -441,6 +513,7 @@ public:
     switch (m_bpmType)
     {
     case BpmType::STD:
+      m_CtxStore_Std  .journal              (ctxId);
       m_CtxStore_Std  [ctxId] = ctx.m_CtxStore_Std  [ctxId];
       m_CtxStore_Std  [ctxId] . setLog2WindowSize   (winSize);
       break;
@@ -449,6 +522,41 @@ public:
     }
   }
 
+  struct JournalMark
+  {
+    size_t   pos;
+    unsigned grAdaptStats[RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS];
+  };
+
+  void  journalMark( JournalMark& mark )
+  {
+    switch (m_bpmType)
+    {
+    case BpmType::STD: mark.pos = m_CtxStore_Std.journalMark(); break;
+    default:        break;
+    }
+    ::memcpy( mark.grAdaptStats, m_GRAdaptStats, sizeof( unsigned ) * RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS );
+  }
+
+  void  journalRollback( const JournalMark& mark )
+  {
+    switch (m_bpmType)
+    {
+    case BpmType::STD: m_CtxStore_Std.journalRollback(mark.pos); break;
+    default:        break;
+    }
+    ::memcpy( m_GRAdaptStats, mark.grAdaptStats, sizeof( unsigned ) * RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS );
+  }
+
+  void  journalRelease()
+  {
+    switch (m_bpmType)
+    {
+    case BpmType::STD: m_CtxStore_Std.journalRelease(); break;
+    default:        break;
+    }
+  }
+
   const unsigned&     getGRAdaptStats ( unsigned      id )      const { return m_GRAdaptStats[id]; }
   unsigned&           getGRAdaptStats ( unsigned      id )            { return m_GRAdaptStats[id]; }
 
@@ -501,6 +609,30 @@ private:
   CtxPool  *m_pool;
 };
 
+// Lightweight alternative to TempCtx for restoring a context state several times:
+// instead of a full copy, only the contexts modified since the checkpoint are journaled and restored.
+// Checkpoints on the same Ctx must be released in reverse order of creation.
+class CtxCheckpoint
+{
+  CtxCheckpoint( const CtxCheckpoint& ) = delete;
+  const CtxCheckpoint& operator=( const CtxCheckpoint& ) = delete;
+public:
+  CtxCheckpoint( Ctx& ctx ) : m_ctx( &ctx ) { m_ctx->journalMark( m_mark ); }
+  ~CtxCheckpoint()  { release(); }
+  void restore()    { CHECKD( !m_ctx, "Checkpoint already released" ); m_ctx->journalRollback( m_mark ); }
+  void release()
+  {
+    if( m_ctx )
+    {
+      m_ctx->journalRelease();
+      m_ctx = nullptr;
+    }
+  }
+private:
+  Ctx*             m_ctx;
+  Ctx::JournalMark m_mark;
+};
+
 
 
 #endif
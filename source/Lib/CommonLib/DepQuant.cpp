@@ -35,6 +35,7 @@
 #include "TrQuant.h"
 #include "CodingStructure.h"
 #include "UnitTools.h"
+#include "StageProfiler.h"
 
 #include <bitset>
 
@@ -1711,6 +1712,8 @@ DepQuant::~DepQuant()
 void DepQuant::quant(TransformUnit &tu, const ComponentID &compID, const CCoeffBuf &pSrc, TCoeff &absSum,
                      const QpParam &cQP, const Ctx &ctx)
 {
+  PROFILE_STAGE( "DepQuant" );
+
   const bool useRegularResidualCoding =
     tu.cu->slice->getTSResidualCodingDisabledFlag() || tu.mtsIdx[compID] != MtsType::SKIP;
   if( tu.cs->slice->getDepQuantEnabledFlag() && useRegularResidualCoding )
@@ -45,8 +45,8 @@
  // Constructor / destructor / create / destroy
  // ====================================================================================================================
 
-CrcCalculatorLight Hash::m_crcCalculator1(24, 0x5D6DCB);
-CrcCalculatorLight Hash::m_crcCalculator2(24, 0x864CFB);
+thread_local CrcCalculatorLight Hash::m_crcCalculator1(24, 0x5D6DCB);
+thread_local CrcCalculatorLight Hash::m_crcCalculator2(24, 0x864CFB);
 
 CrcCalculatorLight::CrcCalculatorLight(uint32_t bits, uint32_t truncPoly)
 {
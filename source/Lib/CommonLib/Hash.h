@@ -139,8 +139,9 @@ private:
     return w == 4 ? 4 : floorLog2(w) - 3;
   }
 
-  static CrcCalculatorLight m_crcCalculator1;
-  static CrcCalculatorLight m_crcCalculator2;
+  // scratch state of the hash computation, one per thread so that concurrent encoders do not interfere
+  static thread_local CrcCalculatorLight m_crcCalculator1;
+  static thread_local CrcCalculatorLight m_crcCalculator2;
 };
 
 #endif // __HASH__
@@ -424,6 +424,11 @@ void InterPrediction::xSubPuBio(PredictionUnit &pu, PelUnitBuf &predBuf, const R
   subPu.ciipFlag       = pu.ciipFlag;
   subPu.refIdx[0]      = pu.refIdx[0];
   subPu.refIdx[1]      = pu.refIdx[1];
+  // DMVR is not applied here, so the motion is uniform over the PU and is taken from the PU itself
+  // rather than from the motion buffer of the CS, which may hold a different candidate during the encoder search
+  subPu.interDir       = pu.interDir;
+  subPu.mv[0]          = pu.mv[0];
+  subPu.mv[1]          = pu.mv[1];
 
   int  fstStart = puPos.y;
   int  secStart = puPos.x;
@@ -440,10 +445,7 @@ void InterPrediction::xSubPuBio(PredictionUnit &pu, PelUnitBuf &predBuf, const R
       int dx = secStep;
       int dy = fstStep;
 
-      const MotionInfo &curMi = pu.getMotionInfo(Position{ x, y });
-
       subPu.UnitArea::operator=(UnitArea(pu.chromaFormat, Area(x, y, dx, dy)));
-      subPu = curMi;
       PelUnitBuf subPredBuf = predBuf.subBuf(UnitAreaRelative(pu, subPu));
 
       if (yuvDstTmp)
@@ -890,7 +892,6 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
   PelBuf    dstExtBuf(m_filteredBlockTmp[1][compID], dstExtW, dstExtH);
 
   const int refExtH = dstExtH + MAX_FILTER_SIZE - 1;
-  PelBuf    tmpBuf  = PelBuf(m_filteredBlockTmp[0][compID], dstExtW, refExtH);
 
   PelBuf &dstBuf = dstPic.bufs[compID];
 
@@ -1025,17 +1026,25 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
   CHECK(sbWidth > width, "Subblock width > block width");
   CHECK(sbHeight > height, "Subblock height > block height");
 
+  const int numSbHor = width / sbWidth;
+
+  Mv   rowMv[MAX_CU_SIZE / AFFINE_SUBBLOCK_SIZE];
+  bool rowWrapRef[MAX_CU_SIZE / AFFINE_SUBBLOCK_SIZE];
+
   for (int h = 0; h < height; h += sbHeight)
   {
-    for (int w = 0; w < width; w += sbWidth)
-    {
-      Mv curMv;
+    const int hLuma = h << scaleY;
 
-      const int hLuma = h << scaleY;
+    // derive the motion vectors of the row of sub-blocks
+    for (int sbIdx = 0; sbIdx < numSbHor; sbIdx++)
+    {
+      const int w     = sbIdx * sbWidth;
       const int wLuma = w << scaleX;
 
       const ptrdiff_t idx = hLuma / AFFINE_SUBBLOCK_SIZE * MVBUFFER_SIZE + wLuma / AFFINE_SUBBLOCK_SIZE;
 
+      Mv curMv;
+
       if (compID == COMPONENT_Y || chFmt == ChromaFormat::_444)
       {
         curMv = m_storedMv[idx];
@@ -1069,17 +1078,38 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
       }
 #endif
 
-      const auto filterIdx = InterpolationFilter::Filter::AFFINE;
+      rowMv[sbIdx]      = curMv;
+      rowWrapRef[sbIdx] = wrapRef;
+    }
+
+    const auto filterIdx = InterpolationFilter::Filter::AFFINE;
+
+    for (int sbIdx = 0, numSb = 1; sbIdx < numSbHor; sbIdx += numSb)
+    {
+      const int  w       = sbIdx * sbWidth;
+      const Mv  &curMv   = rowMv[sbIdx];
+      const bool wrapRef = rowWrapRef[sbIdx];
 
       if( isRefScaled )
       {
         CHECK(enableProf, "PROF should be disabled with RPR");
+        numSb = 1;
         xPredInterBlkRPR(scalingRatio, sps, pps,
                          CompArea(compID, chFmt, pu.blocks[compID].offset(w, h), Size(sbWidth, sbHeight)), refPic,
                          curMv, dstBuf.buf + w + h * dstBuf.stride, dstBuf.stride, bi, wrapRef, clpRng, filterIdx);
       }
       else
       {
+        // without PROF, neighbouring sub-blocks with the same motion vector are interpolated in a single call
+        numSb = 1;
+        while (!enableProf && sbIdx + numSb < numSbHor && rowMv[sbIdx + numSb] == curMv
+               && rowWrapRef[sbIdx + numSb] == wrapRef)
+        {
+          numSb++;
+        }
+
+        const int blkWidth = numSb * sbWidth;
+
         // get the MV in high precision
         int xFrac, yFrac, xInt, yInt;
 
@@ -1110,11 +1140,11 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
 
         if (yFrac == 0)
         {
-          m_if.filterHor(compID, ref, refStride, dst, dstStride, sbWidth, sbHeight, xFrac, isLast, clpRng, filterIdx);
+          m_if.filterHor(compID, ref, refStride, dst, dstStride, blkWidth, sbHeight, xFrac, isLast, clpRng, filterIdx);
         }
         else if (xFrac == 0)
         {
-          m_if.filterVer(compID, ref, refStride, dst, dstStride, sbWidth, sbHeight, yFrac, true, isLast, clpRng,
+          m_if.filterVer(compID, ref, refStride, dst, dstStride, blkWidth, sbHeight, yFrac, true, isLast, clpRng,
                          filterIdx);
         }
         else
@@ -1122,10 +1152,12 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
           const int filterSize = isLuma(compID) ? NTAPS_LUMA_AFFINE : NTAPS_CHROMA_AFFINE;
           const int rowsAbove  = (filterSize - 1) >> 1;
 
-          m_if.filterHor(compID, ref - rowsAbove * refStride, refStride, tmpBuf.buf, tmpBuf.stride, sbWidth,
+          const PelBuf tmpBuf(m_filteredBlockTmp[0][compID], std::max(dstExtW, blkWidth), refExtH);
+
+          m_if.filterHor(compID, ref - rowsAbove * refStride, refStride, tmpBuf.buf, tmpBuf.stride, blkWidth,
                          sbHeight + filterSize - 1, xFrac, false, clpRng, filterIdx);
           JVET_J0090_SET_CACHE_ENABLE(false);
-          m_if.filterVer(compID, tmpBuf.buf + rowsAbove * tmpBuf.stride, tmpBuf.stride, dst, dstStride, sbWidth,
+          m_if.filterVer(compID, tmpBuf.buf + rowsAbove * tmpBuf.stride, tmpBuf.stride, dst, dstStride, blkWidth,
                          sbHeight, yFrac, false, isLast, clpRng, filterIdx);
           JVET_J0090_SET_CACHE_ENABLE(true);
         }
@@ -1156,20 +1188,10 @@ void InterPrediction::xPredAffineBlk(const ComponentID &compID, const Prediction
             dstPel[sbWidth] = (refPel[sbWidth] << shift) - IF_INTERNAL_OFFS;
           }
 
-          const ptrdiff_t strideGrad = AFFINE_SUBBLOCK_WIDTH_EXT;
-
-          g_pelBufOP.profGradFilter(dstExtBuf.buf, dstExtBuf.stride, AFFINE_SUBBLOCK_WIDTH_EXT,
-                                    AFFINE_SUBBLOCK_HEIGHT_EXT, strideGrad, m_gradBuf[0], m_gradBuf[1], clpRng.bd);
-
           const Pel offset = (1 << shift >> 1) + IF_INTERNAL_OFFS;
 
-          Pel *src  = dst;
-          Pel *gX   = m_gradBuf[0] + PROF_BORDER_EXT_H * strideGrad + PROF_BORDER_EXT_W;
-          Pel *gY   = m_gradBuf[1] + PROF_BORDER_EXT_H * strideGrad + PROF_BORDER_EXT_W;
-          Pel *dstY = dstBuf.bufAt(w, h);
-
-          g_pelBufOP.applyPROF(dstY, dstBuf.stride, src, dstExtBuf.stride, sbWidth, sbHeight, gX, gY, strideGrad,
-                               dMvScaleHor, dMvScaleVer, sbWidth, bi, shift, offset, clpRng);
+          g_pelBufOP.applyPROF(dstBuf.bufAt(w, h), dstBuf.stride, dst, dstStride, sbWidth, sbHeight, dMvScaleHor,
+                               dMvScaleVer, sbWidth, bi, shift, offset, clpRng);
         }
       }
     }
@@ -1607,49 +1629,42 @@ void InterPrediction::xDmvrPrefetch(const PredictionUnit &pu, const bool forLuma
       {
         clipMv(cMv, pu.lumaPos(), pu.lumaSize(), *pu.cs->sps, *pu.cs->pps);
       }
-      /* Pre-fetch similar to HEVC*/
+      /* Pre-fetch similar to HEVC, padded for the refined motion in the same pass*/
       {
         Position recOffset =
           pu.blocks[compID].pos().offset(cMv.getHor() >> mvshiftTempHor, cMv.getVer() >> mvshiftTempVer);
         CPelBuf refBuf = refPic->getRecoBuf(
           CompArea((ComponentID) compID, pu.chromaFormat, recOffset, pu.blocks[compID].size()), wrapRef);
-        g_pelBufOP.copyBuffer(refBuf.buf, refBuf.stride, dstBuf.bufAt(DMVR_RANGE, DMVR_RANGE), dstBuf.stride, width,
-                              height);
+        // using larger padsize for 4:2:2
+        const int padSize = DMVR_RANGE >> getComponentScaleY((ComponentID) compID, pu.chromaFormat);
+        g_pelBufOP.copyPadded(refBuf.buf, refBuf.stride, dstBuf.bufAt(DMVR_RANGE, DMVR_RANGE), dstBuf.stride, width,
+                              height, padSize);
       }
     }
   }
 }
 
-void InterPrediction::xDmvrPad(const PredictionUnit &pu)
-{
-  for (const auto l: { REF_PIC_LIST_0, REF_PIC_LIST_1 })
-  {
-    for (int compID = 0; compID < getNumberValidComponents(pu.chromaFormat); compID++)
-    {
-      PelBuf &buf = m_yuvRefBufDmvr[l].bufs[compID];
-
-      const int filtersize = isLuma(ComponentID(compID)) ? NTAPS_LUMA : NTAPS_CHROMA;
-      const int width      = buf.width + filtersize - 1;
-      const int height     = buf.height + filtersize - 1;
-      // using larger padsize for 4:2:2
-      const int padsize = DMVR_RANGE >> getComponentScaleY((ComponentID) compID, pu.chromaFormat);
-      g_pelBufOP.padding(buf.bufAt(DMVR_RANGE, DMVR_RANGE), buf.stride, width, height, padsize);
-    }
-  }
-}
-
 constexpr InterPrediction::DmvrDist InterPrediction::UNDEFINED_DMVR_DIST;
 
 void InterPrediction::xDmvrIntegerRefine(int bd, DmvrDist &minCost, Mv &deltaMv, DmvrDist *sadPtr, int width,
                                          int height)
 {
-  for (const auto &mvd: m_dmvrSearchOffsets)
+  // SADs of all offsets in one pass, normalised as in xDmvrCost
+  std::array<Distortion, DMVR_AREA> sads;
+  g_pelBufOP.dmvrIntegerSad(m_dmvrInitialPred[REF_PIC_LIST_0].bufAt(DMVR_RANGE, DMVR_RANGE),
+                            m_dmvrInitialPred[REF_PIC_LIST_0].stride,
+                            m_dmvrInitialPred[REF_PIC_LIST_1].bufAt(DMVR_RANGE, DMVR_RANGE),
+                            m_dmvrInitialPred[REF_PIC_LIST_1].stride, width, height, sads.data());
+  const uint32_t distortionShift = DISTORTION_PRECISION_ADJUSTMENT(bd);
+
+  for (int i = 0; i < DMVR_AREA; i++)
   {
+    const Mv     &mvd       = m_dmvrSearchOffsets[i];
     const int32_t sadOffset = mvd.ver * DMVR_SPAN + mvd.hor;
 
     if (sadPtr[sadOffset] == UNDEFINED_DMVR_DIST)
     {
-      sadPtr[sadOffset] = xDmvrCost(bd, mvd, width, height);
+      sadPtr[sadOffset] = DmvrDist(((sads[i] << 1) >> distortionShift) >> 1);
     }
     if (sadPtr[sadOffset] < minCost)
     {
@@ -1980,13 +1995,9 @@ void InterPrediction::xProcessDMVR(PredictionUnit &pu, PelUnitBuf &pcYuvDst, con
 
       const bool blockMoved = deltaMv != Mv();
 
-      if (blockMoved)
+      if (blockMoved && isChromaEnabled(pu.chromaFormat))
       {
-        if (isChromaEnabled(pu.chromaFormat))
-        {
-          xDmvrPrefetch(subPu, false);
-        }
-        xDmvrPad(subPu);
+        xDmvrPrefetch(subPu, false);
       }
 
       pu.mvdL0SubPu[subPuIdx] = deltaMv;
@@ -2317,22 +2328,64 @@ bool InterPrediction::xPredInterBlkRPR(const ScalingRatio scalingRatio, const SP
     int tmpStride = width;
     int xInt = 0, yInt = 0;
 
-    for( col = 0; col < width; col++ )
+    if (xFilter != InterpolationFilter::Filter::DMVR)
+    {
+      // all columns are filtered in one pass, each with its own integer position and taps
+      RprColumnTable &tab     = m_rprColTable;
+      const int       numTaps = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+
+      if (tab.x0 != (int32_t) x0Int || tab.stepX != stepX || tab.width != width || tab.boundLeft != boundLeft
+          || tab.boundRight != boundRight || tab.compID != compID || tab.filter != xFilter)
+      {
+        for (col = 0; col < width; col++)
+        {
+          int posX = (int32_t) x0Int + col * stepX;
+          xInt     = (posX + offX) >> posShift;
+          xInt     = std::min(std::max(boundLeft - (NTAPS_LUMA / 2), xInt), boundRight + (NTAPS_LUMA / 2));
+          int xFrac = ((posX + offX) >> (posShift - shiftHor)) & ((1 << shiftHor) - 1);
+
+          CHECK(xInt0 > xInt, "Wrong horizontal starting point");
+
+          tab.pos[col] = xInt - xInt0 - (numTaps / 2 - 1);
+          InterpolationFilter::getScaledFilterCoeff(compID, xFrac, xFilter, tab.coeff + col * numTaps);
+        }
+        tab.x0         = (int32_t) x0Int;
+        tab.stepX      = stepX;
+        tab.width      = width;
+        tab.boundLeft  = boundLeft;
+        tab.boundRight = boundRight;
+        tab.compID     = compID;
+        tab.filter     = xFilter;
+      }
+
+      const int headRoom = IF_INTERNAL_FRAC_BITS(clpRng.bd);
+      const int shift    = IF_FILTER_PREC - headRoom;
+      const int offset   = -IF_INTERNAL_OFFS * (1 << shift);
+
+      refBuf = refPic->getRecoBuf(CompArea(compID, chFmt, Position(xInt0, yInt0), Size(1, refHeight)), wrapRef);
+      g_pelBufOP.scaledFilterHor(refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tab.pos,
+                                 tab.coeff, numTaps, m_filteredBlockTmpRPR, tmpStride, width,
+                                 refHeight + vFilterSize - 1 + extSize, shift, offset);
+    }
+    else
     {
-      int posX = (int32_t)x0Int + col * stepX;
-      xInt = ( posX + offX ) >> posShift;
-      xInt = std::min( std::max( boundLeft - (NTAPS_LUMA / 2), xInt ), boundRight + (NTAPS_LUMA / 2) );
-      int xFrac = ( ( posX + offX ) >> ( posShift - shiftHor ) ) & ( ( 1 << shiftHor ) - 1 );
+      for (col = 0; col < width; col++)
+      {
+        int posX = (int32_t) x0Int + col * stepX;
+        xInt     = (posX + offX) >> posShift;
+        xInt     = std::min(std::max(boundLeft - (NTAPS_LUMA / 2), xInt), boundRight + (NTAPS_LUMA / 2));
+        int xFrac = ((posX + offX) >> (posShift - shiftHor)) & ((1 << shiftHor) - 1);
 
-      CHECK( xInt0 > xInt, "Wrong horizontal starting point" );
+        CHECK(xInt0 > xInt, "Wrong horizontal starting point");
 
-      Position offset = Position( xInt, yInt0 );
-      refBuf = refPic->getRecoBuf( CompArea( compID, chFmt, offset, Size( 1, refHeight ) ), wrapRef );
+        Position offset = Position(xInt, yInt0);
+        refBuf          = refPic->getRecoBuf(CompArea(compID, chFmt, offset, Size(1, refHeight)), wrapRef);
 
-      Pel *const tempBuf = m_filteredBlockTmpRPR + col;
+        Pel *const tempBuf = m_filteredBlockTmpRPR + col;
 
-      m_if.filterHor(compID, (Pel *) refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tempBuf,
-                     tmpStride, 1, refHeight + vFilterSize - 1 + extSize, xFrac, false, clpRng, xFilter);
+        m_if.filterHor(compID, (Pel *) refBuf.buf - ((vFilterSize >> 1) - 1) * refBuf.stride, refBuf.stride, tempBuf,
+                       tmpStride, 1, refHeight + vFilterSize - 1 + extSize, xFrac, false, clpRng, xFilter);
+      }
     }
 
     for( row = 0; row < height; row++ )
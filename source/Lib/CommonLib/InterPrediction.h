@@ -156,6 +156,21 @@ protected:
 
   Pel *m_filteredBlockTmpRPR;
 
+  // column positions and taps of the scaled horizontal filtering, reused while the block geometry does not change
+  struct RprColumnTable
+  {
+    int32_t                     x0         = std::numeric_limits<int32_t>::min();
+    int                         stepX      = 0;
+    int                         width      = 0;
+    int                         boundLeft  = 0;
+    int                         boundRight = 0;
+    ComponentID                 compID     = COMPONENT_Y;
+    InterpolationFilter::Filter filter     = InterpolationFilter::Filter::DEFAULT;
+    int                         pos[TMP_RPR_WIDTH];
+    TFilterCoeff                coeff[TMP_RPR_WIDTH * NTAPS_LUMA];
+  };
+  RprColumnTable m_rprColTable;
+
   ChromaFormat         m_currChromaFormat;
 
   ComponentID          m_maxCompIDToPred;      ///< tells the predictor to only process the components up to (inklusive) this one - useful to skip chroma components during RD-search
@@ -171,17 +186,12 @@ protected:
   Pel   *m_yuvPredTempDmvr[NUM_REF_PIC_LIST_01];
   PelBuf m_dmvrInitialPred[NUM_REF_PIC_LIST_01];
 
-  // buffers for padded data, initially filled by xDmvrPrefetch(), padded by xDmvrPad()
+  // buffers for padded data, filled and padded by xDmvrPrefetch()
   Pel       *m_refSamplesDmvr[NUM_REF_PIC_LIST_01][MAX_NUM_COMPONENT];
   PelUnitBuf m_yuvRefBufDmvr[NUM_REF_PIC_LIST_01];
 
   static const std::array<Mv, DMVR_AREA> m_dmvrSearchOffsets;
 
-  static constexpr int AFFINE_SUBBLOCK_WIDTH_EXT  = AFFINE_SUBBLOCK_SIZE + 2 * PROF_BORDER_EXT_W;
-  static constexpr int AFFINE_SUBBLOCK_HEIGHT_EXT = AFFINE_SUBBLOCK_SIZE + 2 * PROF_BORDER_EXT_H;
-
-  Pel m_gradBuf[2][AFFINE_SUBBLOCK_WIDTH_EXT * AFFINE_SUBBLOCK_HEIGHT_EXT];
-
   // PROF skip flags for encoder speedup
   bool m_skipProf{ false };
   bool m_skipProfCond{ false };
@@ -277,7 +287,6 @@ public:
   void     xDmvrSetEncoderCheckFlag(bool enableFlag) { dmvrEnableEncoderCheck = enableFlag; }
   bool     xDmvrGetEncoderCheckFlag() { return dmvrEnableEncoderCheck; }
   void     xDmvrPrefetch(const PredictionUnit &pu, bool forLuma);
-  void     xDmvrPad(const PredictionUnit &pu);
   void     xDmvrFinalMc(const PredictionUnit &pu, PelUnitBuf yuvSrc[NUM_REF_PIC_LIST_01], bool applyBdof,
                         const Mv startMV[NUM_REF_PIC_LIST_01], bool blockMoved);
   void     xDmvrIntegerRefine(int bd, DmvrDist &minCost, Mv &deltaMv, DmvrDist *sadPtr, int width, int height);
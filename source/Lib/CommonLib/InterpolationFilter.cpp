@@ -708,6 +708,65 @@ void InterpolationFilter::filterHor(const ComponentID compID, Pel const *src, co
   }
 }
 
+/**
+ * \brief Get the taps filterHor() applies for a given fraction and filter type
+ *
+ * The coefficients are written in a uniform layout of NTAPS_LUMA taps for luma and NTAPS_CHROMA taps for chroma, the
+ * first one applying NTAPS / 2 - 1 samples left of the integer position. A copy is expressed as a unit filter.
+ *
+ * \param  compID     Colour component ID
+ * \param  frac       Fractional sample offset
+ * \param  nFilterIdx Filter type, DMVR is not supported
+ * \param  coeff      Pointer to the output coefficients
+ */
+void InterpolationFilter::getScaledFilterCoeff(const ComponentID compID, const int frac, const Filter nFilterIdx,
+                                               TFilterCoeff *coeff)
+{
+  CHECK(nFilterIdx == Filter::DMVR, "DMVR filter not supported");
+
+  const int numTaps = isLuma(compID) ? NTAPS_LUMA : NTAPS_CHROMA;
+  std::fill_n(coeff, numTaps, 0);
+
+  if (frac == 0 && nFilterIdx <= Filter::AFFINE)
+  {
+    coeff[numTaps / 2 - 1] = 1 << IF_FILTER_PREC;
+  }
+  else if (isLuma(compID))
+  {
+    CHECK(frac < 0 || frac >= LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction");
+    const TFilterCoeff *src = m_lumaFilter[frac];
+    switch (nFilterIdx)
+    {
+    case Filter::AFFINE: src = m_affineLumaFilter[frac]; break;
+    case Filter::RPR1: src = m_lumaFilterRPR1[frac]; break;
+    case Filter::RPR2: src = m_lumaFilterRPR2[frac]; break;
+    case Filter::AFFINE_RPR1: src = m_affineLumaFilterRPR1[frac]; break;
+    case Filter::AFFINE_RPR2: src = m_affineLumaFilterRPR2[frac]; break;
+    case Filter::HALFPEL_ALT:
+      src = frac == LUMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS / 2 ? m_lumaAltHpelIFilter : m_lumaFilter[frac];
+      break;
+    default: break;
+    }
+    if (nFilterIdx == Filter::AFFINE || nFilterIdx == Filter::AFFINE_RPR1 || nFilterIdx == Filter::AFFINE_RPR2)
+    {
+      // the 6-tap filters start one sample later than the 8-tap ones
+      std::copy_n(src, NTAPS_LUMA_AFFINE, coeff + (NTAPS_LUMA - NTAPS_LUMA_AFFINE) / 2);
+    }
+    else
+    {
+      std::copy_n(src, NTAPS_LUMA, coeff);
+    }
+  }
+  else
+  {
+    CHECK(frac < 0 || frac >= CHROMA_INTERPOLATION_FILTER_SUB_SAMPLE_POSITIONS, "Invalid fraction");
+    const TFilterCoeff *src = nFilterIdx == Filter::RPR1   ? m_chromaFilterRPR1[frac]
+                              : nFilterIdx == Filter::RPR2 ? m_chromaFilterRPR2[frac]
+                                                           : m_chromaFilter[frac];
+    std::copy_n(src, NTAPS_CHROMA, coeff);
+  }
+}
+
 void InterpolationFilter::filterVer(const ComponentID compID, Pel const *src, const ptrdiff_t srcStride, Pel *dst,
                                     const ptrdiff_t dstStride, int width, int height, int frac, bool isFirst,
                                     bool isLast, const ClpRng &clpRng, Filter nFilterIdx)
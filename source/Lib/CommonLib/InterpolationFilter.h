@@ -145,6 +145,7 @@ public:
 #endif
 
   static TFilterCoeff const * const getChromaFilterTable(const int deltaFract) { return m_chromaFilter[deltaFract]; };
+  static void getScaledFilterCoeff(const ComponentID compID, const int frac, const Filter nFilterIdx, TFilterCoeff *coeff);
 };
 
 //! \}
@@ -1363,7 +1363,7 @@ void IntraPrediction::xGetLumaRecPixels(const PredictionUnit &pu, CompArea chrom
   const ptrdiff_t recStride2 = recStride << logSubHeightC;
 
   const CodingUnit &lumaCU =
-    isChroma(pu.chType) ? *pu.cs->picture->cs->getCU(lumaArea.pos(), ChannelType::LUMA) : *pu.cu;
+    isChroma(pu.chType) ? *pu.cs->getTopLevelCS().getCU(lumaArea.pos(), ChannelType::LUMA) : *pu.cu;
   const CodingUnit&     cu = *pu.cu;
 
   const CompArea& area = isChroma( pu.chType ) ? chromaArea : lumaArea;
@@ -212,6 +212,26 @@ struct MotionInfo
   }
 };
 
+// motion of a completed picture as read by temporal MV prediction, one entry per 8x8 block
+struct ColMotionInfo
+{
+  Mv       mv[NUM_REF_PIC_LIST_01];
+  int8_t   refIdx[NUM_REF_PIC_LIST_01];
+  uint16_t sliceIdx;
+  bool     isInter;
+  bool     isIBCmot;
+
+  ColMotionInfo() : refIdx{ NOT_VALID, NOT_VALID }, sliceIdx(0), isInter(false), isIBCmot(false) {}
+  explicit ColMotionInfo(const MotionInfo &mi)
+    : mv{ mi.mv[REF_PIC_LIST_0], mi.mv[REF_PIC_LIST_1] }
+    , refIdx{ mi.refIdx[REF_PIC_LIST_0], mi.refIdx[REF_PIC_LIST_1] }
+    , sliceIdx(mi.sliceIdx)
+    , isInter(mi.isInter)
+    , isIBCmot(mi.isIBCmot)
+  {
+  }
+};
+
 class BcwMotionParam
 {
   RefSetArray<bool>       m_readOnly;
@@ -0,0 +1,209 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     ParallelFor.h
+ *  \brief    Fork-join helper for data-parallel loops
+ */
+
+#ifndef __PARALLELFOR__
+#define __PARALLELFOR__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// Runs func(jobIdx) for all jobIdx in [0, numJobs) on up to numThreads threads, the calling thread included.
+// Jobs are handed out dynamically, so func must not depend on the order of execution.
+template<typename F> void parallelFor(int numThreads, int numJobs, F &&func)
+{
+  numThreads = std::min(numThreads, numJobs);
+
+  if (numThreads <= 1)
+  {
+    for (int jobIdx = 0; jobIdx < numJobs; jobIdx++)
+    {
+      func(jobIdx);
+    }
+    return;
+  }
+
+  std::atomic<int> nextJob(0);
+
+  auto worker = [&]()
+  {
+    for (int jobIdx = nextJob++; jobIdx < numJobs; jobIdx = nextJob++)
+    {
+      func(jobIdx);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads - 1);
+  for (int i = 1; i < numThreads; i++)
+  {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread: threads)
+  {
+    thread.join();
+  }
+}
+
+// Keeps its worker threads alive between loops, for loops that are too short to amortise the thread creation of
+// parallelFor(). Runs func(jobIdx, threadIdx) for all jobIdx in [0, numJobs), threadIdx in [0, getNumThreads())
+// identifying the executing thread with 0 being the caller, so that func can use per-thread scratch data.
+class ParallelForPool
+{
+public:
+  explicit ParallelForPool(int numThreads) : m_numThreads(std::max(1, numThreads))
+  {
+    m_threads.reserve(m_numThreads - 1);
+    for (int threadIdx = 1; threadIdx < m_numThreads; threadIdx++)
+    {
+      m_threads.emplace_back([this, threadIdx]() { workerLoop(threadIdx); });
+    }
+  }
+
+  ~ParallelForPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_shutdown = true;
+    }
+    m_wakeUp.notify_all();
+    for (auto &thread: m_threads)
+    {
+      thread.join();
+    }
+  }
+
+  ParallelForPool(const ParallelForPool &)            = delete;
+  ParallelForPool &operator=(const ParallelForPool &) = delete;
+
+  int getNumThreads() const { return m_numThreads; }
+
+  void run(int numJobs, const std::function<void(int, int)> &func)
+  {
+    if (m_numThreads <= 1 || numJobs <= 1)
+    {
+      for (int jobIdx = 0; jobIdx < numJobs; jobIdx++)
+      {
+        func(jobIdx, 0);
+      }
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_func    = &func;
+      m_numJobs = numJobs;
+      m_nextJob = 0;
+      m_numBusy = m_numThreads - 1;
+      m_generation++;
+    }
+    m_wakeUp.notify_all();
+
+    runJobs(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]() { return m_numBusy == 0; });
+    m_func = nullptr;
+  }
+
+private:
+  void runJobs(int threadIdx)
+  {
+    for (int jobIdx = m_nextJob++; jobIdx < m_numJobs; jobIdx = m_nextJob++)
+    {
+      (*m_func)(jobIdx, threadIdx);
+    }
+  }
+
+  void workerLoop(int threadIdx)
+  {
+    uint64_t generation = 0;
+
+    while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_wakeUp.wait(lock, [&]() { return m_shutdown || m_generation != generation; });
+        if (m_shutdown)
+        {
+          return;
+        }
+        generation = m_generation;
+      }
+
+      runJobs(threadIdx);
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_numBusy--;
+      }
+      m_done.notify_one();
+    }
+  }
+
+  const int                m_numThreads;
+  std::vector<std::thread> m_threads;
+
+  std::mutex              m_mutex;
+  std::condition_variable m_wakeUp;
+  std::condition_variable m_done;
+  bool                    m_shutdown   = false;
+  uint64_t                m_generation = 0;
+  int                     m_numBusy    = 0;
+
+  const std::function<void(int, int)> *m_func    = nullptr;
+  int                                  m_numJobs = 0;
+  std::atomic<int>                     m_nextJob{ 0 };
+};
+
+inline int resolveNumThreads(int numThreads)
+{
+  return numThreads > 0 ? numThreads : std::max<int>(1, std::thread::hardware_concurrency());
+}
+
+//! \}
+
+#endif // __PARALLELFOR__
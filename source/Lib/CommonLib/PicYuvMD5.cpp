@@ -35,91 +35,94 @@
 #include "SEI.h"
 #include "libmd5/MD5.h"
 
+#include <array>
+
 //! \ingroup CommonLib
 //! \{
 
 /**
- * Update md5 using n samples from plane, each sample is adjusted to
- * OUTBIT_BITDEPTH_DIV8.
+ * Update md5 with all samples in plane in raster order, each sample
+ * is adjusted to OUTBIT_BITDEPTH_DIV8.
  */
 template<uint32_t OUTPUT_BITDEPTH_DIV8>
-static void md5_block(MD5& md5, const Pel* plane, uint32_t n)
+static void md5_plane(MD5& md5, const Pel* plane, uint32_t width, uint32_t height, ptrdiff_t stride)
 {
-  /* create a 64 byte buffer for packing Pel's into */
-  uint8_t buf[64/OUTPUT_BITDEPTH_DIV8][OUTPUT_BITDEPTH_DIV8];
-  for (uint32_t i = 0; i < n; i++)
+  /* convert each line of pels into unsigned chars in little endian byte order
+   * and update md5 with the whole line.
+   * NB, for 8bit data, data is truncated to 8bits. */
+  std::vector<uint8_t> line(width * OUTPUT_BITDEPTH_DIV8);
+
+  for (uint32_t y = 0; y < height; y++)
   {
-    Pel pel = plane[i];
-    /* perform bitdepth and endian conversion */
-    for (uint32_t d = 0; d < OUTPUT_BITDEPTH_DIV8; d++)
+    if (OUTPUT_BITDEPTH_DIV8 == 1)
+    {
+      g_pelBufOP.packSamples8(&plane[y * stride], line.data(), width);
+    }
+    else
     {
-      buf[i][d] = pel >> (d*8);
+      g_pelBufOP.packSamples16(&plane[y * stride], line.data(), width);
     }
+    md5.update(line.data(), width * OUTPUT_BITDEPTH_DIV8);
   }
-  md5.update((uint8_t*)buf, n * OUTPUT_BITDEPTH_DIV8);
 }
 
 /**
- * Update md5 with all samples in plane in raster order, each sample
- * is adjusted to OUTBIT_BITDEPTH_DIV8.
+ * Table for the byte-wise update of the CRC register: entry t is the register
+ * after shifting the byte t out of the upper eight bits (polynomial 0x1021).
  */
-template<uint32_t OUTPUT_BITDEPTH_DIV8>
-static void md5_plane(MD5& md5, const Pel* plane, uint32_t width, uint32_t height, ptrdiff_t stride)
+static std::array<uint16_t, 256> makeCrcTable()
 {
-  /* N is the number of samples to process per md5 update.
-   * All N samples must fit in buf */
-  uint32_t N = 32;
-  uint32_t width_modN = width % N;
-  uint32_t width_less_modN = width - width_modN;
-
-  for (uint32_t y = 0; y < height; y++)
+  std::array<uint16_t, 256> table;
+  for (uint32_t t = 0; t < 256; t++)
   {
-    /* convert pels into unsigned chars in little endian byte order.
-     * NB, for 8bit data, data is truncated to 8bits. */
-    for (uint32_t x = 0; x < width_less_modN; x += N)
+    uint32_t crcVal = t << 8;
+    for (int bitIdx = 0; bitIdx < 8; bitIdx++)
     {
-      md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + x], N);
+      const uint32_t crcMsb = (crcVal >> 15) & 1;
+      crcVal                = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
     }
-
-    /* mop up any of the remaining line */
-    md5_block<OUTPUT_BITDEPTH_DIV8>(md5, &plane[y*stride + width_less_modN], width_modN);
+    table[t] = crcVal;
   }
+  return table;
+}
+
+/**
+ * Shift one byte of picture data into the CRC register, most significant
+ * bit first. Same as eight single-bit updates, as the message bits shifted
+ * in do not reach the register msb within one byte.
+ */
+static inline uint32_t crcByte(const std::array<uint16_t, 256> &table, uint32_t crcVal, uint32_t byte)
+{
+  return (((crcVal << 8) & 0xffff) | byte) ^ table[crcVal >> 8];
 }
 
 uint32_t compCRC(int bitdepth, const Pel *plane, uint32_t width, uint32_t height, ptrdiff_t stride, PictureHash &digest)
 {
-  uint32_t crcMsb;
-  uint32_t bitVal;
+  static const std::array<uint16_t, 256> crcTable = makeCrcTable();
+
   uint32_t crcVal = 0xffff;
-  uint32_t bitIdx;
   for (uint32_t y = 0; y < height; y++)
   {
-    for (uint32_t x = 0; x < width; x++)
+    const Pel *line = plane + y * stride;
+    if (bitdepth > 8)
     {
-      // take CRC of first pictureData byte
-      for(bitIdx=0; bitIdx<8; bitIdx++)
+      // take CRC of both pictureData bytes, least significant byte first
+      for (uint32_t x = 0; x < width; x++)
       {
-        crcMsb = (crcVal >> 15) & 1;
-        bitVal = (plane[y*stride+x] >> (7 - bitIdx)) & 1;
-        crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
+        crcVal = crcByte(crcTable, crcVal, line[x] & 0xff);
+        crcVal = crcByte(crcTable, crcVal, (line[x] >> 8) & 0xff);
       }
-      // take CRC of second pictureData byte if bit depth is greater than 8-bits
-      if(bitdepth > 8)
+    }
+    else
+    {
+      for (uint32_t x = 0; x < width; x++)
       {
-        for(bitIdx=0; bitIdx<8; bitIdx++)
-        {
-          crcMsb = (crcVal >> 15) & 1;
-          bitVal = (plane[y*stride+x] >> (15 - bitIdx)) & 1;
-          crcVal = (((crcVal << 1) + bitVal) & 0xffff) ^ (crcMsb * 0x1021);
-        }
+        crcVal = crcByte(crcTable, crcVal, line[x] & 0xff);
       }
     }
   }
-  for(bitIdx=0; bitIdx<16; bitIdx++)
-  {
-    crcMsb = (crcVal >> 15) & 1;
-    crcVal = ((crcVal << 1) & 0xffff) ^ (crcMsb * 0x1021);
-  }
+  crcVal = crcByte(crcTable, crcVal, 0);
+  crcVal = crcByte(crcTable, crcVal, 0);
 
   digest.hash.push_back((crcVal>>8)  & 0xff);
   digest.hash.push_back( crcVal      & 0xff);
@@ -144,20 +147,11 @@ uint32_t compChecksum(int bitdepth, const Pel *plane, uint32_t width, uint32_t h
                       PictureHash &digest, const BitDepths & /*bitDepths*/)
 {
   uint32_t checksum = 0;
-  uint8_t xor_mask;
 
   for (uint32_t y = 0; y < height; y++)
   {
-    for (uint32_t x = 0; x < width; x++)
-    {
-      xor_mask = (x & 0xff) ^ (y & 0xff) ^ (x >> 8) ^ (y >> 8);
-      checksum = (checksum + ((plane[y*stride+x] & 0xff) ^ xor_mask)) & 0xffffffff;
-
-      if(bitdepth > 8)
-      {
-        checksum = (checksum + ((plane[y*stride+x]>>8) ^ xor_mask)) & 0xffffffff;
-      }
-    }
+    const uint8_t rowMask = (y & 0xff) ^ (y >> 8);
+    checksum += g_pelBufOP.checksumRow(plane + y * stride, width, rowMask, bitdepth > 8);
   }
 
   digest.hash.push_back((checksum>>24) & 0xff);
@@ -39,16 +39,19 @@
 #include "SEI.h"
 #include "ChromaFormat.h"
 #include "CommonLib/InterpolationFilter.h"
+#include "CommonLib/ParallelFor.h"
 
 // ---------------------------------------------------------------------------
 // picture methods
 // ---------------------------------------------------------------------------
 
-
+thread_local Scheduler scheduler;
 
 Picture::Picture()
 {
   cs                   = nullptr;
+  m_splitPicBufs       = nullptr;
+  m_tilePicBufs        = nullptr;
   m_isSubPicBorderSaved = false;
   m_extendedBorder        = false;
   m_wrapAroundValid    = false;
@@ -75,15 +78,20 @@ Picture::Picture()
   unscaledPic = nullptr;
   m_grainCharacteristic = nullptr;
   m_grainBuf            = nullptr;
+  m_maxCUSize           = 0;
+  m_buffersReleased     = false;
 }
 
 void Picture::create(const bool useWrapAround, const ChromaFormat& _chromaFormat, const Size& size,
                      const unsigned _maxCUSize, const unsigned _margin, const bool _decoder, const int _layerId,
-                     const bool enablePostFilteringForHFR)
+                     const bool enablePostFilteringForHFR, const bool scaledRefMargin)
 {
   layerId = _layerId;
   UnitArea::operator=( UnitArea( _chromaFormat, Area( Position{ 0, 0 }, size ) ) );
-  margin            =  MAX_SCALING_RATIO*_margin;
+  // scaled references are read up to MAX_SCALING_RATIO times further outside the picture
+  margin            = scaledRefMargin ? MAX_SCALING_RATIO * _margin : _margin;
+  m_maxCUSize       = _maxCUSize;
+  m_buffersReleased = false;
   const Area a      = Area( Position(), size );
   M_BUFS( 0, PIC_RECONSTRUCTION ).create( _chromaFormat, a, _maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE );
 
@@ -113,6 +121,9 @@ void Picture::destroy()
   {
     M_BUFS(jId, t).destroy();
   }
+  m_subPicRefBufs.clear();
+  m_subPicRefAreas.clear();
+  m_subPicRefValid.clear();
   m_hashMap.clearAll();
   if (cs)
   {
@@ -146,6 +157,7 @@ void Picture::destroy()
   }
   m_invColourTransfBuf = nullptr;
   m_grainBuf           = nullptr;
+  m_buffersReleased    = false;
 }
 
 void Picture::createTempBuffers( const unsigned _maxCUSize, bool useFilterFrame, bool resChange, bool decoder, bool isFgFiltered)
@@ -206,6 +218,61 @@ void Picture::destroyTempBuffers()
   }
 }
 
+// Frees the data of a picture that is no longer used for reference: the wrap-around reconstruction, the motion field
+// and, on the encoder side, the original samples. The reconstruction itself is kept for output.
+void Picture::releaseUnreferencedBuffers(const bool releaseOrig)
+{
+  if (m_buffersReleased)
+  {
+    return;
+  }
+
+  for (const PictureType t: { PIC_RECON_WRAP, PIC_ORIGINAL, PIC_ORIGINAL_INPUT })
+  {
+    PelStorage &buf = M_BUFS(0, t);
+    if (buf.bufs.empty() || (t != PIC_RECON_WRAP && !releaseOrig))
+    {
+      m_releasedSize[t] = Size();
+      continue;
+    }
+    m_releasedSize[t] = Size(buf.Y().width, buf.Y().height);
+    buf.destroy();
+  }
+  if (cs)
+  {
+    cs->destroyMotionBuf();
+  }
+  m_buffersReleased = true;
+}
+
+// Re-creates what releaseUnreferencedBuffers() freed before the picture object is reused
+void Picture::restoreReleasedBuffers()
+{
+  if (!m_buffersReleased)
+  {
+    return;
+  }
+
+  if (m_releasedSize[PIC_RECON_WRAP].area() > 0)
+  {
+    M_BUFS(0, PIC_RECON_WRAP)
+      .create(chromaFormat, Area(Position(), m_releasedSize[PIC_RECON_WRAP]), m_maxCUSize, margin,
+              MEMORY_ALIGN_DEF_SIZE);
+  }
+  for (const PictureType t: { PIC_ORIGINAL, PIC_ORIGINAL_INPUT })
+  {
+    if (m_releasedSize[t].area() > 0)
+    {
+      M_BUFS(0, t).create(chromaFormat, Area(Position(), m_releasedSize[t]));
+    }
+  }
+  if (cs)
+  {
+    cs->createMotionBuf();
+  }
+  m_buffersReleased = false;
+}
+
        PelBuf     Picture::getOrigBuf(const CompArea &blk)        { return getBuf(blk,  PIC_ORIGINAL); }
 const CPelBuf     Picture::getOrigBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_ORIGINAL); }
        PelUnitBuf Picture::getOrigBuf(const UnitArea &unit)       { return getBuf(unit, PIC_ORIGINAL); }
@@ -231,11 +298,15 @@ const CPelBuf     Picture::getFilteredOrigBuf(const CompArea &blk)  const { retu
 const CPelBuf     Picture::getPredBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_PREDICTION); }
        PelUnitBuf Picture::getPredBuf(const UnitArea &unit)       { return getBuf(unit, PIC_PREDICTION); }
 const CPelUnitBuf Picture::getPredBuf(const UnitArea &unit) const { return getBuf(unit, PIC_PREDICTION); }
+       PelUnitBuf Picture::getPredBuf()                           { return xGetBufs(PIC_PREDICTION); }
+const CPelUnitBuf Picture::getPredBuf()                     const { return xGetBufs(PIC_PREDICTION); }
 
        PelBuf     Picture::getResiBuf(const CompArea &blk)        { return getBuf(blk,  PIC_RESIDUAL); }
 const CPelBuf     Picture::getResiBuf(const CompArea &blk)  const { return getBuf(blk,  PIC_RESIDUAL); }
        PelUnitBuf Picture::getResiBuf(const UnitArea &unit)       { return getBuf(unit, PIC_RESIDUAL); }
 const CPelUnitBuf Picture::getResiBuf(const UnitArea &unit) const { return getBuf(unit, PIC_RESIDUAL); }
+       PelUnitBuf Picture::getResiBuf()                           { return xGetBufs(PIC_RESIDUAL); }
+const CPelUnitBuf Picture::getResiBuf()                     const { return xGetBufs(PIC_RESIDUAL); }
 
        PelBuf     Picture::getRecoBuf(const ComponentID compID, bool wrap)       { return getBuf(compID,                    wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 const CPelBuf     Picture::getRecoBuf(const ComponentID compID, bool wrap) const { return getBuf(compID,                    wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
@@ -243,13 +314,14 @@ const CPelBuf     Picture::getRecoBuf(const ComponentID compID, bool wrap) const
 const CPelBuf     Picture::getRecoBuf(const CompArea &blk, bool wrap)      const { return getBuf(blk,                       wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
        PelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)           { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 const CPelUnitBuf Picture::getRecoBuf(const UnitArea &unit, bool wrap)     const { return getBuf(unit,                      wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
-const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return M_BUFS(scheduler.getSplitPicId(), wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+       PelUnitBuf Picture::getRecoBuf(bool wrap)                                 { return xGetBufs(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
+const CPelUnitBuf Picture::getRecoBuf(bool wrap)                           const { return xGetBufs(wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION); }
 
        PelUnitBuf Picture::getPostRecBuf()                           { return M_BUFS(scheduler.getSplitPicId(), PIC_YUV_POST_REC); }
 const CPelUnitBuf Picture::getPostRecBuf()                     const { return M_BUFS(scheduler.getSplitPicId(), PIC_YUV_POST_REC); }
 
-void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps )
+void Picture::finalInit(const VPS *vps, const SPS &sps, const PPS &pps, PicHeader *picHeader, APS **alfApss,
+                        APS *lmcsAps, APS *scalingListAps, XuPool &xuPool)
 {
   for( auto &sei : SEIs )
   {
@@ -257,6 +329,7 @@ void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHead
   }
   SEIs.clear();
   clearSliceBuffer();
+  m_subPicRefValid.assign(m_subPicRefValid.size(), false);
 
   const ChromaFormat chromaFormatIdc = sps.getChromaFormatIdc();
   const int          width           = pps.getPicWidthInLumaSamples();
@@ -264,9 +337,14 @@ void Picture::finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHead
 
   if (cs == nullptr)
   {
-    cs      = new CodingStructure(g_xuPool);
+    cs      = new CodingStructure(xuPool);
     cs->create(chromaFormatIdc, Area(0, 0, width, height), true, (bool) sps.getPLTMode());
   }
+  else
+  {
+    // the motion field of a reused picture has been compacted when it was completed
+    cs->createMotionBuf();
+  }
 
   cs->sps = &sps;
   cs->vps = vps;
@@ -567,6 +645,8 @@ const TFilterCoeff m_chromaFilter6_alt[32][6] =
 { 0, -1, 6, 256, -6, 1, }
 };
 
+static constexpr int RESCALE_BAND_HEIGHT = 16;   // number of rows filtered by one job of the resampling passes
+
 const TFilterCoeff m_lumaFilter12[16][12] =
 {
     { 0,     0,     0,     0,     0,   256,     0,     0,     0,     0,     0,     0, },
@@ -629,7 +709,7 @@ void Picture::sampleRateConv(const ScalingRatio scalingRatio, const int scaleX,
                              const int afterScaleTopOffset, const int bitDepth, const bool useLumaFilter,
                              const bool downsampling,
                               const bool horCollocatedPositionFlag, const bool verCollocatedPositionFlag,
-                              const bool rescaleForDisplay, const int upscaleFilterForDisplay
+                              const bool rescaleForDisplay, const int upscaleFilterForDisplay, const int numThreads
 )
 {
   const Pel* orgSrc = beforeScale.buf;
@@ -747,65 +827,87 @@ void Picture::sampleRateConv(const ScalingRatio scalingRatio, const int scaleX,
   int log2NormList[3] = { 12, 16, 16 };
   const int filterLength = downsampling ? 12 : (rescaleForDisplay ? (useLumaFilter ? filterLengthsLuma[upscaleFilterForDisplay] : filterLengthsChroma[upscaleFilterForDisplay]) : useLumaFilter ? NTAPS_LUMA : NTAPS_CHROMA);
   const int log2Norm = downsampling ? 14 : (rescaleForDisplay ? log2NormList[upscaleFilterForDisplay] : 12);
-  int *buf = new int[orgHeight * scaledWidth];
-  int maxVal = ( 1 << bitDepth ) - 1;
+  const int maxVal = ( 1 << bitDepth ) - 1;
 
   CHECK( bitDepth > 17, "Overflow may happen!" );
 
+  // The horizontal pass reads a copy of each source row that is extended by replicating its first and last sample,
+  // so that no tap needs to be clipped. The coefficients of each output column are zero-padded to 8 or 16 taps.
+  const int numTapsHor = filterLength <= 8 ? 8 : 16;
+  std::vector<int>          srcPosHor( scaledWidth );
+  std::vector<TFilterCoeff> coeffHor( scaledWidth * numTapsHor, 0 );
+  int extLeft  = 0;
+  int extRight = orgWidth;
+
   for( int i = 0; i < scaledWidth; i++ )
   {
-    const Pel* org = orgSrc;
+    const int refPos  = (((i << scaleX) - afterScaleLeftOffset) * scalingRatio.x + addX) >> posShiftX;
+    const int integer = refPos >> numFracShift;
+    const int frac    = refPos & numFracPositions;
 
-    int  refPos  = (((i << scaleX) - afterScaleLeftOffset) * scalingRatio.x + addX) >> posShiftX;
-    int integer = refPos >> numFracShift;
-    int frac = refPos & numFracPositions;
-    int* tmp = buf + i;
-
-    for( int j = 0; j < orgHeight; j++ )
-    {
-      int sum = 0;
-      const TFilterCoeff* f = filterHor + frac * filterLength;
+    srcPosHor[i] = integer - filterLength / 2 + 1;
+    std::copy_n( filterHor + frac * filterLength, filterLength, &coeffHor[i * numTapsHor] );
 
-      for( int k = 0; k < filterLength; k++ )
-      {
-        int xInt = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgWidth - 1 );
-        sum += f[k] * org[xInt]; // postpone horizontal filtering gain removal after vertical filtering
-      }
+    extLeft  = std::min( extLeft, srcPosHor[i] );
+    extRight = std::max( extRight, srcPosHor[i] + numTapsHor );
+  }
+  for( int i = 0; i < scaledWidth; i++ )
+  {
+    srcPosHor[i] -= extLeft;
+  }
 
-      *tmp = sum;
+  // source rows of the vertical pass, clipped to the picture
+  std::vector<int> srcRowVer( scaledHeight * filterLength );
+  std::vector<int> fracVer( scaledHeight );
+  for( int j = 0; j < scaledHeight; j++ )
+  {
+    const int refPos  = (((j << scaleY) - afterScaleTopOffset) * scalingRatio.y + addY) >> posShiftY;
+    const int integer = refPos >> numFracShift;
+    const int frac    = refPos & numFracPositions;
 
-      tmp += scaledWidth;
-      org += orgStride;
+    for( int k = 0; k < filterLength; k++ )
+    {
+      srcRowVer[j * filterLength + k] = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgHeight - 1 );
     }
+    fracVer[j] = frac;
   }
 
-  Pel* dst = scaledSrc;
+  // postpone horizontal filtering gain removal after vertical filtering
+  std::vector<int> buf( orgHeight * scaledWidth );
 
-  for( int j = 0; j < scaledHeight; j++ )
-  {
-    int refPos  = (((j << scaleY) - afterScaleTopOffset) * scalingRatio.y + addY) >> posShiftY;
-    int integer = refPos >> numFracShift;
-    int frac = refPos & numFracPositions;
+  const int numBandsHor = ( orgHeight + RESCALE_BAND_HEIGHT - 1 ) / RESCALE_BAND_HEIGHT;
+  parallelFor( numThreads, numBandsHor, [&]( int band ) {
+    std::vector<Pel> extRow( extRight - extLeft );
+    const int        yEnd = std::min( orgHeight, ( band + 1 ) * RESCALE_BAND_HEIGHT );
 
-    for( int i = 0; i < scaledWidth; i++ )
+    for( int j = band * RESCALE_BAND_HEIGHT; j < yEnd; j++ )
     {
-      int sum = 0;
-      int* tmp = buf + i;
-      const TFilterCoeff* f = filterVer + frac * filterLength;
+      const Pel *org = orgSrc + j * orgStride;
+      std::fill( extRow.begin(), extRow.begin() - extLeft, org[0] );
+      std::copy_n( org, orgWidth, extRow.begin() - extLeft );
+      std::fill( extRow.begin() - extLeft + orgWidth, extRow.end(), org[orgWidth - 1] );
+
+      g_pelBufOP.rescaleHor( extRow.data(), srcPosHor.data(), coeffHor.data(), numTapsHor, &buf[j * scaledWidth],
+                             scaledWidth );
+    }
+  } );
+
+  const int numBandsVer = ( scaledHeight + RESCALE_BAND_HEIGHT - 1 ) / RESCALE_BAND_HEIGHT;
+  parallelFor( numThreads, numBandsVer, [&]( int band ) {
+    const int *rows[16];
+    const int  yEnd = std::min( scaledHeight, ( band + 1 ) * RESCALE_BAND_HEIGHT );
 
+    for( int j = band * RESCALE_BAND_HEIGHT; j < yEnd; j++ )
+    {
       for( int k = 0; k < filterLength; k++ )
       {
-        int yInt = std::min<int>( std::max( 0, integer + k - filterLength / 2 + 1 ), orgHeight - 1 );
-        sum += f[k] * tmp[yInt*scaledWidth];
+        rows[k] = &buf[srcRowVer[j * filterLength + k] * scaledWidth];
       }
 
-      dst[i] = std::min<int>( std::max( 0, ( sum + ( 1 << ( log2Norm - 1 ) ) ) >> log2Norm ), maxVal );
+      g_pelBufOP.rescaleVer( rows, filterVer + fracVer[j] * filterLength, filterLength, scaledSrc + j * scaledStride,
+                             scaledWidth, log2Norm, maxVal );
     }
-
-    dst += scaledStride;
-  }
-
-  delete[] buf;
+  } );
 }
 
 void Picture::rescalePicture(const ScalingRatio scalingRatio, const CPelUnitBuf& beforeScaling,
@@ -813,7 +915,7 @@ void Picture::rescalePicture(const ScalingRatio scalingRatio, const CPelUnitBuf&
                              const Window& scalingWindowAfter, const ChromaFormat chromaFormatIdc,
                              const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling,
                              const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag,
-                             bool rescaleForDisplay, int upscaleFilterForDisplay)
+                             bool rescaleForDisplay, int upscaleFilterForDisplay, int numThreads)
 {
   for (int comp = 0; comp < ::getNumberValidComponents(chromaFormatIdc); comp++)
   {
@@ -828,7 +930,7 @@ void Picture::rescalePicture(const ScalingRatio scalingRatio, const CPelUnitBuf&
       scalingWindowAfter.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
       scalingWindowAfter.getWindowTopOffset() * SPS::getWinUnitY(chromaFormatIdc), bitDepths[toChannelType(compID)],
       downsampling || useLumaFilter ? true : isLuma(compID), downsampling, isLuma(compID) ? 1 : horCollocatedChromaFlag,
-      isLuma(compID) ? 1 : verCollocatedChromaFlag, rescaleForDisplay, upscaleFilterForDisplay);
+      isLuma(compID) ? 1 : verCollocatedChromaFlag, rescaleForDisplay, upscaleFilterForDisplay, numThreads);
   }
 }
 
@@ -937,7 +1039,19 @@ void Picture::saveSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWi
 
 void Picture::extendSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWidth, int subPicHeight)
 {
+  xExtendSubPicBorder(M_BUFS(0, PIC_RECONSTRUCTION), false, subPicX0, subPicY0, subPicWidth, subPicHeight);
 
+  // Appy padding for recon wrap buffer
+  if (cs->sps->getWrapAroundEnabledFlag())
+  {
+    xExtendSubPicBorder(M_BUFS(0, PIC_RECON_WRAP), true, subPicX0, subPicY0, subPicWidth, subPicHeight);
+  }
+}
+
+/// pads the given buffer around a subpicture, the recon wrap buffer is padded on top and bottom only
+void Picture::xExtendSubPicBorder(PelStorage& buf, const bool wrap, int subPicX0, int subPicY0, int subPicWidth,
+                                  int subPicHeight)
+{
   for (int comp = 0; comp < getNumberValidComponents(cs->area.chromaFormat); comp++)
   {
     ComponentID compID = ComponentID(comp);
@@ -955,10 +1069,11 @@ void Picture::extendSubPicBorder(int POC, int subPicX0, int subPicY0, int subPic
     int height = subPicHeight >> getComponentScaleY(compID, cs->area.chromaFormat);
 
     // 3.1 set reconstructed picture
-    PelBuf s = M_BUFS(0, PIC_RECONSTRUCTION).get(compID);
+    PelBuf s = buf.get(compID);
     Pel *src = s.bufAt(left, top);
 
     // 4.1 apply padding for left and right
+    if (!wrap)
     {
       Pel *dstLeft  = src - xmargin;
       Pel *dstRight = src + width;
@@ -998,35 +1113,71 @@ void Picture::extendSubPicBorder(int POC, int subPicX0, int subPicY0, int subPic
       ::memcpy(dstTop, srcTop, sizeof(Pel)*(2 * xmargin + width));
       dstTop -= s.stride;
     }
+  } // end of for
+}
 
-    // Appy padding for recon wrap buffer
-    if (cs->sps->getWrapAroundEnabledFlag())
-    {
-      // set recon wrap picture
-      PelBuf sWrap = M_BUFS(0, PIC_RECON_WRAP).get(compID);
-      Pel *srcWrap = sWrap.bufAt(left, top);
+/// the padded copies are identical to the reconstruction extended in place by extendSubPicBorder within the margin
+/// around the subpicture, the motion vectors of a subpicture treated as a picture are clipped to stay inside it.
+/// Each copy only holds the subpicture and its margin, but is addressed in picture coordinates. A reference picture
+/// does not change while it is referenced, so the copies are made once and reused by the following pictures.
+void Picture::createSubPicRefBufs(int subPicIdx, const SubPic& subPic)
+{
+  const int  numBufs = cs->sps->getWrapAroundEnabledFlag() ? 2 : 1;
+  const Area subPicArea(subPic.getSubPicLeft(), subPic.getSubPicTop(), subPic.getSubPicWidthInLumaSample(),
+                        subPic.getSubPicHeightInLumaSample());
 
-      // apply padding on bottom
-      Pel *srcBottomWrap = srcWrap + sWrap.stride * (height - 1) - xmargin;
-      Pel *dstBottomWrap = srcBottomWrap + sWrap.stride;
-      for (int y = 0; y < ymargin; y++)
-      {
-        ::memcpy(dstBottomWrap, srcBottomWrap, sizeof(Pel)*(2 * xmargin + width));
-        dstBottomWrap += sWrap.stride;
-      }
+  if (m_subPicRefAreas.size() != subPictures.size())
+  {
+    // the buffers cannot be copied, so they are all recreated when the number of subpictures changes
+    m_subPicRefBufs.clear();
+    m_subPicRefBufs.resize(2 * subPictures.size());
+    m_subPicRefAreas.assign(subPictures.size(), Area());
+    m_subPicRefValid.assign(subPictures.size(), false);
+  }
 
-      // apply padding for top
-      // si is still (-marginX, SubpictureHeight-1)
-      Pel *srcTopWrap = srcWrap - xmargin;
-      Pel *dstTopWrap = srcTopWrap - sWrap.stride;
-      // si is now (-marginX, 0)
-      for (int y = 0; y < ymargin; y++)
+  for (int wrap = 0; wrap < numBufs; wrap++)
+  {
+    PelStorage       &buf = m_subPicRefBufs[2 * subPicIdx + wrap];
+    const PelStorage &rec = M_BUFS(0, wrap ? PIC_RECON_WRAP : PIC_RECONSTRUCTION);
+
+    if (buf.bufs.empty() || m_subPicRefAreas[subPicIdx] != subPicArea)
+    {
+      buf.destroy();
+      buf.create(chromaFormat, Area(Position(), subPicArea.size()), m_maxCUSize, margin, MEMORY_ALIGN_DEF_SIZE);
+      for (int comp = 0; comp < (int) buf.bufs.size(); comp++)
       {
-        ::memcpy(dstTopWrap, srcTopWrap, sizeof(Pel)*(2 * xmargin + width));
-        dstTopWrap -= sWrap.stride;
+        PelBuf &compBuf = buf.bufs[comp];
+        compBuf.buf -= (subPicArea.x >> getComponentScaleX(ComponentID(comp), chromaFormat))
+                       + (subPicArea.y >> getComponentScaleY(ComponentID(comp), chromaFormat)) * compBuf.stride;
+        compBuf.width  = rec.bufs[comp].width;
+        compBuf.height = rec.bufs[comp].height;
       }
     }
-  } // end of for
+
+    for (int comp = 0; comp < (int) buf.bufs.size(); comp++)
+    {
+      const ComponentID compID = ComponentID(comp);
+      const int         left   = subPicArea.x >> getComponentScaleX(compID, chromaFormat);
+      const int         top    = subPicArea.y >> getComponentScaleY(compID, chromaFormat);
+      const int         width  = subPicArea.width >> getComponentScaleX(compID, chromaFormat);
+      const int         height = subPicArea.height >> getComponentScaleY(compID, chromaFormat);
+      // wrap around requires the subpicture to span the picture width, the horizontal margins of the wrap buffer
+      // hold the samples wrapped around the picture
+      const int xmargin = wrap ? margin >> getComponentScaleX(compID, chromaFormat) : 0;
+
+      buf.bufs[comp]
+        .subBuf(left - xmargin, top, width + 2 * xmargin, height)
+        .copyFrom(rec.bufs[comp].subBuf(left - xmargin, top, width + 2 * xmargin, height));
+    }
+    xExtendSubPicBorder(buf, wrap != 0, subPicArea.x, subPicArea.y, subPicArea.width, subPicArea.height);
+  }
+  m_subPicRefAreas[subPicIdx] = subPicArea;
+  m_subPicRefValid[subPicIdx] = true;
+}
+
+bool Picture::hasSubPicRefBufs(int subPicIdx) const
+{
+  return subPicIdx < (int) m_subPicRefValid.size() && m_subPicRefValid[subPicIdx];
 }
 
 void Picture::restoreSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWidth, int subPicHeight)
@@ -1231,14 +1382,46 @@ void Picture::extendWrapBorder( const PPS *pps )
   m_wrapAroundOffset = pps->getWrapAroundOffset();
 }
 
+PelStorage& Picture::xGetBufs(const PictureType type)
+{
+  return const_cast<PelStorage&>(static_cast<const Picture&>(*this).xGetBufs(type));
+}
+
+const PelStorage& Picture::xGetBufs(const PictureType type) const
+{
+  // only the encoder attaches per-thread buffers, all others use the picture's own without the thread local lookup
+  if (m_splitPicBufs == nullptr && m_tilePicBufs == nullptr && m_subPicRefBufs.empty())
+  {
+    return m_bufs[type];
+  }
+
+  const Scheduler &picScheduler = scheduler;
+  const int        splitPicId   = picScheduler.getSplitPicId();
+  if (splitPicId > 0 && m_splitPicBufs != nullptr && (type == PIC_RECONSTRUCTION || type == PIC_PREDICTION))
+  {
+    return (*m_splitPicBufs)[2 * (splitPicId - 1) + (type == PIC_PREDICTION ? 1 : 0)];
+  }
+  const int tilePicId = picScheduler.getTilePicId();
+  if (tilePicId >= 0 && m_tilePicBufs != nullptr && (type == PIC_PREDICTION || type == PIC_RESIDUAL))
+  {
+    return (*m_tilePicBufs)[2 * tilePicId + (type == PIC_RESIDUAL ? 1 : 0)];
+  }
+  const int subPicRefId = picScheduler.getSubPicRefId();
+  if (subPicRefId >= 0 && hasSubPicRefBufs(subPicRefId) && (type == PIC_RECONSTRUCTION || type == PIC_RECON_WRAP))
+  {
+    return m_subPicRefBufs[2 * subPicRefId + (type == PIC_RECON_WRAP ? 1 : 0)];
+  }
+  return m_bufs[type];
+}
+
 PelBuf Picture::getBuf( const ComponentID compID, const PictureType &type )
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return xGetBufs( type ).getBuf( compID );
 }
 
 const CPelBuf Picture::getBuf( const ComponentID compID, const PictureType &type ) const
 {
-  return M_BUFS( ( type == PIC_ORIGINAL || type == PIC_TRUE_ORIGINAL || type == PIC_FILTERED_ORIGINAL || type == PIC_ORIGINAL_INPUT || type == PIC_TRUE_ORIGINAL_INPUT || type == PIC_FILTERED_ORIGINAL_INPUT ) ? 0 : scheduler.getSplitPicId(), type ).getBuf( compID );
+  return xGetBufs( type ).getBuf( compID );
 }
 
 PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
@@ -1255,11 +1438,11 @@ PelBuf Picture::getBuf( const CompArea &blk, const PictureType &type )
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return xGetBufs( type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return xGetBufs( type ).getBuf( blk );
 }
 
 const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) const
@@ -1276,11 +1459,11 @@ const CPelBuf Picture::getBuf( const CompArea &blk, const PictureType &type ) co
     localBlk.x &= ( cs->pcv->maxCUWidthMask  >> getComponentScaleX( blk.compID, blk.chromaFormat ) );
     localBlk.y &= ( cs->pcv->maxCUHeightMask >> getComponentScaleY( blk.compID, blk.chromaFormat ) );
 
-    return M_BUFS( jId, type ).getBuf( localBlk );
+    return xGetBufs( type ).getBuf( localBlk );
   }
 #endif
 
-  return M_BUFS( jId, type ).getBuf( blk );
+  return xGetBufs( type ).getBuf( blk );
 }
 
 PelUnitBuf Picture::getBuf( const UnitArea &unit, const PictureType &type )
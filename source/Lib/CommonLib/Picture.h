@@ -59,6 +59,29 @@ typedef std::list<SEI*> SEIMessages;
 
 #define M_BUFS(JID,PID) m_bufs[PID]
 
+/// per-thread selection of the picture buffers: the worker threads of the split-mode evaluation in EncCu write their
+/// reconstruction and prediction into private copies, selected by a split picture id > 0 (0: the picture's own buffers).
+/// The tile workers of EncSlice write their prediction and residual into private copies, selected by a tile picture
+/// id >= 0, and read the reference pictures padded around the subpicture they code, selected by a subpicture
+/// reference id >= 0 (-1: the picture's own buffers)
+class Scheduler
+{
+public:
+  int  getSplitPicId() const { return m_splitPicId; }
+  void setSplitPicId(const int id) { m_splitPicId = id; }
+  int  getTilePicId() const { return m_tilePicId; }
+  void setTilePicId(const int id) { m_tilePicId = id; }
+  int  getSubPicRefId() const { return m_subPicRefId; }
+  void setSubPicRefId(const int id) { m_subPicRefId = id; }
+
+private:
+  int m_splitPicId  = 0;
+  int m_tilePicId   = -1;
+  int m_subPicRefId = -1;
+};
+
+extern thread_local Scheduler scheduler;
+
 #if GDR_ENABLED
 struct GdrPicParam
 {
@@ -73,12 +96,16 @@ struct Picture : public UnitArea
   Picture();
 
   void create(const bool useWrapAround, const ChromaFormat& _chromaFormat, const Size& size, const unsigned _maxCUSize,
-              const unsigned margin, const bool bDecoder, const int layerId, const bool enablePostFilteringForHFR);
+              const unsigned margin, const bool bDecoder, const int layerId, const bool enablePostFilteringForHFR,
+              const bool scaledRefMargin = true);
   void destroy();
 
   void createTempBuffers( const unsigned _maxCUSize, bool useFilterFrame, bool resChange, bool decoder, bool isFgFiltered);
   void destroyTempBuffers();
 
+  void releaseUnreferencedBuffers(const bool releaseOrig);
+  void restoreReleasedBuffers();
+
   int                       m_padValue;
   SEIFilmGrainSynthesizer*  m_grainCharacteristic;
   PelStorage*               m_grainBuf;
@@ -122,11 +149,15 @@ struct Picture : public UnitArea
   const CPelBuf     getPredBuf(const CompArea &blk) const;
          PelUnitBuf getPredBuf(const UnitArea &unit);
   const CPelUnitBuf getPredBuf(const UnitArea &unit) const;
+         PelUnitBuf getPredBuf();
+  const CPelUnitBuf getPredBuf() const;
 
          PelBuf     getResiBuf(const CompArea &blk);
   const CPelBuf     getResiBuf(const CompArea &blk) const;
          PelUnitBuf getResiBuf(const UnitArea &unit);
   const CPelUnitBuf getResiBuf(const UnitArea &unit) const;
+         PelUnitBuf getResiBuf();
+  const CPelUnitBuf getResiBuf() const;
 
          PelBuf     getRecoBuf(const ComponentID compID, bool wrap=false);
   const CPelBuf     getRecoBuf(const ComponentID compID, bool wrap=false) const;
@@ -147,9 +178,15 @@ struct Picture : public UnitArea
         PelUnitBuf getPostRecBuf();
   const CPelUnitBuf getPostRecBuf() const;
 
+  /// attaches the reconstruction / prediction copies of the split jobs (two per job, indexed by split picture id - 1)
+  void setSplitPicBufs(std::vector<PelStorage>* bufs) { m_splitPicBufs = bufs; }
+  /// attaches the prediction / residual copies of the tile workers (two per worker, indexed by tile picture id)
+  void setTilePicBufs(std::vector<PelStorage>* bufs) { m_tilePicBufs = bufs; }
+
   void extendPicBorder(const SPS* sps, const PPS* pps);
   void extendWrapBorder( const PPS *pps );
-  void finalInit( const VPS* vps, const SPS& sps, const PPS& pps, PicHeader *picHeader, APS** alfApss, APS* lmcsAps, APS* scalingListAps );
+  void finalInit(const VPS *vps, const SPS &sps, const PPS &pps, PicHeader *picHeader, APS **alfApss, APS *lmcsAps,
+                 APS *scalingListAps, XuPool &xuPool = g_xuPool);
 
   int  getPOC()                               const { return poc; }
   int  getDecodingOrderNumber()               const { return m_decodingOrderNumber; }
@@ -178,7 +215,8 @@ struct Picture : public UnitArea
                                const int afterScaleLeftOffset, const int afterScaleTopOffset, const int bitDepth,
                                const bool useLumaFilter, const bool downsampling,
                               const bool horCollocatedPositionFlag, const bool verCollocatedPositionFlag,
-                              const bool rescaleForDisplay, const int upscaleFilterForDisplay
+                              const bool rescaleForDisplay, const int upscaleFilterForDisplay,
+                              const int numThreads = 1
   );
 
   static void rescalePicture(const ScalingRatio scalingRatio, const CPelUnitBuf& beforeScaling,
@@ -186,7 +224,7 @@ struct Picture : public UnitArea
                              const Window& scalingWindowAfter, const ChromaFormat chromaFormatIdc,
                              const BitDepths& bitDepths, const bool useLumaFilter, const bool downsampling,
                              const bool horCollocatedChromaFlag, const bool verCollocatedChromaFlag,
-                             bool rescaleForDisplay = false, int upscaleFilterForDisplay = 0);
+                             bool rescaleForDisplay = false, int upscaleFilterForDisplay = 0, int numThreads = 1);
 
 private:
   Window        m_conformanceWindow;
@@ -196,6 +234,17 @@ private:
 #if GREEN_METADATA_SEI_ENABLED
   FeatureCounterStruct m_featureCounter;
 #endif
+  std::vector<PelStorage>* m_splitPicBufs;
+  std::vector<PelStorage>* m_tilePicBufs;
+  std::vector<PelStorage>  m_subPicRefBufs;    ///< reconstruction and wrap copies padded around each subpicture
+  std::vector<Area>        m_subPicRefAreas;   ///< subpicture area the copies are allocated and addressed for
+  std::vector<bool>        m_subPicRefValid;   ///< whether the copies hold the current reconstruction
+
+        PelStorage& xGetBufs(const PictureType type);
+  const PelStorage& xGetBufs(const PictureType type) const;
+  void              xExtendSubPicBorder(PelStorage& buf, const bool wrap, int subPicX0, int subPicY0, int subPicWidth,
+                                        int subPicHeight);
+
 public:
   bool m_isSubPicBorderSaved;
 
@@ -210,6 +259,12 @@ public:
   void    saveSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWidth, int subPicHeight);
   void  extendSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWidth, int subPicHeight);
   void restoreSubPicBorder(int POC, int subPicX0, int subPicY0, int subPicWidth, int subPicHeight);
+
+  /// copies a subpicture of the reconstruction into buffers of its own and pads them around the subpicture, so that
+  /// the subpictures can be coded concurrently (selected by Scheduler::setSubPicRefId). The copies stay valid until
+  /// the picture is reused by finalInit.
+  void createSubPicRefBufs(int subPicIdx, const SubPic& subPic);
+  bool hasSubPicRefBufs(int subPicIdx) const;
 #if GREEN_METADATA_SEI_ENABLED
   void setFeatureCounter (FeatureCounterStruct b ) { m_featureCounter = b;}
   FeatureCounterStruct getFeatureCounter (){return m_featureCounter;}
@@ -252,6 +307,10 @@ public:
   PelStorage m_bufs[NUM_PIC_TYPES];
   const Picture*           unscaledPic;
 
+  unsigned m_maxCUSize;
+  bool     m_buffersReleased;   ///< lean mode: the buffers only needed by a reference picture have been freed
+  Size     m_releasedSize[NUM_PIC_TYPES];
+
   Hash               m_hashMap;
   Hash              *getHashMap() { return &m_hashMap; }
   const Hash        *getHashMap() const { return &m_hashMap; }
@@ -1271,4 +1271,18 @@ void Quant::lambdaAdjustColorTrans(bool forward)
     m_lambdas[component] = m_lambdasStore[m_pairCheck][component];
   }
 }
+
+/** copy the lambda state of another quantizer, the quantization tables are not touched
+ * \param other quantizer to copy the lambdas from
+ */
+void Quant::copyState( const Quant& other )
+{
+  m_dLambda    = other.m_dLambda;
+#if RDOQ_CHROMA_LAMBDA
+  std::copy_n( other.m_lambdas, MAX_NUM_COMPONENT, m_lambdas );
+#endif
+  std::copy_n( &other.m_lambdasStore[0][0], 2 * MAX_NUM_COMPONENT, &m_lambdasStore[0][0] );
+  m_resetStore = other.m_resetStore;
+  m_pairCheck  = other.m_pairCheck;
+}
 //! \}
@@ -117,6 +117,7 @@ public:
   double getLambda               () const                                      { return m_dLambda; }
   void   lambdaAdjustColorTrans(bool forward);
   void   resetStore() { m_resetStore = true; }
+  void   copyState               ( const Quant& other );
 
   int* getQuantCoeff             ( uint32_t list, int qp, uint32_t sizeX, uint32_t sizeY ) { return m_quantCoef            [sizeX][sizeY][list][qp]; };  //!< get Quant Coefficent
   int* getDequantCoeff           ( uint32_t list, int qp, uint32_t sizeX, uint32_t sizeY ) { return m_dequantCoef          [sizeX][sizeY][list][qp]; };  //!< get DeQuant Coefficent
@@ -138,15 +138,19 @@ int  Reshape::calculateChromaAdjVpduNei(TransformUnit &tu, const CompArea &areaY
   }
   else
   {
-    setVPDULoc(xPos, yPos);
+    // the cache is only used by the decoder; the encoder may evaluate several VPDUs concurrently
+    if (!cs.pcv->isEncoder)
+    {
+      setVPDULoc(xPos, yPos);
+    }
     Position topLeft(xPos, yPos);
     CodingUnit *topLeftLuma;
     const CodingUnit *cuAbove, *cuLeft;
     if (CS::isDualITree(cs) && cs.slice->getSliceType() == I_SLICE)
     {
-      topLeftLuma = tu.cs->picture->cs->getCU(topLeft, ChannelType::LUMA);
-      cuAbove = cs.picture->cs->getCURestricted(topLeftLuma->lumaPos().offset(0, -1), *topLeftLuma, ChannelType::LUMA);
-      cuLeft  = cs.picture->cs->getCURestricted(topLeftLuma->lumaPos().offset(-1, 0), *topLeftLuma, ChannelType::LUMA);
+      topLeftLuma = tu.cs->getTopLevelCS().getCU(topLeft, ChannelType::LUMA);
+      cuAbove = cs.getTopLevelCS().getCURestricted(topLeftLuma->lumaPos().offset(0, -1), *topLeftLuma, ChannelType::LUMA);
+      cuLeft  = cs.getTopLevelCS().getCURestricted(topLeftLuma->lumaPos().offset(-1, 0), *topLeftLuma, ChannelType::LUMA);
     }
     else
     {
@@ -202,7 +206,10 @@ int  Reshape::calculateChromaAdjVpduNei(TransformUnit &tu, const CompArea &areaY
       lumaValue = valueDC;
     }
     chromaScale = calculateChromaAdj(lumaValue);
-    setChromaScale(chromaScale);
+    if (!cs.pcv->isEncoder)
+    {
+      setChromaScale(chromaScale);
+    }
     return(chromaScale);
   }
 }
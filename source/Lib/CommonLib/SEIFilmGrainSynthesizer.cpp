@@ -36,6 +36,7 @@
  */
 
 #include "SEIFilmGrainSynthesizer.h"
+#include "ParallelFor.h"
 
 #include <stdio.h>
 #include <cmath>
@@ -220,6 +221,7 @@ SEIFilmGrainSynthesizer::SEIFilmGrainSynthesizer()
   , m_idrPicId(0)
   , m_grainSynt(nullptr)
   , m_fgsBlkSize(8)
+  , m_numThreads(1)
   , m_poc(0)
   , m_errorCode(0)
   , m_fgcParameters(nullptr)
@@ -248,6 +250,11 @@ SEIFilmGrainSynthesizer::~SEIFilmGrainSynthesizer()
   destroy();
 }
 
+void SEIFilmGrainSynthesizer::setNumThreads(int numThreads)
+{
+  m_numThreads = numThreads;
+}
+
 void SEIFilmGrainSynthesizer::fgsInit()
 {
   deriveFGSBlkSize();
@@ -391,12 +398,13 @@ void SEIFilmGrainSynthesizer::grainSynthesizeAndBlend(PelStorage* pGrainBuf, boo
   m_fgsArgs.blkSize = m_fgsBlkSize;
   m_fgsArgs.bitDepth = m_bitDepth;
   m_fgsArgs.pGrainSynt = m_grainSynt;
+  m_fgsArgs.numThreads = m_numThreads;
 
   fgsProcess(m_fgsArgs);
 
   for (compCtr = 0; compCtr < numComp; compCtr++)
   {
-    delete offsetsArr[compCtr];
+    delete[] offsetsArr[compCtr];
   }
   return;
 }
@@ -749,81 +757,20 @@ void SEIFilmGrainSynthesizer::blendStripe(Pel *decSampleHbdOffsetY, Pel *grainSt
                                           ptrdiff_t strideSrc, ptrdiff_t strideGrain, uint32_t blockHeight,
                                           uint8_t bitDepth)
 {
-  uint32_t k, l;
-  uint16_t maxRange;
-  maxRange = (1 << bitDepth) - 1;
-
-  int32_t  grainSample;
-  uint16_t decodeSampleHbd;
-  uint8_t bitDepthShift = (bitDepth - BIT_DEPTH_8);
-  ptrdiff_t bufInc        = (strideSrc - widthComp);
-  ptrdiff_t grainBufInc   = (strideGrain - widthComp);
-
-  for (l = 0; l < blockHeight; l++) /* y direction */
-  {
-    for (k = 0; k < widthComp; k++) /* x direction */
-    {
-      decodeSampleHbd = *decSampleHbdOffsetY;
-      grainSample = *grainStripe;
-      grainSample <<= bitDepthShift;
-      grainSample = CLIP3(0, maxRange, grainSample + decodeSampleHbd);
-      *decSampleHbdOffsetY = (Pel)grainSample;
-      decSampleHbdOffsetY++;
-      grainStripe++;
-    }
-    decSampleHbdOffsetY += bufInc;
-    grainStripe += grainBufInc;
-  }
-  return;
+  g_pelBufOP.fgsBlend(decSampleHbdOffsetY, strideSrc, grainStripe, strideGrain, widthComp, blockHeight, bitDepth);
 }
 
 void SEIFilmGrainSynthesizer::blendStripe_32x32(Pel *decSampleHbdOffsetY, Pel *grainStripe, uint32_t widthComp,
                                                 ptrdiff_t strideSrc, ptrdiff_t strideGrain, uint32_t blockHeight,
                                                 uint8_t bitDepth)
 {
-  uint32_t k, l;
-  uint16_t maxRange;
-  maxRange = (1 << bitDepth) - 1;
-
-  int32_t  grainSample;
-  uint16_t decodeSampleHbd;
-  uint8_t bitDepthShift = (bitDepth - BIT_DEPTH_8);
-  ptrdiff_t bufInc        = (strideSrc - widthComp);
-  ptrdiff_t grainBufInc   = (strideGrain - widthComp);
-
-  for (l = 0; l < blockHeight; l++) /* y direction */
-  {
-    for (k = 0; k < widthComp; k++) /* x direction */
-    {
-      decodeSampleHbd = *decSampleHbdOffsetY;
-      grainSample = *grainStripe;
-      grainSample <<= bitDepthShift;
-      grainSample = CLIP3(0, maxRange, grainSample + decodeSampleHbd);
-      *decSampleHbdOffsetY = (Pel)grainSample;
-      decSampleHbdOffsetY++;
-      grainStripe++;
-    }
-    decSampleHbdOffsetY += bufInc;
-    grainStripe += grainBufInc;
-  }
-  return;
+  g_pelBufOP.fgsBlend(decSampleHbdOffsetY, strideSrc, grainStripe, strideGrain, widthComp, blockHeight, bitDepth);
 }
 
 Pel SEIFilmGrainSynthesizer::blockAverage_8x8(Pel *decSampleBlk8, ptrdiff_t widthComp, uint16_t *pNumSamples,
                                               uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
 {
-  uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  for (k = 0; k < ySize; k++)
-  {
-    for (l = 0; l < xSize; l++)
-    {
-      blockAvg += *decSampleBlk8;
-      decSampleBlk8++;
-    }
-    decSampleBlk8 += widthComp - xSize;
-  }
+  uint32_t blockAvg = g_pelBufOP.fgsBlockSum(decSampleBlk8, widthComp, xSize, ySize);
 
   blockAvg = blockAvg >> (BLK_8_shift + (bitDepth - BIT_DEPTH_8));
   *pNumSamples = BLK_AREA_8x8;
@@ -834,18 +781,7 @@ Pel SEIFilmGrainSynthesizer::blockAverage_8x8(Pel *decSampleBlk8, ptrdiff_t widt
 uint32_t SEIFilmGrainSynthesizer::blockAverage_16x16(Pel *decSampleBlk8, ptrdiff_t widthComp, uint16_t *pNumSamples,
                                                      uint8_t ySize, uint8_t xSize, uint8_t bitDepth)
 {
-  uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  for (k = 0; k < ySize; k++)
-  {
-    for (l = 0; l < xSize; l++)
-    {
-      blockAvg += *decSampleBlk8;
-      decSampleBlk8++;
-    }
-    decSampleBlk8 += widthComp - xSize;
-  }
+  uint32_t blockAvg = g_pelBufOP.fgsBlockSum(decSampleBlk8, widthComp, xSize, ySize);
 
   // blockAvg = blockAvg >> (BLK_16_shift + (bitDepth - BIT_DEPTH_8));
   // If BLK_16 is not used or changed BLK_AREA_16x16 has to be changed
@@ -855,18 +791,7 @@ uint32_t SEIFilmGrainSynthesizer::blockAverage_16x16(Pel *decSampleBlk8, ptrdiff
 
 uint32_t SEIFilmGrainSynthesizer::blockAverage_32x32(Pel *decSampleBlk32, ptrdiff_t strideComp, uint8_t bitDepth)
 {
-  uint32_t blockAvg = 0;
-  uint8_t  k;
-  uint8_t l;
-  ptrdiff_t bufInc = strideComp - BLK_32;
-  for (k = 0; k < BLK_32; k++)
-  {
-    for (l = 0; l < BLK_32; l++)
-    {
-      blockAvg += *decSampleBlk32++;
-    }
-    decSampleBlk32 += bufInc;
-  }
+  uint32_t blockAvg = g_pelBufOP.fgsBlockSum(decSampleBlk32, strideComp, BLK_32, BLK_32);
   blockAvg = blockAvg >> (BLK_32_shift + (bitDepth - BIT_DEPTH_8));
   return blockAvg;
 }
@@ -876,22 +801,9 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk8x8(Pel *grainStripe, uint32_t gra
   uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
   uint32_t lOffset, uint8_t h, uint8_t v, uint32_t xSize)
 {
-  uint32_t l;
-  int8_t * database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
-  grainStripe += grainStripeOffsetBlk8;
-  uint32_t k;
-  for (l = 0; l < BLK_8; l++) /* y direction */
-  {
-    for (k = 0; k < xSize; k++) /* x direction */
-    {
-      *grainStripe = ((scaleFactor * (*database_h_v)) >> (log2ScaleFactor + GRAIN_SCALE));
-      grainStripe++;
-      database_h_v++;
-    }
-    grainStripe += width - xSize;
-    database_h_v += DATA_BASE_SIZE - xSize;
-  }
-  return;
+  int8_t *database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
+  g_pelBufOP.fgsScaleGrain(grainStripe + grainStripeOffsetBlk8, width, database_h_v, DATA_BASE_SIZE, xSize, BLK_8,
+                           scaleFactor, log2ScaleFactor + GRAIN_SCALE);
 }
 
 void SEIFilmGrainSynthesizer::simulateGrainBlk16x16(Pel *grainStripe, uint32_t grainStripeOffsetBlk8,
@@ -899,22 +811,9 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk16x16(Pel *grainStripe, uint32_t g
   uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
   uint32_t lOffset, uint8_t h, uint8_t v, uint32_t xSize)
 {
-  uint32_t l;
-  int8_t * database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
-  grainStripe += grainStripeOffsetBlk8;
-  uint32_t k;
-  for (l = 0; l < BLK_16; l++) /* y direction */
-  {
-    for (k = 0; k < xSize; k++) /* x direction */
-    {
-      *grainStripe = (int16_t)(((int32_t)scaleFactor * (*database_h_v)) >> (log2ScaleFactor + GRAIN_SCALE));
-      grainStripe++;
-      database_h_v++;
-    }
-    grainStripe += width - xSize;
-    database_h_v += DATA_BASE_SIZE - xSize;
-  }
-  return;
+  int8_t *database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
+  g_pelBufOP.fgsScaleGrain(grainStripe + grainStripeOffsetBlk8, width, database_h_v, DATA_BASE_SIZE, xSize, BLK_16,
+                           scaleFactor, log2ScaleFactor + GRAIN_SCALE);
 }
 
 void SEIFilmGrainSynthesizer::simulateGrainBlk32x32(Pel *grainStripe, uint32_t grainStripeOffsetBlk32,
@@ -922,342 +821,291 @@ void SEIFilmGrainSynthesizer::simulateGrainBlk32x32(Pel *grainStripe, uint32_t g
   uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
   uint32_t lOffset, uint8_t h, uint8_t v)
 {
-  uint32_t l;
-  int8_t * database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
-  grainStripe += grainStripeOffsetBlk32;
-  uint32_t k;
-  uint8_t shiftVal = log2ScaleFactor + GRAIN_SCALE;
-  uint32_t grainbufInc = width - BLK_32;
-
-  for (l = 0; l < BLK_32; l++) /* y direction */
+  int8_t *database_h_v = &grain_synt->dataBase[h][v][lOffset][kOffset];
+  g_pelBufOP.fgsScaleGrain(grainStripe + grainStripeOffsetBlk32, width, database_h_v, DATA_BASE_SIZE, BLK_32, BLK_32,
+                           scaleFactor, log2ScaleFactor + GRAIN_SCALE);
+}
+
+void SEIFilmGrainSynthesizer::fgsProcessStripes(fgsProcessArgs *inArgs, uint32_t stripeHeight,
+                                                FgsStripeFunc *stripeFunc)
+{
+  /* Stripes are independent: the PRNG seeds of all blocks are derived up front and deblocking of the grain only
+   * crosses vertical block edges inside a stripe. Distributing them over threads therefore does not change the output. */
+  std::vector<std::pair<uint8_t, uint32_t>> stripes;
+
+  for (uint8_t compCtr = 0; compCtr < inArgs->numComp; compCtr++)
   {
-    for (k = 0; k < BLK_32; k++) /* x direction */
+    if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
     {
-      *grainStripe = ((scaleFactor * (*database_h_v)) >> shiftVal);
-      grainStripe++;
-      database_h_v++;
+      for (uint32_t stripeIdx = 0; stripeIdx < inArgs->heightComp[compCtr] / stripeHeight; stripeIdx++)
+      {
+        stripes.push_back(std::make_pair(compCtr, stripeIdx));
+      }
     }
-    grainStripe += grainbufInc;
-    database_h_v += DATA_BASE_SIZE - BLK_32;
   }
-  return;
+
+  const uint32_t wdPadded  = ((inArgs->widthComp[0] - 1) | (stripeHeight - 1)) + 1;
+  const int      numChunks = std::max(1, std::min<int>(inArgs->numThreads, (int) stripes.size()));
+
+  // one contiguous run of stripes per thread, so that the grain scratch buffer is allocated once per thread
+  parallelFor(numChunks, numChunks,
+              [&](int chunkIdx)
+              {
+                std::vector<Pel> grainStripe(wdPadded * stripeHeight);
+
+                const size_t begin = stripes.size() * chunkIdx / numChunks;
+                const size_t end   = stripes.size() * (chunkIdx + 1) / numChunks;
+                for (size_t i = begin; i < end; i++)
+                {
+                  stripeFunc(inArgs, stripes[i].first, stripes[i].second, grainStripe.data());
+                }
+              });
 }
 
-uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(fgsProcessArgs *inArgs)
+void SEIFilmGrainSynthesizer::fgsSimulationBlendingStripe_8x8(fgsProcessArgs *inArgs, uint8_t compCtr,
+                                                              uint32_t stripeIdx, Pel *grainStripe)
 {
-  uint8_t  numComp, compCtr, blkId; /* number of color components */
+  uint8_t  blkId;
   uint8_t  log2ScaleFactor, h, v;
   uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
-  uint32_t  widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT];
-  ptrdiff_t strideComp[MAX_NUM_COMPONENT];
+  uint32_t  widthComp;
+  ptrdiff_t strideComp;
   Pel *    decSampleHbdBlk16, *decSampleHbdBlk8, *decSampleHbdOffsetY;
-  Pel *    decHbdComp[MAX_NUM_COMPONENT];
   uint16_t numSamples;
   int16_t  scaleFactor;
   uint32_t  kOffset, lOffset, grainStripeOffset, grainStripeOffsetBlk8;
   ptrdiff_t offsetBlk8x8;
   uint32_t kOffset_const, lOffset_const;
   int16_t  scaleFactor_const;
-  Pel *    grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
   int32_t  yOffset8x8, xOffset8x8;
-  uint32_t x, y;
+  uint32_t x;
   uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
   uint32_t grainStripeWidth;
-  uint32_t wdPadded;
 
   bitDepth        = inArgs->bitDepth;
-  numComp         = inArgs->numComp;
   log2ScaleFactor = inArgs->pFgcParameters->m_log2ScaleFactor;
+  widthComp       = inArgs->widthComp[compCtr];
+  strideComp      = inArgs->strideComp[compCtr];
 
-  for (compCtr = 0; compCtr < numComp; compCtr++)
-  {
-    decHbdComp[compCtr] = inArgs->decComp[compCtr];
-    strideComp[compCtr] = inArgs->strideComp[compCtr];
-    widthComp[compCtr]  = inArgs->widthComp[compCtr];
-    heightComp[compCtr] = inArgs->heightComp[compCtr];
-  }
-
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0xF) + 1;
-  grainStripe = new Pel[wdPadded * BLK_16];
+  grainStripeWidth    = ((widthComp - 1) | 0xF) + 1;   // Make next muliptle of 16
+  decSampleHbdOffsetY = inArgs->decComp[compCtr] + stripeIdx * BLK_16 * strideComp;
+  uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr] + stripeIdx * (grainStripeWidth / BLK_16);
 
-  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  /* Initialization of grain stripe of 16xwidth size */
+  memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
+  for (x = 0; x < widthComp; x += BLK_16)
   {
-    for (compCtr = 0; compCtr < numComp; compCtr++)
-    {
-      if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
-      {
-        decSampleHbdOffsetY  = decHbdComp[compCtr];
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        grainStripeWidth = ((widthComp[compCtr] - 1) | 0xF) + 1;   // Make next muliptle of 16
-
-        /* Loop of 16x16 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += BLK_16)
-        {
-          /* Initialization of grain stripe of 16xwidth size */
-          memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += BLK_16)
-          {
-            /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-
-            decSampleHbdBlk16 = decSampleHbdOffsetY + x;
-
-            kOffset_const = (MSB16(*offset_tmp) % 52);
-            kOffset_const &= 0xFFFC;
-
-            lOffset_const = (LSB16(*offset_tmp) % 56);
-            lOffset_const &= 0xFFF8;
-            scaleFactor_const = 1 - 2 * BIT0(*offset_tmp);
-            for (blkId = 0; blkId < NUM_8x8_BLKS_16x16; blkId++)
-            {
-              yOffset8x8   = (blkId >> 1) * BLK_8;
-              xOffset8x8   = (blkId & 0x1) * BLK_8;
-              offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp[compCtr]);
+    /* start position offset of decoded sample in x direction */
+    grainStripeOffset = x;
 
-              grainStripeOffsetBlk8 = grainStripeOffset + (xOffset8x8 + (yOffset8x8 * grainStripeWidth));
+    decSampleHbdBlk16 = decSampleHbdOffsetY + x;
 
-              decSampleHbdBlk8 = decSampleHbdBlk16 + offsetBlk8x8;
-              blockAvg = blockAverage_8x8(decSampleHbdBlk8, strideComp[compCtr], &numSamples, BLK_8, BLK_8, bitDepth);
+    kOffset_const = (MSB16(*offset_tmp) % 52);
+    kOffset_const &= 0xFFFC;
 
-              /* Selection of the component model */
-              intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
-
-              if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
-              {
-                /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
-                // kOffset = kOffset_const;
-                kOffset = kOffset_const + xOffset8x8;
-
-                lOffset = lOffset_const + yOffset8x8;
-
-                scaleFactor =
-                  scaleFactor_const
-                  * inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-                h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-                v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
-
-                /* 8x8 block grain simulation */
-                simulateGrainBlk8x8(grainStripe, grainStripeOffsetBlk8, inArgs->pGrainSynt, grainStripeWidth,
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_8);
-              } /* only if average falls in any interval */
-              //  }/* includes corner case handling */
-            } /* 8x8 level block processing */
-
-            /* uppdate the PRNG once per 16x16 block of samples */
-            offset_tmp++;
-          } /* End of 16xwidth grain simulation */
-
-          /* deblocking at the vertical edges of 8x8 at 16xwidth*/
-          deblockGrainStripe(grainStripe, widthComp[compCtr], BLK_16, grainStripeWidth, BLK_8);
+    lOffset_const = (LSB16(*offset_tmp) % 56);
+    lOffset_const &= 0xFFF8;
+    scaleFactor_const = 1 - 2 * BIT0(*offset_tmp);
+    for (blkId = 0; blkId < NUM_8x8_BLKS_16x16; blkId++)
+    {
+      yOffset8x8   = (blkId >> 1) * BLK_8;
+      xOffset8x8   = (blkId & 0x1) * BLK_8;
+      offsetBlk8x8 = xOffset8x8 + (yOffset8x8 * strideComp);
 
-          /* Blending of size 16xwidth*/
+      grainStripeOffsetBlk8 = grainStripeOffset + (xOffset8x8 + (yOffset8x8 * grainStripeWidth));
 
-          blendStripe(decSampleHbdOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth,
-                      BLK_16, bitDepth);
-          decSampleHbdOffsetY += BLK_16 * strideComp[compCtr];
+      decSampleHbdBlk8 = decSampleHbdBlk16 + offsetBlk8x8;
+      blockAvg = blockAverage_8x8(decSampleHbdBlk8, strideComp, &numSamples, BLK_8, BLK_8, bitDepth);
 
-        } /* end of component loop */
-      }
-    }
-  }
+      /* Selection of the component model */
+      intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
-  delete [] grainStripe;
-  return FGS_SUCCESS;
+      if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
+      {
+        /* 8x8 grain block offset using co-ordinates of decoded 8x8 block in the frame */
+        // kOffset = kOffset_const;
+        kOffset = kOffset_const + xOffset8x8;
+
+        lOffset = lOffset_const + yOffset8x8;
+
+        scaleFactor =
+          scaleFactor_const
+          * inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
+        h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+        v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+
+        /* 8x8 block grain simulation */
+        simulateGrainBlk8x8(grainStripe, grainStripeOffsetBlk8, inArgs->pGrainSynt, grainStripeWidth,
+                            log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_8);
+      } /* only if average falls in any interval */
+      //  }/* includes corner case handling */
+    } /* 8x8 level block processing */
+
+    /* uppdate the PRNG once per 16x16 block of samples */
+    offset_tmp++;
+  } /* End of 16xwidth grain simulation */
+
+  /* deblocking at the vertical edges of 8x8 at 16xwidth*/
+  deblockGrainStripe(grainStripe, widthComp, BLK_16, grainStripeWidth, BLK_8);
+
+  /* Blending of size 16xwidth*/
+  blendStripe(decSampleHbdOffsetY, grainStripe, widthComp, strideComp, grainStripeWidth, BLK_16, bitDepth);
 }
 
-uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(fgsProcessArgs *inArgs)
+void SEIFilmGrainSynthesizer::fgsSimulationBlendingStripe_16x16(fgsProcessArgs *inArgs, uint8_t compCtr,
+                                                                uint32_t stripeIdx, Pel *grainStripe)
 {
-  uint8_t  numComp, compCtr; /* number of color components */
   uint8_t  log2ScaleFactor, h, v;
   uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
-  uint32_t  widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT];
-  ptrdiff_t strideComp[MAX_NUM_COMPONENT];
+  uint32_t  widthComp;
+  ptrdiff_t strideComp;
   Pel *    decSampleHbdBlk16, *decSampleHbdOffsetY;
-  Pel *    decHbdComp[MAX_NUM_COMPONENT];
   uint16_t numSamples;
   int16_t  scaleFactor;
   uint32_t kOffset, lOffset, grainStripeOffset;
-  Pel *    grainStripe; /* worth a row of 16x16 : Max size : 16xw;*/
-  uint32_t x, y;
+  uint32_t x;
   uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
   uint32_t grainStripeWidth;
-  uint32_t wdPadded;
 
   bitDepth        = inArgs->bitDepth;
-  numComp         = inArgs->numComp;
   log2ScaleFactor = inArgs->pFgcParameters->m_log2ScaleFactor;
+  widthComp       = inArgs->widthComp[compCtr];
+  strideComp      = inArgs->strideComp[compCtr];
 
-  for (compCtr = 0; compCtr < numComp; compCtr++)
-  {
-    decHbdComp[compCtr] = inArgs->decComp[compCtr];
-    strideComp[compCtr] = inArgs->strideComp[compCtr];
-    widthComp[compCtr]  = inArgs->widthComp[compCtr];
-    heightComp[compCtr] = inArgs->heightComp[compCtr];
-  }
-
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0xF) + 1;
-  grainStripe = new Pel[wdPadded * BLK_16];
+  grainStripeWidth    = ((widthComp - 1) | 0xF) + 1;   // Make next muliptle of 16
+  decSampleHbdOffsetY = inArgs->decComp[compCtr] + stripeIdx * BLK_16 * strideComp;
+  uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr] + stripeIdx * (grainStripeWidth / BLK_16);
 
-  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  /* Initialization of grain stripe of 16xwidth size */
+  memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
+  for (x = 0; x < widthComp; x += BLK_16)
   {
-    for (compCtr = 0; compCtr < numComp; compCtr++)
-    {
-      if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
-      {
-        decSampleHbdOffsetY  = decHbdComp[compCtr];
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        grainStripeWidth = ((widthComp[compCtr] - 1) | 0xF) + 1;   // Make next muliptle of 16
+    /* start position offset of decoded sample in x direction */
+    grainStripeOffset = x;
 
-        /* Loop of 16x16 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += BLK_16)
-        {
-          /* Initialization of grain stripe of 16xwidth size */
-          memset(grainStripe, 0, (grainStripeWidth * BLK_16 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += BLK_16)
-          {
-            /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-
-            decSampleHbdBlk16 = decSampleHbdOffsetY + x;
-
-            blockAvg =
-              blockAverage_16x16(decSampleHbdBlk16, strideComp[compCtr], &numSamples, BLK_16, BLK_16, bitDepth);
-            blockAvg = blockAvg >> (BLK_16_shift + (bitDepth - BIT_DEPTH_8));
-            /* Selection of the component model */
-            intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
-
-            if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
-            {
-              kOffset = (MSB16(*offset_tmp) % 52);
-              kOffset &= 0xFFFC;
-
-              lOffset = (LSB16(*offset_tmp) % 56);
-              lOffset &= 0xFFF8;
-              scaleFactor = 1 - 2 * BIT0(*offset_tmp);
-
-              scaleFactor *=
-                inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-              h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-              v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
-
-              /* 16x16 block grain simulation */
-              simulateGrainBlk16x16(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v, BLK_16);
-
-            } /* only if average falls in any interval */
-            //  }/* includes corner case handling */
-            /* uppdate the PRNG once per 16x16 block of samples */
-            offset_tmp++;
-          } /* End of 16xwidth grain simulation */
-          /* deblocking at the vertical edges of 16x16 at 16xwidth*/
-          deblockGrainStripe(grainStripe, widthComp[compCtr], BLK_16, grainStripeWidth, BLK_16);
-
-          /* Blending of size 16xwidth*/
-          blendStripe(decSampleHbdOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth,
-                      BLK_16, bitDepth);
-          decSampleHbdOffsetY += BLK_16 * strideComp[compCtr];
-
-        } /* end of component loop */
-      }
-    }
-  }
+    decSampleHbdBlk16 = decSampleHbdOffsetY + x;
 
-  delete [] grainStripe;
-  return FGS_SUCCESS;
+    blockAvg = blockAverage_16x16(decSampleHbdBlk16, strideComp, &numSamples, BLK_16, BLK_16, bitDepth);
+    blockAvg = blockAvg >> (BLK_16_shift + (bitDepth - BIT_DEPTH_8));
+    /* Selection of the component model */
+    intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+
+    if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
+    {
+      kOffset = (MSB16(*offset_tmp) % 52);
+      kOffset &= 0xFFFC;
+
+      lOffset = (LSB16(*offset_tmp) % 56);
+      lOffset &= 0xFFF8;
+      scaleFactor = 1 - 2 * BIT0(*offset_tmp);
+
+      scaleFactor *= inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
+      h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+      v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+
+      /* 16x16 block grain simulation */
+      simulateGrainBlk16x16(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth, log2ScaleFactor,
+                            scaleFactor, kOffset, lOffset, h, v, BLK_16);
+
+    } /* only if average falls in any interval */
+    //  }/* includes corner case handling */
+    /* uppdate the PRNG once per 16x16 block of samples */
+    offset_tmp++;
+  } /* End of 16xwidth grain simulation */
+  /* deblocking at the vertical edges of 16x16 at 16xwidth*/
+  deblockGrainStripe(grainStripe, widthComp, BLK_16, grainStripeWidth, BLK_16);
+
+  /* Blending of size 16xwidth*/
+  blendStripe(decSampleHbdOffsetY, grainStripe, widthComp, strideComp, grainStripeWidth, BLK_16, bitDepth);
 }
 
-uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(fgsProcessArgs *inArgs)
+void SEIFilmGrainSynthesizer::fgsSimulationBlendingStripe_32x32(fgsProcessArgs *inArgs, uint8_t compCtr,
+                                                                uint32_t stripeIdx, Pel *grainStripe)
 {
-  uint8_t  numComp, compCtr; /* number of color components */
   uint8_t  log2ScaleFactor, h, v;
   uint8_t  bitDepth; /*grain bit depth and decoded bit depth are assumed to be same */
-  uint32_t  widthComp[MAX_NUM_COMPONENT], heightComp[MAX_NUM_COMPONENT];
-  ptrdiff_t strideComp[MAX_NUM_COMPONENT];
+  uint32_t  widthComp;
+  ptrdiff_t strideComp;
   Pel *    decSampleBlk32, *decSampleOffsetY;
-  Pel *    decComp[MAX_NUM_COMPONENT];
   int16_t  scaleFactor;
   uint32_t kOffset, lOffset, grainStripeOffset;
-  Pel *    grainStripe;
-  uint32_t x, y;
+  uint32_t x;
   uint32_t blockAvg, intensityInt; /* ec : seed to be used for the psudo random generator for a given color component */
   uint32_t grainStripeWidth;
-  uint32_t wdPadded;
-
-  bitDepth = inArgs->bitDepth;
-  numComp  = inArgs->numComp;
 
+  bitDepth        = inArgs->bitDepth;
   log2ScaleFactor = inArgs->pFgcParameters->m_log2ScaleFactor;
+  widthComp       = inArgs->widthComp[compCtr];
+  strideComp      = inArgs->strideComp[compCtr];
 
-  for (compCtr = 0; compCtr < numComp; compCtr++)
-  {
-    decComp[compCtr]    = inArgs->decComp[compCtr];
-    strideComp[compCtr] = inArgs->strideComp[compCtr];
-    heightComp[compCtr] = inArgs->heightComp[compCtr];
-    widthComp[compCtr]  = inArgs->widthComp[compCtr];
-  }
-
-  wdPadded = ((inArgs->widthComp[0] - 1) | 0x1F) + 1;
-  grainStripe = new Pel[wdPadded * BLK_32];
+  grainStripeWidth = ((widthComp - 1) | 0x1F) + 1;   // Make next muliptle of 32
+  decSampleOffsetY = inArgs->decComp[compCtr] + stripeIdx * BLK_32 * strideComp;
+  uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr] + stripeIdx * (grainStripeWidth / BLK_32);
 
-  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  /* Initialization of grain stripe of 32xwidth size */
+  memset(grainStripe, 0, (grainStripeWidth * BLK_32 * sizeof(Pel)));
+  for (x = 0; x < widthComp; x += BLK_32)
   {
-    for (compCtr = 0; compCtr < numComp; compCtr++)
-    {
-      if (1 == inArgs->pFgcParameters->m_compModel[compCtr].presentFlag)
-      {
-        uint32_t *offset_tmp = inArgs->fgsOffsets[compCtr];
-        decSampleOffsetY     = decComp[compCtr];
-        grainStripeWidth = ((widthComp[compCtr] - 1) | 0x1F) + 1;   // Make next muliptle of 32
+    /* start position offset of decoded sample in x direction */
+    grainStripeOffset = x;
+    decSampleBlk32    = decSampleOffsetY + x;
+    blockAvg = blockAverage_32x32(decSampleBlk32, strideComp, bitDepth);
 
-        /* Loop of 32x32 blocks */
-        for (y = 0; y < heightComp[compCtr]; y += BLK_32)
-        {
-          /* Initialization of grain stripe of 32xwidth size */
-          memset(grainStripe, 0, (grainStripeWidth * BLK_32 * sizeof(Pel)));
-          for (x = 0; x < widthComp[compCtr]; x += BLK_32)
-          {
-            /* start position offset of decoded sample in x direction */
-            grainStripeOffset = x;
-            decSampleBlk32    = decSampleOffsetY + x;
-            blockAvg = blockAverage_32x32(decSampleBlk32, strideComp[compCtr], bitDepth);
+    /* Selection of the component model */
+    intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
 
-            /* Selection of the component model */
-            intensityInt = inArgs->pGrainSynt->intensityInterval[compCtr][blockAvg];
+    if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
+    {
+      kOffset = (MSB16(*offset_tmp) % 36);
+      kOffset &= 0xFFFC;
 
-            if (INTENSITY_INTERVAL_MATCH_FAIL != intensityInt)
-            {
-              kOffset = (MSB16(*offset_tmp) % 36);
-              kOffset &= 0xFFFC;
+      lOffset = (LSB16(*offset_tmp) % 40);
+      lOffset &= 0xFFF8;
+      scaleFactor = 1 - 2 * BIT0(*offset_tmp);
 
-              lOffset = (LSB16(*offset_tmp) % 40);
-              lOffset &= 0xFFF8;
-              scaleFactor = 1 - 2 * BIT0(*offset_tmp);
+      scaleFactor *= inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
+      h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
+      v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
 
-              scaleFactor *= inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[0];
-              h = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[1] - 2;
-              v = inArgs->pFgcParameters->m_compModel[compCtr].intensityValues[intensityInt].compModelValue[2] - 2;
+      /* 32x32 block grain simulation */
+      simulateGrainBlk32x32(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth, log2ScaleFactor,
+                            scaleFactor, kOffset, lOffset, h, v);
 
-              /* 32x32 block grain simulation */
-              simulateGrainBlk32x32(grainStripe, grainStripeOffset, inArgs->pGrainSynt, grainStripeWidth,
-                                    log2ScaleFactor, scaleFactor, kOffset, lOffset, h, v);
+    } /* only if average falls in any interval */
 
-            } /* only if average falls in any interval */
+    /* uppdate the PRNG once per 16x16 block of samples */
+    offset_tmp++;
+  } /* End of 32xwidth grain simulation */
 
-            /* uppdate the PRNG once per 16x16 block of samples */
-            offset_tmp++;
-          } /* End of 32xwidth grain simulation */
+  /* deblocking at the vertical edges of 8x8 at 16xwidth*/
+  deblockGrainStripe(grainStripe, widthComp, BLK_32, grainStripeWidth, BLK_32);
 
-          /* deblocking at the vertical edges of 8x8 at 16xwidth*/
-          deblockGrainStripe(grainStripe, widthComp[compCtr], BLK_32, grainStripeWidth, BLK_32);
+  blendStripe_32x32(decSampleOffsetY, grainStripe, widthComp, strideComp, grainStripeWidth, BLK_32, bitDepth);
+}
 
-          blendStripe_32x32(decSampleOffsetY, grainStripe, widthComp[compCtr], strideComp[compCtr], grainStripeWidth, BLK_32, bitDepth);
-          decSampleOffsetY += BLK_32 * strideComp[compCtr];
-        } /* end of component loop */
-      }
-    }
+uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_8x8(fgsProcessArgs *inArgs)
+{
+  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  {
+    fgsProcessStripes(inArgs, BLK_16, fgsSimulationBlendingStripe_8x8);
   }
+  return FGS_SUCCESS;
+}
 
-  delete [] grainStripe;
+uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_16x16(fgsProcessArgs *inArgs)
+{
+  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  {
+    fgsProcessStripes(inArgs, BLK_16, fgsSimulationBlendingStripe_16x16);
+  }
   return FGS_SUCCESS;
 }
 
+uint32_t SEIFilmGrainSynthesizer::fgsSimulationBlending_32x32(fgsProcessArgs *inArgs)
+{
+  if (0 == inArgs->pFgcParameters->m_filmGrainCharacteristicsCancelFlag)
+  {
+    fgsProcessStripes(inArgs, BLK_32, fgsSimulationBlendingStripe_32x32);
+  }
+  return FGS_SUCCESS;
+}
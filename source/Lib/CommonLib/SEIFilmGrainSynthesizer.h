@@ -158,8 +158,11 @@ typedef struct fgsProcessArgs
   GrainSynthesisStruct *       pGrainSynt;
   uint8_t                      bitDepth;
   uint8_t                      blkSize;
+  int                          numThreads;
 } fgsProcessArgs;
 
+typedef void FgsStripeFunc(fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t stripeIdx, Pel *grainStripe);
+
 class SEIFilmGrainSynthesizer
 {
 
@@ -173,6 +176,7 @@ private:
   fgsProcessArgs               m_fgsArgs;
   GrainSynthesisStruct        *m_grainSynt;
   uint8_t                      m_fgsBlkSize;
+  int                          m_numThreads;
 
 public:
   uint32_t                     m_poc;
@@ -187,6 +191,7 @@ public:
   void      destroy   ();
 
   void      fgsInit   ();
+  void      setNumThreads           (int numThreads);
   void      grainSynthesizeAndBlend (PelStorage* pGrainBuf, bool isIdrPic);
   uint8_t   grainValidateParams     ();
 
@@ -219,6 +224,14 @@ private:
                                         uint32_t width, uint8_t log2ScaleFactor, int16_t scaleFactor, uint32_t kOffset,
                                         uint32_t lOffset, uint8_t h, uint8_t v);
 
+  static void     fgsProcessStripes   (fgsProcessArgs *inArgs, uint32_t stripeHeight, FgsStripeFunc *stripeFunc);
+  static void     fgsSimulationBlendingStripe_8x8  (fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t stripeIdx,
+                                                    Pel *grainStripe);
+  static void     fgsSimulationBlendingStripe_16x16(fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t stripeIdx,
+                                                    Pel *grainStripe);
+  static void     fgsSimulationBlendingStripe_32x32(fgsProcessArgs *inArgs, uint8_t compCtr, uint32_t stripeIdx,
+                                                    Pel *grainStripe);
+
   static uint32_t fgsSimulationBlending_8x8   (fgsProcessArgs *inArgs);
   static uint32_t fgsSimulationBlending_16x16 (fgsProcessArgs *inArgs);
   static uint32_t fgsSimulationBlending_32x32 (fgsProcessArgs *inArgs);
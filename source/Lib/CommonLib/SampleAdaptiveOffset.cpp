@@ -36,6 +36,7 @@
 */
 
 #include "SampleAdaptiveOffset.h"
+#include "StageProfiler.h"
 
 #include "UnitTools.h"
 #include "UnitPartitioner.h"
@@ -638,6 +639,8 @@ void SampleAdaptiveOffset::offsetCTU(const UnitArea &area, const CPelUnitBuf &sr
 void SampleAdaptiveOffset::SAOProcess( CodingStructure& cs, SAOBlkParam* saoBlkParams
                                       )
 {
+  PROFILE_STAGE( "SAO" );
+
   CHECK(!saoBlkParams, "No parameters present");
 
   xReconstructBlkSAOParams(cs, saoBlkParams);
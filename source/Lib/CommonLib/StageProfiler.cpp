@@ -0,0 +1,284 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.cpp
+ *  \brief    Hierarchical scoped timers and counters for the codec stages
+ */
+
+#include "StageProfiler.h"
+
+#if ENABLE_STAGE_PROFILING
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//! \ingroup CommonLib
+//! \{
+
+// Every thread records into its own tree, so the timers need no locking. The totals are only written by the owning
+// thread and read with relaxed atomics, the tree mutex serialises adding children against the readers.
+struct StageNode
+{
+  StageNode( const char *_name, bool _isCounter ) : name( _name ), isCounter( _isCounter ) {}
+
+  const char                             *name;
+  bool                                    isCounter;
+  std::atomic<uint64_t>                   timeNs{ 0 };
+  std::atomic<uint64_t>                   count{ 0 };
+  std::vector<std::unique_ptr<StageNode>> children;
+};
+
+struct StageTotals
+{
+  bool     isCounter = false;
+  uint64_t count     = 0;
+  uint64_t timeNs    = 0;
+};
+
+typedef std::map<std::string, StageTotals> StageTotalsMap;
+
+struct PictureStages
+{
+  int            layerId;
+  int            poc;
+  StageTotalsMap stages;
+};
+
+struct ThreadProfile
+{
+  ThreadProfile();
+  ~ThreadProfile();
+
+  StageNode  root{ "", false };
+  StageNode *current = &root;
+  std::mutex treeMutex;
+};
+
+struct ProfileRegistry
+{
+  std::mutex                  mutex;
+  std::vector<ThreadProfile*> threads;
+  StageTotalsMap              finishedThreads;   // totals of the threads that have already exited
+  StageTotalsMap              lastTotals;        // totals at the last finishPicture() call
+  std::vector<PictureStages>  pictures;
+};
+
+static ProfileRegistry &getRegistry()
+{
+  static ProfileRegistry registry;
+  return registry;
+}
+
+static thread_local ThreadProfile t_threadProfile;
+
+static void addTotals( StageTotalsMap &totals, const StageNode &node, const std::string &path )
+{
+  for( const auto &child: node.children )
+  {
+    const std::string childPath = path.empty() ? std::string( child->name ) : path + "/" + child->name;
+    StageTotals      &entry     = totals[childPath];
+    entry.isCounter             = child->isCounter;
+    entry.count                += child->count.load( std::memory_order_relaxed );
+    entry.timeNs               += child->timeNs.load( std::memory_order_relaxed );
+    addTotals( totals, *child, childPath );
+  }
+}
+
+// requires the registry mutex to be held
+static StageTotalsMap collectTotals( ProfileRegistry &registry )
+{
+  StageTotalsMap totals = registry.finishedThreads;
+  for( ThreadProfile *profile: registry.threads )
+  {
+    std::lock_guard<std::mutex> lock( profile->treeMutex );
+    addTotals( totals, profile->root, std::string() );
+  }
+  return totals;
+}
+
+ThreadProfile::ThreadProfile()
+{
+  ProfileRegistry            &registry = getRegistry();
+  std::lock_guard<std::mutex> lock( registry.mutex );
+  registry.threads.push_back( this );
+}
+
+ThreadProfile::~ThreadProfile()
+{
+  ProfileRegistry            &registry = getRegistry();
+  std::lock_guard<std::mutex> lock( registry.mutex );
+  addTotals( registry.finishedThreads, root, std::string() );
+  registry.threads.erase( std::find( registry.threads.begin(), registry.threads.end(), this ) );
+}
+
+static inline StageNode *getChild( ThreadProfile &profile, StageNode *parent, const char *name, bool isCounter )
+{
+  for( const auto &child: parent->children )
+  {
+    if( child->isCounter == isCounter && ( child->name == name || !strcmp( child->name, name ) ) )
+    {
+      return child.get();
+    }
+  }
+
+  std::lock_guard<std::mutex> lock( profile.treeMutex );
+  parent->children.push_back( std::make_unique<StageNode>( name, isCounter ) );
+  return parent->children.back().get();
+}
+
+StageProfiler::ScopedStage::ScopedStage( const char *name )
+{
+  m_profile          = &t_threadProfile;
+  m_parent           = m_profile->current;
+  m_node             = getChild( *m_profile, m_parent, name, false );
+  m_profile->current = m_node;
+  m_start            = std::chrono::steady_clock::now();
+}
+
+StageProfiler::ScopedStage::~ScopedStage()
+{
+  const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_start );
+
+  // single writer, so a plain read-modify-write of the relaxed atomics is sufficient
+  m_node->timeNs.store( m_node->timeNs.load( std::memory_order_relaxed ) + elapsed.count(), std::memory_order_relaxed );
+  m_node->count.store( m_node->count.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+  m_profile->current = m_parent;
+}
+
+void StageProfiler::count( const char *name, uint64_t n )
+{
+  ThreadProfile &profile = t_threadProfile;
+  StageNode     *node    = getChild( profile, profile.current, name, true );
+  node->count.store( node->count.load( std::memory_order_relaxed ) + n, std::memory_order_relaxed );
+}
+
+void StageProfiler::finishPicture( int layerId, int poc )
+{
+  ProfileRegistry            &registry = getRegistry();
+  std::lock_guard<std::mutex> lock( registry.mutex );
+
+  StageTotalsMap totals = collectTotals( registry );
+  PictureStages  picture{ layerId, poc, StageTotalsMap() };
+
+  for( const auto &entry: totals )
+  {
+    const auto   last  = registry.lastTotals.find( entry.first );
+    StageTotals  delta = entry.second;
+    if( last != registry.lastTotals.end() )
+    {
+      delta.count  -= last->second.count;
+      delta.timeNs -= last->second.timeNs;
+    }
+    if( delta.count > 0 || delta.timeNs > 0 )
+    {
+      picture.stages[entry.first] = delta;
+    }
+  }
+
+  registry.pictures.push_back( std::move( picture ) );
+  registry.lastTotals = std::move( totals );
+}
+
+static void writeStagesJson( FILE *file, const StageTotalsMap &stages, const char *indent )
+{
+  bool first = true;
+  for( const auto &entry: stages )
+  {
+    fprintf( file, "%s\n%s{ \"stage\": \"%s\", \"type\": \"%s\", \"count\": %llu, \"time_ms\": %.3f }", first ? "" : ",",
+             indent, entry.first.c_str(), entry.second.isCounter ? "counter" : "stage",
+             (unsigned long long) entry.second.count, entry.second.timeNs / 1.0e6 );
+    first = false;
+  }
+}
+
+static void writeStagesCsv( FILE *file, const StageTotalsMap &stages, const char *scope, int layerId, int poc )
+{
+  for( const auto &entry: stages )
+  {
+    fprintf( file, "%s,%d,%d,%s,%s,%llu,%.3f\n", scope, layerId, poc, entry.first.c_str(),
+             entry.second.isCounter ? "counter" : "stage", (unsigned long long) entry.second.count,
+             entry.second.timeNs / 1.0e6 );
+  }
+}
+
+bool StageProfiler::writeReport( const std::string &fileName )
+{
+  ProfileRegistry            &registry = getRegistry();
+  std::lock_guard<std::mutex> lock( registry.mutex );
+
+  FILE *file = fopen( fileName.c_str(), "w" );
+  if( file == nullptr )
+  {
+    msg( WARNING, "Warning: could not open profile report file %s\n", fileName.c_str() );
+    return false;
+  }
+
+  const StageTotalsMap totals = collectTotals( registry );
+  const bool           isCsv  = fileName.size() >= 4 && fileName.compare( fileName.size() - 4, 4, ".csv" ) == 0;
+
+  if( isCsv )
+  {
+    fprintf( file, "scope,layer,poc,stage,type,count,time_ms\n" );
+    for( const PictureStages &picture: registry.pictures )
+    {
+      writeStagesCsv( file, picture.stages, "picture", picture.layerId, picture.poc );
+    }
+    writeStagesCsv( file, totals, "sequence", -1, -1 );
+  }
+  else
+  {
+    fprintf( file, "{\n  \"pictures\": [" );
+    for( size_t i = 0; i < registry.pictures.size(); i++ )
+    {
+      const PictureStages &picture = registry.pictures[i];
+      fprintf( file, "%s\n    { \"layer\": %d, \"poc\": %d, \"stages\": [", i ? "," : "", picture.layerId, picture.poc );
+      writeStagesJson( file, picture.stages, "      " );
+      fprintf( file, "\n    ] }" );
+    }
+    fprintf( file, "\n  ],\n  \"sequence\": [" );
+    writeStagesJson( file, totals, "    " );
+    fprintf( file, "\n  ]\n}\n" );
+  }
+
+  fclose( file );
+  return true;
+}
+
+//! \}
+
+#endif
@@ -0,0 +1,98 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     StageProfiler.h
+ *  \brief    Hierarchical scoped timers and counters for the codec stages
+ */
+
+#ifndef __STAGEPROFILER__
+#define __STAGEPROFILER__
+
+#include "CommonDef.h"
+
+#if ENABLE_STAGE_PROFILING
+#include <chrono>
+#include <string>
+#endif
+
+//! \ingroup CommonLib
+//! \{
+
+// PROFILE_STAGE( "name" ) times the rest of the enclosing scope as a child of the stage that is currently open on the
+// calling thread, PROFILE_COUNT( "name", n ) adds n to a counter below the current stage. Stage names must be string
+// literals. Both compile to nothing unless ENABLE_STAGE_PROFILING is set.
+#if ENABLE_STAGE_PROFILING
+#define PROFILE_CONCAT_( a, b )     a##b
+#define PROFILE_CONCAT( a, b )      PROFILE_CONCAT_( a, b )
+#define PROFILE_STAGE( name )       StageProfiler::ScopedStage PROFILE_CONCAT( stageProfilerScope, __LINE__ )( name )
+#define PROFILE_COUNT( name, n )    StageProfiler::count( name, n )
+#define PROFILE_FINISH_PICTURE( layerId, poc ) StageProfiler::finishPicture( layerId, poc )
+#else
+#define PROFILE_STAGE( name )                  /* do nothing */
+#define PROFILE_COUNT( name, n )               /* do nothing */
+#define PROFILE_FINISH_PICTURE( layerId, poc ) /* do nothing */
+#endif
+
+#if ENABLE_STAGE_PROFILING
+struct StageNode;
+struct ThreadProfile;
+
+class StageProfiler
+{
+public:
+  class ScopedStage
+  {
+  public:
+    explicit ScopedStage( const char *name );
+    ~ScopedStage();
+
+  private:
+    ThreadProfile                        *m_profile;
+    StageNode                            *m_node;
+    StageNode                            *m_parent;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  static void count( const char *name, uint64_t n );
+
+  // closes the statistics of one picture: everything measured on any thread since the previous call is attributed to it
+  static void finishPicture( int layerId, int poc );
+
+  // writes the per-picture and per-sequence statistics, as CSV when the file name ends in ".csv" and as JSON otherwise
+  static bool writeReport( const std::string &fileName );
+};
+#endif
+
+//! \}
+
+#endif // __STAGEPROFILER__
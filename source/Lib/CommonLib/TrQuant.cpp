@@ -159,6 +159,49 @@ template<int signedMode> void invTransformCbCr( PelBuf &resCb, PelBuf &resCr )
   }
 }
 
+template<int trSize>
+static void fwdLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, int zeroOutSize )
+{
+  TCoeff  coef;
+  TCoeff* out = dst;
+
+  for( int j = 0; j < zeroOutSize; j++ )
+  {
+    const TCoeff* srcPtr   = src;
+    const int8_t* trMatTmp = trMat;
+    coef = 0;
+    for( int i = 0; i < trSize; i++ )
+    {
+      coef += *srcPtr++ * *trMatTmp++;
+    }
+    *out++ = ( coef + 64 ) >> 7;
+    trMat += trSize;
+  }
+
+  std::fill_n( out, trSize - zeroOutSize, 0 );
+}
+
+template<int trSize>
+static void invLfnstCore( const TCoeff* src, TCoeff* dst, const int8_t* trMat, int zeroOutSize, const TCoeff outputMinimum, const TCoeff outputMaximum )
+{
+  TCoeff  resi;
+  TCoeff* out = dst;
+
+  for( int j = 0; j < trSize; j++ )
+  {
+    resi = 0;
+    const int8_t* trMatTmp = trMat;
+    const TCoeff* srcPtr   = src;
+    for( int i = 0; i < zeroOutSize; i++ )
+    {
+      resi += *srcPtr++ * *trMatTmp;
+      trMatTmp += trSize;
+    }
+    *out++ = Clip3<TCoeff>( outputMinimum, outputMaximum, ( resi + 64 ) >> 7 );
+    trMat++;
+  }
+}
+
 // ====================================================================================================================
 // TrQuant class member functions
 // ====================================================================================================================
@@ -262,6 +305,11 @@ void TrQuant::init( const Quant* otherQuant,
   m_invTx[TransType::DST7][4] = fastInverseDST7_B32;
   m_invTx[TransType::DST7][5] = nullptr;
 
+  m_fwdLfnst[0] = fwdLfnstCore<16>;
+  m_fwdLfnst[1] = fwdLfnstCore<48>;
+  m_invLfnst[0] = invLfnstCore<16>;
+  m_invLfnst[1] = invLfnstCore<48>;
+
 #ifdef TARGET_SIMD_X86
   initX86();
 #endif
@@ -270,25 +318,9 @@ void TrQuant::init( const Quant* otherQuant,
 void TrQuant::fwdLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize )
 {
   const int8_t* trMat  = ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
-  const int     trSize = ( size > 4 ) ? 48 : 16;
-  TCoeff           coef;
-  TCoeff*          out    = dst;
   assert( index < 3 );
 
-  for( int j = 0; j < zeroOutSize; j++ )
-  {
-    TCoeff*          srcPtr   = src;
-    const int8_t* trMatTmp = trMat;
-    coef = 0;
-    for( int i = 0; i < trSize; i++ )
-    {
-      coef += *srcPtr++ * *trMatTmp++;
-    }
-    *out++ = ( coef + 64 ) >> 7;
-    trMat += trSize;
-  }
-
-  std::fill_n( out, trSize - zeroOutSize, 0 );
+  m_fwdLfnst[size > 4 ? 1 : 0]( src, dst, trMat, zeroOutSize );
 }
 
 void TrQuant::invLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const uint32_t index, const uint32_t size, int zeroOutSize, const int maxLog2TrDynamicRange )
@@ -296,24 +328,9 @@ void TrQuant::invLfnstNxN( TCoeff* src, TCoeff* dst, const uint32_t mode, const
   const TCoeff    outputMinimum         = -( 1 << maxLog2TrDynamicRange );
   const TCoeff    outputMaximum         =  ( 1 << maxLog2TrDynamicRange ) - 1;
   const int8_t*   trMat                 =  ( size > 4 ) ? g_lfnst8x8[ mode ][ index ][ 0 ] : g_lfnst4x4[ mode ][ index ][ 0 ];
-  const int       trSize                =  ( size > 4 ) ? 48 : 16;
-  TCoeff          resi;
-  TCoeff*         out                   =  dst;
   assert( index < 3 );
 
-  for( int j = 0; j < trSize; j++ )
-  {
-    resi = 0;
-    const int8_t* trMatTmp = trMat;
-    TCoeff*       srcPtr   = src;
-    for( int i = 0; i < zeroOutSize; i++ )
-    {
-      resi += *srcPtr++ * *trMatTmp;
-      trMatTmp += trSize;
-    }
-    *out++ = Clip3<TCoeff>( outputMinimum, outputMaximum, ( resi + 64 ) >> 7 );
-    trMat++;
-  }
+  m_invLfnst[size > 4 ? 1 : 0]( src, dst, trMat, zeroOutSize, outputMinimum, outputMaximum );
 }
 
 uint32_t TrQuant::getLFNSTIntraMode( int wideAngPredMode )
@@ -53,6 +53,8 @@
 
 typedef void FwdTrans(const TCoeff*, TCoeff*, int, int, int, int);
 typedef void InvTrans(const TCoeff*, TCoeff*, int, int, int, int, const TCoeff, const TCoeff);
+typedef void FwdLfnst(const TCoeff*, TCoeff*, const int8_t*, int);
+typedef void InvLfnst(const TCoeff*, TCoeff*, const int8_t*, int, const TCoeff, const TCoeff);
 
 // ====================================================================================================================
 // Class definition
@@ -94,6 +96,10 @@ protected:
   EnumArray<std::array<FwdTrans*, NUM_TRANSFORM_MATRIX_SIZES>, TransType> m_fwdTx;
   EnumArray<std::array<InvTrans*, NUM_TRANSFORM_MATRIX_SIZES>, TransType> m_invTx;
 
+  // LFNST kernels, index 0: 16x16 (4x4 sub-block), index 1: 48x16 (8x8 sub-block)
+  std::array<FwdLfnst*, 2> m_fwdLfnst;
+  std::array<InvLfnst*, 2> m_invLfnst;
+
   void xFwdLfnst( const TransformUnit &tu, const ComponentID compID, const bool loadTr = false );
   void xInvLfnst( const TransformUnit &tu, const ComponentID compID );
 
@@ -125,6 +131,7 @@ public:
   DepQuant* getQuant() { return m_quant; }
   void   lambdaAdjustColorTrans(bool forward) { m_quant->lambdaAdjustColorTrans(forward); }
   void   resetStore() { m_quant->resetStore(); }
+  void   copyState( const TrQuant& other ) { m_quant->copyState( *other.m_quant ); }
 
 protected:
   TCoeff   m_tempCoeff[MAX_TB_SIZEY * MAX_TB_SIZEY];
@@ -145,6 +145,10 @@
 #define ENABLE_TRACING                                    0 // DISABLE by default (enable only when debugging, requires 15% run-time in decoding) -- see documentation in 'doc/DTrace for NextSoftware.pdf'
 #endif
 
+#ifndef ENABLE_STAGE_PROFILING
+#define ENABLE_STAGE_PROFILING                            0 // DISABLE by default, enables the hierarchical stage timers and counters of StageProfiler.h, written with --ProfileReportFile
+#endif
+
 #if ENABLE_TRACING
 #define K0149_BLOCK_STATISTICS                            1 // enables block statistics, which can be analysed with YUView (https://github.com/IENT/YUView)
 #if K0149_BLOCK_STATISTICS
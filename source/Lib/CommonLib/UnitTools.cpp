@@ -794,7 +794,7 @@ const PredictionUnit &PU::getCoLocatedLumaPU(const PredictionUnit &pu)
   Position refPos =
     topLeftPos.offset(pu.block(pu.chType).lumaSize().width >> 1, pu.block(pu.chType).lumaSize().height >> 1);
 
-  const PredictionUnit &lumaPU = pu.cu->isSepTree() ? *pu.cs->picture->cs->getPU(refPos, ChannelType::LUMA)
+  const PredictionUnit &lumaPU = pu.cu->isSepTree() ? *pu.cs->getTopLevelCS().getPU(refPos, ChannelType::LUMA)
                                                     : *pu.cs->getPU(topLeftPos, ChannelType::LUMA);
 
   return lumaPU;
@@ -1834,7 +1834,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList &eRefPicList
   }
   RefPicList eColRefPicList = slice.getCheckLDC() ? eRefPicList : RefPicList(slice.getColFromL0Flag());
 
-  const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
+  const ColMotionInfo mi = pColPic->cs->getColMotionInfo(pos);
 
   if( !mi.isInter )
   {
@@ -3899,7 +3899,7 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx &mrgCtx, c
   centerPos = Position{ PosType(centerPos.x & mask), PosType(centerPos.y & mask) };
 
   // derivation of center motion parameters from the collocated CU
-  const MotionInfo &mi = pColPic->cs->getMotionInfo(centerPos);
+  const ColMotionInfo mi = pColPic->cs->getColMotionInfo(centerPos);
 
   if (mi.isInter && mi.isIBCmot == false)
   {
@@ -3954,7 +3954,7 @@ bool PU::getInterMergeSubPuMvpCand(const PredictionUnit &pu, MergeCtx &mrgCtx, c
 
         colPos = Position{ PosType(colPos.x & mask), PosType(colPos.y & mask) };
 
-        const MotionInfo &colMi = pColPic->cs->getMotionInfo(colPos);
+        const ColMotionInfo colMi = pColPic->cs->getColMotionInfo(colPos);
 
         MotionInfo mi;
 
@@ -102,7 +102,8 @@ std::vector<std::string> split( const std::string &s, char delim )
   return elems;
 }
 
-CDTrace::CDTrace(const char *filename, vstring channel_names) : copy(false), m_trace_file(nullptr), m_error_code(0)
+CDTrace::CDTrace(const char *filename, vstring channel_names)
+  : copy(false), m_trace_file(nullptr), m_error_code(0), m_hasRules(false)
 {
   if (filename)
   {
@@ -118,7 +119,7 @@ CDTrace::CDTrace(const char *filename, vstring channel_names) : copy(false), m_t
 }
 
 CDTrace::CDTrace(const char *filename, const dtrace_channels_t &channels)
-  : copy(false), m_trace_file(nullptr), m_error_code(0)
+  : copy(false), m_trace_file(nullptr), m_error_code(0), m_hasRules(false)
 {
   if( filename )
   {
@@ -142,6 +143,7 @@ CDTrace::CDTrace( const CDTrace& other )
   state                = other.state;
   deserializationTable = other.deserializationTable;
   m_error_code         = other.m_error_code;
+  m_hasRules           = other.m_hasRules;
 }
 
 CDTrace::CDTrace( const std::string& sTracingFile, const std::string& sTracingRule, const dtrace_channels_t& channels )
@@ -165,6 +167,8 @@ void CDTrace::swap( CDTrace& other )
   swap(first.condition_types, second.condition_types);
   swap(first.state, second.state);
   swap(first.deserializationTable, second.deserializationTable);
+  swap(first.m_error_code, second.m_error_code);
+  swap(first.m_hasRules, second.m_hasRules);
 }
 
 CDTrace& CDTrace::operator=( const CDTrace& other )
@@ -254,6 +258,7 @@ int CDTrace::addRule( std::string rulestring )
     if (ichan != deserializationTable.end())
     {
       chanRules[ichan->second].add(rule);
+      m_hasRules = true;
     }
     else
     {
@@ -102,6 +102,7 @@ private:
     bool          copy;
     FILE         *m_trace_file;
     int           m_error_code;
+    bool          m_hasRules;
 
     typedef std::string Key;
     typedef std::vector<std::string> vstring;
@@ -112,7 +113,7 @@ private:
     std::map< Key, int > deserializationTable;
 
 public:
-  CDTrace() : copy(false), m_trace_file(nullptr) {}
+  CDTrace() : copy(false), m_trace_file(nullptr), m_error_code(0), m_hasRules(false) {}
   CDTrace(const char *filename, vstring channel_names);
   CDTrace(const char *filename, const dtrace_channels_t &channels);
   CDTrace(const std::string &sTracingFile, const std::string &sTracingRule, const dtrace_channels_t &channels);
@@ -145,6 +146,8 @@ public:
     bool update       ( state_type stateval );
     int  init( vstring channel_names );
     int  getLastError() { return m_error_code;  }
+    // true if a trace file is open and at least one channel has a rule, i.e. if any output can be produced at all
+    bool isTracing() const { return m_trace_file != nullptr && m_hasRules; }
     const char*  getChannelName( int channel_number );
     void getChannelsList( std::string& sChannels );
     std::string getErrMessage();
@@ -518,6 +518,11 @@ void writeBlockStatisticsHeader(const SPS *sps)
 
 void getAndStoreBlockStatistics(const CodingStructure& cs, const UnitArea& ctuArea)
 {
+  if (!DTRACE_ACTIVE(g_trace_ctx))
+  {
+    return;
+  }
+
   // two differemt behaviors, depending on which information is needed
   bool writeAll =   g_trace_ctx->isChannelActive( D_BLOCK_STATISTICS_ALL);
   bool writeCoded =   g_trace_ctx->isChannelActive( D_BLOCK_STATISTICS_CODED);
@@ -192,16 +192,16 @@ inline void dtraceMotField( CDTrace *trace_ctx, const PredictionUnit& pu )
   }
 }
 
-#define DTRACE_PEL_BUF(...)              dtracePelBuf( __VA_ARGS__ )
-#define DTRACE_COEFF_BUF(...)            dtraceCoeffBuf( __VA_ARGS__ )
-#define DTRACE_BLOCK_REC(...)            dtraceBlockRec( __VA_ARGS__ )
-#define DTRACE_PEL_BUF_COND(_cond,...)   { if((_cond)) dtracePelBuf( __VA_ARGS__ ); }
-#define DTRACE_COEFF_BUF_COND(_cond,...) { if((_cond)) dtraceCoeffBuf( __VA_ARGS__ ); }
-#define DTRACE_BLOCK_REC_COND(_cond,...) { if((_cond)) dtraceBlockRec( __VA_ARGS__ ); }
-#define DTRACE_UNIT_COMP(...)            dtraceUnitComp( __VA_ARGS__ )
-#define DTRACE_CRC(...)                  dtraceCRC( __VA_ARGS__ )
-#define DTRACE_CCRC(...)                 dtraceCCRC( __VA_ARGS__ )
-#define DTRACE_MOT_FIELD(...)            dtraceMotField( __VA_ARGS__ )
+#define DTRACE_PEL_BUF(...)              ( DTRACE_ACTIVE( g_trace_ctx ) ? dtracePelBuf( __VA_ARGS__ ) : void() )
+#define DTRACE_COEFF_BUF(...)            ( DTRACE_ACTIVE( g_trace_ctx ) ? dtraceCoeffBuf( __VA_ARGS__ ) : void() )
+#define DTRACE_BLOCK_REC(...)            ( DTRACE_ACTIVE( g_trace_ctx ) ? dtraceBlockRec( __VA_ARGS__ ) : void() )
+#define DTRACE_PEL_BUF_COND(_cond,...)   { if( DTRACE_ACTIVE( g_trace_ctx ) && (_cond) ) dtracePelBuf( __VA_ARGS__ ); }
+#define DTRACE_COEFF_BUF_COND(_cond,...) { if( DTRACE_ACTIVE( g_trace_ctx ) && (_cond) ) dtraceCoeffBuf( __VA_ARGS__ ); }
+#define DTRACE_BLOCK_REC_COND(_cond,...) { if( DTRACE_ACTIVE( g_trace_ctx ) && (_cond) ) dtraceBlockRec( __VA_ARGS__ ); }
+#define DTRACE_UNIT_COMP(...)            ( DTRACE_ACTIVE( g_trace_ctx ) ? dtraceUnitComp( __VA_ARGS__ ) : void() )
+#define DTRACE_CRC(ctx,...)              ( DTRACE_ACTIVE( ctx ) ? dtraceCRC( ctx, __VA_ARGS__ ) : void() )
+#define DTRACE_CCRC(ctx,...)             ( DTRACE_ACTIVE( ctx ) ? dtraceCCRC( ctx, __VA_ARGS__ ) : void() )
+#define DTRACE_MOT_FIELD(ctx,...)        ( DTRACE_ACTIVE( ctx ) ? dtraceMotField( ctx, __VA_ARGS__ ) : void() )
 
 #else
 
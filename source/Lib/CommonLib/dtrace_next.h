@@ -192,14 +192,17 @@ void dtrace_frame_blockwise( CDTrace *trace_ctx, DTRACE_CHANNEL channel, Tsrc *b
   }
 }
 
-#define DTRACE(ctx,channel,...)              ctx->dtrace<true>( channel, __VA_ARGS__ )
-#define DTRACE_WITHOUT_COUNT(ctx,channel,...) ctx->dtrace<false>( channel, __VA_ARGS__ )
+// The output macros test DTRACE_ACTIVE before evaluating their arguments, so that a tracing build run without trace
+// file or trace rule skips the formatting calls and the checksums of the trace output.
+#define DTRACE_ACTIVE(ctx)                   ( (ctx) != nullptr && (ctx)->isTracing() )
+#define DTRACE(ctx,channel,...)              ( DTRACE_ACTIVE( ctx ) ? (ctx)->dtrace<true>( channel, __VA_ARGS__ ) : void() )
+#define DTRACE_WITHOUT_COUNT(ctx,channel,...) ( DTRACE_ACTIVE( ctx ) ? (ctx)->dtrace<false>( channel, __VA_ARGS__ ) : void() )
 #define DTRACE_DECR_COUNTER(ctx,channel)     ctx->decrementChannelCounter( channel )
 #define DTRACE_UPDATE(ctx,s)                 if((ctx)){(ctx)->update((s));}
-#define DTRACE_REPEAT(ctx,channel,times,...) ctx->dtrace_repeat( channel, times,__VA_ARGS__ )
-#define DTRACE_COND(cond,ctx,channel,...)    { if( cond ) ctx->dtrace<true>( channel, __VA_ARGS__ ); }
-#define DTRACE_BLOCK(...)                    dtrace_block(__VA_ARGS__)
-#define DTRACE_FRAME_BLOCKWISE(...)          dtrace_frame_blockwise(__VA_ARGS__)
+#define DTRACE_REPEAT(ctx,channel,times,...) ( DTRACE_ACTIVE( ctx ) ? (ctx)->dtrace_repeat( channel, times, __VA_ARGS__ ) : void() )
+#define DTRACE_COND(cond,ctx,channel,...)    { if( DTRACE_ACTIVE( ctx ) && ( cond ) ) (ctx)->dtrace<true>( channel, __VA_ARGS__ ); }
+#define DTRACE_BLOCK(ctx,...)                ( DTRACE_ACTIVE( ctx ) ? dtrace_block( ctx, __VA_ARGS__ ) : void() )
+#define DTRACE_FRAME_BLOCKWISE(ctx,...)      ( DTRACE_ACTIVE( ctx ) ? dtrace_frame_blockwise( ctx, __VA_ARGS__ ) : void() )
 #define DTRACE_GET_COUNTER(ctx,channel)      ctx->getChannelCounter(channel)
 
 #include "CommonLib/Rom.h"
@@ -268,6 +271,7 @@ inline CDTrace* tracing_init( std::string& sTracingFile, std::string& sTracingRu
 
 #else
 
+#define DTRACE_ACTIVE(ctx)                   false
 #define DTRACE(ctx,channel,...)
 #define DTRACE_WITHOUT_COUNT(ctx,channel,...)
 #define DTRACE_DECR_COUNTER(ctx,channel)
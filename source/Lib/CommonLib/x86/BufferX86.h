@@ -232,6 +232,135 @@ template<X86_VEXT vext> void paddingSimd(Pel *dst, ptrdiff_t stride, int width,
   }
 }
 
+template<X86_VEXT vext>
+void copyPadded_SIMD(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                     int padSize)
+{
+  if (width < 8)
+  {
+    copyPaddedCore(src, srcStride, dst, dstStride, width, height, padSize);
+    return;
+  }
+
+  Pel *dstRow = dst;
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      if (x > width - 8)
+      {
+        x = width - 8;
+      }
+      _mm_storeu_si128((__m128i *) (dstRow + x), _mm_loadu_si128((const __m128i *) (src + x)));
+    }
+    for (int j = 1; j <= padSize; j++)
+    {
+      dstRow[-j]            = src[0];
+      dstRow[width - 1 + j] = src[width - 1];
+    }
+    src += srcStride;
+    dstRow += dstStride;
+  }
+
+  const int  extWidth = width + 2 * padSize;
+  const Pel *top      = dst - padSize;
+  const Pel *bottom   = dst + (height - 1) * dstStride - padSize;
+  for (int x = 0; x < extWidth; x += 8)
+  {
+    if (x > extWidth - 8)
+    {
+      x = extWidth - 8;
+    }
+    const __m128i topVal    = _mm_loadu_si128((const __m128i *) (top + x));
+    const __m128i bottomVal = _mm_loadu_si128((const __m128i *) (bottom + x));
+    for (int i = 1; i <= padSize; i++)
+    {
+      _mm_storeu_si128((__m128i *) (top - i * dstStride + x), topVal);
+      _mm_storeu_si128((__m128i *) (bottom + i * dstStride + x), bottomVal);
+    }
+  }
+}
+
+template<X86_VEXT vext>
+void dmvrIntegerSad_SIMD(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                         int height, Distortion sad[DMVR_AREA])
+{
+  if (width & 7)
+  {
+    dmvrIntegerSadCore(src0, src0Stride, src1, src1Stride, width, height, sad);
+    return;
+  }
+
+  // The offsets are processed one vertical offset at a time, accumulating the SADs of all horizontal offsets side by
+  // side while the rows are in the registers. The absolute differences fit 16 bit and are summed in 32-bit lanes.
+  for (int v = -DMVR_RANGE; v <= DMVR_RANGE; v++)
+  {
+    const Pel *p0 = src0 + v * src0Stride;
+    const Pel *p1 = src1 - v * src1Stride;
+
+    __m128i acc[DMVR_SPAN];
+#ifdef USE_AVX2
+    if ((width & 15) == 0)
+    {
+      const __m256i vone = _mm256_set1_epi16(1);
+      __m256i       acc2[DMVR_SPAN];
+      for (int k = 0; k < DMVR_SPAN; k++)
+      {
+        acc2[k] = _mm256_setzero_si256();
+      }
+      for (int y = 0; y < height; y += 2)
+      {
+        for (int x = 0; x < width; x += 16)
+        {
+          for (int h = -DMVR_RANGE; h <= DMVR_RANGE; h++)
+          {
+            const __m256i d = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *) (p0 + x + h)),
+                                               _mm256_loadu_si256((const __m256i *) (p1 + x - h)));
+            acc2[h + DMVR_RANGE] =
+              _mm256_add_epi32(acc2[h + DMVR_RANGE], _mm256_madd_epi16(_mm256_abs_epi16(d), vone));
+          }
+        }
+        p0 += 2 * src0Stride;
+        p1 += 2 * src1Stride;
+      }
+      for (int k = 0; k < DMVR_SPAN; k++)
+      {
+        acc[k] = _mm_add_epi32(_mm256_castsi256_si128(acc2[k]), _mm256_extracti128_si256(acc2[k], 1));
+      }
+    }
+    else
+#endif
+    {
+      const __m128i vone = _mm_set1_epi16(1);
+      for (int k = 0; k < DMVR_SPAN; k++)
+      {
+        acc[k] = _mm_setzero_si128();
+      }
+      for (int y = 0; y < height; y += 2)
+      {
+        for (int x = 0; x < width; x += 8)
+        {
+          for (int h = -DMVR_RANGE; h <= DMVR_RANGE; h++)
+          {
+            const __m128i d = _mm_sub_epi16(_mm_loadu_si128((const __m128i *) (p0 + x + h)),
+                                            _mm_loadu_si128((const __m128i *) (p1 + x - h)));
+            acc[h + DMVR_RANGE] = _mm_add_epi32(acc[h + DMVR_RANGE], _mm_madd_epi16(_mm_abs_epi16(d), vone));
+          }
+        }
+        p0 += 2 * src0Stride;
+        p1 += 2 * src1Stride;
+      }
+    }
+
+    for (int k = 0; k < DMVR_SPAN; k++)
+    {
+      __m128i sum = _mm_add_epi32(acc[k], _mm_shuffle_epi32(acc[k], 0x4e));
+      sum         = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+      sad[(v + DMVR_RANGE) * DMVR_SPAN + k] = Distortion(uint32_t(_mm_cvtsi128_si32(sum)));
+    }
+  }
+}
+
 template<X86_VEXT vext>
 void addBIOAvg4_SSE(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, Pel *dst,
                     ptrdiff_t dstStride, const Pel *gradX0, const Pel *gradX1, const Pel *gradY0, const Pel *gradY1,
@@ -351,142 +480,136 @@ void calcBIOSums_SSE(const Pel *srcY0Tmp, const Pel *srcY1Tmp, Pel *gradX0, Pel
 
 template<X86_VEXT vext>
 void applyPROF_SSE(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrdiff_t srcStride, int width, int height,
-                   const Pel *gradX, const Pel *gradY, ptrdiff_t gradStride, const int *dMvX, const int *dMvY,
-                   ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset, const ClpRng &clpRng)
+                   const int *dMvX, const int *dMvY, ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset,
+                   const ClpRng &clpRng)
 {
   CHECKD((width & 3), "block width error!");
+  CHECKD((height & 1), "block height error!");
 
   const int dILimit = 1 << std::max<int>(clpRng.bd + 1, 13);
+  const int shift1  = 6;
 
+  // gradients and the clipped dMv * gradient products are computed in 16 bits and combined with madd, the sample
+  // offsets being limited to [-31, 31]
 #ifdef USE_AVX2
-  __m256i mm_dmvx, mm_dmvy, mm_gradx, mm_grady, mm_dI, mm_dI0, mm_src;
-  __m256i mm_offset = _mm256_set1_epi16(offset);
-  __m256i vibdimin = _mm256_set1_epi16(clpRng.min);
-  __m256i vibdimax = _mm256_set1_epi16(clpRng.max);
-  __m256i mm_dimin = _mm256_set1_epi32(-dILimit);
-  __m256i mm_dimax = _mm256_set1_epi32(dILimit - 1);
-#else
-  __m128i mm_dmvx, mm_dmvy, mm_gradx, mm_grady, mm_dI, mm_dI0;
-  __m128i mm_offset = _mm_set1_epi16(offset);
-  __m128i vibdimin = _mm_set1_epi16(clpRng.min);
-  __m128i vibdimax = _mm_set1_epi16(clpRng.max);
-  __m128i mm_dimin = _mm_set1_epi32(-dILimit);
-  __m128i mm_dimax = _mm_set1_epi32(dILimit - 1);
-#endif
-
-#if USE_AVX2
-  for (int h = 0; h < height; h += 4)
-#else
-  for (int h = 0; h < height; h += 2)
-#endif
+  if (vext >= AVX2 && (height & 3) == 0)
   {
-    const int* vX = dMvX;
-    const int* vY = dMvY;
-    const Pel* gX = gradX;
-    const Pel* gY = gradY;
-    const Pel* src = srcPel;
-    Pel*       dst = dstPel;
+    // four rows of four samples, rows 0 and 1 in the low lane and rows 2 and 3 in the high lane
+    auto loadRows = [](const Pel *p, ptrdiff_t stride)
+    {
+      const __m128i r01 =
+        _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) p), _mm_loadl_epi64((const __m128i *) (p + stride)));
+      const __m128i r23 = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (p + 2 * stride)),
+                                             _mm_loadl_epi64((const __m128i *) (p + 3 * stride)));
+      return _mm256_inserti128_si256(_mm256_castsi128_si256(r01), r23, 1);
+    };
+    auto loadDMv = [dMvStride](const int *v)
+    {
+      const __m256i r02 = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) v)),
+                                                  _mm_loadu_si128((const __m128i *) (v + 2 * dMvStride)), 1);
+      const __m256i r13 = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (v + dMvStride))),
+        _mm_loadu_si128((const __m128i *) (v + 3 * dMvStride)), 1);
+      return _mm256_packs_epi32(r02, r13);
+    };
 
-    for (int w = 0; w < width; w += 4)
+    const __m256i mm_offset = _mm256_set1_epi16(offset);
+    const __m256i vibdimin  = _mm256_set1_epi16(clpRng.min);
+    const __m256i vibdimax  = _mm256_set1_epi16(clpRng.max);
+    const __m256i mm_dimin  = _mm256_set1_epi32(-dILimit);
+    const __m256i mm_dimax  = _mm256_set1_epi32(dILimit - 1);
+
+    for (int h = 0; h < height; h += 4)
     {
-#if USE_AVX2
-      const int *vX0 = vX, *vY0 = vY;
-      const Pel *gX0 = gX, *gY0 = gY;
-
-      // first two rows
-      mm_dmvx = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)vX0)), _mm_loadu_si128((const __m128i *)(vX0 + dMvStride)), 1);
-      mm_dmvy = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)vY0)), _mm_loadu_si128((const __m128i *)(vY0 + dMvStride)), 1);
-      mm_gradx = _mm256_inserti128_si256(
-        _mm256_castsi128_si256(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)gX0))),
-        _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(gX0 + gradStride))), 1);
-      mm_grady = _mm256_inserti128_si256(
-        _mm256_castsi128_si256(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)gY0))),
-        _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(gY0 + gradStride))), 1);
-      mm_dI0 = _mm256_add_epi32(_mm256_mullo_epi32(mm_dmvx, mm_gradx), _mm256_mullo_epi32(mm_dmvy, mm_grady));
-      mm_dI0 = _mm256_min_epi32(mm_dimax, _mm256_max_epi32(mm_dimin, mm_dI0));
-
-      // next two rows
-      vX0 += (dMvStride << 1); vY0 += (dMvStride << 1); gX0 += (gradStride << 1); gY0 += (gradStride << 1);
-      mm_dmvx = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)vX0)), _mm_loadu_si128((const __m128i *)(vX0 + dMvStride)), 1);
-      mm_dmvy = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)vY0)), _mm_loadu_si128((const __m128i *)(vY0 + dMvStride)), 1);
-      mm_gradx = _mm256_inserti128_si256(
-        _mm256_castsi128_si256(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)gX0))),
-        _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(gX0 + gradStride))), 1);
-      mm_grady = _mm256_inserti128_si256(
-        _mm256_castsi128_si256(_mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)gY0))),
-        _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(gY0 + gradStride))), 1);
-      mm_dI = _mm256_add_epi32(_mm256_mullo_epi32(mm_dmvx, mm_gradx), _mm256_mullo_epi32(mm_dmvy, mm_grady));
-      mm_dI = _mm256_min_epi32(mm_dimax, _mm256_max_epi32(mm_dimin, mm_dI));
-
-      // combine four rows
-      mm_dI = _mm256_packs_epi32(mm_dI0, mm_dI);
-      const Pel* src0 = src + srcStride;
-      mm_src = _mm256_inserti128_si256(
-        _mm256_castsi128_si256(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)src), _mm_loadl_epi64((const __m128i *)(src + (srcStride << 1))))),
-        _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)src0), _mm_loadl_epi64((const __m128i *)(src0 + (srcStride << 1)))),
-        1
-      );
-      mm_dI = _mm256_add_epi16(mm_dI, mm_src);
-      if (!bi)
+      for (int w = 0; w < width; w += 4)
       {
-        mm_dI = _mm256_srai_epi16(_mm256_adds_epi16(mm_dI, mm_offset), shiftNum);
-        mm_dI = _mm256_min_epi16(vibdimax, _mm256_max_epi16(vibdimin, mm_dI));
+        const Pel *src = srcPel + w;
+
+        const __m256i mm_gradx = _mm256_sub_epi16(_mm256_srai_epi16(loadRows(src + 1, srcStride), shift1),
+                                                  _mm256_srai_epi16(loadRows(src - 1, srcStride), shift1));
+        const __m256i mm_grady = _mm256_sub_epi16(_mm256_srai_epi16(loadRows(src + srcStride, srcStride), shift1),
+                                                  _mm256_srai_epi16(loadRows(src - srcStride, srcStride), shift1));
+        const __m256i mm_dmvx  = loadDMv(dMvX + w);
+        const __m256i mm_dmvy  = loadDMv(dMvY + w);
+
+        __m256i mm_dI0 = _mm256_madd_epi16(_mm256_unpacklo_epi16(mm_gradx, mm_grady),
+                                           _mm256_unpacklo_epi16(mm_dmvx, mm_dmvy));
+        __m256i mm_dI1 = _mm256_madd_epi16(_mm256_unpackhi_epi16(mm_gradx, mm_grady),
+                                           _mm256_unpackhi_epi16(mm_dmvx, mm_dmvy));
+        mm_dI0         = _mm256_min_epi32(mm_dimax, _mm256_max_epi32(mm_dimin, mm_dI0));
+        mm_dI1         = _mm256_min_epi32(mm_dimax, _mm256_max_epi32(mm_dimin, mm_dI1));
+
+        __m256i mm_dI = _mm256_add_epi16(loadRows(src, srcStride), _mm256_packs_epi32(mm_dI0, mm_dI1));
+        if (!bi)
+        {
+          mm_dI = _mm256_srai_epi16(_mm256_adds_epi16(mm_dI, mm_offset), shiftNum);
+          mm_dI = _mm256_min_epi16(vibdimax, _mm256_max_epi16(vibdimin, mm_dI));
+        }
+
+        const __m128i dI01 = _mm256_castsi256_si128(mm_dI);
+        const __m128i dI23 = _mm256_extracti128_si256(mm_dI, 1);
+        Pel          *dst  = dstPel + w;
+        _mm_storel_epi64((__m128i *) dst, dI01);
+        _mm_storel_epi64((__m128i *) (dst + dstStride), _mm_unpackhi_epi64(dI01, dI01));
+        _mm_storel_epi64((__m128i *) (dst + 2 * dstStride), dI23);
+        _mm_storel_epi64((__m128i *) (dst + 3 * dstStride), _mm_unpackhi_epi64(dI23, dI23));
       }
 
-      // store final results
-      __m128i dITmp = _mm256_extractf128_si256(mm_dI, 1);
-      Pel* dst0 = dst;
-      _mm_storel_epi64((__m128i *)dst0, _mm256_castsi256_si128(mm_dI));
-      dst0 += dstStride; _mm_storel_epi64((__m128i *)dst0, dITmp);
-      dst0 += dstStride; _mm_storel_epi64((__m128i *)dst0, _mm_unpackhi_epi64(_mm256_castsi256_si128(mm_dI), _mm256_castsi256_si128(mm_dI)));
-      dst0 += dstStride; _mm_storel_epi64((__m128i *)dst0, _mm_unpackhi_epi64(dITmp, dITmp));
-#else
-      // first row
-      mm_dmvx = _mm_loadu_si128((const __m128i *)vX);
-      mm_dmvy = _mm_loadu_si128((const __m128i *)vY);
-      mm_gradx = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)gX));
-      mm_grady = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)gY));
-      mm_dI0 = _mm_add_epi32(_mm_mullo_epi32(mm_dmvx, mm_gradx), _mm_mullo_epi32(mm_dmvy, mm_grady));
-      mm_dI0 = _mm_min_epi32(mm_dimax, _mm_max_epi32(mm_dimin, mm_dI0));
-
-      // second row
-      mm_dmvx = _mm_loadu_si128((const __m128i *)(vX + dMvStride));
-      mm_dmvy = _mm_loadu_si128((const __m128i *)(vY + dMvStride));
-      mm_gradx = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(gX + gradStride)));
-      mm_grady = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i*)(gY + gradStride)));
-      mm_dI = _mm_add_epi32(_mm_mullo_epi32(mm_dmvx, mm_gradx), _mm_mullo_epi32(mm_dmvy, mm_grady));
-      mm_dI = _mm_min_epi32(mm_dimax, _mm_max_epi32(mm_dimin, mm_dI));
-
-      // combine both rows
-      mm_dI = _mm_packs_epi32(mm_dI0, mm_dI);
-      mm_dI = _mm_add_epi16(_mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *)src), _mm_loadl_epi64((const __m128i *)(src + srcStride))), mm_dI);
+      dMvX += 4 * dMvStride;
+      dMvY += 4 * dMvStride;
+      srcPel += 4 * srcStride;
+      dstPel += 4 * dstStride;
+    }
+    return;
+  }
+#endif
+
+  // two rows of four samples
+  auto loadRows = [srcStride](const Pel *p)
+  { return _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) p), _mm_loadl_epi64((const __m128i *) (p + srcStride))); };
+
+  const __m128i mm_offset = _mm_set1_epi16(offset);
+  const __m128i vibdimin  = _mm_set1_epi16(clpRng.min);
+  const __m128i vibdimax  = _mm_set1_epi16(clpRng.max);
+  const __m128i mm_dimin  = _mm_set1_epi32(-dILimit);
+  const __m128i mm_dimax  = _mm_set1_epi32(dILimit - 1);
+
+  for (int h = 0; h < height; h += 2)
+  {
+    for (int w = 0; w < width; w += 4)
+    {
+      const Pel *src = srcPel + w;
+
+      const __m128i mm_gradx =
+        _mm_sub_epi16(_mm_srai_epi16(loadRows(src + 1), shift1), _mm_srai_epi16(loadRows(src - 1), shift1));
+      const __m128i mm_grady = _mm_sub_epi16(_mm_srai_epi16(loadRows(src + srcStride), shift1),
+                                             _mm_srai_epi16(loadRows(src - srcStride), shift1));
+      const __m128i mm_dmvx  = _mm_packs_epi32(_mm_loadu_si128((const __m128i *) (dMvX + w)),
+                                               _mm_loadu_si128((const __m128i *) (dMvX + dMvStride + w)));
+      const __m128i mm_dmvy  = _mm_packs_epi32(_mm_loadu_si128((const __m128i *) (dMvY + w)),
+                                               _mm_loadu_si128((const __m128i *) (dMvY + dMvStride + w)));
+
+      __m128i mm_dI0 = _mm_madd_epi16(_mm_unpacklo_epi16(mm_gradx, mm_grady), _mm_unpacklo_epi16(mm_dmvx, mm_dmvy));
+      __m128i mm_dI1 = _mm_madd_epi16(_mm_unpackhi_epi16(mm_gradx, mm_grady), _mm_unpackhi_epi16(mm_dmvx, mm_dmvy));
+      mm_dI0         = _mm_min_epi32(mm_dimax, _mm_max_epi32(mm_dimin, mm_dI0));
+      mm_dI1         = _mm_min_epi32(mm_dimax, _mm_max_epi32(mm_dimin, mm_dI1));
+
+      __m128i mm_dI = _mm_add_epi16(loadRows(src), _mm_packs_epi32(mm_dI0, mm_dI1));
       if (!bi)
       {
         mm_dI = _mm_srai_epi16(_mm_adds_epi16(mm_dI, mm_offset), shiftNum);
         mm_dI = _mm_min_epi16(vibdimax, _mm_max_epi16(vibdimin, mm_dI));
       }
 
-      _mm_storel_epi64((__m128i *)dst, mm_dI);
-      _mm_storel_epi64((__m128i *)(dst + dstStride), _mm_unpackhi_epi64(mm_dI, mm_dI));
-#endif
-      vX += 4; vY += 4; gX += 4; gY += 4; src += 4; dst += 4;
+      Pel *dst = dstPel + w;
+      _mm_storel_epi64((__m128i *) dst, mm_dI);
+      _mm_storel_epi64((__m128i *) (dst + dstStride), _mm_unpackhi_epi64(mm_dI, mm_dI));
     }
 
-#if USE_AVX2
-    dMvX += (dMvStride << 2);
-    dMvY += (dMvStride << 2);
-    gradX += (gradStride << 2);
-    gradY += (gradStride << 2);
-    srcPel += (srcStride << 2);
-    dstPel += (dstStride << 2);
-#else
-    dMvX += (dMvStride << 1);
-    dMvY += (dMvStride << 1);
-    gradX += (gradStride << 1);
-    gradY += (gradStride << 1);
-    srcPel += (srcStride << 1);
-    dstPel += (dstStride << 1);
-#endif
+    dMvX += 2 * dMvStride;
+    dMvY += 2 * dMvStride;
+    srcPel += 2 * srcStride;
+    dstPel += 2 * dstStride;
   }
 }
 #if RExt__HIGH_BIT_DEPTH_SUPPORT
@@ -827,11 +950,12 @@ void addBIOAvg4HBD_SIMD(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1,
 
 template<X86_VEXT vext>
 void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrdiff_t srcStride, int width, int height,
-                       const Pel *gradX, const Pel *gradY, ptrdiff_t gradStride, const int *dMvX, const int *dMvY,
-                       ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset, const ClpRng &clpRng)
+                       const int *dMvX, const int *dMvY, ptrdiff_t dMvStride, const bool bi, int shiftNum, Pel offset,
+                       const ClpRng &clpRng)
 {
   CHECKD((width & 3), "block width error!");
   const int dILimit = 1 << std::max<int>(clpRng.bd + 1, 13);
+  const int shift1  = 6;
 
 #ifdef USE_AVX2
   if (vext >= AVX2)
@@ -847,8 +971,6 @@ void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrd
     {
       const int* vX = dMvX;
       const int* vY = dMvY;
-      const Pel* gX = gradX;
-      const Pel* gY = gradY;
       const Pel* src = srcPel;
       Pel*       dst = dstPel;
 
@@ -856,10 +978,15 @@ void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrd
       {
         mm_dmvx = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)vX)), _mm_lddqu_si128((__m128i *)(vX + dMvStride)), 1);
         mm_dmvy = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)vY)), _mm_lddqu_si128((__m128i *)(vY + dMvStride)), 1);
-        mm_gradx = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)gX)), _mm_lddqu_si128((__m128i *)(gX + gradStride)), 1);
-        mm_grady = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)gY)), _mm_lddqu_si128((__m128i *)(gY + gradStride)), 1);
         mm_src = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)src)), _mm_lddqu_si128((__m128i *)(src + srcStride)), 1);
 
+        const __m256i mm_left  = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)(src - 1))), _mm_lddqu_si128((__m128i *)(src + srcStride - 1)), 1);
+        const __m256i mm_right = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)(src + 1))), _mm_lddqu_si128((__m128i *)(src + srcStride + 1)), 1);
+        const __m256i mm_above = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)(src - srcStride))), _mm_lddqu_si128((__m128i *)src), 1);
+        const __m256i mm_below = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_lddqu_si128((__m128i *)(src + srcStride))), _mm_lddqu_si128((__m128i *)(src + 2 * srcStride)), 1);
+        mm_gradx = _mm256_sub_epi32(_mm256_srai_epi32(mm_right, shift1), _mm256_srai_epi32(mm_left, shift1));
+        mm_grady = _mm256_sub_epi32(_mm256_srai_epi32(mm_below, shift1), _mm256_srai_epi32(mm_above, shift1));
+
         mm_dI = _mm256_add_epi32(_mm256_mullo_epi32(mm_dmvx, mm_gradx), _mm256_mullo_epi32(mm_dmvy, mm_grady));
         mm_dI = _mm256_min_epi32(mm_dimax, _mm256_max_epi32(mm_dimin, mm_dI));
         mm_dI = _mm256_add_epi32(mm_src, mm_dI);
@@ -872,12 +999,10 @@ void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrd
 
         _mm_storeu_si128((__m128i *)dst, _mm256_castsi256_si128(mm_dI));
         _mm_storeu_si128((__m128i *)(dst + dstStride), _mm256_castsi256_si128(_mm256_permute4x64_epi64(mm_dI, 0xee)));
-        vX += 4; vY += 4; gX += 4; gY += 4; src += 4; dst += 4;
+        vX += 4; vY += 4; src += 4; dst += 4;
       }
       dMvX += (dMvStride << 1);
       dMvY += (dMvStride << 1);
-      gradX += (gradStride << 1);
-      gradY += (gradStride << 1);
       srcPel += (srcStride << 1);
       dstPel += (dstStride << 1);
     }
@@ -896,8 +1021,6 @@ void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrd
     {
       const int* vX = dMvX;
       const int* vY = dMvY;
-      const Pel* gX = gradX;
-      const Pel* gY = gradY;
       const Pel* src = srcPel;
       Pel*       dst = dstPel;
 
@@ -905,8 +1028,10 @@ void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrd
       {
         mm_dmvx = _mm_lddqu_si128((__m128i *)vX);
         mm_dmvy = _mm_lddqu_si128((__m128i *)vY);
-        mm_gradx = _mm_lddqu_si128((__m128i*)gX);
-        mm_grady = _mm_lddqu_si128((__m128i*)gY);
+        mm_gradx = _mm_sub_epi32(_mm_srai_epi32(_mm_lddqu_si128((__m128i *)(src + 1)), shift1),
+                                 _mm_srai_epi32(_mm_lddqu_si128((__m128i *)(src - 1)), shift1));
+        mm_grady = _mm_sub_epi32(_mm_srai_epi32(_mm_lddqu_si128((__m128i *)(src + srcStride)), shift1),
+                                 _mm_srai_epi32(_mm_lddqu_si128((__m128i *)(src - srcStride)), shift1));
         mm_dI = _mm_add_epi32(_mm_mullo_epi32(mm_dmvx, mm_gradx), _mm_mullo_epi32(mm_dmvy, mm_grady));
         mm_dI = _mm_min_epi32(mm_dimax, _mm_max_epi32(mm_dimin, mm_dI));
         mm_dI = _mm_add_epi32(_mm_lddqu_si128((__m128i *)src), mm_dI);
@@ -917,12 +1042,10 @@ void applyPROFHBD_SIMD(Pel *dstPel, ptrdiff_t dstStride, const Pel *srcPel, ptrd
         }
 
         _mm_storeu_si128((__m128i *)dst, mm_dI);
-        vX += 4; vY += 4; gX += 4; gY += 4; src += 4; dst += 4;
+        vX += 4; vY += 4; src += 4; dst += 4;
       }
       dMvX += dMvStride;
       dMvY += dMvStride;
-      gradX += gradStride;
-      gradY += gradStride;
       srcPel += srcStride;
       dstPel += dstStride;
     }
@@ -1791,6 +1914,917 @@ void linTf_SSE_entry(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t ds
   }
 }
 
+#if !RExt__HIGH_BIT_DEPTH_SUPPORT
+template<X86_VEXT vext>
+void fgsScaleGrain_SIMD(Pel *dst, ptrdiff_t dstStride, const int8_t *src, ptrdiff_t srcStride, int width, int height,
+                        int scale, int shift)
+{
+  if (width & 7)
+  {
+    fgsScaleGrainCore(dst, dstStride, src, srcStride, width, height, scale, shift);
+    return;
+  }
+
+  const __m128i vshift = _mm_cvtsi32_si128(shift);
+#ifdef USE_AVX2
+  if ((width & 15) == 0)
+  {
+    const __m256i vscale = _mm256_set1_epi32(scale);
+
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x += 16)
+      {
+        const __m128i s8 = _mm_loadu_si128((const __m128i *) (src + x));
+        __m256i       lo = _mm256_cvtepi8_epi32(s8);
+        __m256i       hi = _mm256_cvtepi8_epi32(_mm_srli_si128(s8, 8));
+        lo = _mm256_sra_epi32(_mm256_mullo_epi32(lo, vscale), vshift);
+        hi = _mm256_sra_epi32(_mm256_mullo_epi32(hi, vscale), vshift);
+        _mm256_storeu_si256((__m256i *) (dst + x), _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8));
+      }
+      dst += dstStride;
+      src += srcStride;
+    }
+    return;
+  }
+#endif
+  const __m128i vscale = _mm_set1_epi32(scale);
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x += 8)
+    {
+      const __m128i s8 = _mm_loadl_epi64((const __m128i *) (src + x));
+      __m128i       lo = _mm_cvtepi8_epi32(s8);
+      __m128i       hi = _mm_cvtepi8_epi32(_mm_srli_si128(s8, 4));
+      lo = _mm_sra_epi32(_mm_mullo_epi32(lo, vscale), vshift);
+      hi = _mm_sra_epi32(_mm_mullo_epi32(hi, vscale), vshift);
+      _mm_storeu_si128((__m128i *) (dst + x), _mm_packs_epi32(lo, hi));
+    }
+    dst += dstStride;
+    src += srcStride;
+  }
+}
+
+template<X86_VEXT vext>
+uint32_t fgsBlockSum_SIMD(const Pel *src, ptrdiff_t srcStride, int width, int height)
+{
+  if (width & 7)
+  {
+    return fgsBlockSumCore(src, srcStride, width, height);
+  }
+
+  __m128i vsum = _mm_setzero_si128();
+#ifdef USE_AVX2
+  if ((width & 15) == 0)
+  {
+    const __m256i vone  = _mm256_set1_epi16(1);
+    __m256i       vsum2 = _mm256_setzero_si256();
+
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x += 16)
+      {
+        vsum2 = _mm256_add_epi32(vsum2, _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (src + x)), vone));
+      }
+      src += srcStride;
+    }
+    vsum = _mm_add_epi32(_mm256_castsi256_si128(vsum2), _mm256_extracti128_si256(vsum2, 1));
+  }
+  else
+#endif
+  {
+    const __m128i vone = _mm_set1_epi16(1);
+
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x += 8)
+      {
+        vsum = _mm_add_epi32(vsum, _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (src + x)), vone));
+      }
+      src += srcStride;
+    }
+  }
+  vsum = _mm_hadd_epi32(vsum, vsum);
+  vsum = _mm_hadd_epi32(vsum, vsum);
+  return (uint32_t) _mm_cvtsi128_si32(vsum);
+}
+
+template<X86_VEXT vext>
+void fgsBlend_SIMD(Pel *dst, ptrdiff_t dstStride, const Pel *grain, ptrdiff_t grainStride, int width, int height,
+                   int bitDepth)
+{
+  const int     maxVal = (1 << bitDepth) - 1;
+  const int     shift  = bitDepth - 8;
+  const __m128i vshift = _mm_cvtsi32_si128(shift);
+#ifdef USE_AVX2
+  const __m256i vzero2 = _mm256_setzero_si256();
+  const __m256i vmax2  = _mm256_set1_epi32(maxVal);
+#endif
+  const __m128i vzero = _mm_setzero_si128();
+  const __m128i vmax  = _mm_set1_epi32(maxVal);
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m256i d  = _mm256_loadu_si256((const __m256i *) (dst + x));
+      const __m256i g  = _mm256_loadu_si256((const __m256i *) (grain + x));
+      __m256i       lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(d));
+      __m256i       hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(d, 1));
+      lo = _mm256_add_epi32(lo, _mm256_sll_epi32(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(g)), vshift));
+      hi = _mm256_add_epi32(hi, _mm256_sll_epi32(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(g, 1)), vshift));
+      lo = _mm256_min_epi32(_mm256_max_epi32(lo, vzero2), vmax2);
+      hi = _mm256_min_epi32(_mm256_max_epi32(hi, vzero2), vmax2);
+      _mm256_storeu_si256((__m256i *) (dst + x), _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8));
+    }
+#endif
+    for (; x + 8 <= width; x += 8)
+    {
+      const __m128i d  = _mm_loadu_si128((const __m128i *) (dst + x));
+      const __m128i g  = _mm_loadu_si128((const __m128i *) (grain + x));
+      __m128i       lo = _mm_cvtepu16_epi32(d);
+      __m128i       hi = _mm_cvtepu16_epi32(_mm_srli_si128(d, 8));
+      lo = _mm_add_epi32(lo, _mm_sll_epi32(_mm_cvtepi16_epi32(g), vshift));
+      hi = _mm_add_epi32(hi, _mm_sll_epi32(_mm_cvtepi16_epi32(_mm_srli_si128(g, 8)), vshift));
+      lo = _mm_min_epi32(_mm_max_epi32(lo, vzero), vmax);
+      hi = _mm_min_epi32(_mm_max_epi32(hi, vzero), vmax);
+      _mm_storeu_si128((__m128i *) (dst + x), _mm_packus_epi32(lo, hi));
+    }
+    for (; x < width; x++)
+    {
+      dst[x] = (Pel) Clip3(0, maxVal, ((int) grain[x] << shift) + (uint16_t) dst[x]);
+    }
+    dst += dstStride;
+    grain += grainStride;
+  }
+}
+
+template<X86_VEXT vext>
+void sobel3x3_SIMD(const Pel *src, ptrdiff_t srcStride, Pel *gradVer, Pel *gradHor, ptrdiff_t gradStride, int width,
+                   int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    const Pel *above = src - srcStride;
+    const Pel *below = src + srcStride;
+
+    int x = 0;
+#ifdef USE_AVX2
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m256i aL = _mm256_loadu_si256((const __m256i *) (above + x - 1));
+      const __m256i aC = _mm256_loadu_si256((const __m256i *) (above + x));
+      const __m256i aR = _mm256_loadu_si256((const __m256i *) (above + x + 1));
+      const __m256i cL = _mm256_loadu_si256((const __m256i *) (src + x - 1));
+      const __m256i cR = _mm256_loadu_si256((const __m256i *) (src + x + 1));
+      const __m256i bL = _mm256_loadu_si256((const __m256i *) (below + x - 1));
+      const __m256i bC = _mm256_loadu_si256((const __m256i *) (below + x));
+      const __m256i bR = _mm256_loadu_si256((const __m256i *) (below + x + 1));
+
+      const __m256i sumA = _mm256_add_epi16(_mm256_add_epi16(aL, aR), _mm256_slli_epi16(aC, 1));
+      const __m256i sumB = _mm256_add_epi16(_mm256_add_epi16(bL, bR), _mm256_slli_epi16(bC, 1));
+      const __m256i sumL = _mm256_add_epi16(_mm256_add_epi16(aL, bL), _mm256_slli_epi16(cL, 1));
+      const __m256i sumR = _mm256_add_epi16(_mm256_add_epi16(aR, bR), _mm256_slli_epi16(cR, 1));
+
+      _mm256_storeu_si256((__m256i *) (gradVer + x), _mm256_sub_epi16(sumB, sumA));
+      _mm256_storeu_si256((__m256i *) (gradHor + x), _mm256_sub_epi16(sumR, sumL));
+    }
+#endif
+    for (; x + 8 <= width; x += 8)
+    {
+      const __m128i aL = _mm_loadu_si128((const __m128i *) (above + x - 1));
+      const __m128i aC = _mm_loadu_si128((const __m128i *) (above + x));
+      const __m128i aR = _mm_loadu_si128((const __m128i *) (above + x + 1));
+      const __m128i cL = _mm_loadu_si128((const __m128i *) (src + x - 1));
+      const __m128i cR = _mm_loadu_si128((const __m128i *) (src + x + 1));
+      const __m128i bL = _mm_loadu_si128((const __m128i *) (below + x - 1));
+      const __m128i bC = _mm_loadu_si128((const __m128i *) (below + x));
+      const __m128i bR = _mm_loadu_si128((const __m128i *) (below + x + 1));
+
+      const __m128i sumA = _mm_add_epi16(_mm_add_epi16(aL, aR), _mm_slli_epi16(aC, 1));
+      const __m128i sumB = _mm_add_epi16(_mm_add_epi16(bL, bR), _mm_slli_epi16(bC, 1));
+      const __m128i sumL = _mm_add_epi16(_mm_add_epi16(aL, bL), _mm_slli_epi16(cL, 1));
+      const __m128i sumR = _mm_add_epi16(_mm_add_epi16(aR, bR), _mm_slli_epi16(cR, 1));
+
+      _mm_storeu_si128((__m128i *) (gradVer + x), _mm_sub_epi16(sumB, sumA));
+      _mm_storeu_si128((__m128i *) (gradHor + x), _mm_sub_epi16(sumR, sumL));
+    }
+    for (; x < width; x++)
+    {
+      gradVer[x] = (Pel) ((below[x - 1] + 2 * below[x] + below[x + 1]) - (above[x - 1] + 2 * above[x] + above[x + 1]));
+      gradHor[x] = (Pel) ((above[x + 1] + 2 * src[x + 1] + below[x + 1]) - (above[x - 1] + 2 * src[x - 1] + below[x - 1]));
+    }
+    src += srcStride;
+    gradVer += gradStride;
+    gradHor += gradStride;
+  }
+}
+
+template<X86_VEXT vext>
+void morph3x3_SIMD(const Pel *src, ptrdiff_t srcStride, Pel *dst, ptrdiff_t dstStride, int width, int height,
+                   Pel matchVal)
+{
+#ifdef USE_AVX2
+  const __m256i vmatch2 = _mm256_set1_epi16(matchVal);
+#endif
+  const __m128i vmatch = _mm_set1_epi16(matchVal);
+
+  for (int y = 0; y < height; y++)
+  {
+    const Pel *rows[3] = { src - srcStride, src, src + srcStride };
+
+    int x = 0;
+#ifdef USE_AVX2
+    for (; x + 16 <= width; x += 16)
+    {
+      __m256i match = _mm256_setzero_si256();
+      for (int r = 0; r < 3; r++)
+      {
+        for (int k = -1; k <= 1; k++)
+        {
+          match = _mm256_or_si256(
+            match, _mm256_cmpeq_epi16(_mm256_loadu_si256((const __m256i *) (rows[r] + x + k)), vmatch2));
+        }
+      }
+      const __m256i cur = _mm256_loadu_si256((const __m256i *) (src + x));
+      _mm256_storeu_si256((__m256i *) (dst + x), _mm256_blendv_epi8(cur, vmatch2, match));
+    }
+#endif
+    for (; x + 8 <= width; x += 8)
+    {
+      __m128i match = _mm_setzero_si128();
+      for (int r = 0; r < 3; r++)
+      {
+        for (int k = -1; k <= 1; k++)
+        {
+          match = _mm_or_si128(match, _mm_cmpeq_epi16(_mm_loadu_si128((const __m128i *) (rows[r] + x + k)), vmatch));
+        }
+      }
+      const __m128i cur = _mm_loadu_si128((const __m128i *) (src + x));
+      _mm_storeu_si128((__m128i *) (dst + x), _mm_blendv_epi8(cur, vmatch, match));
+    }
+    for (; x < width; x++)
+    {
+      bool match = false;
+      for (int k = -1; k <= 1; k++)
+      {
+        match |= rows[0][x + k] == matchVal || rows[1][x + k] == matchVal || rows[2][x + k] == matchVal;
+      }
+      dst[x] = match ? matchVal : src[x];
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext>
+void sumAndSumSq_SIMD(const Pel *src, ptrdiff_t srcStride, int width, int height, int64_t &sum, int64_t &sumSq)
+{
+  if (width & 7)
+  {
+    sumAndSumSqCore(src, srcStride, width, height, sum, sumSq);
+    return;
+  }
+
+  const __m128i vone   = _mm_set1_epi16(1);
+  __m128i       vsum   = _mm_setzero_si128();
+  __m128i       vsumSq = _mm_setzero_si128();
+
+  for (int y = 0; y < height; y++)
+  {
+    __m128i rowSum = _mm_setzero_si128();
+    for (int x = 0; x < width; x += 8)
+    {
+      const __m128i v  = _mm_loadu_si128((const __m128i *) (src + x));
+      const __m128i sq = _mm_madd_epi16(v, v);
+      rowSum           = _mm_add_epi32(rowSum, _mm_madd_epi16(v, vone));
+      vsumSq = _mm_add_epi64(vsumSq, _mm_add_epi64(_mm_cvtepu32_epi64(sq), _mm_cvtepu32_epi64(_mm_srli_si128(sq, 8))));
+    }
+    vsum = _mm_add_epi64(vsum, _mm_add_epi64(_mm_cvtepi32_epi64(rowSum), _mm_cvtepi32_epi64(_mm_srli_si128(rowSum, 8))));
+    src += srcStride;
+  }
+
+  sum   = _mm_cvtsi128_si64(vsum) + _mm_extract_epi64(vsum, 1);
+  sumSq = _mm_cvtsi128_si64(vsumSq) + _mm_extract_epi64(vsumSq, 1);
+}
+
+template<X86_VEXT vext>
+void unpackSamples8_SIMD(const uint8_t *src, Pel *dst, int width)
+{
+  int x = 0;
+#ifdef USE_AVX2
+  for (; x + 16 <= width; x += 16)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i *) (src + x));
+    _mm256_storeu_si256((__m256i *) (dst + x), _mm256_cvtepu8_epi16(v));
+  }
+#endif
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i v = _mm_loadl_epi64((const __m128i *) (src + x));
+    _mm_storeu_si128((__m128i *) (dst + x), _mm_cvtepu8_epi16(v));
+  }
+  for (; x < width; x++)
+  {
+    dst[x] = src[x];
+  }
+}
+
+template<X86_VEXT vext>
+void unpackSamples16_SIMD(const uint8_t *src, Pel *dst, int width)
+{
+  // x86 is little endian, so the file samples have the memory layout of Pel
+  int x = 0;
+#ifdef USE_AVX2
+  for (; x + 16 <= width; x += 16)
+  {
+    _mm256_storeu_si256((__m256i *) (dst + x), _mm256_loadu_si256((const __m256i *) (src + 2 * x)));
+  }
+#endif
+  for (; x + 8 <= width; x += 8)
+  {
+    _mm_storeu_si128((__m128i *) (dst + x), _mm_loadu_si128((const __m128i *) (src + 2 * x)));
+  }
+  for (; x < width; x++)
+  {
+    dst[x] = Pel(src[2 * x + 0]) | (Pel(src[2 * x + 1]) << 8);
+  }
+}
+
+template<X86_VEXT vext>
+void packSamples8_SIMD(const Pel *src, uint8_t *dst, int width)
+{
+  // keep the low byte of each sample, as the scalar cast does, instead of saturating
+  const __m128i vmask = _mm_set1_epi16(0xff);
+#ifdef USE_AVX2
+  const __m256i vmask2 = _mm256_set1_epi16(0xff);
+#endif
+
+  int x = 0;
+#ifdef USE_AVX2
+  for (; x + 32 <= width; x += 32)
+  {
+    const __m256i lo = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (src + x)), vmask2);
+    const __m256i hi = _mm256_and_si256(_mm256_loadu_si256((const __m256i *) (src + x + 16)), vmask2);
+    _mm256_storeu_si256((__m256i *) (dst + x), _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xd8));
+  }
+#endif
+  for (; x + 16 <= width; x += 16)
+  {
+    const __m128i lo = _mm_and_si128(_mm_loadu_si128((const __m128i *) (src + x)), vmask);
+    const __m128i hi = _mm_and_si128(_mm_loadu_si128((const __m128i *) (src + x + 8)), vmask);
+    _mm_storeu_si128((__m128i *) (dst + x), _mm_packus_epi16(lo, hi));
+  }
+  for (; x < width; x++)
+  {
+    dst[x] = (uint8_t) src[x];
+  }
+}
+
+template<X86_VEXT vext>
+void packSamples16_SIMD(const Pel *src, uint8_t *dst, int width)
+{
+  int x = 0;
+#ifdef USE_AVX2
+  for (; x + 16 <= width; x += 16)
+  {
+    _mm256_storeu_si256((__m256i *) (dst + 2 * x), _mm256_loadu_si256((const __m256i *) (src + x)));
+  }
+#endif
+  for (; x + 8 <= width; x += 8)
+  {
+    _mm_storeu_si128((__m128i *) (dst + 2 * x), _mm_loadu_si128((const __m128i *) (src + x)));
+  }
+  for (; x < width; x++)
+  {
+    dst[2 * x + 0] = (src[x] >> 0) & 0xff;
+    dst[2 * x + 1] = (src[x] >> 8) & 0xff;
+  }
+}
+
+template<X86_VEXT vext>
+void scaleSamples_SIMD(Pel *buf, ptrdiff_t stride, int width, int height, int shift, Pel minVal, Pel maxVal)
+{
+  if (shift == 0)
+  {
+    return;
+  }
+  if (width & 7)
+  {
+    scaleSamplesCore(buf, stride, width, height, shift, minVal, maxVal);
+    return;
+  }
+
+  const __m128i vshift = _mm_cvtsi32_si128(std::abs(shift));
+  const __m128i vround = _mm_set1_epi32(shift < 0 ? 1 << (-shift - 1) : 0);
+  const __m128i vmin   = _mm_set1_epi16(minVal);
+  const __m128i vmax   = _mm_set1_epi16(maxVal);
+#ifdef USE_AVX2
+  const __m256i vround2 = _mm256_set1_epi32(shift < 0 ? 1 << (-shift - 1) : 0);
+  const __m256i vmin2   = _mm256_set1_epi16(minVal);
+  const __m256i vmax2   = _mm256_set1_epi16(maxVal);
+#endif
+
+  for (int y = 0; y < height; y++, buf += stride)
+  {
+    int x = 0;
+    if (shift > 0)
+    {
+#ifdef USE_AVX2
+      for (; x + 16 <= width; x += 16)
+      {
+        const __m256i v = _mm256_loadu_si256((const __m256i *) (buf + x));
+        _mm256_storeu_si256((__m256i *) (buf + x), _mm256_sll_epi16(v, vshift));
+      }
+#endif
+      for (; x < width; x += 8)
+      {
+        const __m128i v = _mm_loadu_si128((const __m128i *) (buf + x));
+        _mm_storeu_si128((__m128i *) (buf + x), _mm_sll_epi16(v, vshift));
+      }
+    }
+    else
+    {
+#ifdef USE_AVX2
+      for (; x + 16 <= width; x += 16)
+      {
+        const __m256i v  = _mm256_loadu_si256((const __m256i *) (buf + x));
+        __m256i       lo = _mm256_cvtepi16_epi32(_mm256_castsi256_si128(v));
+        __m256i       hi = _mm256_cvtepi16_epi32(_mm256_extracti128_si256(v, 1));
+        lo               = _mm256_sra_epi32(_mm256_add_epi32(lo, vround2), vshift);
+        hi               = _mm256_sra_epi32(_mm256_add_epi32(hi, vround2), vshift);
+        __m256i r        = _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xd8);
+        r                = _mm256_min_epi16(_mm256_max_epi16(r, vmin2), vmax2);
+        _mm256_storeu_si256((__m256i *) (buf + x), r);
+      }
+#endif
+      for (; x < width; x += 8)
+      {
+        const __m128i v  = _mm_loadu_si128((const __m128i *) (buf + x));
+        __m128i       lo = _mm_cvtepi16_epi32(v);
+        __m128i       hi = _mm_cvtepi16_epi32(_mm_srli_si128(v, 8));
+        lo               = _mm_sra_epi32(_mm_add_epi32(lo, vround), vshift);
+        hi               = _mm_sra_epi32(_mm_add_epi32(hi, vround), vshift);
+        const __m128i r  = _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(lo, hi), vmin), vmax);
+        _mm_storeu_si128((__m128i *) (buf + x), r);
+      }
+    }
+  }
+}
+
+template<X86_VEXT vext>
+uint64_t sumSquaredDiff_SIMD(const Pel *src0, ptrdiff_t src0Stride, const Pel *src1, ptrdiff_t src1Stride, int width,
+                             int height)
+{
+  // the squared differences of 16-bit samples are widened to 64 bit before accumulation
+  const __m128i vzero = _mm_setzero_si128();
+  __m128i       vsum  = _mm_setzero_si128();
+  uint64_t      sum   = 0;
+#ifdef USE_AVX2
+  const __m256i vzero2 = _mm256_setzero_si256();
+  __m256i       vsum2  = _mm256_setzero_si256();
+#endif
+
+  for (int y = 0; y < height; y++)
+  {
+    int x = 0;
+#ifdef USE_AVX2
+    for (; x + 16 <= width; x += 16)
+    {
+      const __m256i d  = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i *) (src0 + x)),
+                                          _mm256_loadu_si256((const __m256i *) (src1 + x)));
+      const __m256i sq = _mm256_madd_epi16(d, d);
+      vsum2 = _mm256_add_epi64(vsum2, _mm256_add_epi64(_mm256_unpacklo_epi32(sq, vzero2), _mm256_unpackhi_epi32(sq, vzero2)));
+    }
+#endif
+    for (; x + 8 <= width; x += 8)
+    {
+      const __m128i d =
+        _mm_sub_epi16(_mm_loadu_si128((const __m128i *) (src0 + x)), _mm_loadu_si128((const __m128i *) (src1 + x)));
+      const __m128i sq = _mm_madd_epi16(d, d);
+      vsum = _mm_add_epi64(vsum, _mm_add_epi64(_mm_unpacklo_epi32(sq, vzero), _mm_unpackhi_epi32(sq, vzero)));
+    }
+    for (; x < width; x++)
+    {
+      const int64_t diff = (int64_t) src0[x] - (int64_t) src1[x];
+      sum += uint64_t(diff * diff);
+    }
+    src0 += src0Stride;
+    src1 += src1Stride;
+  }
+
+#ifdef USE_AVX2
+  vsum = _mm_add_epi64(vsum, _mm_add_epi64(_mm256_castsi256_si128(vsum2), _mm256_extracti128_si256(vsum2, 1)));
+#endif
+  return sum + _mm_cvtsi128_si64(vsum) + _mm_extract_epi64(vsum, 1);
+}
+
+template<X86_VEXT vext>
+uint32_t checksumRow_SIMD(const Pel *src, int width, uint8_t rowMask, bool highByte)
+{
+  // x is a multiple of the vector width, so (x & 0xff) of the lanes is the lane index ORed into (x & 0xff) of lane 0
+  // and (x >> 8) is the same for all lanes. The sums are modulo 2^32, so the lanes are accumulated with wrap-around.
+  const __m128i vlow  = _mm_set1_epi16(0xff);
+  const __m128i vone  = _mm_set1_epi16(1);
+  __m128i       vsum  = _mm_setzero_si128();
+  int           x     = 0;
+#ifdef USE_AVX2
+  const __m256i lanes2 = _mm256_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  const __m256i vlow2  = _mm256_set1_epi16(0xff);
+  const __m256i vone2  = _mm256_set1_epi16(1);
+  __m256i       vsum2  = _mm256_setzero_si256();
+  for (; x + 16 <= width; x += 16)
+  {
+    const __m256i mask  = _mm256_xor_si256(_mm256_set1_epi16(uint8_t((x & 0xff) ^ (x >> 8) ^ rowMask)), lanes2);
+    const __m256i v     = _mm256_loadu_si256((const __m256i *) (src + x));
+    __m256i       bytes = _mm256_xor_si256(_mm256_and_si256(v, vlow2), mask);
+    if (highByte)
+    {
+      bytes = _mm256_add_epi16(bytes, _mm256_xor_si256(_mm256_srli_epi16(v, 8), mask));
+    }
+    vsum2 = _mm256_add_epi32(vsum2, _mm256_madd_epi16(bytes, vone2));
+  }
+  vsum = _mm_add_epi32(_mm256_castsi256_si128(vsum2), _mm256_extracti128_si256(vsum2, 1));
+#endif
+  const __m128i lanes = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+  for (; x + 8 <= width; x += 8)
+  {
+    const __m128i mask  = _mm_xor_si128(_mm_set1_epi16(uint8_t((x & 0xff) ^ (x >> 8) ^ rowMask)), lanes);
+    const __m128i v     = _mm_loadu_si128((const __m128i *) (src + x));
+    __m128i       bytes = _mm_xor_si128(_mm_and_si128(v, vlow), mask);
+    if (highByte)
+    {
+      bytes = _mm_add_epi16(bytes, _mm_xor_si128(_mm_srli_epi16(v, 8), mask));
+    }
+    vsum = _mm_add_epi32(vsum, _mm_madd_epi16(bytes, vone));
+  }
+  vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0x4e));
+  vsum = _mm_add_epi32(vsum, _mm_shuffle_epi32(vsum, 0xb1));
+
+  uint32_t checksum = _mm_cvtsi128_si32(vsum);
+  for (; x < width; x++)
+  {
+    const uint8_t xorMask = (x & 0xff) ^ (x >> 8) ^ rowMask;
+    checksum += (src[x] & 0xff) ^ xorMask;
+    if (highByte)
+    {
+      checksum += (src[x] >> 8) ^ xorMask;
+    }
+  }
+  return checksum;
+}
+#endif
+
+template<X86_VEXT vext>
+void ssimMomentsHor_SIMD(const double *org, const double *rec, int width, const double *taps, double *dst,
+                         ptrdiff_t dstStride)
+{
+  // same operation order as the scalar version, so the results are identical
+  int x = 0;
+#ifdef USE_AVX2
+  for (; x + 4 <= width; x += 4)
+  {
+    __m256d muOrg  = _mm256_setzero_pd();
+    __m256d muRec  = _mm256_setzero_pd();
+    __m256d orgSqr = _mm256_setzero_pd();
+    __m256d recSqr = _mm256_setzero_pd();
+    __m256d orgRec = _mm256_setzero_pd();
+    for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+    {
+      const __m256d w  = _mm256_broadcast_sd(taps + i);
+      const __m256d o  = _mm256_loadu_pd(org + x + i);
+      const __m256d r  = _mm256_loadu_pd(rec + x + i);
+      const __m256d wo = _mm256_mul_pd(w, o);
+      const __m256d wr = _mm256_mul_pd(w, r);
+      muOrg            = _mm256_add_pd(muOrg, wo);
+      muRec            = _mm256_add_pd(muRec, wr);
+      orgSqr           = _mm256_add_pd(orgSqr, _mm256_mul_pd(wo, o));
+      recSqr           = _mm256_add_pd(recSqr, _mm256_mul_pd(wr, r));
+      orgRec           = _mm256_add_pd(orgRec, _mm256_mul_pd(wo, r));
+    }
+    _mm256_storeu_pd(dst + 0 * dstStride + x, muOrg);
+    _mm256_storeu_pd(dst + 1 * dstStride + x, muRec);
+    _mm256_storeu_pd(dst + 2 * dstStride + x, orgSqr);
+    _mm256_storeu_pd(dst + 3 * dstStride + x, recSqr);
+    _mm256_storeu_pd(dst + 4 * dstStride + x, orgRec);
+  }
+#endif
+  for (; x + 2 <= width; x += 2)
+  {
+    __m128d muOrg  = _mm_setzero_pd();
+    __m128d muRec  = _mm_setzero_pd();
+    __m128d orgSqr = _mm_setzero_pd();
+    __m128d recSqr = _mm_setzero_pd();
+    __m128d orgRec = _mm_setzero_pd();
+    for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+    {
+      const __m128d w  = _mm_set1_pd(taps[i]);
+      const __m128d o  = _mm_loadu_pd(org + x + i);
+      const __m128d r  = _mm_loadu_pd(rec + x + i);
+      const __m128d wo = _mm_mul_pd(w, o);
+      const __m128d wr = _mm_mul_pd(w, r);
+      muOrg            = _mm_add_pd(muOrg, wo);
+      muRec            = _mm_add_pd(muRec, wr);
+      orgSqr           = _mm_add_pd(orgSqr, _mm_mul_pd(wo, o));
+      recSqr           = _mm_add_pd(recSqr, _mm_mul_pd(wr, r));
+      orgRec           = _mm_add_pd(orgRec, _mm_mul_pd(wo, r));
+    }
+    _mm_storeu_pd(dst + 0 * dstStride + x, muOrg);
+    _mm_storeu_pd(dst + 1 * dstStride + x, muRec);
+    _mm_storeu_pd(dst + 2 * dstStride + x, orgSqr);
+    _mm_storeu_pd(dst + 3 * dstStride + x, recSqr);
+    _mm_storeu_pd(dst + 4 * dstStride + x, orgRec);
+  }
+  if (x < width)
+  {
+    ssimMomentsHorCore(org + x, rec + x, width - x, taps, dst + x, dstStride);
+  }
+}
+
+template<X86_VEXT vext>
+double ssimSumVer_SIMD(const double *const *rows, ptrdiff_t momentStride, int width, const double *taps, double c1,
+                       double c2, bool useLuminance)
+{
+  // the SSIM value of each window matches the scalar version, only the summation order differs
+  int    x   = 0;
+  double sum = 0;
+#ifdef USE_AVX2
+  {
+    const __m256d vc1  = _mm256_set1_pd(c1);
+    const __m256d vc2  = _mm256_set1_pd(c2);
+    const __m256d vtwo = _mm256_set1_pd(2.0);
+    __m256d       vsum = _mm256_setzero_pd();
+    for (; x + 4 <= width; x += 4)
+    {
+      __m256d m[5];
+      for (int k = 0; k < 5; k++)
+      {
+        m[k] = _mm256_setzero_pd();
+      }
+      for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+      {
+        const __m256d w = _mm256_broadcast_sd(taps + i);
+        for (int k = 0; k < 5; k++)
+        {
+          m[k] = _mm256_add_pd(m[k], _mm256_mul_pd(w, _mm256_loadu_pd(rows[i] + k * momentStride + x)));
+        }
+      }
+      const __m256d sigmaSqrOrg = _mm256_sub_pd(m[2], _mm256_mul_pd(m[0], m[0]));
+      const __m256d sigmaSqrRec = _mm256_sub_pd(m[3], _mm256_mul_pd(m[1], m[1]));
+      const __m256d sigmaOrgRec = _mm256_sub_pd(m[4], _mm256_mul_pd(m[0], m[1]));
+
+      __m256d ssim = _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(vtwo, sigmaOrgRec), vc2),
+                                   _mm256_add_pd(_mm256_add_pd(sigmaSqrOrg, sigmaSqrRec), vc2));
+      if (useLuminance)
+      {
+        const __m256d lum =
+          _mm256_div_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(vtwo, m[0]), m[1]), vc1),
+                        _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m[0], m[0]), _mm256_mul_pd(m[1], m[1])), vc1));
+        ssim = _mm256_mul_pd(ssim, lum);
+      }
+      vsum = _mm256_add_pd(vsum, ssim);
+    }
+    const __m128d s = _mm_add_pd(_mm256_castpd256_pd128(vsum), _mm256_extractf128_pd(vsum, 1));
+    sum             = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+  }
+#endif
+  {
+    const __m128d vc1  = _mm_set1_pd(c1);
+    const __m128d vc2  = _mm_set1_pd(c2);
+    const __m128d vtwo = _mm_set1_pd(2.0);
+    __m128d       vsum = _mm_setzero_pd();
+    for (; x + 2 <= width; x += 2)
+    {
+      __m128d m[5];
+      for (int k = 0; k < 5; k++)
+      {
+        m[k] = _mm_setzero_pd();
+      }
+      for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+      {
+        const __m128d w = _mm_set1_pd(taps[i]);
+        for (int k = 0; k < 5; k++)
+        {
+          m[k] = _mm_add_pd(m[k], _mm_mul_pd(w, _mm_loadu_pd(rows[i] + k * momentStride + x)));
+        }
+      }
+      const __m128d sigmaSqrOrg = _mm_sub_pd(m[2], _mm_mul_pd(m[0], m[0]));
+      const __m128d sigmaSqrRec = _mm_sub_pd(m[3], _mm_mul_pd(m[1], m[1]));
+      const __m128d sigmaOrgRec = _mm_sub_pd(m[4], _mm_mul_pd(m[0], m[1]));
+
+      __m128d ssim = _mm_div_pd(_mm_add_pd(_mm_mul_pd(vtwo, sigmaOrgRec), vc2),
+                                _mm_add_pd(_mm_add_pd(sigmaSqrOrg, sigmaSqrRec), vc2));
+      if (useLuminance)
+      {
+        const __m128d lum = _mm_div_pd(_mm_add_pd(_mm_mul_pd(_mm_mul_pd(vtwo, m[0]), m[1]), vc1),
+                                       _mm_add_pd(_mm_add_pd(_mm_mul_pd(m[0], m[0]), _mm_mul_pd(m[1], m[1])), vc1));
+        ssim              = _mm_mul_pd(ssim, lum);
+      }
+      vsum = _mm_add_pd(vsum, ssim);
+    }
+    sum += _mm_cvtsd_f64(_mm_add_sd(vsum, _mm_unpackhi_pd(vsum, vsum)));
+  }
+  if (x < width)
+  {
+    const double *tail[SSIM_FILTER_SIZE];
+    for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+    {
+      tail[i] = rows[i] + x;
+    }
+    sum += ssimSumVerCore(tail, momentStride, width - x, taps, c1, c2, useLuminance);
+  }
+  return sum;
+}
+
+template<X86_VEXT vext>
+void rescaleHor_SIMD(const Pel *src, const int *srcPos, const TFilterCoeff *coeff, int numTaps, int *dst, int width)
+{
+  // each output is the horizontal sum of one or two madd results, four outputs are reduced together
+  int x = 0;
+  if (numTaps == 8)
+  {
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i sum[4];
+      for (int i = 0; i < 4; i++)
+      {
+        sum[i] = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (src + srcPos[x + i])),
+                                _mm_loadu_si128((const __m128i *) (coeff + (x + i) * 8)));
+      }
+      _mm_storeu_si128((__m128i *) (dst + x),
+                       _mm_hadd_epi32(_mm_hadd_epi32(sum[0], sum[1]), _mm_hadd_epi32(sum[2], sum[3])));
+    }
+  }
+  else if (numTaps == 16)
+  {
+    for (; x + 4 <= width; x += 4)
+    {
+#ifdef USE_AVX2
+      __m256i sum[4];
+      for (int i = 0; i < 4; i++)
+      {
+        sum[i] = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *) (src + srcPos[x + i])),
+                                   _mm256_loadu_si256((const __m256i *) (coeff + (x + i) * 16)));
+      }
+      const __m256i h = _mm256_hadd_epi32(_mm256_hadd_epi32(sum[0], sum[1]), _mm256_hadd_epi32(sum[2], sum[3]));
+      _mm_storeu_si128((__m128i *) (dst + x), _mm_add_epi32(_mm256_castsi256_si128(h), _mm256_extracti128_si256(h, 1)));
+#else
+      __m128i sum[4];
+      for (int i = 0; i < 4; i++)
+      {
+        const Pel          *s = src + srcPos[x + i];
+        const TFilterCoeff *f = coeff + (x + i) * 16;
+        sum[i] = _mm_add_epi32(_mm_madd_epi16(_mm_loadu_si128((const __m128i *) s), _mm_loadu_si128((const __m128i *) f)),
+                               _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (s + 8)),
+                                              _mm_loadu_si128((const __m128i *) (f + 8))));
+      }
+      _mm_storeu_si128((__m128i *) (dst + x),
+                       _mm_hadd_epi32(_mm_hadd_epi32(sum[0], sum[1]), _mm_hadd_epi32(sum[2], sum[3])));
+#endif
+    }
+  }
+  if (x < width)
+  {
+    rescaleHorCore(src, srcPos + x, coeff + x * numTaps, numTaps, dst + x, width - x);
+  }
+}
+
+template<X86_VEXT vext>
+void scaledFilterHor_SIMD(const Pel *src, ptrdiff_t srcStride, const int *srcPos, const TFilterCoeff *coeff,
+                          int numTaps, Pel *dst, ptrdiff_t dstStride, int width, int height, int shift, int offset)
+{
+  if (numTaps != 8 && numTaps != 4)
+  {
+    scaledFilterHorCore(src, srcStride, srcPos, coeff, numTaps, dst, dstStride, width, height, shift, offset);
+    return;
+  }
+
+  const int     width8 = width & ~7;
+  const __m128i voff   = _mm_set1_epi32(offset);
+#ifdef USE_AVX2
+  const __m256i voff256 = _mm256_set1_epi32(offset);
+#endif
+
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width8; x += 8)
+    {
+      if (numTaps == 8)
+      {
+#ifdef USE_AVX2
+        // lane 0 holds output x + i, lane 1 output x + i + 4
+        __m256i sum[4];
+        for (int i = 0; i < 4; i++)
+        {
+          const __m256i s = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (src + srcPos[x + i]))),
+            _mm_loadu_si128((const __m128i *) (src + srcPos[x + i + 4])), 1);
+          const __m256i f = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) (coeff + (x + i) * 8))),
+            _mm_loadu_si128((const __m128i *) (coeff + (x + i + 4) * 8)), 1);
+          sum[i] = _mm256_madd_epi16(s, f);
+        }
+        __m256i v = _mm256_hadd_epi32(_mm256_hadd_epi32(sum[0], sum[1]), _mm256_hadd_epi32(sum[2], sum[3]));
+        v         = _mm256_srai_epi32(_mm256_add_epi32(v, voff256), shift);
+        v         = _mm256_permute4x64_epi64(_mm256_packs_epi32(v, v), 0x08);
+        _mm_storeu_si128((__m128i *) (dst + x), _mm256_castsi256_si128(v));
+#else
+        __m128i res[2];
+        for (int j = 0; j < 2; j++)
+        {
+          __m128i sum[4];
+          for (int i = 0; i < 4; i++)
+          {
+            const int k = x + 4 * j + i;
+            sum[i]      = _mm_madd_epi16(_mm_loadu_si128((const __m128i *) (src + srcPos[k])),
+                                         _mm_loadu_si128((const __m128i *) (coeff + k * 8)));
+          }
+          res[j] = _mm_hadd_epi32(_mm_hadd_epi32(sum[0], sum[1]), _mm_hadd_epi32(sum[2], sum[3]));
+          res[j] = _mm_srai_epi32(_mm_add_epi32(res[j], voff), shift);
+        }
+        _mm_storeu_si128((__m128i *) (dst + x), _mm_packs_epi32(res[0], res[1]));
+#endif
+      }
+      else
+      {
+        // two 4-tap outputs share one madd, their coefficients are adjacent in coeff
+        __m128i res[2];
+        for (int j = 0; j < 2; j++)
+        {
+          __m128i sum[2];
+          for (int i = 0; i < 2; i++)
+          {
+            const int     k = x + 4 * j + 2 * i;
+            const __m128i s = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i *) (src + srcPos[k])),
+                                                 _mm_loadl_epi64((const __m128i *) (src + srcPos[k + 1])));
+            sum[i]          = _mm_madd_epi16(s, _mm_loadu_si128((const __m128i *) (coeff + k * 4)));
+          }
+          res[j] = _mm_srai_epi32(_mm_add_epi32(_mm_hadd_epi32(sum[0], sum[1]), voff), shift);
+        }
+        _mm_storeu_si128((__m128i *) (dst + x), _mm_packs_epi32(res[0], res[1]));
+      }
+    }
+    if (width8 < width)
+    {
+      scaledFilterHorCore(src, srcStride, srcPos + width8, coeff + width8 * numTaps, numTaps, dst + width8, dstStride,
+                          width - width8, 1, shift, offset);
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+template<X86_VEXT vext>
+void rescaleVer_SIMD(const int *const *src, const TFilterCoeff *coeff, int numTaps, Pel *dst, int width, int shift,
+                     int maxVal)
+{
+  int x = 0;
+#ifdef USE_AVX2
+  {
+    const __m256i vround = _mm256_set1_epi32(1 << (shift - 1));
+    const __m256i vzero  = _mm256_setzero_si256();
+    const __m256i vmax   = _mm256_set1_epi32(maxVal);
+    for (; x + 8 <= width; x += 8)
+    {
+      __m256i sum = vround;
+      for (int k = 0; k < numTaps; k++)
+      {
+        sum = _mm256_add_epi32(sum, _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i *) (src[k] + x)),
+                                                       _mm256_set1_epi32(coeff[k])));
+      }
+      sum = _mm256_min_epi32(_mm256_max_epi32(_mm256_srai_epi32(sum, shift), vzero), vmax);
+      const __m128i r = _mm_packs_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+      _mm_storeu_si128((__m128i *) (dst + x), r);
+    }
+  }
+#endif
+  const __m128i vround = _mm_set1_epi32(1 << (shift - 1));
+  const __m128i vzero  = _mm_setzero_si128();
+  const __m128i vmax   = _mm_set1_epi32(maxVal);
+  for (; x + 4 <= width; x += 4)
+  {
+    __m128i sum = vround;
+    for (int k = 0; k < numTaps; k++)
+    {
+      sum = _mm_add_epi32(sum, _mm_mullo_epi32(_mm_loadu_si128((const __m128i *) (src[k] + x)), _mm_set1_epi32(coeff[k])));
+    }
+    sum = _mm_min_epi32(_mm_max_epi32(_mm_srai_epi32(sum, shift), vzero), vmax);
+    _mm_storel_epi64((__m128i *) (dst + x), _mm_packs_epi32(sum, sum));
+  }
+  if (x < width)
+  {
+    const int *rows[16];
+    for (int k = 0; k < numTaps; k++)
+    {
+      rows[k] = src[k] + x;
+    }
+    rescaleVerCore(rows, coeff, numTaps, dst + x, width - x, shift, maxVal);
+  }
+}
+
 template<X86_VEXT vext>
 void PelBufferOps::_initPelBufOpsX86()
 {
@@ -1814,7 +2848,6 @@ void PelBufferOps::_initPelBufOpsX86()
   removeHighFreq4 = removeHighFreq_HBD_SIMD<vext, 4>;
 #endif
 
-  profGradFilter = gradFilterHBD_SIMD<vext, false>;
   applyPROF = applyPROFHBD_SIMD<vext>;
 #else
   addAvg8 = addAvg_SSE<vext, 8>;
@@ -1826,6 +2859,8 @@ void PelBufferOps::_initPelBufOpsX86()
 
   copyBuffer = copyBufferSimd<vext>;
   padding    = paddingSimd<vext>;
+  copyPadded     = copyPadded_SIMD<vext>;
+  dmvrIntegerSad = dmvrIntegerSad_SIMD<vext>;
   reco8 = reco_SSE<vext, 8>;
   reco4 = reco_SSE<vext, 4>;
 
@@ -1837,10 +2872,34 @@ void PelBufferOps::_initPelBufOpsX86()
   removeHighFreq8 = removeHighFreq_SSE<vext, 8>;
   removeHighFreq4 = removeHighFreq_SSE<vext, 4>;
 #endif
-  profGradFilter = gradFilter_SSE<vext, false>;
-  applyPROF      = applyPROF_SSE<vext>;
+  applyPROF = applyPROF_SSE<vext>;
+
+  fgsScaleGrain = fgsScaleGrain_SIMD<vext>;
+  fgsBlockSum   = fgsBlockSum_SIMD<vext>;
+  fgsBlend      = fgsBlend_SIMD<vext>;
+
+  sobel3x3    = sobel3x3_SIMD<vext>;
+  morph3x3    = morph3x3_SIMD<vext>;
+  sumAndSumSq = sumAndSumSq_SIMD<vext>;
+
+  unpackSamples8  = unpackSamples8_SIMD<vext>;
+  unpackSamples16 = unpackSamples16_SIMD<vext>;
+  packSamples8    = packSamples8_SIMD<vext>;
+  packSamples16   = packSamples16_SIMD<vext>;
+  scaleSamples    = scaleSamples_SIMD<vext>;
+
+  sumSquaredDiff = sumSquaredDiff_SIMD<vext>;
+  checksumRow    = checksumRow_SIMD<vext>;
+
+  rescaleHor = rescaleHor_SIMD<vext>;
+  rescaleVer = rescaleVer_SIMD<vext>;
+
+  scaledFilterHor = scaledFilterHor_SIMD<vext>;
 #endif
   roundIntVector = roundIntVector_SIMD<vext>;
+
+  ssimMomentsHor = ssimMomentsHor_SIMD<vext>;
+  ssimSumVer     = ssimSumVer_SIMD<vext>;
 }
 
 template void PelBufferOps::_initPelBufOpsX86<SIMDX86>();
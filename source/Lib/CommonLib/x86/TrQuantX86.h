@@ -452,6 +452,134 @@ static void matrixMult(const TCoeff* src, TCoeff* dst, int shift, int numRowsIn,
                                 maxOutVal, M[TRANSFORM_INVERSE]);
 }
 }   // namespace Inv
+
+//---------------------------------------------------------------------------------------------------------------------
+
+namespace Lfnst   // LFNST matrix multiplications (16x16 and 48x16)
+{
+// Widen 16 matrix coefficients to 32 bit
+static inline void loadMatrixCoeff8(const int8_t* p, __m128i c[4])
+{
+  const __m128i x = _mm_loadu_si128((const __m128i*) p);
+
+  c[0] = _mm_cvtepi8_epi32(x);
+  c[1] = _mm_cvtepi8_epi32(_mm_srli_si128(x, 4));
+  c[2] = _mm_cvtepi8_epi32(_mm_srli_si128(x, 8));
+  c[3] = _mm_cvtepi8_epi32(_mm_srli_si128(x, 12));
+}
+
+template<X86_VEXT vext, int TR_SIZE>
+static void fwd(const TCoeff* src, TCoeff* dst, const int8_t* trMat, int zeroOutSize)
+{
+  static_assert(TR_SIZE % 16 == 0);
+  CHECK(zeroOutSize & 3, "zeroOutSize should be a multiple of 4");
+
+#if !USE_AVX2
+  __m128i x[TR_SIZE / NUM_ELEMENTS];
+  for (int i = 0; i < TR_SIZE / NUM_ELEMENTS; i++)
+  {
+    x[i] = loadCoeff(src + NUM_ELEMENTS * i);
+  }
+#endif
+
+  for (int j = 0; j < zeroOutSize; j += 4)
+  {
+    __m128i sum[4];
+
+    for (int k = 0; k < 4; k++)
+    {
+      const int8_t* m = trMat + (j + k) * TR_SIZE;
+#if USE_AVX2
+      __m256i acc = _mm256_setzero_si256();
+      for (int i = 0; i < TR_SIZE; i += 16)
+      {
+        const __m128i c  = _mm_loadu_si128((const __m128i*) (m + i));
+        const __m256i x0 = _mm256_loadu_si256((const __m256i*) (src + i));
+        const __m256i x1 = _mm256_loadu_si256((const __m256i*) (src + i + 8));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(x0, _mm256_cvtepi8_epi32(c)));
+        acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(x1, _mm256_cvtepi8_epi32(_mm_srli_si128(c, 8))));
+      }
+      sum[k] = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+#else
+      __m128i acc = _mm_setzero_si128();
+      for (int i = 0; i < TR_SIZE; i += 16)
+      {
+        __m128i c[4];
+        loadMatrixCoeff8(m + i, c);
+        for (int l = 0; l < 4; l++)
+        {
+          acc = _mm_add_epi32(acc, _mm_mullo_epi32(x[i / NUM_ELEMENTS + l], c[l]));
+        }
+      }
+      sum[k] = acc;
+#endif
+    }
+
+    // horizontal sums of the four accumulators
+    const __m128i s01   = _mm_add_epi32(_mm_unpacklo_epi32(sum[0], sum[1]), _mm_unpackhi_epi32(sum[0], sum[1]));
+    const __m128i s23   = _mm_add_epi32(_mm_unpacklo_epi32(sum[2], sum[3]), _mm_unpackhi_epi32(sum[2], sum[3]));
+    const __m128i s0123 = _mm_add_epi32(_mm_unpacklo_epi64(s01, s23), _mm_unpackhi_epi64(s01, s23));
+
+    storeCoeff(dst + j, _mm_srai_epi32(_mm_add_epi32(s0123, _mm_set1_epi32(64)), 7));
+  }
+
+  for (int j = zeroOutSize; j < TR_SIZE; j += NUM_ELEMENTS)
+  {
+    storeCoeff(dst + j, _mm_setzero_si128());
+  }
+}
+
+template<X86_VEXT vext, int TR_SIZE>
+static void inv(const TCoeff* src, TCoeff* dst, const int8_t* trMat, int zeroOutSize, const TCoeff outputMinimum,
+                const TCoeff outputMaximum)
+{
+  static_assert(TR_SIZE % 16 == 0);
+
+  for (int j = 0; j < TR_SIZE; j += 16)
+  {
+#if USE_AVX2
+    __m256i acc[2] = { _mm256_setzero_si256(), _mm256_setzero_si256() };
+
+    for (int i = 0; i < zeroOutSize; i++)
+    {
+      const __m128i c = _mm_loadu_si128((const __m128i*) (trMat + i * TR_SIZE + j));
+      const __m256i x = _mm256_set1_epi32(src[i]);
+      acc[0] = _mm256_add_epi32(acc[0], _mm256_mullo_epi32(x, _mm256_cvtepi8_epi32(c)));
+      acc[1] = _mm256_add_epi32(acc[1], _mm256_mullo_epi32(x, _mm256_cvtepi8_epi32(_mm_srli_si128(c, 8))));
+    }
+
+    for (int l = 0; l < 2; l++)
+    {
+      __m256i y = _mm256_srai_epi32(_mm256_add_epi32(acc[l], _mm256_set1_epi32(64)), 7);
+      y         = _mm256_min_epi32(y, _mm256_set1_epi32(outputMaximum));
+      y         = _mm256_max_epi32(y, _mm256_set1_epi32(outputMinimum));
+      storeCoeff(dst + j + 8 * l, y);
+    }
+#else
+    __m128i acc[4] = { _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128(), _mm_setzero_si128() };
+
+    for (int i = 0; i < zeroOutSize; i++)
+    {
+      __m128i c[4];
+      loadMatrixCoeff8(trMat + i * TR_SIZE + j, c);
+      const __m128i x = _mm_set1_epi32(src[i]);
+      for (int l = 0; l < 4; l++)
+      {
+        acc[l] = _mm_add_epi32(acc[l], _mm_mullo_epi32(x, c[l]));
+      }
+    }
+
+    for (int l = 0; l < 4; l++)
+    {
+      __m128i y = _mm_srai_epi32(_mm_add_epi32(acc[l], _mm_set1_epi32(64)), 7);
+      y         = _mm_min_epi32(y, _mm_set1_epi32(outputMaximum));
+      y         = _mm_max_epi32(y, _mm_set1_epi32(outputMinimum));
+      storeCoeff(dst + j + NUM_ELEMENTS * l, y);
+    }
+#endif
+  }
+}
+}   // namespace Lfnst
 #endif
 }   // namespace SIMD::X86::TX
 
@@ -493,6 +621,11 @@ template<X86_VEXT vext> void TrQuant::_initX86()
   m_invTx[TransType::DCT8][2] = SIMD::X86::TX::Inv::matrixMult<vext, 8, g_trCoreDCT8P8>;
   m_invTx[TransType::DCT8][3] = SIMD::X86::TX::Inv::matrixMult<vext, 16, g_trCoreDCT8P16>;
   m_invTx[TransType::DCT8][4] = SIMD::X86::TX::Inv::matrixMult<vext, 32, g_trCoreDCT8P32>;
+
+  m_fwdLfnst[0] = SIMD::X86::TX::Lfnst::fwd<vext, 16>;
+  m_fwdLfnst[1] = SIMD::X86::TX::Lfnst::fwd<vext, 48>;
+  m_invLfnst[0] = SIMD::X86::TX::Lfnst::inv<vext, 16>;
+  m_invLfnst[1] = SIMD::X86::TX::Lfnst::inv<vext, 48>;
 #endif
 }
 
@@ -283,21 +283,24 @@ unsigned BinDecoderBase::decodeAlignedBinsEP( unsigned numBins )
   return bins;
 }
 
-template<class BinProbModel>
-TBinDecoder<BinProbModel>::TBinDecoder()
+template<class BinProbModel, bool Trace>
+TBinDecoder<BinProbModel, Trace>::TBinDecoder()
   : BinDecoderBase(static_cast<const BinProbModel *>(nullptr)), m_ctx(static_cast<CtxStore<BinProbModel> &>(*this))
 {}
 
-template <class BinProbModel>
-unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
+template<class BinProbModel, bool Trace>
+unsigned TBinDecoder<BinProbModel, Trace>::decodeBin( unsigned ctxId )
 {
   BinProbModel &probModel = m_ctx[ctxId];
   unsigned      bin       = probModel.mps();
   uint32_t      lpsRange  = probModel.getLPS(m_range);
 
-  DTRACE(g_trace_ctx, D_CABAC, "%d %d %d  [%d:%d]  %2d(MPS=%d)  ", DTRACE_GET_COUNTER(g_trace_ctx, D_CABAC), ctxId,
-         m_range, m_range - lpsRange, lpsRange, (unsigned int) (probModel.state()),
-         m_value < ((m_range - lpsRange) << 7));
+  if constexpr (Trace)
+  {
+    DTRACE(g_trace_ctx, D_CABAC, "%d %d %d  [%d:%d]  %2d(MPS=%d)  ", DTRACE_GET_COUNTER(g_trace_ctx, D_CABAC), ctxId,
+           m_range, m_range - lpsRange, lpsRange, (unsigned int) (probModel.state()),
+           m_value < ((m_range - lpsRange) << 7));
+  }
 
   m_range -= lpsRange;
   uint32_t scaledRange = m_range << 7;
@@ -339,10 +342,16 @@ unsigned TBinDecoder<BinProbModel>::decodeBin( unsigned ctxId )
     }
   }
   probModel.update(bin);
-  //DTRACE_DECR_COUNTER( g_trace_ctx, D_CABAC );
-  DTRACE_WITHOUT_COUNT( g_trace_ctx, D_CABAC, "  -  " "%d" "\n", bin );
+  if constexpr (Trace)
+  {
+    //DTRACE_DECR_COUNTER( g_trace_ctx, D_CABAC );
+    DTRACE_WITHOUT_COUNT( g_trace_ctx, D_CABAC, "  -  " "%d" "\n", bin );
+  }
   return  bin;
 }
 
 template class TBinDecoder<BinProbModel_Std>;
+#if ENABLE_TRACING
+template class TBinDecoder<BinProbModel_Std, false>;
+#endif
 
@@ -94,7 +94,9 @@ protected:
 
 
 
-template <class BinProbModel>
+// Trace selects whether decodeBin writes the D_CABAC trace. A tracing build instantiates both variants and uses the
+// one without trace output unless tracing was requested, a build without tracing only the latter.
+template <class BinProbModel, bool Trace = ENABLE_TRACING != 0>
 class TBinDecoder : public BinDecoderBase
 {
 public:
@@ -108,5 +110,8 @@ private:
 
 
 typedef TBinDecoder<BinProbModel_Std>   BinDecoder_Std;
+#if ENABLE_TRACING
+typedef TBinDecoder<BinProbModel_Std, false> BinDecoder_StdNoTrace;
+#endif
 
 
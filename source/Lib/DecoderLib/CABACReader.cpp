@@ -44,6 +44,7 @@
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/MatrixIntraPrediction.h"
+#include "CommonLib/StageProfiler.h"
 
 #if RExt__DECODER_DEBUG_BIT_STATISTICS
 #include "CommonLib/CodingStatistics.h"
@@ -148,6 +149,8 @@ void CABACReader::remaining_bytes( bool noTrailingBytesExpected )
 void CABACReader::coding_tree_unit(CodingStructure &cs, const UnitArea &area, EnumArray<int, ChannelType> &qps,
                                    unsigned ctuRsAddr)
 {
+  PROFILE_STAGE( "ParseCtu" );
+
   CUCtx           cuCtx(qps[ChannelType::LUMA]);
   QTBTPartitioner partitioner;
 
@@ -43,6 +43,7 @@
 #include "CommonLib/ContextModelling.h"
 #include "CommonLib/MotionInfo.h"
 #include "CommonLib/UnitPartitioner.h"
+#include "CommonLib/dtrace_next.h"
 
 
 class CABACReader
@@ -169,15 +170,38 @@ private:
 class CABACDecoder
 {
 public:
+#if ENABLE_TRACING
+  CABACDecoder()
+    : m_CABACReaderStd(m_BinDecoderStd)
+    , m_CABACReaderStdNoTrace(m_BinDecoderStdNoTrace)
+    , m_CABACReader{ &m_CABACReaderStd }
+    , m_CABACReaderNoTrace{ &m_CABACReaderStdNoTrace }
+  {
+  }
+
+  // the readers without CABAC trace are used unless a trace file and a trace rule were given
+  CABACReader *getCABACReader(BpmType id)
+  {
+    return DTRACE_ACTIVE(g_trace_ctx) ? m_CABACReader[id] : m_CABACReaderNoTrace[id];
+  }
+#else
   CABACDecoder() : m_CABACReaderStd(m_BinDecoderStd), m_CABACReader{ &m_CABACReaderStd } {}
 
   CABACReader *getCABACReader(BpmType id) { return m_CABACReader[id]; }
+#endif
 
 private:
   BinDecoder_Std          m_BinDecoderStd;
   CABACReader             m_CABACReaderStd;
+#if ENABLE_TRACING
+  BinDecoder_StdNoTrace   m_BinDecoderStdNoTrace;
+  CABACReader             m_CABACReaderStdNoTrace;
+#endif
 
   EnumArray<CABACReader *, BpmType> m_CABACReader;
+#if ENABLE_TRACING
+  EnumArray<CABACReader *, BpmType> m_CABACReaderNoTrace;
+#endif
 };
 
 #endif
@@ -41,6 +41,7 @@
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "CommonLib/dtrace_buffer.h"
 
@@ -98,6 +99,8 @@ void DecCu::destoryDecCuReshaprBuf()
 
 void DecCu::decompressCtu( CodingStructure& cs, const UnitArea& ctuArea )
 {
+  PROFILE_STAGE( "ReconstructCtu" );
+
   const int maxNumChannelType = isChromaEnabled(cs.pcv->chrFormat) && CS::isDualITree(cs) ? 2 : 1;
 
   if (cs.resetIBCBuffer)
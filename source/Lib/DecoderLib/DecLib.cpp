@@ -37,6 +37,7 @@
 
 #include "NALread.h"
 #include "DecLib.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "CommonLib/dtrace_next.h"
 #include "CommonLib/dtrace_buffer.h"
@@ -513,6 +514,7 @@ DecLib::DecLib()
   , m_warningMessageSkipPicture(false)
   , m_prefixSEINALUs()
   , m_ShutterFilterEnable(false)
+  , m_leanPicBuffers(false)
   , m_debugPOC(-1)
   , m_debugCTU(-1)
   , m_opi(nullptr)
@@ -651,11 +653,16 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
                                     ? sps.getWrapAroundEnabledFlag()
                                     : true;
 
+  // without RPR and inter-layer prediction no reference is scaled, so the lean mode keeps the regular margin
+  const bool scaledRefMargin = !m_leanPicBuffers || sps.getRprEnabledFlag()
+                               || (m_vps != nullptr && m_vps->m_numLayersInOls[m_vps->m_targetOlsIdx] > 1);
+  const unsigned picMargin = (scaledRefMargin ? MAX_SCALING_RATIO : 1) * (sps.getMaxCUWidth() + PIC_MARGIN);
+
   if (m_cListPic.size() < (uint32_t) m_maxRefPicNum)
   {
     pcPic = new Picture();
     pcPic->create(allocateWrappedPic, sps.getChromaFormatIdc(), Size(pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples()),
-      sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag() );
+      sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag(), scaledRefMargin );
 
     m_cListPic.push_back( pcPic );
 
@@ -691,15 +698,19 @@ Picture* DecLib::xGetNewPicBuffer( const SPS &sps, const PPS &pps, const uint32_
 
     m_cListPic.push_back( pcPic );
 
-    pcPic->create(allocateWrappedPic, sps.getChromaFormatIdc(), Size(pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples()), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag());
+    pcPic->create(allocateWrappedPic, sps.getChromaFormatIdc(), Size(pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples()), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag(), scaledRefMargin);
   }
   else
   {
-    if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId )
+    if( !pcPic->Y().Size::operator==( Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ) ) || pps.pcv->maxCUWidth != sps.getMaxCUWidth() || pps.pcv->maxCUHeight != sps.getMaxCUHeight() || pcPic->layerId != layerId || pcPic->margin != picMargin )
     {
       pcPic->destroy();
 
-      pcPic->create(allocateWrappedPic, sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag());
+      pcPic->create(allocateWrappedPic, sps.getChromaFormatIdc(), Size( pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples() ), sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, true, layerId, getShutterFilterFlag(), scaledRefMargin);
+    }
+    else
+    {
+      pcPic->restoreReleasedBuffers();
     }
   }
 
@@ -742,6 +753,8 @@ void DecLib::xProcessStoredNALUnitsForSignature(int substreamId)
 
 void DecLib::executeLoopFilters()
 {
+  PROFILE_STAGE( "LoopFilters" );
+
   if( !m_pcPic )
   {
     return; // nothing to deblock
@@ -884,6 +897,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
 
   Slice*  pcSlice = m_pcPic->cs->slice;
   m_prevPicPOC = pcSlice->getPOC();
+  PROFILE_FINISH_PICTURE(m_pcPic->layerId, pcSlice->getPOC());
 #if GREEN_METADATA_SEI_ENABLED
   m_featureCounter.height = m_pcPic->Y().height;
   m_featureCounter.width = m_pcPic->Y().width;
@@ -1057,6 +1071,7 @@ void DecLib::finishPicture(int &poc, PicList *&rpcListPic, MsgLevel msgl, bool a
 
   m_pcPic->destroyTempBuffers();
   m_pcPic->cs->destroyTemporaryCsData();
+  m_pcPic->cs->compactMotion();
 #if !GDR_ENABLED
   m_pcPic->cs->picHeader->initPicHeader();
 #endif
@@ -2161,6 +2176,17 @@ void DecLib::xActivateParameterSets( const InputNALUnit nalu )
     m_apcSlicePilot->applyReferencePictureListBasedMarking(m_cListPic, m_apcSlicePilot->getRpl(REF_PIC_LIST_0),
                                                            m_apcSlicePilot->getRpl(REF_PIC_LIST_1), layerId, *pps);
 
+    if (m_leanPicBuffers)
+    {
+      for (Picture *pic: m_cListPic)
+      {
+        if (!pic->referenced && pic->reconstructed && pic->layerId == layerId)
+        {
+          pic->releaseUnreferencedBuffers(false);
+        }
+      }
+    }
+
     //  Get a new picture buffer. This will also set up m_pcPic, and therefore give us a SPS and PPS pointer that we can use.
     m_pcPic = xGetNewPicBuffer( *sps, *pps, m_apcSlicePilot->getTLayer(), layerId );
 
@@ -3662,6 +3688,7 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int &iSkipFrame, int iPOCLastDispl
           cs.getRecoBuf().Y().fill(0 * 4); // for 8-bit sequence
           cs.getRecoBuf().Cb().fill(0 * 4);
           cs.getRecoBuf().Cr().fill(0 * 4);
+          cs.createMotionBuf();
           cs.getMotionBuf().memset(0);    // clear MV storage
         }
       }
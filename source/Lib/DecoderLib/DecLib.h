@@ -179,6 +179,7 @@ private:
 
   std::list<InputNALUnit*> m_prefixSEINALUs; /// Buffered up prefix SEI NAL Units.
   bool                                m_ShutterFilterEnable;          ///< enable Post-processing with Shutter Interval SEI
+  bool                    m_leanPicBuffers;                   ///< free picture buffers that are only needed for reference
   int                     m_debugPOC;
   int                     m_debugCTU;
 
@@ -384,6 +385,8 @@ public:
 
   bool  getShutterFilterFlag()        const { return m_ShutterFilterEnable; }
   void  setShutterFilterFlag(bool value) { m_ShutterFilterEnable = value; }
+  void  setFilmGrainNumThreads(int numThreads) { m_grainCharacteristic.setNumThreads(numThreads); }
+  void  setLeanPicBuffers(bool value) { m_leanPicBuffers = value; }
 
   void applyNnPostFilter();
   void setPrevPicPOC(const int prevPicPoc) { m_prevPicPOC  = prevPicPoc;}
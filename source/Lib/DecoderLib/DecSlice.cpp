@@ -38,6 +38,7 @@
 #include "DecSlice.h"
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_next.h"
+#include "CommonLib/StageProfiler.h"
 
 #include <vector>
 
@@ -72,6 +73,8 @@ void DecSlice::init( CABACDecoder* cabacDecoder, DecCu* pcCuDecoder )
 
 void DecSlice::decompressSlice( Slice* slice, InputBitstream* bitstream, int debugCTU )
 {
+  PROFILE_STAGE( "DecodeSlice" );
+
   //-- For time output for each slice
   slice->startProcessingTimer();
 
@@ -282,7 +282,11 @@ class TBitEstimator : public BitEstimatorBase
 public:
   TBitEstimator ();
   ~TBitEstimator() {}
-  void            encodeBin(unsigned bin, unsigned ctxId) { m_ctx[ctxId].estFracBitsUpdate(bin, m_estFracBits); }
+  void            encodeBin(unsigned bin, unsigned ctxId)
+  {
+    m_ctx.journal(ctxId);
+    m_ctx[ctxId].estFracBitsUpdate(bin, m_estFracBits);
+  }
   void            encodeBinTrm(unsigned bin) { m_estFracBits += BinProbModel::estFracBitsTrm(bin); }
   void            setBinStorage     ( bool b )        {}
   const BinStore* getBinStore       ()          const { return 0; }
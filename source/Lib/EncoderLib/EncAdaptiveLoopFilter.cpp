@@ -35,6 +35,7 @@
  \brief    estimation part of adaptive loop filter class
  */
 #include "EncAdaptiveLoopFilter.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "CommonLib/Picture.h"
 #include "CommonLib/CodingStructure.h"
@@ -877,6 +878,8 @@ void EncAdaptiveLoopFilter::ALFProcess(CodingStructure& cs, const double *lambda
                                        , Picture* pcPic, uint32_t numSliceSegments
                                       )
 {
+  PROFILE_STAGE( "ALF" );
+
   // IRAP AU is assumed
   if( ( cs.slice->getPendingRasInit() || cs.slice->isIDRorBLA() || ( cs.slice->getNalUnitType() == NAL_UNIT_CODED_SLICE_CRA && m_encCfg->getCraAPSreset() ) ) )
   {
@@ -185,6 +185,10 @@ protected:
   bool      m_printMSSSIM;
   bool      m_printWPSNR;
   bool      m_printHighPrecEncTime = false;
+  int       m_metricNumThreads     = 1;
+  bool      m_fastMetrics          = false;
+  int       m_rescaleNumThreads    = 1;
+  bool      m_leanPicBuffers       = false;
   bool      m_cabacZeroWordPaddingEnabled;
   bool      m_ShutterFilterEnable;                          ///< enable Pre-Filtering with Shutter Interval SEI
   int       m_SII_BlendingRatio;
@@ -421,6 +425,9 @@ protected:
   int       m_mergeRdCandQuotaSubBlk;
   int       m_mergeRdCandQuotaCiip;
   int       m_mergeRdCandQuotaGpm;
+  int       m_mergeNumThreads = 1;
+  int       m_splitNumThreads = 1;
+  int       m_tileNumThreads = 1;
   bool      m_usePbIntraFast;
   bool      m_useAMaxBT;
   bool      m_e0023FastEnc;
@@ -436,6 +443,7 @@ protected:
   bool      m_disableFastDecisionTT;
   uint32_t  m_log2MaxTbSize;
   bool      m_useMttSkip;
+  int       m_fastPartitionDecision;
 
   //====== Loop/Deblock Filter ========
   bool      m_deblockingFilterDisable;
@@ -842,6 +850,7 @@ protected:
   uint8_t   m_fgcSEILog2ScaleFactor;
   bool      m_fgcSEICompModelPresent[MAX_NUM_COMPONENT];
   bool      m_fgcSEIAnalysisEnabled;
+  int       m_fgcSEIAnalysisNumThreads;
   std::string m_fgcSEIExternalMask;
   std::string m_fgcSEIExternalDenoised;
   int       m_fgcSEITemporalFilterPastRefs;
@@ -1034,6 +1043,8 @@ protected:
   bool      m_rcCpbSaturationEnabled = false;
   uint32_t  m_rcCpbSize;
   double    m_rcInitialCpbFullness;
+  int         m_rcPass = 0;
+  std::string m_rcStatsFileName;
   CostMode  m_costMode;                                       ///< The cost function to use, primarily when considering lossless coding.
   bool      m_TSRCdisableLL;                                  ///< Disable TSRC for lossless
 
@@ -1079,6 +1090,7 @@ protected:
   bool        m_forceDecodeBitstream1;                        ///< guess what it means
   int         m_switchPOC;                                    ///< dbg poc.
   int         m_switchDQP;                                    ///< dqp applied to  switchPOC and subsequent pictures.
+  mutable int m_appliedSwitchDQP = 0;                         ///< dqp applied to the current picture, set once switchPOC is reached
   int         m_fastForwardToPOC;                             ///<
   bool        m_stopAfterFFtoPOC;                             ///<
   int         m_debugCTU;                                     ///< dbg ctu
@@ -1407,6 +1419,15 @@ public:
   bool getPrintHighPrecEncTime() const { return m_printHighPrecEncTime; }
   void setPrintHightPrecEncTime(bool val) { m_printHighPrecEncTime = val; }
 
+  int       getMetricNumThreads             ()         const { return m_metricNumThreads;          }
+  void      setMetricNumThreads             (int n)          { m_metricNumThreads = n;             }
+  bool      getFastMetrics                  ()         const { return m_fastMetrics;               }
+  void      setFastMetrics                  (bool b)         { m_fastMetrics = b;                  }
+  int       getRescaleNumThreads            ()         const { return m_rescaleNumThreads;         }
+  void      setRescaleNumThreads            (int n)          { m_rescaleNumThreads = n;            }
+  bool      getLeanPicBuffers               ()         const { return m_leanPicBuffers;            }
+  void      setLeanPicBuffers               (bool b)         { m_leanPicBuffers = b;               }
+
   bool      getCabacZeroWordPaddingEnabled()           const { return m_cabacZeroWordPaddingEnabled;  }
   void      setCabacZeroWordPaddingEnabled(bool value)       { m_cabacZeroWordPaddingEnabled = value; }
 
@@ -1747,6 +1768,12 @@ public:
   int       getMergeRdCandQuotaCiip         () const         { return m_mergeRdCandQuotaCiip;}
   void      setMergeRdCandQuotaGpm          ( int n )        { m_mergeRdCandQuotaGpm = n;}
   int       getMergeRdCandQuotaGpm          () const         { return m_mergeRdCandQuotaGpm;}
+  void      setMergeNumThreads              ( int n )        { m_mergeNumThreads = n;}
+  int       getMergeNumThreads              () const         { return m_mergeNumThreads;}
+  void      setSplitNumThreads              ( int n )        { m_splitNumThreads = n;}
+  int       getSplitNumThreads              () const         { return m_splitNumThreads;}
+  void      setTileNumThreads               ( int n )        { m_tileNumThreads = n;}
+  int       getTileNumThreads               () const         { return m_tileNumThreads;}
   void      setUsePbIntraFast               ( bool  n )      { m_usePbIntraFast = n; }
   bool      getUsePbIntraFast               () const         { return m_usePbIntraFast; }
   void      setUseAMaxBT                    ( bool  n )      { m_useAMaxBT = n; }
@@ -1777,8 +1804,11 @@ public:
 
   void      setUseMttSkip                   (bool i)         { m_useMttSkip = i; }
   bool      getUseMttSkip                   () const         { return m_useMttSkip; }
+  void      setFastPartitionDecision        (int i)          { m_fastPartitionDecision = i; }
+  int       getFastPartitionDecision        () const         { return m_fastPartitionDecision; }
  
   void      setLog2MaxTbSize                ( uint32_t  u )   { m_log2MaxTbSize = u; }
+  uint32_t  getLog2MaxTbSize                () const          { return m_log2MaxTbSize; }
 
   //====== Loop/Deblock Filter ========
   void      setDeblockingFilterDisable      ( bool  b )      { m_deblockingFilterDisable           = b; }
@@ -1798,6 +1828,7 @@ public:
     m_searchRange = i;
   }
   void      setBipredSearchRange            ( int   i )      { m_bipredSearchRange = i; }
+  int       getBipredSearchRange            () const         { return m_bipredSearchRange; }
   void      setClipForBiPredMeEnabled       ( bool  b )      { m_bClipForBiPredMeEnabled = b; }
   void      setFastMEAssumingSmootherMVEnabled ( bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   void      setMinSearchWindow              ( int   i )      { m_minSearchWindow = i; }
@@ -2628,6 +2659,8 @@ public:
   bool*     getFGCSEICompModelPresent                 ()                        { return m_fgcSEICompModelPresent; }
   void      setFilmGrainAnalysisEnabled               (bool b)                  { m_fgcSEIAnalysisEnabled = b; }
   bool      getFilmGrainAnalysisEnabled               ()                        { return m_fgcSEIAnalysisEnabled; }
+  void      setFilmGrainAnalysisNumThreads            (int n)                   { m_fgcSEIAnalysisNumThreads = n; }
+  int       getFilmGrainAnalysisNumThreads            ()                        { return m_fgcSEIAnalysisNumThreads; }
   void        setFilmGrainExternalMask(std::string s) { m_fgcSEIExternalMask = s; }
   void        setFilmGrainExternalDenoised(std::string s) { m_fgcSEIExternalDenoised = s; }
   std::string getFilmGrainExternalMask() { return m_fgcSEIExternalMask; }
@@ -2985,6 +3018,10 @@ public:
   void         setCpbSize(uint32_t ui) { m_rcCpbSize = ui; }
   double       getInitialCpbFullness() { return m_rcInitialCpbFullness; }
   void         setInitialCpbFullness(double f) { m_rcInitialCpbFullness = f; }
+  int          getRCPass() const { return m_rcPass; }
+  void         setRCPass(int i) { m_rcPass = i; }
+  const std::string &getRCStatsFileName() const { return m_rcStatsFileName; }
+  void         setRCStatsFileName(const std::string &s) { m_rcStatsFileName = s; }
   CostMode     getCostMode( ) const                                  { return m_costMode; }
   void         setCostMode(CostMode m )                              { m_costMode = m; }
   bool         getTSRCdisableLL       ()                             { return m_TSRCdisableLL;         }
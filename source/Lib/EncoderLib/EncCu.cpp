@@ -44,6 +44,7 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/Picture.h"
 #include "CommonLib/UnitTools.h"
+#include "CommonLib/StageProfiler.h"
 #include "MCTS.h"
 
 
@@ -67,9 +68,35 @@ const MergeIdxPair EncCu::m_geoModeTest[GEO_MAX_NUM_CANDS] = {
   MergeIdxPair{ 5, 0 }, MergeIdxPair{ 5, 1 }, MergeIdxPair{ 5, 2 }, MergeIdxPair{ 5, 3 }, MergeIdxPair{ 5, 4 }
 };
 
-EncCu::EncCu() {}
+struct EncCu::WorkerSearch
+{
+  IntraSearch      intraSearch;
+  InterSearch      interSearch;
+  TrQuant          trQuant;
+  RdCost           rdCost;
+  CABACEncoder     cabacEncoder;
+  CtxPool          ctxPool;
+  DeblockingFilter deblockingFilter;
+};
 
-void EncCu::create( EncCfg* encCfg )
+struct EncCu::SplitJob
+{
+  EncCu            cuEncoder;
+  QTBTPartitioner  partitioner;
+
+  CodingStructure *spareCS  = nullptr;   // receives the coded split, swapped with the temporary CS of the job
+  CodingStructure *resultCS = nullptr;
+  Ctx              resultCtx;
+  double           splitRdCost = MAX_DOUBLE;
+  EncTestMode      testMode;
+  uint32_t         depth   = 0;
+  int              ctuRsAddr = -1;   // CTU of the last run, -1 at the start of a slice
+  bool             pending = false;
+};
+
+EncCu::EncCu() : m_picCsMutex( nullptr ), m_splitJob( nullptr ) {}
+
+void EncCu::create( EncCfg* encCfg, const bool isWorker )
 {
   unsigned      uiMaxWidth    = encCfg->getMaxCUWidth();
   unsigned      uiMaxHeight   = encCfg->getMaxCUHeight();
@@ -85,6 +112,13 @@ void EncCu::create( EncCfg* encCfg )
   m_pelUnitBufPool.initPelUnitBufPool(chromaFormat, uiMaxWidth, uiMaxHeight);
   m_mergeItemList.init(encCfg->getMaxMergeRdCandNumTotal(), chromaFormat, uiMaxWidth, uiMaxHeight);
 
+  // the worker encoders run on worker threads themselves and evaluate the merge candidates serially
+  m_mergeThreadPool = std::make_unique<ParallelForPool>(isWorker ? 1 : encCfg->getMergeNumThreads());
+  for (int i = 1; i < m_mergeThreadPool->getNumThreads(); i++)
+  {
+    m_mergeInterPred.push_back(new InterPrediction);
+  }
+
   for( unsigned w = 0; w < numWidths; w++ )
   {
     m_pTempCS[w] = new CodingStructure*  [numHeights];
@@ -132,6 +166,33 @@ void EncCu::create( EncCfg* encCfg )
 
   m_ctxBuffer.resize(maxDepth);
   m_CurrCtx = 0;
+
+  if (isWorker)
+  {
+    m_workerSearch = std::make_unique<WorkerSearch>();
+    m_workerSearch->deblockingFilter.create(floorLog2(uiMaxWidth) - MIN_CU_LOG2);
+    if (!encCfg->getDeblockingFilterDisable() && encCfg->getUseEncDbOpt())
+    {
+      m_workerSearch->deblockingFilter.initEncPicYuvBuffer(chromaFormat,
+                                                           Size(encCfg->getSourceWidth(), encCfg->getSourceHeight()),
+                                                           uiMaxWidth);
+    }
+  }
+  else if (encCfg->getSplitNumThreads() > 1)
+  {
+    m_splitThreadPool = std::make_unique<ParallelForPool>(encCfg->getSplitNumThreads());
+
+    for (int i = 0; i < CU_TRIV_SPLIT - CU_QUAD_SPLIT + 1; i++)
+    {
+      m_splitJobs.push_back(std::make_unique<SplitJob>());
+
+      SplitJob &job = *m_splitJobs.back();
+      job.cuEncoder.create(encCfg, true);
+      job.spareCS = new CodingStructure(job.cuEncoder.m_unitPool);
+      job.spareCS->create(chromaFormat, Area(0, 0, 64, 64), false, (bool) encCfg->getPLTMode());
+    }
+    m_splitPicBufs.resize(2 * m_splitJobs.size());
+  }
 }
 
 
@@ -196,6 +257,32 @@ void EncCu::destroy()
   delete m_modeCtrl;
   m_modeCtrl = nullptr;
 
+  for (auto interPred: m_mergeInterPred)
+  {
+    delete interPred;
+  }
+  m_mergeInterPred.clear();
+  m_mergeThreadPool.reset();
+
+  for (auto &job: m_splitJobs)
+  {
+    job->spareCS->destroy();
+    delete job->spareCS;
+    job->cuEncoder.destroy();
+  }
+  m_splitJobs.clear();
+  m_splitThreadPool.reset();
+  for (auto &buf: m_splitPicBufs)
+  {
+    buf.destroy();
+  }
+  m_splitPicBufs.clear();
+
+  if (m_workerSearch)
+  {
+    m_workerSearch->deblockingFilter.destroy();
+    m_workerSearch.reset();
+  }
 }
 
 EncCu::~EncCu()
@@ -206,31 +293,139 @@ EncCu::~EncCu()
  */
 void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 {
-  m_pcEncCfg           = pcEncLib;
-  m_pcIntraSearch      = pcEncLib->getIntraSearch();
-  m_pcInterSearch      = pcEncLib->getInterSearch();
-  m_pcTrQuant          = pcEncLib->getTrQuant();
-  m_pcRdCost           = pcEncLib->getRdCost ();
-  m_CABACEstimator     = pcEncLib->getCABACEncoder()->getCABACEstimator( &sps );
-  m_CABACEstimator->setEncCu(this);
-  m_ctxPool            = pcEncLib->getCtxCache();
   m_pcRateCtrl         = pcEncLib->getRateCtrl();
   m_pcSliceEncoder     = pcEncLib->getSliceEncoder();
-  m_deblockingFilter   = pcEncLib->getDeblockingFilter();
+
+  xInitSearch( pcEncLib, pcEncLib->getIntraSearch(), pcEncLib->getInterSearch(), pcEncLib->getTrQuant(), pcEncLib->getRdCost(),
+               pcEncLib->getCABACEncoder()->getCABACEstimator( &sps ), pcEncLib->getCtxCache(), pcEncLib->getDeblockingFilter() );
+
+  m_pcGOPEncoder = pcEncLib->getGOPEncoder();
+  m_pcGOPEncoder->setModeCtrl( m_modeCtrl );
+
+  for (auto &job: m_splitJobs)
+  {
+    job->cuEncoder.initWorker( pcEncLib, sps, &m_splitPicCsMutex );
+    job->cuEncoder.m_splitJob = job.get();
+  }
+}
+
+void EncCu::xInitSearch( EncCfg* encCfg, IntraSearch* intraSearch, InterSearch* interSearch, TrQuant* trQuant, RdCost* rdCost,
+                         CABACWriter* cabacEstimator, CtxPool* ctxPool, DeblockingFilter* deblockingFilter )
+{
+  m_pcEncCfg           = encCfg;
+  m_pcIntraSearch      = intraSearch;
+  m_pcInterSearch      = interSearch;
+  m_pcTrQuant          = trQuant;
+  m_pcRdCost           = rdCost;
+  m_CABACEstimator     = cabacEstimator;
+  m_CABACEstimator->setEncCu(this);
+  m_ctxPool            = ctxPool;
+  m_deblockingFilter   = deblockingFilter;
   m_geoCostList.init(m_pcEncCfg->getMaxNumGeoCand());
   m_AFFBestSATDCost = MAX_DOUBLE;
 
   DecCu::init( m_pcTrQuant, m_pcIntraSearch, m_pcInterSearch );
 
+  for (auto interPred: m_mergeInterPred)
+  {
+    interPred->init(m_pcRdCost, m_pcEncCfg->getChromaFormatIdc(), m_pcEncCfg->getMaxCUHeight());
+  }
+
   m_modeCtrl->init( m_pcEncCfg, m_pcRateCtrl, m_pcRdCost );
   m_modeCtrl->setBIMQPMap( m_pcEncCfg->getAdaptQPmap() );
 
   m_pcInterSearch->setModeCtrl( m_modeCtrl );
   m_modeCtrl->setInterSearch(m_pcInterSearch);
   m_pcIntraSearch->setModeCtrl( m_modeCtrl );
+}
 
-  m_pcGOPEncoder = pcEncLib->getGOPEncoder();
-  m_pcGOPEncoder->setModeCtrl( m_modeCtrl );
+/// sets up the search components of a worker encoder like EncLib::init does for the main encoder; the state that
+/// changes during encoding is copied from the main encoder whenever a split job or a tile is started
+void EncCu::initWorker( EncLib* pcEncLib, const SPS& sps, std::mutex* picCsMutex )
+{
+  CHECK( !m_workerSearch, "Not created as worker encoder" );
+
+  WorkerSearch  &search          = *m_workerSearch;
+  EncCfg        *encCfg          = pcEncLib;
+  const unsigned maxCUWidth      = encCfg->getMaxCUWidth();
+  const unsigned maxCUHeight     = encCfg->getMaxCUHeight();
+  const unsigned maxTotalCUDepth = floorLog2(maxCUWidth) - encCfg->getLog2MinCodingBlockSize();
+  const int      maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] = { sps.getMaxLog2TrDynamicRange(ChannelType::LUMA),
+                                                                 sps.getMaxLog2TrDynamicRange(ChannelType::CHROMA) };
+
+  search.trQuant.init( nullptr, 1 << encCfg->getLog2MaxTbSize(), encCfg->getUseRDOQ(), encCfg->getUseRDOQTS(),
+                       encCfg->getUseSelectiveRDOQ(), true );
+  search.trQuant.getQuant()->setFlatScalingList( maxLog2TrDynamicRange, sps.getBitDepths() );
+  search.trQuant.getQuant()->setUseScalingList( false );
+
+  CABACWriter *cabacEstimator = search.cabacEncoder.getCABACEstimator( &sps );
+  search.intraSearch.init( encCfg, &search.trQuant, &search.rdCost, cabacEstimator, &search.ctxPool, maxCUWidth, maxCUHeight,
+                           maxTotalCUDepth, pcEncLib->getReshaper(), sps.getBitDepth(ChannelType::LUMA) );
+  search.interSearch.init( encCfg, &search.trQuant, encCfg->getSearchRange(), encCfg->getBipredSearchRange(),
+                           encCfg->getMotionEstimationSearchMethod(), encCfg->getUseCompositeRef(), maxCUWidth, maxCUHeight,
+                           maxTotalCUDepth, &search.rdCost, cabacEstimator, &search.ctxPool, pcEncLib->getReshaper() );
+  search.interSearch.setTempBuffers( search.intraSearch.getSplitCSBuf(), search.intraSearch.getFullCSBuf(),
+                                     search.intraSearch.getSaveCSBuf() );
+
+  m_pcRateCtrl     = pcEncLib->getRateCtrl();
+  m_pcSliceEncoder = pcEncLib->getSliceEncoder();
+  m_pcGOPEncoder   = nullptr;
+  xInitSearch( encCfg, &search.intraSearch, &search.interSearch, &search.trQuant, &search.rdCost, cabacEstimator,
+               &search.ctxPool, &search.deblockingFilter );
+  m_picCsMutex = picCsMutex;
+}
+
+/// takes the state set up per slice, the slices of a picture may be compressed together after all are set up
+void EncCu::saveSliceState( SliceState& sliceState ) const
+{
+  sliceState.rdCost = *m_pcRdCost;
+#if RDOQ_CHROMA_LAMBDA
+  m_pcTrQuant->getLambdas( sliceState.lambdas );
+#endif
+  sliceState.lambda = m_pcTrQuant->getLambda();
+  m_pcInterSearch->saveSliceState( sliceState.interSearch );
+  sliceState.fastDeltaQp = m_modeCtrl->getFastDeltaQp();
+  sliceState.doPlt       = m_modeCtrl->getPltEnc();
+}
+
+/// every tile starts from the search state of the main encoder at the start of its slice, so that the tiles neither
+/// depend on each other nor on the worker compressing them
+void EncCu::initTile( const EncCu& master, const SliceState& sliceState )
+{
+  m_pcTrQuant->copyState( *master.m_pcTrQuant );
+  m_pcInterSearch->copyState( *master.m_pcInterSearch );
+  m_pcInterSearch->resetReusedUniMvs();
+  m_modeCtrl->copySliceState( *master.m_modeCtrl );
+
+  *m_pcRdCost = sliceState.rdCost;
+#if RDOQ_CHROMA_LAMBDA
+  m_pcTrQuant->setLambdas( sliceState.lambdas );
+#endif
+  m_pcTrQuant->setLambda( sliceState.lambda );
+  m_pcInterSearch->loadSliceState( sliceState.interSearch );
+  m_modeCtrl->setFastDeltaQp( sliceState.fastDeltaQp );
+  m_modeCtrl->setPltEnc( sliceState.doPlt );
+
+  m_AFFBestSATDCost   = master.m_AFFBestSATDCost;
+  m_mergeBestSATDCost = master.m_mergeBestSATDCost;
+}
+
+void EncCu::setDecCuReshaperInEncCU( EncReshape* pcReshape, ChromaFormat chromaFormatIdc )
+{
+  initDecCuReshaper( (Reshape*) pcReshape, chromaFormatIdc );
+
+  for (auto &job: m_splitJobs)
+  {
+    job->cuEncoder.setDecCuReshaperInEncCU( pcReshape, chromaFormatIdc );
+  }
+}
+
+void EncCu::resetSplitJobs()
+{
+  for (auto &job: m_splitJobs)
+  {
+    job->ctuRsAddr = -1;
+  }
 }
 
 // ====================================================================================================================
@@ -240,6 +435,8 @@ void EncCu::init( EncLib* pcEncLib, const SPS& sps )
 void EncCu::compressCtu(CodingStructure &cs, const UnitArea &area, const unsigned ctuRsAddr,
                         const EnumArray<int, ChannelType> &prevQP, const EnumArray<int, ChannelType> &currQP)
 {
+  PROFILE_STAGE( "CompressCtu" );
+
   m_modeCtrl->initCTUEncoding( *cs.slice );
   cs.treeType = TREE_D;
 
@@ -448,6 +645,17 @@ bool EncCu::xCheckBestMode( CodingStructure *&tempCS, CodingStructure *&bestCS,
 {
   bool bestCSUpdated = false;
 
+  if( m_splitJob && partitioner.currDepth == m_splitJob->depth )
+  {
+    // the coded split of a split job is selected by the main encoder, keep it and continue with the spare structure
+    m_splitJob->resultCtx   = m_CABACEstimator->getCtx();
+    m_splitJob->splitRdCost = tempCS->cost;
+    m_splitJob->resultCS    = tempCS;
+    std::swap( tempCS, m_splitJob->spareCS );
+    m_CABACEstimator->getCtx() = m_CurrCtx->start;
+    return false;
+  }
+
   if( !tempCS->cus.empty() )
   {
     if( tempCS->cus.size() == 1 )
@@ -479,6 +687,8 @@ bool EncCu::xCheckBestMode( CodingStructure *&tempCS, CodingStructure *&bestCS,
 
 void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Partitioner& partitioner, double maxCostAllowed )
 {
+  PROFILE_COUNT( "CUsTested", 1 );
+
   CHECK(maxCostAllowed < 0, "Wrong value of maxCostAllowed!");
 
   uint32_t compBegin;
@@ -702,6 +912,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     m_bestBcwCost.fill(std::numeric_limits<double>::max());
     m_bestBcwIdx.fill(BCW_NUM);
   }
+  bool splitJobsChecked = false;
   do
   {
     for (int i = compBegin; i < (compBegin + numComp); i++)
@@ -717,7 +928,7 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     {
       const Position chromaCentral(tempCS->area.Cb().chromaPos().offset(tempCS->area.Cb().chromaSize().width >> 1, tempCS->area.Cb().chromaSize().height >> 1));
       const Position lumaRefPos(chromaCentral.x << getComponentScaleX(COMPONENT_Cb, tempCS->area.chromaFormat), chromaCentral.y << getComponentScaleY(COMPONENT_Cb, tempCS->area.chromaFormat));
-      const CodingStructure* baseCS = bestCS->picture->cs;
+      const CodingStructure* baseCS = &bestCS->getTopLevelCS();
       const CodingUnit      *colLumaCu = baseCS->getCU(lumaRefPos, ChannelType::LUMA);
 
       if (colLumaCu)
@@ -874,6 +1085,14 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
       {
         splitmode = bestCS->cus[0]->splitSeries;
       }
+      if (!splitJobsChecked)
+      {
+        splitJobsChecked = true;
+        if (xCanStartSplitJobs(*tempCS, partitioner, modeTypeParent))
+        {
+          xStartSplitJobs(tempCS, bestCS, partitioner, currTestMode, modeTypeParent, splitRdCostBest);
+        }
+      }
       assert( partitioner.modeType == tempCS->modeType );
       int signalModeConsVal = tempCS->signalModeCons( getPartSplit( currTestMode ), partitioner, modeTypeParent );
       int numRoundRdo = signalModeConsVal == LDT_MODE_TYPE_SIGNAL ? 2 : 1;
@@ -912,7 +1131,14 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
           }
         }
 
-        xCheckModeSplit( tempCS, bestCS, partitioner, currTestMode, modeTypeParent, skipInterPass, splitRdCostBest );
+        if (const SplitJob *splitJob = xGetSplitJobResult(currTestMode, partitioner))
+        {
+          xUseSplitJobResult(tempCS, bestCS, partitioner, currTestMode, *splitJob, splitRdCostBest);
+        }
+        else
+        {
+          xCheckModeSplit(tempCS, bestCS, partitioner, currTestMode, modeTypeParent, skipInterPass, splitRdCostBest);
+        }
         tempCS->splitRdCostBest = splitRdCostBest;
         //recover cons modes
         tempCS->modeType = partitioner.modeType = modeTypeParent;
@@ -954,6 +1180,14 @@ void EncCu::xCompressCU( CodingStructure*& tempCS, CodingStructure*& bestCS, Par
     }
   } while( m_modeCtrl->nextMode( *tempCS, partitioner ) );
 
+  if (splitJobsChecked)
+  {
+    for (auto &job: m_splitJobs)
+    {
+      job->pending = false;
+    }
+  }
+
 
   //////////////////////////////////////////////////////////////////////////
   // Finishing CU
@@ -1375,9 +1609,21 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       }
     }
     assert( tempCS->treeType == TREE_L );
+    // the split jobs share picture->cs for the chroma blocks of local dual trees
+    std::unique_lock<std::mutex> picCsLock;
+    if (m_picCsMutex)
+    {
+      picCsLock = std::unique_lock<std::mutex>(*m_picCsMutex);
+    }
+    CodingStructure &topLevelCS = tempCS->getTopLevelCS();
+    CHECK( m_picCsMutex
+             && ( topLevelCS.cus.size() + tempCS->cus.size() > topLevelCS.cus.capacity()
+                  || topLevelCS.pus.size() + tempCS->pus.size() > topLevelCS.pus.capacity()
+                  || topLevelCS.tus.size() + tempCS->tus.size() > topLevelCS.tus.capacity() ),
+           "Units of the split jobs exceed the reserved picture units" );
     uint32_t numCuPuTu[6];
-    tempCS->picture->cs->getNumCuPuTuOffset( numCuPuTu );
-    tempCS->picture->cs->useSubStructure( *tempCS, partitioner.chType, CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), false, true, false, false, false );
+    topLevelCS.getNumCuPuTuOffset( numCuPuTu );
+    topLevelCS.useSubStructure( *tempCS, partitioner.chType, CS::getArea( *tempCS, partitioner.currArea(), partitioner.chType ), false, true, false, false, false );
 
     if (isChromaEnabled(tempCS->pcv->chrFormat))
     {
@@ -1409,7 +1655,7 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
       // tempCS->picture->cs->releaseIntermediateData();
       m_CurrCtx--;
     }
-    tempCS->picture->cs->clearCuPuTuIdxMap( partitioner.currArea(), numCuPuTu[0], numCuPuTu[1], numCuPuTu[2], numCuPuTu + 3 );
+    topLevelCS.clearCuPuTuIdxMap( partitioner.currArea(), numCuPuTu[0], numCuPuTu[1], numCuPuTu[2], numCuPuTu + 3 );
 
 
     //recover luma tree status
@@ -1524,8 +1770,271 @@ void EncCu::xCheckModeSplit(CodingStructure *&tempCS, CodingStructure *&bestCS,
   tempCS->prevQP[partitioner.chType] = oldPrevQp;
 }
 
+/// the split modes of a 64x64 luma node are evaluated by the split jobs if the coding does not depend on state shared
+/// beyond the node (QP adaptation, chroma QP offsets, palette and IBC predictors) or on the ordering of local dual trees
+bool EncCu::xCanStartSplitJobs( const CodingStructure& cs, const Partitioner& partitioner, const ModeType modeTypeParent ) const
+{
+  if( m_splitJobs.empty() || !isLuma( partitioner.chType ) || partitioner.treeType != TREE_D || modeTypeParent != MODE_TYPE_ALL )
+  {
+    return false;
+  }
+
+  const Area &lumaArea = cs.area.Y();
+  if( lumaArea.width != 64 || lumaArea.height != 64 || lumaArea.x + lumaArea.width > cs.picture->lwidth()
+      || lumaArea.y + lumaArea.height > cs.picture->lheight() )
+  {
+    return false;
+  }
+
+  const Slice &slice = *cs.slice;
+  const SPS   &sps   = *cs.sps;
+  if( cs.pps->getUseDQP() || slice.getUseChromaQpAdj() || sps.getIBCFlag() || sps.getPLTMode() || sps.getUseColorTrans()
+      || sps.getScalingListFlag() )
+  {
+    return false;
+  }
+  if( cs.slice->getRpl( REF_PIC_LIST_0 )->getNumberOfInterLayerPictures() + cs.slice->getRpl( REF_PIC_LIST_1 )->getNumberOfInterLayerPictures() > 0 )
+  {
+    return false;
+  }
+#if GDR_ENABLED
+  if( m_pcEncCfg->getGdrEnabled() )
+  {
+    return false;
+  }
+#endif
+#if SHARP_LUMA_DELTA_QP
+  if( m_pcEncCfg->getLumaLevelToDeltaQPMapping().isEnabled() )
+  {
+    return false;
+  }
+#endif
+  return !m_pcEncCfg->getBIM() && !m_pcEncCfg->getSmoothQPReductionEnable();
+}
+
+/// runs the pending split modes of the current node on the split jobs, each job starts from the state of the main
+/// encoder at this point, so that the results neither depend on each other nor on the number of threads
+void EncCu::xStartSplitJobs( CodingStructure* tempCS, CodingStructure* bestCS, Partitioner& partitioner, const EncTestMode& encTestMode,
+                             const ModeType modeTypeParent, const double* splitRdCostBest )
+{
+  m_modeCtrl->getPendingSplitModes( *tempCS, partitioner, m_splitModes );
+
+  // modes signalling a mode constraint are coded in two rounds and stay with the main encoder
+  m_splitModes.erase( std::remove_if( m_splitModes.begin(), m_splitModes.end(),
+                                      [&]( const EncTestMode &mode ) {
+                                        return tempCS->signalModeCons( getPartSplit( mode ), partitioner, modeTypeParent ) != LDT_MODE_TYPE_INHERIT;
+                                      } ),
+                      m_splitModes.end() );
+
+  if( m_splitModes.size() < 2 )
+  {
+    return;
+  }
+  CHECK( m_splitModes.size() > m_splitJobs.size(), "Too many split modes" );
+
+  Picture             &pic = *tempCS->picture;
+  const PreCalcValues &pcv = *tempCS->pcv;
+
+  if( m_splitPicBufs[0].bufs.empty() || m_splitPicBufs[0].Y().width != pic.lwidth() || m_splitPicBufs[0].Y().height != pic.lheight() )
+  {
+    for( size_t i = 0; i < m_splitPicBufs.size(); i += 2 )
+    {
+      m_splitPicBufs[i].destroy();
+      m_splitPicBufs[i].create( pic.chromaFormat, Area( Position(), pic.lumaSize() ), pcv.maxCUWidth, pic.margin, MEMORY_ALIGN_DEF_SIZE );
+      m_splitPicBufs[i + 1].destroy();
+      m_splitPicBufs[i + 1].create( pic.chromaFormat, Area( 0, 0, pcv.maxCUWidth, pcv.maxCUHeight ) );
+    }
+  }
+
+  // local dual trees of the jobs add their luma units to picture->cs, one at a time under m_picCsMutex and at most one
+  // CU, PU and TU per minimum sized block of the node. The readers of the other jobs must not see the unit vectors
+  // reallocated
+  const size_t maxUnits = tempCS->area.Y().area() >> ( 2 * MIN_CU_LOG2 );
+  pic.cs->cus.reserve( pic.cs->cus.size() + maxUnits );
+  pic.cs->pus.reserve( pic.cs->pus.size() + maxUnits );
+  pic.cs->tus.reserve( pic.cs->tus.size() + maxUnits );
+
+  const int ctuRsAddr = getCtuAddr( tempCS->area.lumaPos(), pcv );
+
+  for( size_t i = 0; i < m_splitModes.size(); i++ )
+  {
+    SplitJob &job = *m_splitJobs[i];
+
+    job.testMode                = m_splitModes[i];
+    job.testMode.maxCostAllowed = encTestMode.maxCostAllowed;
+    job.depth                   = partitioner.currDepth;
+  }
+
+  pic.setSplitPicBufs( &m_splitPicBufs );
+  m_splitThreadPool->run( (int) m_splitModes.size(), [&]( int jobIdx, int )
+  {
+    SplitJob  &job      = *m_splitJobs[jobIdx];
+    const bool newSlice = job.ctuRsAddr < 0;
+    const bool newCtu   = job.ctuRsAddr != ctuRsAddr;
+
+    job.ctuRsAddr = ctuRsAddr;
+
+    scheduler.setSplitPicId( jobIdx + 1 );
+    job.cuEncoder.xRunSplitJob( job, *this, *tempCS, *bestCS, partitioner, splitRdCostBest, newSlice, newCtu );
+    scheduler.setSplitPicId( 0 );
+  } );
+  pic.setSplitPicBufs( nullptr );
+
+  for( size_t i = 0; i < m_splitModes.size(); i++ )
+  {
+    m_splitJobs[i]->pending = m_splitJobs[i]->resultCS != nullptr;
+  }
+}
+
+/// evaluates the split mode of the job on this (job) encoder, the state is taken over from the main encoder
+void EncCu::xRunSplitJob( SplitJob& job, const EncCu& master, const CodingStructure& masterTempCS, const CodingStructure& masterBestCS,
+                          const Partitioner& masterPartitioner, const double* splitRdCostBest, const bool newSlice, const bool newCtu )
+{
+  Picture     &pic   = *masterTempCS.picture;
+  const Slice &slice = *masterTempCS.slice;
+  const SPS   &sps   = *masterTempCS.sps;
+  const UnitArea &area = masterTempCS.area;
+
+  // reconstructed neighbourhood: intra reference samples up to twice the block size, LMCS chroma scaling and the
+  // deblocking of the edges in the RD cost
+  const int   margin   = 8;
+  const Area &lumaArea = area.Y();
+  const int   x0       = std::max( 0, lumaArea.x - margin );
+  const int   y0       = std::max( 0, lumaArea.y - margin );
+  const int   x1       = std::min( (int) pic.lwidth(), lumaArea.x + 2 * (int) lumaArea.width + margin );
+  const int   y1       = std::min( (int) pic.lheight(), lumaArea.y + 2 * (int) lumaArea.height + margin );
+  const Area  bands[2] = { Area( x0, y0, x1 - x0, lumaArea.y - y0 ), Area( x0, lumaArea.y, lumaArea.x - x0, y1 - lumaArea.y ) };
+
+  for( const Area &band: bands )
+  {
+    if( band.width > 0 && band.height > 0 )
+    {
+      const UnitArea unitBand( pic.chromaFormat, band );
+      pic.getRecoBuf( unitBand ).copyFrom( pic.M_BUFS( 0, PIC_RECONSTRUCTION ).getBuf( unitBand ) );
+    }
+  }
+
+  // search state
+  *m_pcRdCost = *master.m_pcRdCost;
+  m_pcTrQuant->copyState( *master.m_pcTrQuant );
+  m_pcInterSearch->copyState( *master.m_pcInterSearch );
+  if( newSlice )
+  {
+    m_pcInterSearch->resetReusedUniMvs();
+    m_CABACEstimator->initCtxModels( slice );
+  }
+  m_CABACEstimator->getCtx() = master.m_CABACEstimator->getCtx();
+
+  m_CurrCtx  = &m_ctxBuffer[master.m_CurrCtx - &master.m_ctxBuffer[0]];
+  *m_CurrCtx = *master.m_CurrCtx;
+
+  m_bestModeUpdated          = master.m_bestModeUpdated;
+  m_cuChromaQpOffsetIdxPlus1 = master.m_cuChromaQpOffsetIdxPlus1;
+  m_sbtCostSave[0]           = master.m_sbtCostSave[0];
+  m_sbtCostSave[1]           = master.m_sbtCostSave[1];
+  m_bestBcwIdx               = master.m_bestBcwIdx;
+  m_bestBcwCost              = master.m_bestBcwCost;
+  m_AFFBestSATDCost          = master.m_AFFBestSATDCost;
+  m_mergeBestSATDCost        = master.m_mergeBestSATDCost;
+
+  // coding structures of the node
+  const unsigned   wIdx     = gp_sizeIdxInfo->idxFrom( area.lwidth() );
+  const unsigned   hIdx     = gp_sizeIdxInfo->idxFrom( area.lheight() );
+  CodingStructure *tempCS   = m_pTempCS[wIdx][hIdx];
+  CodingStructure *bestCS   = m_pBestCS[wIdx][hIdx];
+  CodingStructure &parentCS = *masterTempCS.parent;
+  const ChannelType chType  = masterPartitioner.chType;
+
+  for( CodingStructure *cs: { tempCS, bestCS, job.spareCS } )
+  {
+    parentCS.initSubStructure( *cs, chType, area, false );
+    cs->bestParent = masterTempCS.bestParent;
+    cs->baseQP     = masterTempCS.baseQP;
+    cs->prevQP     = masterTempCS.prevQP;
+    cs->currQP     = masterTempCS.currQP;
+    cs->motionLut  = masterTempCS.motionLut;
+    cs->prevPLT    = masterTempCS.prevPLT;
+    cs->modeType   = masterTempCS.modeType;
+    cs->treeType   = masterTempCS.treeType;
+  }
+
+  bestCS->copyStructure( masterBestCS, chType, true, true );
+  bestCS->prevQP    = masterBestCS.prevQP;
+  bestCS->useDbCost = masterBestCS.useDbCost;
+  bestCS->lumaCost  = masterBestCS.lumaCost;
+  bestCS->interHad  = masterBestCS.interHad;
+  bestCS->features  = masterBestCS.features;
+
+  m_modeCtrl->copyState( *master.m_modeCtrl, *bestCS, newCtu );
+  if( newCtu && !slice.isIntra() && ( sps.getUseSBT() || sps.getExplicitMtsInterEnabled() ) )
+  {
+    auto slsSbt = dynamic_cast<SaveLoadEncInfoSbt*>( m_modeCtrl );
+    slsSbt->resetSaveloadSbt( sps.getUseSBT() ? sps.getMaxTbSize() : MTS_INTER_MAX_CU_SIZE );
+  }
+  m_pcIntraSearch->setSaveCuCostInSCIPU( false );
+  m_pcIntraSearch->setNumCuInSCIPU( 0 );
+
+  Partitioner &partitioner = job.partitioner;
+  partitioner.copyState( masterPartitioner );
+  partitioner.treeType = masterPartitioner.treeType;
+  partitioner.modeType = masterPartitioner.modeType;
+
+  double jobSplitRdCostBest[NUM_PART_SPLIT];
+  std::copy_n( splitRdCostBest, NUM_PART_SPLIT, jobSplitRdCostBest );
+  tempCS->splitRdCostBest = jobSplitRdCostBest;
+
+  bool skipInterPass = false;
+  job.resultCS = nullptr;
+  xCheckModeSplit( tempCS, bestCS, partitioner, job.testMode, masterPartitioner.modeType, skipInterPass, jobSplitRdCostBest );
+
+  // the coded split has been swapped into the spare structure, keep the node structures apart for the next run
+  m_pTempCS[wIdx][hIdx] = tempCS;
+}
+
+const EncCu::SplitJob* EncCu::xGetSplitJobResult( const EncTestMode& encTestMode, const Partitioner& partitioner ) const
+{
+  for( const auto &job: m_splitJobs )
+  {
+    if( job->pending && job->depth == partitioner.currDepth && job->testMode.type == encTestMode.type
+        && job->testMode.opts == encTestMode.opts && job->testMode.qp == encTestMode.qp )
+    {
+      return job.get();
+    }
+  }
+  return nullptr;
+}
+
+/// takes over the split coded by a job as if xCheckModeSplit() had been run for it
+void EncCu::xUseSplitJobResult( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode,
+                                const SplitJob& job, double *splitRdCostBest )
+{
+  const int  oldPrevQp    = tempCS->prevQP[partitioner.chType];
+  const auto oldMotionLut = tempCS->motionLut;
+  const auto oldPLT       = tempCS->prevPLT;
+
+  tempCS->initStructData( encTestMode.qp );
+  tempCS->copyStructure( *job.resultCS, partitioner.chType, true, true );
+  tempCS->prevQP[partitioner.chType] = job.resultCS->prevQP[partitioner.chType];
+  tempCS->useDbCost                  = job.resultCS->useDbCost;
+
+  if( job.splitRdCost != MAX_DOUBLE )
+  {
+    splitRdCostBest[getPartSplit( encTestMode )] = job.splitRdCost;
+  }
+
+  m_CABACEstimator->getCtx() = job.resultCtx;
+  xCheckBestMode( tempCS, bestCS, partitioner, encTestMode );
+
+  tempCS->motionLut = oldMotionLut;
+  tempCS->prevPLT   = oldPLT;
+  tempCS->releaseIntermediateData();
+  tempCS->prevQP[partitioner.chType] = oldPrevQp;
+}
+
 bool EncCu::xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode, bool adaptiveColorTrans)
 {
+  PROFILE_STAGE( "IntraMode" );
+
   double          bestInterCost             = m_modeCtrl->getBestInterCost();
   double          costSize2Nx2NmtsFirstPass = m_modeCtrl->getMtsSize2Nx2NFirstPassCost();
   bool            skipSecondMtsPass         = m_modeCtrl->getSkipSecondMTSPass();
@@ -1914,6 +2423,8 @@ bool EncCu::xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS
 
 void EncCu::xCheckPLT(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  PROFILE_STAGE( "PaletteMode" );
+
   if (((partitioner.currArea().lumaSize().width * partitioner.currArea().lumaSize().height <= 16) && (isLuma(partitioner.chType)) )
         || ((partitioner.currArea().chromaSize().width * partitioner.currArea().chromaSize().height <= 16) && (!isLuma(partitioner.chType)) && partitioner.isSepTree(*tempCS) )
       || (partitioner.isLocalSepTree(*tempCS)  && (!isLuma(partitioner.chType))  )  )
@@ -2139,6 +2650,8 @@ void EncCu::xCheckChromaQPOffset( CodingStructure& cs, Partitioner& partitioner
 
 void EncCu::xCheckRDCostHashInter( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  PROFILE_STAGE( "HashInterMode" );
+
   bool isPerfectMatch = false;
 
   tempCS->initStructData(encTestMode.qp);
@@ -2188,6 +2701,8 @@ int getDmvrMvdNum(const PredictionUnit& pu)
 
 void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  PROFILE_STAGE( "MergeMode" );
+
   const Slice &slice = *tempCS->slice;
 
   CHECK(slice.getSliceType() == I_SLICE, "Merge modes not available for I-slices");
@@ -2281,7 +2796,8 @@ void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *
   {
     m_mergeItemList.resetBackupList(1);
   }
-  const TempCtx ctxStart(m_ctxPool, m_CABACEstimator->getCtx());
+  // only the few contexts touched by the merge data coding of a candidate are restored between candidates
+  CtxCheckpoint ctxStart(m_CABACEstimator->getCtx());
   DistParam distParam;
   const bool bUseHadamard = !tempCS->slice->getDisableSATDForRD();
   // the third arguments to setDistParam is dummy and will be updated before being used
@@ -2324,7 +2840,8 @@ void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *
 
   // 2. Pass: RD checking 
   tempCS->initStructData(encTestMode.qp);
-  m_CABACEstimator->getCtx() = ctxStart;
+  ctxStart.restore();
+  ctxStart.release();
   m_bestModeUpdated = tempCS->useDbCost = bestCS->useDbCost = false;
   bool bestIsSkip = false;
   for (uint32_t noResidualPass = 0; noResidualPass < 2; noResidualPass++)
@@ -2474,6 +2991,8 @@ void EncCu::xCheckRDCostUnifiedMerge(CodingStructure *&tempCS, CodingStructure *
 // ibc merge/skip mode check
 void EncCu::xCheckRDCostIBCModeMerge2Nx2N(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  PROFILE_STAGE( "IbcMergeMode" );
+
   CHECK(partitioner.chType == ChannelType::CHROMA, "chroma IBC is derived");
 
   if (!CU::canUseIbc(tempCS->area))
@@ -2781,22 +3300,29 @@ PredictionUnit* EncCu::getPuForInterPrediction(CodingStructure* cs)
   return pu;
 }
 
-void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma, 
-  PelUnitBuf& dstBuf, bool finalRd, bool forceNoResidual, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2)
+void EncCu::exportMergeItemToPu(MergeItem* mergeItem, PredictionUnit& pu, bool finalRd, bool forceNoResidual)
 {
-  CHECK((luma && mergeItem->lumaPredReady) || (chroma && mergeItem->chromaPredReady), "Prediction has been avaiable");
   // update Pu info
   mergeItem->exportMergeInfo(pu, forceNoResidual);
   if (!finalRd)
   {
     mergeItem->useInterLayerRef = pu.checkUseInterLayerRef();
   }
+  if (mergeItem->mergeItemType == MergeItem::MergeItemType::MMVD)
+  {
+    pu.mmvdEncOptMode = finalRd ? 0 : (pu.mmvdMergeIdx.pos.step > 2 ? 2 : 1);
+    mergeItem->noBdofRefine = pu.mmvdEncOptMode == 2 && pu.cs->sps->getBDOFEnabledFlag();
+  }
+}
 
+void EncCu::predictMergeItem(InterPrediction& interPred, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
+  PelUnitBuf& dstBuf, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2)
+{
   switch (mergeItem->mergeItemType)
   {
   case MergeItem::MergeItemType::REGULAR:
     // here predBuf1 is predBufNoMvRefine, predBuf2 is predBufNoCiip
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, predBuf1, false);
+    interPred.motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, predBuf1, false);
     if (predBuf2 != nullptr)
     {
       if (luma && chroma)
@@ -2839,29 +3365,35 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
     break;
 
   case MergeItem::MergeItemType::MMVD:
-    pu.mmvdEncOptMode = finalRd ? 0 : (pu.mmvdMergeIdx.pos.step > 2 ? 2 : 1);
-    mergeItem->noBdofRefine = pu.mmvdEncOptMode == 2 && pu.cs->sps->getBDOFEnabledFlag();
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
+    interPred.motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
     break;
 
   case MergeItem::MergeItemType::SBTMVP:
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
+    interPred.motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
     break;
 
   case MergeItem::MergeItemType::AFFINE:
-    m_pcInterSearch->motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
+    interPred.motionCompensation(pu, dstBuf, REF_PIC_LIST_X, luma, chroma, nullptr, false);
     break;
 
   case MergeItem::MergeItemType::GPM:
     // here predBuf1 and predBuf2 point to geoBuffer[mergeCand0] and geoBuffer[mergeCand1], respectively
     CHECK(predBuf1 == nullptr || predBuf2 == nullptr, "Invalid input buffer to GPM");
-    m_pcInterSearch->weightedGeoBlk(pu, pu.geoSplitDir, luma && chroma 
+    interPred.weightedGeoBlk(pu, pu.geoSplitDir, luma && chroma 
       ? ChannelType::NUM : luma ? ChannelType::LUMA : ChannelType::CHROMA, dstBuf, *predBuf1, *predBuf2);
     break;
 
   default:
     THROW("Wrong merge item type");
   }
+}
+
+void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma, 
+  PelUnitBuf& dstBuf, bool finalRd, bool forceNoResidual, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2)
+{
+  CHECK((luma && mergeItem->lumaPredReady) || (chroma && mergeItem->chromaPredReady), "Prediction has been avaiable");
+  exportMergeItemToPu(mergeItem, pu, finalRd, forceNoResidual);
+  predictMergeItem(*m_pcInterSearch, mergeItem, pu, luma, chroma, dstBuf, predBuf1, predBuf2);
 
   auto mergeItemPredBuf = mergeItem->getPredBuf(unitArea);
   if (dstBuf.Y().buf == mergeItemPredBuf.Y().buf)
@@ -2887,16 +3419,60 @@ void EncCu::generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeIt
   }
 }
 
-double EncCu::calcLumaCost4MergePrediction(const TempCtx& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam)
+double EncCu::calcLumaCost4MergePrediction(CtxCheckpoint& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam)
 {
   distParam.cur = predBuf.Y();
   auto dist = distParam.distFunc(distParam);
-  m_CABACEstimator->getCtx() = ctxStart;
+  ctxStart.restore();
   auto fracBits = m_pcInterSearch->xCalcPuMeBits(pu);
   double cost = (double)dist + (double)fracBits * lambda;
   return cost;
 }
 
+EncCu::MergeSatdTask& EncCu::addMergeSatdTask(MergeItem* mergeItem, PredictionUnit& pu, CtxCheckpoint& ctxStart,
+  PelUnitBuf* predBuf1, PelUnitBuf* predBuf2)
+{
+  // exporting the candidate writes the motion buffer of the CS and the rate depends on the CABAC contexts,
+  // so both are done here in candidate order; only the prediction and the distortion are deferred
+  exportMergeItemToPu(mergeItem, pu, false, false);
+  ctxStart.restore();
+  const uint64_t fracBits = m_pcInterSearch->xCalcPuMeBits(pu);
+  m_mergeSatdTasks.push_back({ mergeItem, pu, *pu.cu, predBuf1, predBuf2, fracBits, false, false });
+  return m_mergeSatdTasks.back();
+}
+
+void EncCu::runMergeSatdTasks(const UnitArea& localUnitArea, double lambda, const DistParam& distParam)
+{
+  m_mergeThreadPool->run((int) m_mergeSatdTasks.size(), [&](int taskIdx, int threadIdx) {
+    MergeSatdTask& task = m_mergeSatdTasks[taskIdx];
+    if (task.predicted)
+    {
+      return;
+    }
+    task.pu.cu = &task.cu;
+    InterPrediction& interPred = threadIdx == 0 ? *m_pcInterSearch : *m_mergeInterPred[threadIdx - 1];
+    auto dstBuf = task.mergeItem->getPredBuf(localUnitArea);
+    predictMergeItem(interPred, task.mergeItem, task.pu, true, false, dstBuf, task.predBuf1, task.predBuf2);
+    task.mergeItem->lumaPredReady = true;
+
+    DistParam taskDistParam = distParam;
+    taskDistParam.cur = dstBuf.Y();
+    const Distortion dist = taskDistParam.distFunc(taskDistParam);
+    task.mergeItem->cost = (double) dist + (double) task.fracBits * lambda;
+  });
+
+  // rank in candidate order, which keeps the list independent of the number of threads
+  for (auto& task: m_mergeSatdTasks)
+  {
+    if (task.invalid)
+    {
+      task.mergeItem->cost = MAX_DOUBLE;
+    }
+    m_mergeItemList.insertMergeItemToList(task.mergeItem, m_pcEncCfg->getEncILOpt());
+  }
+  m_mergeSatdTasks.clear();
+}
+
 unsigned int EncCu::updateRdCheckingNum(double threshold, unsigned int numMergeSatdCand)
 {
   numMergeSatdCand = std::min(numMergeSatdCand, (unsigned int) m_mergeItemList.size());
@@ -2961,7 +3537,7 @@ void EncCu::checkEarlySkip(const CodingStructure* bestCS, const Partitioner &par
 
 template <size_t N>
 void EncCu::addRegularCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
-  const TempCtx& ctxStart, int numDmvrMvd, Mv dmvrL0Mvd[MRG_MAX_NUM_CANDS][MAX_NUM_SUBCU_DMVR], bool dmvrImpreciseMv[MRG_MAX_NUM_CANDS],
+  CtxCheckpoint& ctxStart, int numDmvrMvd, Mv dmvrL0Mvd[MRG_MAX_NUM_CANDS][MAX_NUM_SUBCU_DMVR], bool dmvrImpreciseMv[MRG_MAX_NUM_CANDS],
   PelUnitBufVector<N>& mrgPredBufNoCiip, PelUnitBufVector<N>& mrgPredBufNoMvRefine, DistParam& distParam, PredictionUnit* pu)
 {
   // only set this to true when cfg, size, tid, framerate all fulfilled
@@ -3000,7 +3576,7 @@ void EncCu::addRegularCandsToPruningList(const MergeCtx& mergeCtx, const UnitAre
 
 template <size_t N>
 void EncCu::addCiipCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
-  const TempCtx& ctxStart, PelUnitBufVector<N>& mrgPredBufNoCiip, PelUnitBufVector<N>& mrgPredBufNoMvRefine, DistParam& distParam, PredictionUnit* pu)
+  CtxCheckpoint& ctxStart, PelUnitBufVector<N>& mrgPredBufNoCiip, PelUnitBufVector<N>& mrgPredBufNoMvRefine, DistParam& distParam, PredictionUnit* pu)
 {
   // save the to-be-tested merge candidates
   static_vector<int, NUM_MRG_SATD_CAND> ciipMergeIdxList;
@@ -3054,7 +3630,7 @@ void EncCu::addCiipCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea&
 }
 
 void EncCu::addMmvdCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
-  const TempCtx& ctxStart, DistParam& distParam, PredictionUnit* pu)
+  CtxCheckpoint& ctxStart, DistParam& distParam, PredictionUnit* pu)
 {
   pu->cu->mmvdSkip = true;
   pu->regularMergeFlag = true;
@@ -3068,15 +3644,13 @@ void EncCu::addMmvdCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea&
     }
     MergeItem* mmvdMerge = m_mergeItemList.allocateNewMergeItem();
     mmvdMerge->importMergeInfo(mergeCtx, mmvdIdx.val, MergeItem::MergeItemType::MMVD, *pu);
-    auto dstBuf = mmvdMerge->getPredBuf(localUnitArea);
-    generateMergePrediction(localUnitArea, mmvdMerge, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
-    mmvdMerge->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPassIntra, *pu, distParam);
-    m_mergeItemList.insertMergeItemToList(mmvdMerge, m_pcEncCfg->getEncILOpt());
+    addMergeSatdTask(mmvdMerge, *pu, ctxStart, nullptr, nullptr);
   }
+  runMergeSatdTasks(localUnitArea, sqrtLambdaForFirstPassIntra, distParam);
 }
 
 void EncCu::addAffineCandsToPruningList(AffineMergeCtx& affineMergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPass,
-  const TempCtx& ctxStart, DistParam& distParam, PredictionUnit* pu)
+  CtxCheckpoint& ctxStart, DistParam& distParam, PredictionUnit* pu)
 {
 #if GDR_ENABLED
   CodingStructure* cs = pu->cs;
@@ -3089,9 +3663,20 @@ void EncCu::addAffineCandsToPruningList(AffineMergeCtx& affineMergeCtx, const Un
     MergeItem* mergeItem = m_mergeItemList.allocateNewMergeItem();
     mergeItem->importMergeInfo(affineMergeCtx, mergeIdx, affineMergeCtx.mergeType[mergeIdx] == MergeType::SUBPU_ATMVP
       ? MergeItem::MergeItemType::SBTMVP : MergeItem::MergeItemType::AFFINE, localUnitArea);
-    auto dstBuf = mergeItem->getPredBuf(localUnitArea);
-    generateMergePrediction(localUnitArea, mergeItem, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
-    mergeItem->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPass, *pu, distParam);
+    MergeSatdTask* task = nullptr;
+    if (mergeItem->mergeItemType == MergeItem::MergeItemType::SBTMVP)
+    {
+      // the sub-block MC of SbTMVP reads the motion buffer of the CS, so it is predicted right away
+      auto dstBuf = mergeItem->getPredBuf(localUnitArea);
+      generateMergePrediction(localUnitArea, mergeItem, *pu, true, false, dstBuf, false, false, nullptr, nullptr);
+      mergeItem->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPass, *pu, distParam);
+      m_mergeSatdTasks.push_back({ mergeItem, *pu, *pu->cu, nullptr, nullptr, 0, true, false });
+      task = &m_mergeSatdTasks.back();
+    }
+    else
+    {
+      task = &addMergeSatdTask(mergeItem, *pu, ctxStart, nullptr, nullptr);
+    }
 
 #if GDR_ENABLED
     if (isEncodeGdrClean)
@@ -3115,17 +3700,17 @@ void EncCu::addAffineCandsToPruningList(AffineMergeCtx& affineMergeCtx, const Un
 
       if (!isSolid0 || !isSolid1 || !isValid0 || !isValid1)
       {
-        mergeItem->cost = MAX_DOUBLE;
+        task->invalid = true;
       }
     }
 #endif
-    m_mergeItemList.insertMergeItemToList(mergeItem, m_pcEncCfg->getEncILOpt());
   }
+  runMergeSatdTasks(localUnitArea, sqrtLambdaForFirstPass, distParam);
 }
 
 template <size_t N>
 void EncCu::addGpmCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPass,
-  const TempCtx& ctxStart, const GeoComboCostList& comboList, PelUnitBufVector<N>& geoBuffer, DistParam& distParamSAD2, PredictionUnit* pu)
+  CtxCheckpoint& ctxStart, const GeoComboCostList& comboList, PelUnitBufVector<N>& geoBuffer, DistParam& distParamSAD2, PredictionUnit* pu)
 {
   const int geoNumMrgSadCand = std::min(GEO_MAX_TRY_WEIGHTED_SAD, (int)comboList.list.size());
   for (int candidateIdx = 0; candidateIdx < geoNumMrgSadCand; candidateIdx++)
@@ -3136,12 +3721,9 @@ void EncCu::addGpmCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& l
 
     MergeItem* mergeItem = m_mergeItemList.allocateNewMergeItem();
     mergeItem->importMergeInfo(mergeCtx, gpmIndex, MergeItem::MergeItemType::GPM, *pu);
-    auto dstBuf = mergeItem->getPredBuf(localUnitArea);
-    generateMergePrediction(localUnitArea, mergeItem, *pu, true, false, dstBuf, false, false,
-      geoBuffer[mergeIdxPair[0]], geoBuffer[mergeIdxPair[1]]);
-    mergeItem->cost = calcLumaCost4MergePrediction(ctxStart, dstBuf, sqrtLambdaForFirstPass, *pu, distParamSAD2);
-    m_mergeItemList.insertMergeItemToList(mergeItem, m_pcEncCfg->getEncILOpt());
+    addMergeSatdTask(mergeItem, *pu, ctxStart, geoBuffer[mergeIdxPair[0]], geoBuffer[mergeIdxPair[1]]);
   }
+  runMergeSatdTasks(localUnitArea, sqrtLambdaForFirstPass, distParamSAD2);
 }
 
 template <size_t N>
@@ -3332,6 +3914,8 @@ bool EncCu::prepareGpmComboList(const MergeCtx& mergeCtx, const UnitArea& localU
 
 void EncCu::xCheckRDCostIBCMode(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode)
 {
+  PROFILE_STAGE( "IbcMode" );
+
   if (!CU::canUseIbc(tempCS->area))
   {
     // skip IBC mode for blocks larger than 64x64
@@ -3419,6 +4003,8 @@ void EncCu::xCheckRDCostIBCMode(CodingStructure *&tempCS, CodingStructure *&best
 
 void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner, const EncTestMode& encTestMode )
 {
+  PROFILE_STAGE( "InterMode" );
+
   const EncType encType = dynamic_cast<EncLib*>(m_pcEncCfg)->getEncType();
   if (m_pcEncCfg->getDPF() && encType == ENC_PRE)
   {
@@ -3608,6 +4194,8 @@ void EncCu::xCheckRDCostInter( CodingStructure *&tempCS, CodingStructure *&bestC
 bool EncCu::xCheckRDCostInterAmvr(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &partitioner,
                                   const EncTestMode &encTestMode, double &bestIntPelCost)
 {
+  PROFILE_STAGE( "InterAmvrMode" );
+
   const auto amvrSearchMode = encTestMode.getAmvrSearchMode();
   m_pcInterSearch->setAffineModeSelected(false);
   // Only Half-Pel, int-Pel, 4-Pel and fast 4-Pel allowed
@@ -3872,8 +4460,10 @@ void EncCu::xCalDebCost( CodingStructure &cs, Partitioner &partitioner, bool cal
   const Position lumaPos      = cu->Y().valid()
                                   ? cu->Y().pos()
                                   : recalcPosition(format, cu->chType, ChannelType::LUMA, cu->block(cu->chType).pos());
-  bool topEdgeAvai = lumaPos.y > 0 && ((lumaPos.y % 4) == 0);
-  bool leftEdgeAvai = lumaPos.x > 0 && ((lumaPos.x % 4) == 0);
+  // the tile workers do not deblock across the boundaries of their tile, the neighbouring tiles are coded concurrently
+  const CompArea &codedArea = cs.getTopLevelCS().area.Y();
+  bool topEdgeAvai  = lumaPos.y > 0 && ((lumaPos.y % 4) == 0) && codedArea.contains(lumaPos.offset(0, -1));
+  bool leftEdgeAvai = lumaPos.x > 0 && ((lumaPos.x % 4) == 0) && codedArea.contains(lumaPos.offset(-1, 0));
   bool anyEdgeAvai = topEdgeAvai || leftEdgeAvai;
   cs.costDbOffset = 0;
 
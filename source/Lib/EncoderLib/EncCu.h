@@ -47,6 +47,7 @@
 #include "CommonLib/UnitPartitioner.h"
 #include "CommonLib/IbcHashMap.h"
 #include "CommonLib/DeblockingFilter.h"
+#include "CommonLib/ParallelFor.h"
 
 #include "DecoderLib/DecCu.h"
 
@@ -296,16 +297,68 @@ private:
   GeoComboCostList m_comboList;
   MergeItemList         m_mergeItemList;
 
+  // merge candidate of the SATD pass whose luma prediction and distortion are computed by runMergeSatdTasks;
+  // the PU/CU are private copies so that the candidates can be predicted concurrently
+  struct MergeSatdTask
+  {
+    MergeItem*     mergeItem;
+    PredictionUnit pu;
+    CodingUnit     cu;
+    PelUnitBuf*    predBuf1;
+    PelUnitBuf*    predBuf2;
+    uint64_t       fracBits;
+    bool           predicted;   // cost already computed on the calling thread
+    bool           invalid;     // candidate is not allowed (GDR), cost is forced to MAX_DOUBLE
+  };
+
+  std::vector<MergeSatdTask>        m_mergeSatdTasks;
+  std::unique_ptr<ParallelForPool>  m_mergeThreadPool;
+  std::vector<InterPrediction*>     m_mergeInterPred;   // predictors of the worker threads 1..n-1
+
+  // speculative evaluation of one split type of a 64x64 CU with a private CU encoder and search state (SplitNumThreads),
+  // the results are selected on the calling thread in the usual mode order
+  struct SplitJob;
+
+  std::vector<std::unique_ptr<SplitJob>> m_splitJobs;        // one per split type, empty for the encoders of the jobs
+  std::unique_ptr<ParallelForPool>       m_splitThreadPool;
+  std::vector<PelStorage>                m_splitPicBufs;     // reconstruction and prediction copies of the jobs
+  std::vector<EncTestMode>               m_splitModes;
+  std::mutex                             m_splitPicCsMutex;
+  std::mutex*                            m_picCsMutex;       // guards picture->cs, set for the encoders of the jobs only
+  SplitJob*                              m_splitJob;         // job run by this encoder, nullptr for the main encoder
+
+  // search state owned by the worker encoders (split jobs and tile workers of EncSlice), nullptr for the main encoder
+  struct WorkerSearch;
+
+  std::unique_ptr<WorkerSearch>          m_workerSearch;
+
 public:
+  /// search state of the main encoder at the start of a slice, which the tiles of the slice start from
+  struct SliceState
+  {
+    RdCost                  rdCost;
+#if RDOQ_CHROMA_LAMBDA
+    double                  lambdas[MAX_NUM_COMPONENT];
+#endif
+    double                  lambda;
+    InterSearch::SliceState interSearch;
+    bool                    fastDeltaQp;
+    bool                    doPlt;
+  };
+
   /// copy parameters from encoder class
   void  init                ( EncLib* pcEncLib, const SPS& sps );
-
-  void setDecCuReshaperInEncCU(EncReshape* pcReshape, ChromaFormat chromaFormatIdc)
-  {
-    initDecCuReshaper((Reshape*) pcReshape, chromaFormatIdc);
-  }
+  /// set up a worker encoder with its own search state, picCsMutex guards picture->cs if shared with other workers
+  void  initWorker          ( EncLib* pcEncLib, const SPS& sps, std::mutex* picCsMutex );
+  void  saveSliceState      ( SliceState& sliceState ) const;
+  /// start a tile on a tile worker from the search state of the main encoder and that of the slice of the tile
+  void  initTile            ( const EncCu& master, const SliceState& sliceState );
+
+  void setDecCuReshaperInEncCU(EncReshape* pcReshape, ChromaFormat chromaFormatIdc);
+  /// resets the slice level search state of the split jobs
+  void resetSplitJobs();
   /// create internal buffers
-  void  create              ( EncCfg* encCfg );
+  void  create              ( EncCfg* encCfg, const bool isWorker = false );
 
   /// destroy internal buffers
   void  destroy             ();
@@ -317,6 +370,7 @@ public:
   int   updateCtuDataISlice ( const CPelBuf buf );
 
   EncModeCtrl* getModeCtrl  () { return m_modeCtrl; }
+  CABACWriter* getCABACEstimator() { return m_CABACEstimator; }
 
 
   void   setMergeBestSATDCost(double cost) { m_mergeBestSATDCost = cost; }
@@ -341,6 +395,17 @@ protected:
 
   void xCheckModeSplit        ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode, const ModeType modeTypeParent, bool &skipInterPass, double *splitRdCostBest);
 
+  void xInitSearch            ( EncCfg* encCfg, IntraSearch* intraSearch, InterSearch* interSearch, TrQuant* trQuant, RdCost* rdCost,
+                                CABACWriter* cabacEstimator, CtxPool* ctxPool, DeblockingFilter* deblockingFilter );
+  bool xCanStartSplitJobs     ( const CodingStructure& cs, const Partitioner& partitioner, const ModeType modeTypeParent ) const;
+  void xStartSplitJobs        ( CodingStructure* tempCS, CodingStructure* bestCS, Partitioner& partitioner, const EncTestMode& encTestMode,
+                                const ModeType modeTypeParent, const double* splitRdCostBest );
+  void xRunSplitJob           ( SplitJob& job, const EncCu& master, const CodingStructure& masterTempCS, const CodingStructure& masterBestCS,
+                                const Partitioner& masterPartitioner, const double* splitRdCostBest, const bool newSlice, const bool newCtu );
+  const SplitJob* xGetSplitJobResult( const EncTestMode& encTestMode, const Partitioner& pm ) const;
+  void xUseSplitJobResult     ( CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode,
+                                const SplitJob& job, double *splitRdCostBest );
+
   bool xCheckRDCostIntra(CodingStructure *&tempCS, CodingStructure *&bestCS, Partitioner &pm, const EncTestMode& encTestMode, bool adaptiveColorTrans);
 
   void xCheckDQP              ( CodingStructure& cs, Partitioner& partitioner, bool bKeepCtx = false);
@@ -382,22 +447,28 @@ protected:
 
   void generateMergePrediction(const UnitArea& unitArea, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
     PelUnitBuf& dstBuf, bool finalRd, bool forceNoResidual, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2);
-  double calcLumaCost4MergePrediction(const TempCtx& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam);
+  double calcLumaCost4MergePrediction(CtxCheckpoint& ctxStart, const PelUnitBuf& predBuf, double lambda, PredictionUnit& pu, DistParam& distParam);
+  void exportMergeItemToPu(MergeItem* mergeItem, PredictionUnit& pu, bool finalRd, bool forceNoResidual);
+  void predictMergeItem(InterPrediction& interPred, MergeItem* mergeItem, PredictionUnit& pu, bool luma, bool chroma,
+    PelUnitBuf& dstBuf, PelUnitBuf* predBuf1, PelUnitBuf* predBuf2);
+  MergeSatdTask& addMergeSatdTask(MergeItem* mergeItem, PredictionUnit& pu, CtxCheckpoint& ctxStart, PelUnitBuf* predBuf1,
+    PelUnitBuf* predBuf2);
+  void runMergeSatdTasks(const UnitArea& localUnitArea, double lambda, const DistParam& distParam);
 
   template <size_t N>
   void addRegularCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
-    const TempCtx& ctxStart, int numDmvrMvd, Mv dmvrL0Mvd[MRG_MAX_NUM_CANDS][MAX_NUM_SUBCU_DMVR], bool dmvrImpreciseMv[MRG_MAX_NUM_CANDS],
+    CtxCheckpoint& ctxStart, int numDmvrMvd, Mv dmvrL0Mvd[MRG_MAX_NUM_CANDS][MAX_NUM_SUBCU_DMVR], bool dmvrImpreciseMv[MRG_MAX_NUM_CANDS],
     PelUnitBufVector<N>& mrgPredBufNoCiip, PelUnitBufVector<N>& mrgPredBufNoMvRefine, DistParam& distParam, PredictionUnit* pu);
   template <size_t N>
   void addCiipCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
-    const TempCtx& ctxStart, PelUnitBufVector<N>& mrgPredBufNoCiip, PelUnitBufVector<N>& mrgPredBufNoMvRefine, DistParam& distParam, PredictionUnit* pu);
+    CtxCheckpoint& ctxStart, PelUnitBufVector<N>& mrgPredBufNoCiip, PelUnitBufVector<N>& mrgPredBufNoMvRefine, DistParam& distParam, PredictionUnit* pu);
   void addMmvdCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPassIntra,
-    const TempCtx& ctxStart, DistParam& distParam, PredictionUnit* pu);
+    CtxCheckpoint& ctxStart, DistParam& distParam, PredictionUnit* pu);
   void addAffineCandsToPruningList(AffineMergeCtx& affineMergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPass,
-    const TempCtx& ctxStart, DistParam& distParam, PredictionUnit* pu);
+    CtxCheckpoint& ctxStart, DistParam& distParam, PredictionUnit* pu);
   template <size_t N>
   void addGpmCandsToPruningList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPass,
-    const TempCtx& ctxStart, const GeoComboCostList& comboList, PelUnitBufVector<N>& geoBuffer, DistParam& distParamSAD2, PredictionUnit* pu);
+    CtxCheckpoint& ctxStart, const GeoComboCostList& comboList, PelUnitBufVector<N>& geoBuffer, DistParam& distParamSAD2, PredictionUnit* pu);
 
   template<size_t N>
   bool prepareGpmComboList(const MergeCtx& mergeCtx, const UnitArea& localUnitArea, double sqrtLambdaForFirstPass,
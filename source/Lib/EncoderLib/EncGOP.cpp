@@ -56,6 +56,8 @@
 #include "CommonLib/dtrace_codingstruct.h"
 #include "CommonLib/dtrace_buffer.h"
 #include "CommonLib/ProfileTierLevel.h"
+#include "CommonLib/ParallelFor.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "DecoderLib/DecLib.h"
 
@@ -88,6 +90,7 @@ EncGOP::EncGOP()
 
   m_refreshPending       = 0;
   m_pocCRA              = 0;
+  m_wcgChromaQpPpsId    = 0;
   m_numLongTermRefPicSPS = 0;
   ::memset(m_ltRefPicPocLsbSps, 0, sizeof(m_ltRefPicPocLsbSps));
   ::memset(m_ltRefPicUsedByCurrPicFlag, 0, sizeof(m_ltRefPicUsedByCurrPicFlag));
@@ -130,6 +133,9 @@ EncGOP::EncGOP()
   m_lastLTRefPoc = 0;
   m_cntRightBottom      = 0;
   m_cntRightBottomIntra = 0;
+
+  std::fill_n(m_doDecode1stPart, MAX_VPS_LAYERS, true);
+  m_hitFastForwardPOC = false;
 }
 
 EncGOP::~EncGOP()
@@ -226,7 +232,10 @@ void EncGOP::init ( EncLib* pcEncLib )
                       m_pcCfg->getInputBitDepth(), m_pcCfg->getBitDepth(), m_pcCfg->getFrameSkip(),
                       m_pcCfg->getFGCSEICompModelPresent(), m_pcCfg->getFilmGrainExternalMask(),
                       m_pcCfg->getFilmGrainExternalDenoised());
+    m_fgAnalyzer.setNumThreads(resolveNumThreads(m_pcCfg->getFilmGrainAnalysisNumThreads()));
   }
+  m_metricEngine.setNumThreads(resolveNumThreads(m_pcCfg->getMetricNumThreads()));
+  m_metricEngine.setFastMetrics(m_pcCfg->getFastMetrics());
 
 #if WCG_EXT
   if (m_pcCfg->getLmcs())
@@ -1963,19 +1972,13 @@ bool isPicEncoded( int targetPoc, int curPoc, int curTLayer, int gopSize, int in
 }
 
 void trySkipOrDecodePicture(bool &decPic, bool &encPic, const EncCfg &cfg, Picture *pcPic,
-                            EnumArray<ParameterSetMap<APS>, ApsType> *apsMap)
+                            EnumArray<ParameterSetMap<APS>, ApsType> *apsMap, bool *doDecode1stPart,
+                            bool &bHitFastForwardPOC)
 {
   // check if we should decode a leading bitstream
   if( !cfg.getDecodeBitstream( 0 ).empty() )
   {
-    static bool firstTime = true;
-    static bool doDecode1stPart[MAX_VPS_LAYERS] ; /* TODO: MT */
     const int layerIdx = (pcPic->cs->vps == nullptr) ? 0 : pcPic->cs->vps->getGeneralLayerIdx(pcPic->layerId);
-    if (firstTime)
-    {
-      firstTime = false;
-      std::fill_n(doDecode1stPart, MAX_VPS_LAYERS, true);
-    }
     if(doDecode1stPart[layerIdx])
     {
       if( cfg.getForceDecodeBitstream1() )
@@ -2072,7 +2075,6 @@ void trySkipOrDecodePicture(bool &decPic, bool &encPic, const EncCfg &cfg, Pictu
   }
 
   // this is the forward to poc section
-  static bool bHitFastForwardPOC = false; /* TODO: MT */
   if( bHitFastForwardPOC || isPicEncoded( cfg.getFastForwardToPOC(), pcPic->getPOC(), pcPic->temporalId, cfg.getGOPSize(), cfg.getIntraPeriod() ) )
   {
     bHitFastForwardPOC |= cfg.getFastForwardToPOC() == pcPic->getPOC(); // once we hit the poc we continue encoding
@@ -2177,7 +2179,7 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
   {
     frameLevel = 0;
   }
-  m_pcRateCtrl->initRCPic( frameLevel );
+  m_pcRateCtrl->initRCPic( frameLevel, slice->getPOC() );
   estimatedBits = m_pcRateCtrl->getRCPic()->getTargetBits();
 
   if (m_pcRateCtrl->getCpbSaturationEnabled() && frameLevel != 0)
@@ -2216,7 +2218,8 @@ void EncGOP::xPicInitRateControl(int &estimatedBits, int gopId, double &lambda,
   else if ( frameLevel == 0 )   // intra case, but use the model
   {
     m_pcSliceEncoder->calCostPictureI(pic);
-    if ( m_pcCfg->getIntraPeriod() != 1 )   // do not refine allocated bits for all intra case
+    // do not refine allocated bits for all intra case, nor when the first pass already provided them
+    if (m_pcCfg->getIntraPeriod() != 1 && !m_pcRateCtrl->getUseFirstPassStats())
     {
       int bits = m_pcRateCtrl->getRCSeq()->getLeftAverageBits();
       bits = m_pcRateCtrl->getRCPic()->getRefineBitsForIntra( bits );
@@ -2545,6 +2548,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
 
     //-- For time output for each slice
     auto beforeTime = std::chrono::steady_clock::now();
+    PROFILE_STAGE( "EncodePicture" );
 
 
     /////////////////////////////////////////////////////////////////////////////////////////////////// Initial to start encoding
@@ -2612,12 +2616,11 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
     // th this is a hot fix for the choma qp control
     if( m_pcEncLib->getWCGChromaQPControl().isEnabled() && m_pcEncLib->getSwitchPOC() != -1 )
     {
-      static int usePPS = 0; /* TODO: MT */
       if( pocCurr == m_pcEncLib->getSwitchPOC() )
       {
-        usePPS = 1;
+        m_wcgChromaQpPpsId = 1;
       }
-      const PPS *pPPS = m_pcEncLib->getPPS(usePPS);
+      const PPS *pPPS = m_pcEncLib->getPPS(m_wcgChromaQpPpsId);
       // replace the pps with a more appropriated one
       pcPic->cs->pps = pPPS;
     }
@@ -2664,7 +2667,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
         const int yScale = ((refPicHeight << ScalingRatio::BITS) + (curPicHeight >> 1)) / curPicHeight;
         ScalingRatio scalingRatio = {xScale, yScale};
         Picture::rescalePicture(scalingRatio, pcPic->M_BUFS(0, PIC_ORIGINAL_INPUT), curScalingWindow, pcPic->M_BUFS(0, PIC_ORIGINAL), pps->getScalingWindow(), chromaFormatIdc, sps.getBitDepths(), true, true,
-          sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag());
+          sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), false, 0, m_pcCfg->getRescaleNumThreads());
       }
       else
       {
@@ -2905,6 +2908,20 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
                                                    pcSlice->getRpl(REF_PIC_LIST_1), pcSlice->getPic()->layerId,
                                                    *(pcSlice->getPPS()));
 
+    if (m_pcCfg->getLeanPicBuffers())
+    {
+      // field PSNR, composite reference and shutter interval filtering read originals of earlier pictures
+      const bool releaseOrig =
+        !isField && !m_pcCfg->getUseCompositeRef() && !m_pcEncLib->getShutterFilterFlag();
+      for (Picture *pic: rcListPic)
+      {
+        if (!pic->referenced && pic->reconstructed && pic->layerId == pcPic->layerId)
+        {
+          pic->releaseUnreferencedBuffers(releaseOrig);
+        }
+      }
+    }
+
     if (pcSlice->getTLayer() > 0 && !pcSlice->isLeadingPic())
     {
       if (pcSlice->isStepwiseTemporalLayerSwitchingPointCandidate(rcListPic))
@@ -3412,7 +3429,8 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
     bool decPic = false;
     bool encPic = false;
     // test if we can skip the picture entirely or decode instead of encoding
-    trySkipOrDecodePicture(decPic, encPic, *m_pcCfg, pcPic, m_pcEncLib->getApsMaps());
+    trySkipOrDecodePicture(decPic, encPic, *m_pcCfg, pcPic, m_pcEncLib->getApsMaps(), m_doDecode1stPart,
+                           m_hitFastForwardPOC);
 
     pcPic->cs->slice = pcSlice; // please keep this
 #if ENABLE_QPA
@@ -3511,6 +3529,8 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
         pcPic->fillSliceLossyLosslessArray(sliceLosslessArray, mixedLossyLossless);
       }
 
+      const bool compressSlicesInParallel = m_pcSliceEncoder->initParallelSlices( pcPic );
+
       for(uint32_t sliceIdx = 0; sliceIdx < pcPic->cs->pps->getNumSlicesInPic(); sliceIdx++ )
       {
         pcSlice->setSliceMap( pcPic->cs->pps->getSliceMap( sliceIdx ) );
@@ -3663,6 +3683,13 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
           numSliceSegments++;
         }
       }
+      if (compressSlicesInParallel)
+      {
+        m_pcSliceEncoder->compressParallelSlices( pcPic );
+#if GREEN_METADATA_SEI_ENABLED
+        m_featureCounter = pcPic->getFeatureCounter();
+#endif
+      }
 #if GREEN_METADATA_SEI_ENABLED
       m_featureCounter.baseQP[pcPic->getLossyQPValue()] ++;
       if (m_featureCounter.isYUV420 == -1)
@@ -4042,6 +4069,10 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
     {
       pcSlice = pcPic->slices[0];
 
+      // the reconstruction is final, its quality metrics are computed by the metric engine while the access unit is
+      // written
+      xQueuePictureMetrics(pcPic, pcPic->getRecoBuf(), snr_conversion, printMSSSIM);
+
       /////////////////////////////////////////////////////////////////////////////////////////////////// File writing
 
       // write various parameter sets
@@ -4705,6 +4736,7 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
           m_pcRateCtrl->updateCpbState(actualTotalBits);
           msg( NOTICE, " [CPB %6d bits]", m_pcRateCtrl->getCpbState() );
         }
+        m_pcRateCtrl->updateStatsAfterPicture(pcSlice->getPOC());
       }
       xCreateFrameFieldInfoSEI( leadingSeiMessages, pcSlice, isField );
       xCreatePictureTimingSEI( m_pcCfg->getEfficientFieldIRAPEnabled() ? effFieldIRAPMap.GetIRAPGOPid() : 0, leadingSeiMessages, nestedSeiMessages, duInfoSeiMessages, pcSlice, isField, duData );
@@ -4790,8 +4822,14 @@ void EncGOP::compressGOP(int pocLast, int numPicRcvd, PicList &rcListPic, std::l
 
     pcPic->destroyTempBuffers();
     pcPic->cs->destroyTemporaryCsData();
+    pcPic->cs->compactMotion();
   }   // gopId-loop
 
+  if (pcPic != nullptr)
+  {
+    PROFILE_FINISH_PICTURE(pcPic->layerId, pcPic->getPOC());
+  }
+
   delete pcBitstreamRedirect;
 
   CHECK(m_numPicsCoded > 1, "Unspecified error");
@@ -5060,20 +5098,12 @@ static inline double calcWeightedSquaredError(const CPelBuf& org,        const C
 
   const int hAct = offsetY + (uint32_t)blockHeight < imageHeight ? blockHeight : blockHeight - 1;
   const int wAct = offsetX + (uint32_t)blockWidth  < imageWidth  ? blockWidth  : blockWidth  - 1;
-  uint64_t ssErr = 0; // sum of squared diffs
   uint64_t saAct = 0; // sum of abs. activity
   double msAct;
   int x, y;
 
   // calculate image differences and activity
-  for (y = 0; y < blockHeight; y++)  // error
-  {
-    for (x = 0; x < blockWidth; x++)
-    {
-      const     int64_t iDiff = (int64_t)o[y*O + x] - (int64_t)r[y*R + x];
-      ssErr += uint64_t(iDiff * iDiff);
-    }
-  }
+  const uint64_t ssErr = g_pelBufOP.sumSquaredDiff(o, O, r, R, blockWidth, blockHeight); // sum of squared diffs
   if (wAct <= xAct || hAct <= yAct)
   {
     return (double) ssErr;
@@ -5135,18 +5165,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
 
       if (B < 4) // image is too small to use WPSNR, resort to traditional PSNR
       {
-        totalDiff = 0;
-        for (y = 0; y < H; y++)
-        {
-          for (x = 0; x < W; x++)
-          {
-            const           int64_t iDiff = (int64_t)pSrc0[x] - (int64_t)pSrc1[x];
-            totalDiff += uint64_t(iDiff * iDiff);
-          }
-          pSrc0 += pic0.stride;
-          pSrc1 += pic1.stride;
-        }
-        return totalDiff;
+        return MetricEngine::ssd(pic0, pic1);
       }
 
       double wmse = 0.0, sumAct = 0.0; // compute activity normalized SNR value
@@ -5183,17 +5202,7 @@ uint64_t EncGOP::xFindDistortionPlane(const CPelBuf& pic0, const CPelBuf& pic1,
   }
   else
   {
-    totalDiff = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int temp = pSrc0[x] - pSrc1[x];
-        totalDiff += uint64_t(temp * temp);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-    }
+    totalDiff = MetricEngine::ssd(pic0, pic1);
   }
 
   return totalDiff;
@@ -5208,32 +5217,21 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
     return 0;
   }
 
-  double       totalDiffWpsnr;
-  const  Pel*  pSrc0 = pic0.bufAt(0, 0);
-  const  Pel*  pSrc1 = pic1.bufAt(0, 0);
-  const  Pel*  pSrcLuma = picLuma0.bufAt(0, 0);
   CHECK(pic0.width  != pic1.width , "Unspecified error");
   CHECK(pic0.height != pic1.height, "Unspecified error");
 
-  if( rshift > 0 )
+  if (rshift > 0)
   {
-    totalDiffWpsnr = 0;
-    for (int y = 0; y < pic0.height; y++)
-    {
-      for (int x = 0; x < pic0.width; x++)
-      {
-        Intermediate_Int temp = pSrc0[x] - pSrc1[x];
-        double dW = m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(pSrcLuma[(x << getComponentScaleX(compID, chfmt))]);
-        totalDiffWpsnr += ((dW * (double) temp * (double) temp)) * (double) (1 >> rshift);
-      }
-      pSrc0 += pic0.stride;
-      pSrc1 += pic1.stride;
-      pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
-    }
+    return 0;
   }
-  else
+
+  if (!m_metricEngine.getFastMetrics())
   {
-    totalDiffWpsnr = 0;
+    const Pel *pSrc0    = pic0.bufAt(0, 0);
+    const Pel *pSrc1    = pic1.bufAt(0, 0);
+    const Pel *pSrcLuma = picLuma0.bufAt(0, 0);
+
+    double totalDiffWpsnr = 0;
     for (int y = 0; y < pic0.height; y++)
     {
       for (int x = 0; x < pic0.width; x++)
@@ -5246,6 +5244,22 @@ double EncGOP::xFindDistortionPlaneWPSNR(const CPelBuf& pic0, const CPelBuf& pic
       pSrc1 += pic1.stride;
       pSrcLuma += picLuma0.stride << getComponentScaleY(compID, chfmt);
     }
+    return totalDiffWpsnr;
+  }
+
+  // the weight only depends on the co-located luma level, so the squared errors are accumulated per luma level
+  const int             lumaBitDepth = m_pcCfg->getBitDepth(ChannelType::LUMA);
+  std::vector<uint64_t> ssdPerLumaLevel(size_t(1) << lumaBitDepth, 0);
+  MetricEngine::lumaLevelSquaredErrors(pic0, pic1, picLuma0, getComponentScaleX(compID, chfmt),
+                                       getComponentScaleY(compID, chfmt), ssdPerLumaLevel);
+
+  double totalDiffWpsnr = 0;
+  for (int level = 0; level < (int) ssdPerLumaLevel.size(); level++)
+  {
+    if (ssdPerLumaLevel[level])
+    {
+      totalDiffWpsnr += m_pcEncLib->getRdCost()->getWPSNRLumaLevelWeight(level) * (double) ssdPerLumaLevel[level];
+    }
   }
 
   return totalDiffWpsnr;
@@ -5326,10 +5340,12 @@ void EncGOP::xCalculateAddPSNRs(const bool isField, const bool isFieldTopFieldFi
   }
 }
 
-void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit& accessUnit,
-  double dEncTime, const InputColourSpaceConversion conversion, const bool printFrameMSE, const bool printMSSSIM,
-  double* PSNR_Y, bool isEncodeLtRef)
+void EncGOP::xQueuePictureMetrics(Picture *pcPic, PelUnitBuf cPicD, const InputColourSpaceConversion conversion,
+                                  const bool printMSSSIM)
 {
+  // the engine may still be busy with a picture whose metrics were never collected
+  m_metricEngine.wait();
+
   const SPS&         sps = *pcPic->cs->sps;
   const CPelUnitBuf& pic = cPicD;
   CHECK(!(conversion == IPCOLOURSPACE_UNCHANGED), "Unspecified error");
@@ -5338,57 +5354,51 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
 #if ENABLE_QPA
   const bool    useWPSNR = m_pcEncLib->getUseWPSNR();
 #endif
-  double  dPSNR[MAX_NUM_COMPONENT];
-  double msssim[MAX_NUM_COMPONENT] = {0.0};
 #if WCG_WPSNR
   const bool    useLumaWPSNR = m_pcEncLib->getPrintWPSNR();
-  double  dPSNRWeighted[MAX_NUM_COMPONENT];
-  double  MSEyuvframeWeighted[MAX_NUM_COMPONENT];
 #endif
-  double  upscaledPSNR[MAX_NUM_COMPONENT];
-  double  upscaledMsssim[MAX_NUM_COMPONENT];
-  for(int i=0; i<MAX_NUM_COMPONENT; i++)
+
+  PictureMetrics &metrics = m_picMetrics;
+  metrics.pic             = pcPic;
+  metrics.picRefLayer     = nullptr;
+  for (int i = 0; i < MAX_NUM_COMPONENT; i++)
   {
-    dPSNR[i]=0.0;
-#if WCG_WPSNR
-    dPSNRWeighted[i]=0.0;
-    MSEyuvframeWeighted[i] = 0.0;
-#endif
-    upscaledPSNR[i] = 0.0;
+    metrics.compSize[i]         = 0;
+    metrics.upscaledCompSize[i] = 0;
+    metrics.ssd[i]              = 0;
+    metrics.upscaledSSD[i]      = 0;
+    metrics.ssdWeighted[i]      = 0.0;
+    metrics.msssim[i]           = 0.0;
+    metrics.upscaledMsssim[i]   = 0.0;
   }
 #if JVET_O0756_CALCULATE_HDRMETRICS
-  double deltaE[hdrtoolslib::NB_REF_WHITE];
-  double psnrL[hdrtoolslib::NB_REF_WHITE];
   for (int i=0; i<hdrtoolslib::NB_REF_WHITE; i++)
   {
-    deltaE[i] = 0.0;
-    psnrL[i] = 0.0;
+    metrics.deltaE[i] = 0.0;
+    metrics.psnrL[i] = 0.0;
   }
 #endif
 
-  PelStorage interm;
-
   if (conversion != IPCOLOURSPACE_UNCHANGED)
   {
-    interm.create(pic.chromaFormat, Area(Position(), pic.Y()));
-    VideoIOYuv::colourSpaceConvert(pic, interm, conversion, false);
+    metrics.interm.destroy();
+    metrics.interm.create(pic.chromaFormat, Area(Position(), pic.Y()));
+    VideoIOYuv::colourSpaceConvert(pic, metrics.interm, conversion, false);
   }
 
-  const CPelUnitBuf& picC = (conversion == IPCOLOURSPACE_UNCHANGED) ? pic : interm;
+  const CPelUnitBuf& picC = (conversion == IPCOLOURSPACE_UNCHANGED) ? pic : metrics.interm;
 
-  //===== calculate PSNR =====
-  double             mseYuvFrame[MAX_NUM_COMPONENT] = { 0, 0, 0 };
   const ChromaFormat formatD = pic.chromaFormat;
   const ChromaFormat format  = sps.getChromaFormatIdc();
 
   const bool bPicIsField     = pcPic->fieldPic;
-  const Slice*  pcSlice      = pcPic->slices[0];
 
-  PelStorage upscaledRec;
+  PelStorage &upscaledRec = metrics.upscaledRec;
 
   if (m_pcEncLib->isResChangeInClvsEnabled())
   {
     const CPelBuf& upscaledOrg = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->M_BUFS( 0, PIC_TRUE_ORIGINAL_INPUT).get( COMPONENT_Y ) : pcPic->M_BUFS( 0, PIC_ORIGINAL_INPUT).get( COMPONENT_Y );
+    upscaledRec.destroy();
     upscaledRec.create( pic.chromaFormat, Area( Position(), upscaledOrg ) );
 
     ScalingRatio scalingRatio;
@@ -5398,10 +5408,10 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     CU::getRprScaling(&sps, pps, pcPic, scalingRatio);
 
     bool rescaleForDisplay = true;
-    Picture::rescalePicture(scalingRatio, picC, pcPic->getScalingWindow(), upscaledRec, pps->getScalingWindow(), format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), rescaleForDisplay, m_pcCfg->getUpscaleFilerForDisplay());
+    Picture::rescalePicture(scalingRatio, picC, pcPic->getScalingWindow(), upscaledRec, pps->getScalingWindow(), format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), rescaleForDisplay, m_pcCfg->getUpscaleFilerForDisplay(), m_pcCfg->getRescaleNumThreads());
   }
 
-  Picture* picRefLayer = nullptr;
+  Picture*& picRefLayer = metrics.picRefLayer;
   if (m_pcEncLib->isRefLayerMetricsEnabled())
   {
     const VPS* vps = pcPic->cs->vps;
@@ -5438,12 +5448,16 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
           m_pcRefLayerRescaledPicYuv->create(pub1.chromaFormat, Area(Position(), pub1.get(COMPONENT_Y)));
         }
 
-        Picture::rescalePicture( scalingRatio, pub0, wScaling0, *m_pcRefLayerRescaledPicYuv, wScaling1, format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag() );
+        Picture::rescalePicture( scalingRatio, pub0, wScaling0, *m_pcRefLayerRescaledPicYuv, wScaling1, format, sps.getBitDepths(), false, false, sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), false, 0, m_pcCfg->getRescaleNumThreads() );
         m_pcEncLib->setRefLayerRescaledAvailable(true);
       }
     }
   }
 
+  // the distortion metrics of the components are independent jobs, run by the metric engine while the access unit
+  // is written
+  std::vector<std::function<void()>> metricJobs;
+
   for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
   {
     const ComponentID compID = ComponentID(comp);
@@ -5472,32 +5486,35 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
     const CPelBuf recPB(p.bufAt(0, 0), p.stride, width, height);
     const CPelBuf orgPB(o.bufAt(0, 0), o.stride, width, height);
     const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    metrics.compSize[comp]     = width * height;
 #if ENABLE_QPA
-    const uint64_t ssdTemp =
-      xFindDistortionPlane(recPB, orgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format),
-                           ::getComponentScaleY(compID, format));
+    const uint32_t rshift = useWPSNR ? bitDepth : 0;
 #else
-    const uint64_t ssdTemp = xFindDistortionPlane(recPB, orgPB, 0);
+    const uint32_t rshift = 0;
 #endif
-    const uint32_t maxval = 255 << (bitDepth - 8);
-    const uint32_t size   = width * height;
-    const double fRefValue = (double)maxval * maxval * size;
-    dPSNR[comp]              = ssdTemp ? 10.0 * log10(fRefValue / (double) ssdTemp) : 999.99;
-    mseYuvFrame[comp]        = (double) ssdTemp / size;
+    metricJobs.push_back([=, &metrics]() {
+      metrics.ssd[comp] = xFindDistortionPlane(recPB, orgPB, rshift
+#if ENABLE_QPA
+                                       , ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format)
+#endif
+      );
+    });
     if(printMSSSIM)
     {
-      msssim[comp] = xCalculateMSSSIM (o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, width, height, bitDepth);
+      metricJobs.push_back([=, &metrics]() {
+        metrics.msssim[comp] = m_metricEngine.msssim(orgPB, recPB, bitDepth);
+      });
     }
 #if WCG_WPSNR
-    const double uiSSDtempWeighted = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, org.get(COMPONENT_Y), compID, format);
     if (useLumaWPSNR)
     {
-      dPSNRWeighted[comp] = uiSSDtempWeighted ? 10.0 * log10(fRefValue / (double)uiSSDtempWeighted) : 999.99;
-      MSEyuvframeWeighted[comp] = (double)uiSSDtempWeighted / size;
+      const CPelBuf orgLuma = org.get(COMPONENT_Y);
+      metricJobs.push_back([=, &metrics]() {
+        metrics.ssdWeighted[comp] = xFindDistortionPlaneWPSNR(recPB, orgPB, 0, orgLuma, compID, format);
+      });
     }
 #endif
 
-
     if (m_pcEncLib->isResChangeInClvsEnabled())
     {
       const CPelBuf& upscaledOrg = (sps.getUseLmcs() || m_pcCfg->getGopBasedTemporalFilterEnabled()) ? pcPic->M_BUFS( 0, PIC_TRUE_ORIGINAL_INPUT).get( compID ) : pcPic->M_BUFS( 0, PIC_ORIGINAL_INPUT).get( compID );
@@ -5508,48 +5525,139 @@ void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUni
       // create new buffers with correct dimensions
       const CPelBuf upscaledRecPB( upscaledRec.get( compID ).bufAt( 0, 0 ), upscaledRec.get( compID ).stride, upscaledWidth, upscaledHeight );
       const CPelBuf upscaledOrgPB( upscaledOrg.bufAt( 0, 0 ), upscaledOrg.stride, upscaledWidth, upscaledHeight );
+      metrics.upscaledCompSize[comp] = upscaledWidth * upscaledHeight;
 
+      metricJobs.push_back([=, &metrics]() {
+        metrics.upscaledSSD[comp] = xFindDistortionPlane(upscaledRecPB, upscaledOrgPB, rshift
 #if ENABLE_QPA
-      const uint64_t upscaledSSD = xFindDistortionPlane( upscaledRecPB, upscaledOrgPB, useWPSNR ? bitDepth : 0, ::getComponentScaleX( compID, format ) );
-#else
-      const uint64_t scaledSSD = xFindDistortionPlane( upsacledRecPB, upsacledOrgPB, 0 );
+                                                 , ::getComponentScaleX(compID, format)
 #endif
-
-      upscaledPSNR[comp] = upscaledSSD ? 10.0 * log10( (double)maxval * maxval * upscaledWidth * upscaledHeight / (double)upscaledSSD ) : 999.99;
-      upscaledMsssim[comp] = xCalculateMSSSIM (upscaledOrgPB.bufAt(0, 0), upscaledOrgPB.stride, upscaledRecPB.bufAt(0, 0), upscaledRecPB.stride, upscaledWidth, upscaledHeight, bitDepth);
+        );
+      });
+      metricJobs.push_back([=, &metrics]() {
+        metrics.upscaledMsssim[comp] = m_metricEngine.msssim(upscaledOrgPB, upscaledRecPB, bitDepth);
+      });
     }
     else if (picRefLayer)
     {
       const CPelBuf& p = m_pcRefLayerRescaledPicYuv->get(compID);
       const CPelBuf& o = org.get(compID);
+      metrics.upscaledCompSize[comp] = metrics.compSize[comp];
+
+      metricJobs.push_back([=, &metrics]() {
+        metrics.upscaledSSD[comp] = xFindDistortionPlane(p, o, rshift
 #if ENABLE_QPA
-      const uint64_t upscaledSSD = xFindDistortionPlane(p, o, useWPSNR ? bitDepth : 0, ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format));
-#else
-      const uint64_t upscaledSSD = xFindDistortionPlane(p, o, 0);
+                                                 , ::getComponentScaleX(compID, format), ::getComponentScaleY(compID, format)
 #endif
-      upscaledPSNR[comp] = upscaledSSD ? 10.0 * log10((double) fRefValue / (double) upscaledSSD) : 999.99;
+        );
+      });
       if (printMSSSIM)
       {
         const uint32_t upscaledWidth = o.width - ( m_pcEncLib->getSourcePadding( 0 ) >> ::getComponentScaleX( compID, format ) );
         const uint32_t upscaledHeight = o.height - ( m_pcEncLib->getSourcePadding( 1 ) >> ( !!bPicIsField + ::getComponentScaleY( compID, format ) ) );
-        upscaledMsssim[comp] = xCalculateMSSSIM(o.bufAt(0, 0), o.stride, p.bufAt(0, 0), p.stride, upscaledWidth, upscaledHeight, bitDepth);
+        const CPelBuf  upscaledRecPB(p.bufAt(0, 0), p.stride, upscaledWidth, upscaledHeight);
+        const CPelBuf  upscaledOrgPB(o.bufAt(0, 0), o.stride, upscaledWidth, upscaledHeight);
+        metricJobs.push_back([=, &metrics]() {
+          metrics.upscaledMsssim[comp] = m_metricEngine.msssim(upscaledOrgPB, upscaledRecPB, bitDepth);
+        });
       }
     }
   }
 
-#if EXTENSION_360_VIDEO
-  m_ext360.calculatePSNRs(pcPic);
-#endif
-
 #if JVET_O0756_CALCULATE_HDRMETRICS
   const bool calculateHdrMetrics = m_pcEncLib->getCalculateHdrMetrics();
   if (calculateHdrMetrics)
   {
-    auto beforeTime = std::chrono::steady_clock::now();
-    xCalculateHDRMetrics(pcPic, deltaE, psnrL);
-    auto elapsed = std::chrono::steady_clock::now() - beforeTime;
-    m_metricTime += elapsed;
+    metricJobs.push_back([this, pcPic]() {
+      auto beforeTime = std::chrono::steady_clock::now();
+      xCalculateHDRMetrics(pcPic, m_picMetrics.deltaE, m_picMetrics.psnrL);
+      auto elapsed = std::chrono::steady_clock::now() - beforeTime;
+      m_metricTime += elapsed;
+    });
+  }
+#endif
+
+  m_metricEngine.submit(std::move(metricJobs));
+}
+
+void EncGOP::xCalculateAddPSNR(Picture* pcPic, PelUnitBuf cPicD, const AccessUnit& accessUnit,
+  double dEncTime, const InputColourSpaceConversion conversion, const bool printFrameMSE, const bool printMSSSIM,
+  double* PSNR_Y, bool isEncodeLtRef)
+{
+  if (m_picMetrics.pic != pcPic)
+  {
+    xQueuePictureMetrics(pcPic, cPicD, conversion, printMSSSIM);
+  }
+  // the metrics have been computed while the access unit was written, they are needed for the summary line
+  m_metricEngine.wait();
+  m_picMetrics.pic = nullptr;
+
+  const SPS&         sps = *pcPic->cs->sps;
+  const CPelUnitBuf& pic = cPicD;
+  double  dPSNR[MAX_NUM_COMPONENT];
+  const double *msssim = m_picMetrics.msssim;
+#if WCG_WPSNR
+  const bool    useLumaWPSNR = m_pcEncLib->getPrintWPSNR();
+  double  dPSNRWeighted[MAX_NUM_COMPONENT];
+  double  MSEyuvframeWeighted[MAX_NUM_COMPONENT];
+#endif
+  double  upscaledPSNR[MAX_NUM_COMPONENT];
+  const double *upscaledMsssim = m_picMetrics.upscaledMsssim;
+  for(int i=0; i<MAX_NUM_COMPONENT; i++)
+  {
+    dPSNR[i]=0.0;
+#if WCG_WPSNR
+    dPSNRWeighted[i]=0.0;
+    MSEyuvframeWeighted[i] = 0.0;
+#endif
+    upscaledPSNR[i] = 0.0;
   }
+#if JVET_O0756_CALCULATE_HDRMETRICS
+  const bool    calculateHdrMetrics = m_pcEncLib->getCalculateHdrMetrics();
+  double       *deltaE              = m_picMetrics.deltaE;
+  double       *psnrL               = m_picMetrics.psnrL;
+#endif
+
+  //===== calculate PSNR =====
+  double             mseYuvFrame[MAX_NUM_COMPONENT] = { 0, 0, 0 };
+  const ChromaFormat formatD = pic.chromaFormat;
+
+  const Slice*  pcSlice      = pcPic->slices[0];
+
+  const uint32_t *compSize         = m_picMetrics.compSize;
+  const uint32_t *upscaledCompSize = m_picMetrics.upscaledCompSize;
+  const uint64_t *ssd              = m_picMetrics.ssd;
+  const uint64_t *upscaledSSD      = m_picMetrics.upscaledSSD;
+#if WCG_WPSNR
+  const double   *ssdWeighted      = m_picMetrics.ssdWeighted;
+#endif
+  const Picture  *picRefLayer      = m_picMetrics.picRefLayer;
+
+  for (int comp = 0; comp < ::getNumberValidComponents(formatD); comp++)
+  {
+    const ComponentID compID   = ComponentID(comp);
+    const uint32_t    bitDepth = sps.getBitDepth(toChannelType(compID));
+    const uint32_t    maxval   = 255 << (bitDepth - 8);
+    const uint32_t    size     = compSize[comp];
+    const double      fRefValue = (double)maxval * maxval * size;
+    dPSNR[comp]              = ssd[comp] ? 10.0 * log10(fRefValue / (double) ssd[comp]) : 999.99;
+    mseYuvFrame[comp]        = (double) ssd[comp] / size;
+#if WCG_WPSNR
+    if (useLumaWPSNR)
+    {
+      dPSNRWeighted[comp] = ssdWeighted[comp] ? 10.0 * log10(fRefValue / ssdWeighted[comp]) : 999.99;
+      MSEyuvframeWeighted[comp] = ssdWeighted[comp] / size;
+    }
+#endif
+    if (m_pcEncLib->isResChangeInClvsEnabled() || picRefLayer)
+    {
+      const double upscaledRefValue = (double) maxval * maxval * upscaledCompSize[comp];
+      upscaledPSNR[comp] = upscaledSSD[comp] ? 10.0 * log10(upscaledRefValue / (double) upscaledSSD[comp]) : 999.99;
+    }
+  }
+
+#if EXTENSION_360_VIDEO
+  m_ext360.calculatePSNRs(pcPic);
 #endif
 
   /* calculate the size of the access unit, excluding:
@@ -5954,172 +6062,8 @@ void EncGOP::xCalculateGreenComplexityMetrics( FeatureCounterStruct featureCount
 double EncGOP::xCalculateMSSSIM(const Pel *org, const ptrdiff_t orgStride, const Pel *rec, const ptrdiff_t recStride,
                                 const int width, const int height, const uint32_t bitDepth)
 {
-  const int MAX_MSSSIM_SCALE  = 5;
-  const int WEIGHTING_MID_TAP = 5;
-  const int WEIGHTING_SIZE    = WEIGHTING_MID_TAP*2+1;
-
-  uint32_t maxScale;
-
-  // For low resolution videos determine number of scales
-  if (width < 22 || height < 22)
-  {
-    maxScale = 1;
-  }
-  else if (width < 44 || height < 44)
-  {
-    maxScale = 2;
-  }
-  else if (width < 88 || height < 88)
-  {
-    maxScale = 3;
-  }
-  else if (width < 176 || height < 176)
-  {
-    maxScale = 4;
-  }
-  else
-  {
-    maxScale = 5;
-  }
-
-  assert(maxScale>0 && maxScale<=MAX_MSSSIM_SCALE);
-
-  //Normalized Gaussian mask design, 11*11, s.d. 1.5
-  double weights[WEIGHTING_SIZE][WEIGHTING_SIZE];
-  double coeffSum=0.0;
-  for(int y=0; y<WEIGHTING_SIZE; y++)
-  {
-    for(int x=0; x<WEIGHTING_SIZE; x++)
-    {
-      weights[y][x] =
-        exp(-((y - WEIGHTING_MID_TAP) * (y - WEIGHTING_MID_TAP) + (x - WEIGHTING_MID_TAP) * (x - WEIGHTING_MID_TAP))
-            / (WEIGHTING_MID_TAP - 0.5));
-      coeffSum += weights[y][x];
-    }
-  }
-
-  for(int y=0; y<WEIGHTING_SIZE; y++)
-  {
-    for(int x=0; x<WEIGHTING_SIZE; x++)
-    {
-      weights[y][x] /=coeffSum;
-    }
-  }
-
-  //Resolution based weights
-  const double exponentWeights[MAX_MSSSIM_SCALE][MAX_MSSSIM_SCALE] = {{1.0,    0,      0,      0,      0     },
-                                                                      {0.1356, 0.8644, 0,      0,      0     },
-                                                                      {0.0711, 0.4530, 0.4760, 0,      0     },
-                                                                      {0.0517, 0.3295, 0.3462, 0.2726, 0     },
-                                                                      {0.0448, 0.2856, 0.3001, 0.2363, 0.1333}};
-
-  //Downsampling of data:
-  std::vector<double> original[MAX_MSSSIM_SCALE];
-  std::vector<double> recon[MAX_MSSSIM_SCALE];
-
-  for(uint32_t scale=0; scale<maxScale; scale++)
-  {
-    const int scaledHeight = height >> scale;
-    const int scaledWidth  = width  >> scale;
-    original[scale].resize(scaledHeight*scaledWidth, double(0));
-    recon[scale].resize(scaledHeight*scaledWidth, double(0));
-  }
-
-  // Initial [0] arrays to be a copy of the source data (but stored in array "double", not Pel array).
-  for(int y=0; y<height; y++)
-  {
-    for(int x=0; x<width; x++)
-    {
-      original[0][y*width+x] = org[y*orgStride+x];
-      recon[0][   y*width+x] = rec[y*recStride+x];
-    }
-  }
-
-  // Set up other arrays to be average value of each 2x2 sample.
-  for(uint32_t scale=1; scale<maxScale; scale++)
-  {
-    const int scaledHeight = height >> scale;
-    const int scaledWidth  = width  >> scale;
-    for(int y=0; y<scaledHeight; y++)
-    {
-      for(int x=0; x<scaledWidth; x++)
-      {
-        original[scale][y*scaledWidth+x]= (original[scale-1][ 2*y   *(2*scaledWidth)+2*x  ] +
-                                           original[scale-1][ 2*y   *(2*scaledWidth)+2*x+1] +
-                                           original[scale-1][(2*y+1)*(2*scaledWidth)+2*x  ] +
-                                           original[scale-1][(2*y+1)*(2*scaledWidth)+2*x+1]) / 4.0;
-        recon[scale][y*scaledWidth+x]=    (   recon[scale-1][ 2*y   *(2*scaledWidth)+2*x  ] +
-                                              recon[scale-1][ 2*y   *(2*scaledWidth)+2*x+1] +
-                                              recon[scale-1][(2*y+1)*(2*scaledWidth)+2*x  ] +
-                                              recon[scale-1][(2*y+1)*(2*scaledWidth)+2*x+1]) / 4.0;
-      }
-    }
-  }
-
-  // Calculate MS-SSIM:
-  const uint32_t   maxValue  = (1<<bitDepth)-1;
-  const double c1        = (0.01*maxValue)*(0.01*maxValue);
-  const double c2        = (0.03*maxValue)*(0.03*maxValue);
-
-  double finalMSSSIM = 1.0;
-
-  for(uint32_t scale=0; scale<maxScale; scale++)
-  {
-    const int scaledHeight    = height >> scale;
-    const int scaledWidth     = width  >> scale;
-    const int blocksPerRow    = scaledWidth-WEIGHTING_SIZE+1;
-    const int blocksPerColumn = scaledHeight-WEIGHTING_SIZE+1;
-    const int totalBlocks     = blocksPerRow*blocksPerColumn;
-
-    double meanSSIM= 0.0;
-
-    for(int blockIndexY=0; blockIndexY<blocksPerColumn; blockIndexY++)
-    {
-      for(int blockIndexX=0; blockIndexX<blocksPerRow; blockIndexX++)
-      {
-        double muOrg          =0.0;
-        double muRec          =0.0;
-        double muOrigSqr      =0.0;
-        double muRecSqr       =0.0;
-        double muOrigMultRec  =0.0;
-
-        for(int y=0; y<WEIGHTING_SIZE; y++)
-        {
-          for(int x=0;x<WEIGHTING_SIZE; x++)
-          {
-            const double gaussianWeight=weights[y][x];
-            const int    sampleOffset=(blockIndexY+y)*scaledWidth+(blockIndexX+x);
-            const double orgPel=original[scale][sampleOffset];
-            const double recPel=   recon[scale][sampleOffset];
-
-            muOrg        +=orgPel*       gaussianWeight;
-            muRec        +=recPel*       gaussianWeight;
-            muOrigSqr    +=orgPel*orgPel*gaussianWeight;
-            muRecSqr     +=recPel*recPel*gaussianWeight;
-            muOrigMultRec+=orgPel*recPel*gaussianWeight;
-          }
-        }
-
-        const double sigmaSqrOrig = muOrigSqr    -(muOrg*muOrg);
-        const double sigmaSqrRec  = muRecSqr     -(muRec*muRec);
-        const double sigmaOrigRec = muOrigMultRec-(muOrg*muRec);
-
-        double blockSSIMVal = ((2.0*sigmaOrigRec + c2)/(sigmaSqrOrig+sigmaSqrRec + c2));
-        if(scale == maxScale-1)
-        {
-          blockSSIMVal*=(2.0*muOrg*muRec + c1)/(muOrg*muOrg+muRec*muRec + c1);
-        }
-
-        meanSSIM += blockSSIMVal;
-      }
-    }
-
-    meanSSIM /=totalBlocks;
-
-    finalMSSSIM *= pow(meanSSIM, exponentWeights[maxScale-1][scale]);
-  }
-
-  return finalMSSSIM;
+  return m_metricEngine.msssim(CPelBuf(org, orgStride, width, height), CPelBuf(rec, recStride, width, height),
+                               bitDepth);
 }
 
 #if JVET_O0756_CALCULATE_HDRMETRICS
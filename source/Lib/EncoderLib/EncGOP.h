@@ -59,6 +59,7 @@
 #include "SEIFilmGrainAnalyzer.h"
 
 #include "Analyze.h"
+#include "MetricEngine.h"
 #include "RateCtrl.h"
 #include <vector>
 #include "EncHRD.h"
@@ -155,6 +156,32 @@ private:
   SEIWriter               m_seiWriter;
 
   FGAnalyser m_fgAnalyzer;
+  MetricEngine            m_metricEngine;
+
+  // distortions of the picture whose metrics are computed by the metric engine, see xQueuePictureMetrics()
+  struct PictureMetrics
+  {
+    const Picture *pic;
+    PelStorage     interm;
+    PelStorage     upscaledRec;
+    Picture       *picRefLayer;
+    uint32_t       compSize[MAX_NUM_COMPONENT];
+    uint32_t       upscaledCompSize[MAX_NUM_COMPONENT];
+    uint64_t       ssd[MAX_NUM_COMPONENT];
+    uint64_t       upscaledSSD[MAX_NUM_COMPONENT];
+    double         ssdWeighted[MAX_NUM_COMPONENT];
+    double         msssim[MAX_NUM_COMPONENT];
+    double         upscaledMsssim[MAX_NUM_COMPONENT];
+#if JVET_O0756_CALCULATE_HDRMETRICS
+    double         deltaE[hdrtoolslib::NB_REF_WHITE];
+    double         psnrL[hdrtoolslib::NB_REF_WHITE];
+#endif
+  };
+  PictureMetrics          m_picMetrics;
+
+  // decisions of the debug bitstream decoding and of FastForwardToPOC, kept per encoder instance
+  bool                    m_doDecode1stPart[MAX_VPS_LAYERS];
+  bool                    m_hitFastForwardPOC;
 
   Picture *               m_picBg;
   Picture *               m_picOrig;
@@ -177,6 +204,7 @@ private:
   // clean decoding refresh
   bool                    m_refreshPending;
   int                     m_pocCRA;
+  int                     m_wcgChromaQpPpsId;   ///< PPS used for the WCG chroma QP control, switched at the switch POC
   NalUnitType             m_associatedIRAPType[MAX_VPS_LAYERS];
   int                     m_associatedIRAPPOC[MAX_VPS_LAYERS];
 
@@ -329,6 +357,8 @@ protected:
                               const AccessUnit &accessUnit, PicList &rcListPic, double dEncTime,
                               const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
                               const bool printMSSSIM, double *PSNR_Y, bool isEncodeLtRef);
+  void     xQueuePictureMetrics(Picture *pcPic, PelUnitBuf cPicD, const InputColourSpaceConversion snr_conversion,
+                                const bool printMSSSIM);
   void     xCalculateAddPSNR(Picture *pcPic, PelUnitBuf cPicD, const AccessUnit &, double dEncTime,
                              const InputColourSpaceConversion snr_conversion, const bool printFrameMSE,
                              const bool printMSSSIM, double *PSNR_Y, bool isEncodeLtRef);
@@ -55,6 +55,7 @@
 
 EncLib::EncLib(EncLibCommon *encLibCommon)
   : m_cListPic(encLibCommon->getPictureBuffer())
+  , m_xuPool(encLibCommon->getXuPool())
   , m_spsMap(encLibCommon->getSpsMap())
   , m_ppsMap(encLibCommon->getPpsMap())
   , m_apsMaps(encLibCommon->getApsMaps())
@@ -126,6 +127,10 @@ void EncLib::create( const int layerId )
     m_cRateCtrl.init(m_framesToBeEncoded, m_rcTargetBitrate, frameRate, m_gopSize, m_intraPeriod, m_sourceWidth,
                      m_sourceHeight, m_maxCUWidth, m_maxCUHeight, getBitDepth(ChannelType::LUMA),
                      m_rcKeepHierarchicalBit, m_rcUseCtuSeparateModel, m_GOPList);
+    if (m_rcPass > 0)
+    {
+      m_cRateCtrl.initStats(m_rcPass, m_rcStatsFileName);
+    }
   }
 
 }
@@ -513,7 +518,7 @@ void EncLib::init(AUWriterIf *auWriterIf)
                   sps0.getMaxCUWidth(), sps0.getMaxCUWidth() + 16, false, m_layerId,
                   getGopBasedTemporalFilterEnabled());
     picBg->getRecoBuf().fill(0);
-    picBg->finalInit( m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picBg->finalInit( m_vps, sps0, pps0, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_xuPool );
     picBg->allocateNewSlice();
     picBg->createSpliceIdx(pps0.pcv->sizeInCtus);
     m_cGOPEncoder.setPicBg(picBg);
@@ -628,7 +633,7 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, const InputColourSp
     const SPS *sps = m_spsMap.getPS( pps->getSPSId() );
 
     picCurr->M_BUFS( 0, PIC_ORIGINAL ).copyFrom( m_cGOPEncoder.getPicBg()->getRecoBuf() );
-    picCurr->finalInit( m_vps, *sps, *pps, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    picCurr->finalInit( m_vps, *sps, *pps, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_xuPool );
     picCurr->poc = m_pocLast - 1;
     m_pocLast -= 2;
 
@@ -697,9 +702,9 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, const InputColourSp
 
         const PPS* pTempPPS = m_ppsMap.getPS(ENC_PPS_ID_RPR + m_layerId);
         Picture::rescalePicture(downScalingRatio, *pcPicYuvOrg, orgPPS->getScalingWindow(), *ppcPicYuvRPR[1], pTempPPS->getScalingWindow(), chFormatIdc, orgSPS->getBitDepths(), true, true,
-          orgSPS->getHorCollocatedChromaFlag(), orgSPS->getVerCollocatedChromaFlag());
+          orgSPS->getHorCollocatedChromaFlag(), orgSPS->getVerCollocatedChromaFlag(), false, 0, m_rescaleNumThreads);
         Picture::rescalePicture(upScalingRatio, *ppcPicYuvRPR[1], orgPPS->getScalingWindow(), *ppcPicYuvRPR[0], pTempPPS->getScalingWindow(), chFormatIdc, orgSPS->getBitDepths(), true, false,
-          orgSPS->getHorCollocatedChromaFlag(), orgSPS->getVerCollocatedChromaFlag());
+          orgSPS->getHorCollocatedChromaFlag(), orgSPS->getVerCollocatedChromaFlag(), false, 0, m_rescaleNumThreads);
 
         // Calculate PSNR
         const  Pel* pSrc0 = pcPicYuvOrg->get(COMPONENT_Y).bufAt(0, 0);
@@ -833,13 +838,14 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, const InputColourSp
 
       Picture::rescalePicture(scalingRatio, *pcPicYuvOrg, refPPS->getScalingWindow(), pcPicCurr->getOrigBuf(),
                               pPPS->getScalingWindow(), chromaFormatIdc, pSPS->getBitDepths(), true, true,
-                              pSPS->getHorCollocatedChromaFlag(), pSPS->getVerCollocatedChromaFlag());
+                              pSPS->getHorCollocatedChromaFlag(), pSPS->getVerCollocatedChromaFlag(), false, 0,
+                              m_rescaleNumThreads);
     }
     else
     {
       pcPicCurr->M_BUFS( 0, PIC_ORIGINAL ).swap( *pcPicYuvOrg );
     }
-    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+    pcPicCurr->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_xuPool );
 
     pcPicCurr->poc = m_pocLast;
 
@@ -974,7 +980,7 @@ bool EncLib::encodePrep(bool flush, PelStorage *pcPicYuvOrg, const InputColourSp
       const PPS *pPPS = ( ppsID < 0 ) ? m_ppsMap.getFirstPS() : m_ppsMap.getPS( ppsID );
       const SPS *pSPS = m_spsMap.getPS( pPPS->getSPSId() );
 
-      pcField->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS );
+      pcField->finalInit( m_vps, *pSPS, *pPPS, &m_picHeader, m_apss, m_lmcsAPS, m_scalinglistAPS, m_xuPool );
       pcField->poc           = m_pocLast;
       pcField->reconstructed = false;
 
@@ -1080,6 +1086,11 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   // use an entry in the buffered list if the maximum number that need buffering has been reached:
   int maxDecPicBuffering = ( m_vps == nullptr || m_vps->m_numLayersInOls[m_vps->m_targetOlsIdx] == 1 ) ? sps.getMaxDecPicBuffering( MAX_TLAYER - 1 ) : m_vps->getMaxDecPicBuffering( MAX_TLAYER - 1 );
 
+  // without RPR and inter-layer prediction no reference is scaled, so the lean mode keeps the regular margin
+  const bool scaledRefMargin = !m_leanPicBuffers || sps.getRprEnabledFlag()
+                               || (m_vps != nullptr && m_vps->m_numLayersInOls[m_vps->m_targetOlsIdx] > 1);
+  const unsigned picMargin = (scaledRefMargin ? MAX_SCALING_RATIO : 1) * (sps.getMaxCUWidth() + PIC_MARGIN);
+
   if (m_cListPic.size() >= (uint32_t) (m_gopSize + maxDecPicBuffering + 2))
   {
     PicList::iterator iterPic = m_cListPic.begin();
@@ -1100,7 +1111,7 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
 
     // If PPS ID is the same, we will assume that it has not changed since it was last used
     // and return the old object.
-    if( rpcPic && pps.getPPSId() != rpcPic->cs->pps->getPPSId() )
+    if( rpcPic && (pps.getPPSId() != rpcPic->cs->pps->getPPSId() || rpcPic->margin != picMargin) )
     {
       // the IDs differ - free up an entry in the list, and then create a new one, as with the case where the max buffering state has not been reached.
       rpcPic->destroy();
@@ -1114,7 +1125,7 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
   {
     rpcPic = new Picture;
     rpcPic->create(sps.getWrapAroundEnabledFlag(), sps.getChromaFormatIdc(), Size(pps.getPicWidthInLumaSamples(), pps.getPicHeightInLumaSamples()),
-      sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, false, m_layerId, getShutterFilterFlag());
+      sps.getMaxCUWidth(), sps.getMaxCUWidth() + PIC_MARGIN, false, m_layerId, getShutterFilterFlag(), scaledRefMargin);
 
     if (m_resChangeInClvsEnabled)
     {
@@ -1134,6 +1145,10 @@ void EncLib::xGetNewPicBuffer ( std::list<PelUnitBuf*>& rcListPicYuvRecOut, Pict
 
     m_cListPic.push_back( rpcPic );
   }
+  else
+  {
+    rpcPic->restoreReleasedBuffers();
+  }
 
   rpcPic->setBorderExtension( false );
   rpcPic->reconstructed = false;
@@ -2621,12 +2636,11 @@ int EncCfg::getQPForPicture(const uint32_t gopIndex, const Slice *pSlice) const
     qp = getBaseQP();
 
     // switch at specific qp and keep this qp offset
-    static int appliedSwitchDQQ = 0; /* TODO: MT */
     if( pSlice->getPOC() == getSwitchPOC() )
     {
-      appliedSwitchDQQ = getSwitchDQP();
+      m_appliedSwitchDQP = getSwitchDQP();
     }
-    qp += appliedSwitchDQQ;
+    qp += m_appliedSwitchDQP;
 
     const FrameDeltaQps &deltaQps = getdQPs();
     if (deltaQps.size() != 0)
@@ -79,6 +79,7 @@ private:
   int                       m_receivedPicCount;                   ///< number of received pictures
   uint32_t                  m_codedPicCount;                      ///< number of coded pictures
   PicList&                  m_cListPic;                           ///< dynamic list of pictures
+  XuPool&                   m_xuPool;                             ///< CU/PU/TU pool of the pictures in m_cListPic
   int                       m_layerId;
   int                       m_gopRprPpsId;
 
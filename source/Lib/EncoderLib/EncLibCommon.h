@@ -40,6 +40,7 @@
 #include <fstream>
 #include "CommonLib/Slice.h"
 #include "CommonLib/ParameterSetManager.h"
+#include "CommonLib/Unit.h"
 
 class EncLibCommon
 {
@@ -47,6 +48,7 @@ private:
   ParameterSetMap<SPS>      m_spsMap;             ///< SPS, it is shared across all layers
   ParameterSetMap<PPS>      m_ppsMap;             ///< PPS, it is shared across all layers
   EnumArray<ParameterSetMap<APS>, ApsType> m_apsMaps;            ///< APS, it is shared across all layers
+  XuPool                    m_xuPool;             ///< CU/PU/TU pool of the pictures in the DPB
   PicList                   m_cListPic;           ///< DPB, it is shared across all layers
   VPS                       m_vps;
   int                       m_layerDecPicBuffering[MAX_VPS_LAYERS*MAX_TLAYER];  // to store number of required DPB pictures per layer
@@ -56,6 +58,7 @@ public:
   virtual ~EncLibCommon();
 
   PicList&                 getPictureBuffer()      { return m_cListPic;   }
+  XuPool&                  getXuPool()             { return m_xuPool;     }
   ParameterSetMap<SPS>&    getSpsMap()             { return m_spsMap;     }
   ParameterSetMap<PPS>&    getPpsMap()             { return m_ppsMap;     }
   EnumArray<ParameterSetMap<APS>, ApsType> &getApsMaps() { return m_apsMaps; }
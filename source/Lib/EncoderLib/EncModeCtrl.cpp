@@ -104,6 +104,79 @@ bool EncModeCtrl::nextMode( const CodingStructure &cs, Partitioner &partitioner
   return !m_ComprCUCtxList.back().testModes.empty();
 }
 
+/// collects the current split mode and the split modes still queued at this CU level that would be tried given the
+/// current state, the state of the CU level is not changed
+void EncModeCtrl::getPendingSplitModes( const CodingStructure &cs, Partitioner &partitioner, std::vector<EncTestMode> &modes )
+{
+  const ComprCUCtx savedCtx = m_ComprCUCtxList.back();
+
+  modes.clear();
+  modes.push_back( savedCtx.testModes.back() );
+
+  for( int i = (int) savedCtx.testModes.size() - 2; i >= 0; i-- )
+  {
+    const EncTestMode &mode = savedCtx.testModes[i];
+
+    if( isModeSplit( mode ) && tryModeMaster( mode, cs, partitioner ) )
+    {
+      modes.push_back( mode );
+    }
+  }
+
+  m_ComprCUCtxList.back() = savedCtx;
+}
+
+/// takes over the slice level state of another mode controller (used by the tile workers of EncSlice)
+void EncModeCtrl::copySliceState( const EncModeCtrl &other )
+{
+  m_slice                         = other.m_slice;
+#if SHARP_LUMA_DELTA_QP
+  m_lumaQPOffset                  = other.m_lumaQPOffset;
+#endif
+  m_fastDeltaQP                   = other.m_fastDeltaQP;
+  m_doPlt                         = other.m_doPlt;
+  m_useHashMeInCurrentIntraPeriod = other.m_useHashMeInCurrentIntraPeriod;
+  m_HashMEPOC                     = other.m_HashMEPOC;
+  m_HashMEPOCchecked              = other.m_HashMEPOCchecked;
+  m_HashMEPOC2                    = other.m_HashMEPOC2;
+}
+
+/// takes over the slice and CU level state of another mode controller, the best coding structure of the current CU
+/// level is redirected to the given copy of it (used by the split jobs of EncCu)
+void EncModeCtrl::copyState( const EncModeCtrl &other, CodingStructure &bestCS, const bool newCtu )
+{
+  m_ComprCUCtxList.clear();
+
+  if( newCtu )
+  {
+    initCTUEncoding( *other.m_slice );
+  }
+
+  copySliceState( other );
+  m_noSplitIntraRdCost            = other.m_noSplitIntraRdCost;
+  m_qpCtu                         = other.m_qpCtu;
+  m_currCsArea                    = other.m_currCsArea;
+
+  for( const ComprCUCtx &ctx : other.m_ComprCUCtxList )
+  {
+    m_ComprCUCtxList.push_back( ctx );
+  }
+
+  ComprCUCtx       &cuECtx    = m_ComprCUCtxList.back();
+  const ComprCUCtx &otherCtx  = other.m_ComprCUCtxList.back();
+
+  if( otherCtx.bestCS != nullptr )
+  {
+    const CodingStructure &otherBestCS = *otherCtx.bestCS;
+    const auto cuIt = std::find( otherBestCS.cus.begin(), otherBestCS.cus.end(), otherCtx.bestCU );
+    const auto tuIt = std::find( otherBestCS.tus.begin(), otherBestCS.tus.end(), otherCtx.bestTU );
+
+    cuECtx.bestCS = &bestCS;
+    cuECtx.bestCU = cuIt != otherBestCS.cus.end() ? bestCS.cus[cuIt - otherBestCS.cus.begin()] : nullptr;
+    cuECtx.bestTU = tuIt != otherBestCS.tus.end() ? bestCS.tus[tuIt - otherBestCS.tus.begin()] : nullptr;
+  }
+}
+
 EncTestMode EncModeCtrl::currTestMode() const
 {
   return m_ComprCUCtxList.back().testModes.back();
@@ -1769,6 +1842,23 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
       return false;
     }
 
+    if( m_pcEncCfg->getFastPartitionDecision() > 0 && xFastPartSkipSplit( split, encTestmode.qp, cs, partitioner ) )
+    {
+      if (split == CU_HORZ_SPLIT)
+      {
+        cuECtx.set(DID_HORZ_SPLIT, false);
+      }
+      if (split == CU_VERT_SPLIT)
+      {
+        cuECtx.set(DID_VERT_SPLIT, false);
+      }
+      if (split == CU_QUAD_SPLIT)
+      {
+        cuECtx.set(DID_QUAD_SPLIT, false);
+      }
+      return false;
+    }
+
     if( m_pcEncCfg->getUseContentBasedFastQtbt() )
     {
       const CompArea& currArea = partitioner.currArea().Y();
@@ -1967,9 +2057,10 @@ bool EncModeCtrlMTnoRQT::tryMode( const EncTestMode& encTestmode, const CodingSt
       unsigned idx1, idx2, idx3, idx4;
       getAreaIdx(partitioner.currArea().Y(), *slice.getPPS()->pcv, idx1, idx2, idx3, idx4);
       CHECKD(idx3 >= MAX_NUM_SIZES || idx4 >= MAX_NUM_SIZES, "MAX_NUM_SIZES is too small");
-      if (g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4])
+      ReusedUniMvs &reusedUniMvs = m_pcInterSearch->getReusedUniMvs();
+      if (reusedUniMvs.filled[idx1][idx2][idx3][idx4])
       {
-        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), g_reusedUniMVs[idx1][idx2][idx3][idx4]);
+        m_pcInterSearch->insertUniMvCands(partitioner.currArea().Y(), reusedUniMvs.mvs[idx1][idx2][idx3][idx4]);
       }
     }
     if( !bestCS || ( bestCS && isModeSplit( bestMode ) ) )
@@ -2157,6 +2248,153 @@ bool EncModeCtrlMTnoRQT::xSkipTreeCandidate(const PartSplit split, const double*
   return res;
 }
 
+struct FastPartPreset
+{
+  double smoothVarScale;         // all splits are skipped if the variance is below smoothVarScale * Qstep
+  double homogeneousRatio;       // all splits are skipped if the quadrant SAD ratio exceeds homogeneousRatio ...
+  double homogeneousVarScale;    // ... and the variance is below homogeneousVarScale * Qstep
+  double dirGradRatio;           // BT/TT splits that do not cross the dominant gradient direction are skipped above this ratio
+  int    neighbourDepthMargin;   // splits are skipped if the current depth reaches the deepest neighbour depth plus this margin
+};
+
+static const FastPartPreset g_fastPartPresets[] = {
+  { 0.00, 2.00, 0.0, MAX_DOUBLE, MAX_INT },   // 0: off
+  { 0.25, 0.95, 4.0, 3.0, 2 },                // 1: fast
+  { 0.50, 0.90, 8.0, 2.0, 2 },                // 2: faster
+  { 1.00, 0.85, 16.0, 1.5, 1 },               // 3: fastest
+};
+
+void EncModeCtrlMTnoRQT::xComputeFastPartFeatures( FastPartFeatures& feat, const CodingStructure& cs, const Partitioner& partitioner ) const
+{
+  const CompArea& area  = partitioner.currArea().Y();
+  const CPelBuf   org   = cs.getOrgBuf( area );
+  const int       shift = cs.sps->getBitDepth( ChannelType::LUMA ) - 8;
+  const int       w     = area.width;
+  const int       h     = area.height;
+  const int       hw    = w >> 1;
+  const int       hh    = h >> 1;
+
+  int64_t sum       = 0;
+  int64_t sumSq     = 0;
+  int64_t gradHor   = 0;
+  int64_t gradVer   = 0;
+  int64_t quadSum[4] = { 0, 0, 0, 0 };
+
+  for( int y = 0; y < h; y++ )
+  {
+    for( int x = 0; x < w; x++ )
+    {
+      const int val = org.at( x, y );
+      sum   += val;
+      sumSq += int64_t( val ) * val;
+      quadSum[( y >= hh ? 2 : 0 ) + ( x >= hw ? 1 : 0 )] += val;
+      if( x + 1 < w )
+      {
+        gradHor += abs( org.at( x + 1, y ) - val );
+      }
+      if( y + 1 < h )
+      {
+        gradVer += abs( org.at( x, y + 1 ) - val );
+      }
+    }
+  }
+
+  const int64_t numSamples = int64_t( w ) * h;
+  const int64_t numQuad    = int64_t( hw ) * hh;
+  const double  mean       = double( sum ) / numSamples;
+  const double  scale      = double( 1 << shift );
+
+  feat.variance = ( double( sumSq ) / numSamples - mean * mean ) / ( scale * scale );
+  feat.gradHor  = double( gradHor ) / ( int64_t( w - 1 ) * h * scale );
+  feat.gradVer  = double( gradVer ) / ( int64_t( h - 1 ) * w * scale );
+
+  // mean-removed SAD of the block and of its four quadrants
+  const int blkMean = int( ( sum + ( numSamples >> 1 ) ) / numSamples );
+  int quadMean[4];
+  for( int i = 0; i < 4; i++ )
+  {
+    quadMean[i] = int( ( quadSum[i] + ( numQuad >> 1 ) ) / numQuad );
+  }
+
+  int64_t blkSad  = 0;
+  int64_t quadSad = 0;
+  for( int y = 0; y < h; y++ )
+  {
+    for( int x = 0; x < w; x++ )
+    {
+      const int val = org.at( x, y );
+      blkSad  += abs( val - blkMean );
+      quadSad += abs( val - quadMean[( y >= hh ? 2 : 0 ) + ( x >= hw ? 1 : 0 )] );
+    }
+  }
+  feat.quadSadRatio = blkSad > 0 ? double( quadSad ) / blkSad : 1.0;
+
+  // depths of the already coded left, above and above-left CUs
+  const Position pos = partitioner.currArea().block( partitioner.chType ).pos();
+  for( const Position& nbPos: { pos.offset( -1, 0 ), pos.offset( 0, -1 ), pos.offset( -1, -1 ) } )
+  {
+    const CodingUnit* cuNb = cs.getCU( nbPos, partitioner.chType );
+    if( cuNb )
+    {
+      feat.numNeighbours++;
+      feat.maxNeighbourDepth = std::max<int>( feat.maxNeighbourDepth, cuNb->depth );
+    }
+  }
+
+  feat.valid = true;
+}
+
+bool EncModeCtrlMTnoRQT::xFastPartSkipSplit( const PartSplit split, const int qp, const CodingStructure& cs, Partitioner& partitioner )
+{
+  ComprCUCtx& cuECtx = m_ComprCUCtxList.back();
+
+  // only decide early if a result is available to fall back on
+  if( !isLuma( partitioner.chType ) || !cuECtx.bestCS || cuECtx.bestCS->cost == MAX_DOUBLE )
+  {
+    return false;
+  }
+
+  FastPartFeatures& feat = cuECtx.fastPartFeatures;
+  if( !feat.valid )
+  {
+    xComputeFastPartFeatures( feat, cs, partitioner );
+  }
+
+  const FastPartPreset& preset = g_fastPartPresets[m_pcEncCfg->getFastPartitionDecision()];
+  const double          qStep  = pow( 2.0, ( std::max( qp, 0 ) - 4 ) / 6.0 );
+
+  // flat block
+  if( feat.variance < preset.smoothVarScale * qStep )
+  {
+    return true;
+  }
+
+  // the quadrants are statistically the same as the whole block
+  if( feat.quadSadRatio > preset.homogeneousRatio && feat.variance < preset.homogeneousVarScale * qStep )
+  {
+    return true;
+  }
+
+  // none of the neighbours was split that deep
+  if( feat.numNeighbours > 0 && partitioner.currDepth >= feat.maxNeighbourDepth + preset.neighbourDepthMargin )
+  {
+    return true;
+  }
+
+  // the samples change mainly along one direction: the horizontal splits are skipped if the horizontal gradient
+  // dominates and the vertical splits if the vertical gradient does
+  if( ( split == CU_HORZ_SPLIT || split == CU_TRIH_SPLIT ) && feat.gradHor > preset.dirGradRatio * feat.gradVer )
+  {
+    return true;
+  }
+  if( ( split == CU_VERT_SPLIT || split == CU_TRIV_SPLIT ) && feat.gradVer > preset.dirGradRatio * feat.gradHor )
+  {
+    return true;
+  }
+
+  return false;
+}
+
 bool EncModeCtrlMTnoRQT::checkSkipOtherLfnst( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner )
 {
   xExtractFeatures( encTestmode, *tempCS );
@@ -210,6 +210,18 @@ struct IspPredModeVal
   uint16_t bestPredModeDCT2 : 9;
 };
 
+// Original-signal features of a CU used by the fast partition decision (FastPartitionDecision)
+struct FastPartFeatures
+{
+  bool   valid{ false };
+  double variance{ 0.0 };          // luma variance, normalized to 8 bit
+  double gradHor{ 0.0 };           // mean absolute horizontal gradient
+  double gradVer{ 0.0 };           // mean absolute vertical gradient
+  double quadSadRatio{ 0.0 };      // sum of mean-removed quadrant SADs divided by the mean-removed block SAD
+  int    numNeighbours{ 0 };
+  int    maxNeighbourDepth{ 0 };
+};
+
 struct ComprCUCtx
 {
   ComprCUCtx() : testModes(), extraFeatures()
@@ -263,6 +275,8 @@ struct ComprCUCtx
   ISPType ispMode{ ISPType::NONE };
   uint8_t ispLfnstIdx{ 0 };
 
+  FastPartFeatures fastPartFeatures;
+
   template<typename T> T    get( int ft )       const { return typeid(T) == typeid(double) ? (T&)extraFeaturesd[ft] : T(extraFeatures[ft]); }
   template<typename T> void set( int ft, T val )      { extraFeatures [ft] = int64_t( val ); }
   void                      set( int ft, double val ) { extraFeaturesd[ft] = val; }
@@ -339,6 +353,9 @@ public:
   bool         anyMode              () const;
 
   void         setNoSplitIntraCost  (double cost) { m_noSplitIntraRdCost = cost; }
+  void         getPendingSplitModes ( const CodingStructure &cs, Partitioner &partitioner, std::vector<EncTestMode> &modes );
+  void         copySliceState       ( const EncModeCtrl &other );
+  void         copyState            ( const EncModeCtrl &other, CodingStructure &bestCS, const bool newCtu );
   const ComprCUCtx& getComprCUCtx   () { CHECK( m_ComprCUCtxList.empty(), "Accessing empty list!"); return m_ComprCUCtxList.back(); }
 
 #if SHARP_LUMA_DELTA_QP
@@ -874,6 +891,10 @@ public:
   virtual bool checkSkipOtherLfnst( const EncTestMode& encTestmode, CodingStructure*& tempCS, Partitioner& partitioner );
 
   bool xSkipTreeCandidate(const PartSplit split, const double* splitRdCostBest, const SliceType& sliceType) const;
+
+private:
+  void xComputeFastPartFeatures( FastPartFeatures& feat, const CodingStructure& cs, const Partitioner& partitioner ) const;
+  bool xFastPartSkipSplit      ( const PartSplit split, const int qp, const CodingStructure& cs, Partitioner& partitioner );
 };
 
 //! \}
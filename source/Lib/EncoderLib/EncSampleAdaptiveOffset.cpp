@@ -36,6 +36,7 @@
  \brief       estimation part of sample adaptive offset class
  */
 #include "EncSampleAdaptiveOffset.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "CommonLib/UnitTools.h"
 #include "CommonLib/dtrace_codingstruct.h"
@@ -192,6 +193,8 @@ void EncSampleAdaptiveOffset::SAOProcess(CodingStructure &cs, bool *sliceEnabled
                                          const double saoEncodingRateChroma, const bool isPreDBFSamplesUsed,
                                          bool isGreedyMergeEncoding, bool usingTrueOrg)
 {
+  PROFILE_STAGE( "SAO" );
+
   PelUnitBuf org = usingTrueOrg ? cs.getTrueOrgBuf() : cs.getOrgBuf();
   PelUnitBuf res = cs.getRecoBuf();
   PelUnitBuf src = m_tempBuf;
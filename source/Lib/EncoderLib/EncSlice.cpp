@@ -36,6 +36,7 @@
 */
 
 #include "EncSlice.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "EncLib.h"
 #include "CommonLib/UnitTools.h"
@@ -56,6 +57,7 @@
 
 EncSlice::EncSlice()
  : m_encCABACTableIdx(I_SLICE)
+ , m_compressSlicesInParallel(false)
 #if ENABLE_QPA
  , m_adaptedLumaQP(-1)
 #endif
@@ -79,6 +81,19 @@ void EncSlice::destroy()
   m_vdRdPicQp.clear();
   m_viRdPicQp.clear();
 
+  for (auto &cuEncoder: m_tileCuEncoders)
+  {
+    cuEncoder->destroy();
+  }
+  m_tileCuEncoders.clear();
+  m_tilePicBufs.clear();
+  m_tileThreadPool.reset();
+  for (auto &tileCS: m_tileCS)
+  {
+    tileCS->cs.destroy();
+  }
+  m_tileCS.clear();
+
   if (m_pcCfg->getDPF())
   {
     m_lambdaWeight.clear();
@@ -137,6 +152,18 @@ void EncSlice::init( EncLib* pcEncLib, const SPS& sps )
       m_pixelRecDis[i] = new int[m_maxPicWidth];
     }
   }
+
+  if (m_pcCfg->getTileNumThreads() > 1)
+  {
+    m_tileThreadPool = std::make_unique<ParallelForPool>(m_pcCfg->getTileNumThreads());
+    for (int threadIdx = 0; threadIdx < m_pcCfg->getTileNumThreads(); threadIdx++)
+    {
+      m_tileCuEncoders.push_back(std::make_unique<EncCu>());
+      m_tileCuEncoders.back()->create(pcEncLib, true);
+      m_tileCuEncoders.back()->initWorker(pcEncLib, sps, nullptr);
+    }
+    m_tilePicBufs.resize(2 * m_pcCfg->getTileNumThreads());
+  }
 }
 
 void EncSlice::setUpLambda(Slice *slice, const double dLambda, int qp)
@@ -1512,6 +1539,8 @@ void EncSlice::calCostPictureI(Picture* picture)
  */
 void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP )
 {
+  PROFILE_STAGE( "CompressSlice" );
+
   // if bCompressEntireSlice is true, then the entire slice (not slice segment) is compressed,
   //   effectively disabling the slice-segment-mode.
 
@@ -1608,7 +1637,8 @@ void EncSlice::compressSlice( Picture* pcPic, const bool bCompressEntireSlice, c
 #endif
   m_pcInterSearch->resetAffineMVList();
   m_pcInterSearch->resetUniMvList();
-  ::memset(g_isReusedUniMVsFilled, 0, sizeof(g_isReusedUniMVsFilled));
+  m_pcInterSearch->resetReusedUniMvs();
+  m_pcCuEncoder->resetSplitJobs();
   encodeCtus( pcPic, bCompressEntireSlice, bFastDeltaQP, m_pcLib );
   if (checkPLTRatio)
   {
@@ -1764,6 +1794,18 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     }
   }
 
+  if (m_compressSlicesInParallel || xCanCompressTilesInParallel(*pcPic))
+  {
+    m_parallelSlices.push_back({ pcSlice, EncCu::SliceState() });
+    m_pcCuEncoder->saveSliceState(m_parallelSlices.back().searchState);
+    if (!m_compressSlicesInParallel)
+    {
+      xCompressInParallel(pcPic, m_parallelSlices);
+      m_parallelSlices.clear();
+    }
+    return;
+  }
+
   // for every CTU in the slice
   for( uint32_t ctuIdx = 0; ctuIdx < pcSlice->getNumCtuInSlice(); ctuIdx++ )
   {
@@ -1790,26 +1832,7 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     // padding/restore at slice level
     if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == 0)
     {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
-      {
-        int n = pcSlice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
-        {
-          Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
-
-          if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
-          {
-            refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(true);
-          }
-        }
-      }
+      xExtendSubPicBorders(pcSlice, curSubPic);
     }
     if (cs.pps->ctuIsTileColBd( ctuXPosInCtus ) && cs.pps->ctuIsTileRowBd( ctuYPosInCtus ))
     {
@@ -2036,24 +2059,7 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
     // for last Ctu in the slice
     if (pcSlice->getPPS()->getNumSubPics() >= 2 && curSubPic.getTreatedAsPicFlag() && ctuIdx == (pcSlice->getNumCtuInSlice() - 1))
     {
-      int subPicX = (int)curSubPic.getSubPicLeft();
-      int subPicY = (int)curSubPic.getSubPicTop();
-      int subPicWidth = (int)curSubPic.getSubPicWidthInLumaSample();
-      int subPicHeight = (int)curSubPic.getSubPicHeightInLumaSample();
-
-      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
-      {
-        int n = pcSlice->getNumRefIdx((RefPicList)rlist);
-        for (int idx = 0; idx < n; idx++)
-        {
-          Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
-          if (refPic->getSubPicSaved())
-          {
-            refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
-            refPic->setSubPicSaved(false);
-          }
-        }
-      }
+      xRestoreSubPicBorders(pcSlice, curSubPic);
     }
     if (m_pcCfg->getDPF() && m_pcLib->getEncType() == ENC_PRE)
     {
@@ -2070,8 +2076,321 @@ void EncSlice::encodeCtus( Picture* pcPic, const bool bCompressEntireSlice, cons
   }
 }
 
+void EncSlice::xExtendSubPicBorders( Slice* pcSlice, const SubPic& subPic )
+{
+  const int subPicX      = (int) subPic.getSubPicLeft();
+  const int subPicY      = (int) subPic.getSubPicTop();
+  const int subPicWidth  = (int) subPic.getSubPicWidthInLumaSample();
+  const int subPicHeight = (int) subPic.getSubPicHeightInLumaSample();
+
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = pcSlice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
+
+      if( !refPic->getSubPicSaved() && refPic->subPictures.size() > 1 )
+      {
+        refPic->saveSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->extendSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(true);
+      }
+    }
+  }
+}
+
+void EncSlice::xRestoreSubPicBorders( Slice* pcSlice, const SubPic& subPic )
+{
+  const int subPicX      = (int) subPic.getSubPicLeft();
+  const int subPicY      = (int) subPic.getSubPicTop();
+  const int subPicWidth  = (int) subPic.getSubPicWidthInLumaSample();
+  const int subPicHeight = (int) subPic.getSubPicHeightInLumaSample();
+
+  for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+  {
+    int n = pcSlice->getNumRefIdx((RefPicList)rlist);
+    for (int idx = 0; idx < n; idx++)
+    {
+      Picture *refPic = pcSlice->getRefPic((RefPicList)rlist, idx);
+      if (refPic->getSubPicSaved())
+      {
+        refPic->restoreSubPicBorder(refPic->getPOC(), subPicX, subPicY, subPicWidth, subPicHeight);
+        refPic->setSubPicSaved(false);
+      }
+    }
+  }
+}
+
+/// the tiles and slices of a picture can only be compressed concurrently if no CTU depends on the coding of the
+/// preceding CTUs in other tiles, so tools which carry state across tile boundaries (rate control, CU level QP
+/// adaptation, WPP, palette and IBC predictors, ...) keep the serial CTU loop
+bool EncSlice::xCanCompressInParallel( const Picture& pic ) const
+{
+  const CodingStructure &cs     = *pic.cs;
+  const Slice           &slice  = *cs.slice;
+  const SPS             &sps    = *cs.sps;
+  const PPS             &pps    = *cs.pps;
+
+  if (m_tileCuEncoders.empty() || m_pcCfg->getSwitchPOC() == pic.poc || m_pcCfg->getUseRateCtrl() || m_pcCfg->getDPF()
+      || m_pcCfg->getMCTSEncConstraint() || m_pcCfg->getEntropyCodingSyncEnabledFlag())
+  {
+    return false;
+  }
+  if (pps.getUseDQP() || slice.getUseChromaQpAdj() || sps.getIBCFlag() || sps.getPLTMode() || sps.getUseColorTrans()
+      || sps.getScalingListFlag() || sps.getGDREnabledFlag())
+  {
+    return false;
+  }
+#if SHARP_LUMA_DELTA_QP
+  if (m_pcCfg->getLumaLevelToDeltaQPMapping().isEnabled())
+  {
+    return false;
+  }
+#endif
+#if WCG_EXT && ER_CHROMA_QP_WCG_PPS
+  if (m_pcCfg->getWCGChromaQPControl().isEnabled())
+  {
+    return false;
+  }
+#endif
+  return !m_pcCfg->getBIM() && !m_pcCfg->getSmoothQPReductionEnable();
+}
+
+bool EncSlice::xCanCompressTilesInParallel( const Picture& pic ) const
+{
+  const Slice &slice = *pic.cs->slice;
+  const PPS   &pps   = *pic.cs->pps;
+
+  return pps.getTileIdx(slice.getCtuAddrInSlice(0)) != pps.getTileIdx(slice.getCtuAddrInSlice(slice.getNumCtuInSlice() - 1))
+         && xCanCompressInParallel(pic);
+}
+
+/// prepares the coding structure a tile worker compresses a tile into: a top level coding structure covering only the
+/// tile, so that the units of the tiles coded concurrently are not available to the worker
+void EncSlice::xInitTileCS( CodingStructure& tileCS, const CodingStructure& picCS, Slice* slice, const UnitArea& tileArea )
+{
+  if (tileCS.area != tileArea)
+  {
+    tileCS.destroy();
+    tileCS.create(tileArea, true, false);
+    tileCS.createTemporaryCsData(false);
+  }
+
+  tileCS.picture        = picCS.picture;
+  tileCS.slice          = slice;
+  tileCS.sps            = picCS.sps;
+  tileCS.vps            = picCS.vps;
+  tileCS.pps            = picCS.pps;
+  tileCS.picHeader      = picCS.picHeader;
+  tileCS.lmcsAps        = picCS.lmcsAps;
+  tileCS.scalinglistAps = picCS.scalinglistAps;
+  tileCS.pcv            = picCS.pcv;
+  tileCS.treeType       = TREE_D;
+  tileCS.modeType       = picCS.modeType;
+  memcpy(tileCS.alfApss, picCS.alfApss, sizeof(tileCS.alfApss));
+
+  tileCS.rebindPicBufs();
+  tileCS.initStructData();
+  tileCS.motionLut.lut.resize(0);
+  tileCS.motionLut.lutIbc.resize(0);
+}
+
+/// decides before the slice loop of EncGOP whether the rectangular slices of the picture (e.g. one per subpicture)
+/// are compressed concurrently. In that case compressSlice only prepares the slices and compressParallelSlices
+/// compresses them all at once after the loop
+bool EncSlice::initParallelSlices( const Picture* pcPic )
+{
+  const PPS &pps = *pcPic->cs->pps;
+
+  m_parallelSlices.clear();
+  m_compressSlicesInParallel = pps.getNumSlicesInPic() > 1 && pps.getRectSliceFlag() && m_pcCfg->getDeltaQpRD() == 0
+                               && m_pcCfg->getCostMode() != COST_LOSSLESS_CODING && xCanCompressInParallel(*pcPic);
+  return m_compressSlicesInParallel;
+}
+
+void EncSlice::compressParallelSlices( Picture* pcPic )
+{
+  CHECK( m_parallelSlices.size() != pcPic->cs->pps->getNumSlicesInPic(), "Not all slices of the picture prepared" );
+
+  xCompressInParallel(pcPic, m_parallelSlices);
+
+  m_parallelSlices.clear();
+  m_compressSlicesInParallel = false;
+}
+
+/// compresses the tiles of the given slices on the tile workers: every tile starts from the state of the main CU
+/// encoder at the start of its slice, so the result does not depend on the number of workers. Each tile is coded into
+/// a coding structure of its own and merged into picture->cs in coding order afterwards. The CTUs are written to the
+/// substreams of their tiles by encodeSlice as usual
+void EncSlice::xCompressInParallel( Picture* pcPic, const std::vector<ParallelSlice>& slices )
+{
+  CodingStructure     &cs  = *pcPic->cs;
+  const PreCalcValues &pcv = *cs.pcv;
+
+  struct TileUnit
+  {
+    const ParallelSlice *parallelSlice;
+    int                  subPicRefId;
+    uint32_t             firstCtuIdx;
+    uint32_t             endCtuIdx;
+    uint32_t             bits;
+  };
+
+  // the tiles of a subpicture treated as a picture read the reference pictures padded around their subpicture, each
+  // such subpicture gets padded copies of its own, so that the subpictures are compressed concurrently. The copies
+  // are kept by the reference pictures for the following pictures.
+  std::vector<TileUnit> tileUnits;
+  for (const ParallelSlice &parallelSlice: slices)
+  {
+    Slice     *slice       = parallelSlice.slice;
+    const PPS &pps         = *slice->getPPS();
+    const int  subPicIdx   = pps.getSubPicIdxFromSubPicId(slice->getSliceSubPicId());
+    int        subPicRefId = -1;
+
+    if (pps.getNumSubPics() >= 2 && pps.getSubPic(subPicIdx).getTreatedAsPicFlag() && !slice->isIntra())
+    {
+      subPicRefId = subPicIdx;
+      for (int rlist = REF_PIC_LIST_0; rlist < NUM_REF_PIC_LIST_01; rlist++)
+      {
+        for (int idx = 0; idx < slice->getNumRefIdx((RefPicList) rlist); idx++)
+        {
+          Picture *refPic = slice->getRefPic((RefPicList) rlist, idx);
+          if (refPic->subPictures.size() > 1 && !refPic->hasSubPicRefBufs(subPicIdx))
+          {
+            refPic->createSubPicRefBufs(subPicIdx, pps.getSubPic(subPicIdx));
+          }
+        }
+      }
+    }
+
+    // the CTU ranges of the tiles in the slice
+    for (uint32_t ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++)
+    {
+      if (ctuIdx == 0
+          || cs.pps->getTileIdx(slice->getCtuAddrInSlice(ctuIdx)) != cs.pps->getTileIdx(slice->getCtuAddrInSlice(ctuIdx - 1)))
+      {
+        tileUnits.push_back({ &parallelSlice, subPicRefId, ctuIdx, ctuIdx, 0 });
+      }
+      tileUnits.back().endCtuIdx = ctuIdx + 1;
+    }
+  }
+
+  while (m_tileCS.size() < tileUnits.size())
+  {
+    m_tileCS.push_back(std::make_unique<TileCodingStructure>());
+  }
+
+  auto ctuPos = [&pcv](const uint32_t ctuRsAddr)
+  { return Position((ctuRsAddr % pcv.widthInCtus) * pcv.maxCUWidth, (ctuRsAddr / pcv.widthInCtus) * pcv.maxCUHeight); };
+
+  if (slices.front().slice->getSliceType() == B_SLICE)
+  {
+    resetBcwCodingOrder(false, cs);
+    m_pcInterSearch->initWeightIdxBits();
+  }
+
+  // the CTU-sized prediction and residual buffers of the picture are scratch space of the CU encoder, every worker
+  // gets copies of its own
+  for (PelStorage &buf: m_tilePicBufs)
+  {
+    if (buf.bufs.empty())
+    {
+      buf.create(cs.area.chromaFormat, Area(0, 0, pcv.maxCUWidth, pcv.maxCUHeight));
+    }
+  }
+  pcPic->setTilePicBufs(&m_tilePicBufs);
+
+  m_tileThreadPool->run((int) tileUnits.size(), [&](int unitIdx, int threadIdx) {
+    TileUnit        &unit           = tileUnits[unitIdx];
+    Slice           *pcSlice        = unit.parallelSlice->slice;
+    EncCu           &cuEncoder      = *m_tileCuEncoders[threadIdx];
+    CABACWriter     &cabacEstimator = *cuEncoder.getCABACEstimator();
+    CodingStructure &tileCS         = m_tileCS[unitIdx]->cs;
+    const Position   firstPos       = ctuPos(pcSlice->getCtuAddrInSlice(unit.firstCtuIdx));
+    const Position   lastPos        = ctuPos(pcSlice->getCtuAddrInSlice(unit.endCtuIdx - 1));
+    const Position   endPos(std::min<int>(lastPos.x + pcv.maxCUWidth, cs.area.lwidth()),
+                            std::min<int>(lastPos.y + pcv.maxCUHeight, cs.area.lheight()));
+
+    scheduler.setTilePicId(threadIdx);
+    xInitTileCS(tileCS, cs, pcSlice,
+                UnitArea(cs.area.chromaFormat, Area(firstPos, Size(endPos.x - firstPos.x, endPos.y - firstPos.y))));
+    cuEncoder.initTile(*m_pcCuEncoder, unit.parallelSlice->searchState);
+    scheduler.setSubPicRefId(unit.subPicRefId);
+    if (pcSlice->getSPS()->getUseLmcs())
+    {
+      cuEncoder.setDecCuReshaperInEncCU(m_pcLib->getReshaper(), pcSlice->getSPS()->getChromaFormatIdc());
+    }
+    cabacEstimator.initCtxModels(*pcSlice);
+
+    EnumArray<int, ChannelType> prevQP;
+    EnumArray<int, ChannelType> currQP;
+    prevQP.fill(pcSlice->getSliceQp());
+    currQP.fill(pcSlice->getSliceQp());
+
+    for (uint32_t ctuIdx = unit.firstCtuIdx; ctuIdx < unit.endCtuIdx; ctuIdx++)
+    {
+      const uint32_t ctuRsAddr = pcSlice->getCtuAddrInSlice(ctuIdx);
+      const Position pos       = ctuPos(ctuRsAddr);
+      const UnitArea ctuArea(cs.area.chromaFormat, Area(pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight));
+
+      if (pcSlice->getSliceType() != I_SLICE && cs.pps->ctuIsTileColBd(ctuRsAddr % pcv.widthInCtus))
+      {
+        tileCS.motionLut.lut.resize(0);
+        tileCS.motionLut.lutIbc.resize(0);
+      }
+
+      cuEncoder.compressCtu(tileCS, ctuArea, ctuRsAddr, prevQP, currQP);
+
+      cabacEstimator.resetBits();
+      cabacEstimator.coding_tree_unit(tileCS, ctuArea, prevQP, ctuRsAddr, true, true);
+      unit.bits += uint32_t(cabacEstimator.getEstFracBits() >> SCALE_BITS);
+    }
+    scheduler.setSubPicRefId(-1);
+    scheduler.setTilePicId(-1);
+  });
+  pcPic->setTilePicBufs(nullptr);
+
+  Slice *const curSlice = cs.slice;
+  for (int unitIdx = 0; unitIdx < (int) tileUnits.size(); unitIdx++)
+  {
+    const TileUnit  &unit   = tileUnits[unitIdx];
+    CodingStructure &tileCS = m_tileCS[unitIdx]->cs;
+
+    cs.slice = unit.parallelSlice->slice;
+    cs.useSubStructure(tileCS, ChannelType::LUMA, tileCS.area, false, false, false, false, true);
+    cs.slice->setSliceBits(cs.slice->getSliceBits() + unit.bits);
+  }
+  cs.slice = curSlice;
+  m_uiPicTotalBits = cs.fracBits >> SCALE_BITS;
+  m_uiPicDist      = cs.dist;
+
+#if GREEN_METADATA_SEI_ENABLED || K0149_BLOCK_STATISTICS
+  for (const ParallelSlice &parallelSlice: slices)
+  {
+    Slice *slice = parallelSlice.slice;
+    cs.slice     = slice;
+    for (uint32_t ctuIdx = 0; ctuIdx < slice->getNumCtuInSlice(); ctuIdx++)
+    {
+      const Position pos = ctuPos(slice->getCtuAddrInSlice(ctuIdx));
+      const UnitArea ctuArea(cs.area.chromaFormat, Area(pos.x, pos.y, pcv.maxCUWidth, pcv.maxCUHeight));
+#if GREEN_METADATA_SEI_ENABLED
+      FeatureCounterStruct featureCounter = pcPic->getFeatureCounter();
+      countFeatures(featureCounter, cs, ctuArea);
+      pcPic->setFeatureCounter(featureCounter);
+#endif
+#if K0149_BLOCK_STATISTICS
+      getAndStoreBlockStatistics(cs, ctuArea);
+#endif
+    }
+  }
+  cs.slice = curSlice;
+#endif
+}
+
 void EncSlice::encodeSlice   ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded )
 {
+  PROFILE_STAGE( "EncodeSlice" );
 
   Slice *const pcSlice                 = pcPic->slices[getSliceSegmentIdx()];
   const bool wavefrontsEnabled         = pcSlice->getSPS()->getEntropyCodingSyncEnabledFlag();
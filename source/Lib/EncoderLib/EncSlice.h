@@ -96,6 +96,30 @@ private:
 #if SHARP_LUMA_DELTA_QP || ENABLE_QPA_SUB_CTU
   int                     m_gopID;
 #endif
+  std::unique_ptr<ParallelForPool>    m_tileThreadPool;             ///< workers compressing the tiles of a slice concurrently
+  std::vector<std::unique_ptr<EncCu>> m_tileCuEncoders;             ///< CU encoder of each tile worker
+  std::vector<PelStorage>             m_tilePicBufs;                ///< prediction and residual copies of the tile workers
+
+  /// top level coding structure a tile is compressed into by the tile workers, with its own unit storage
+  struct TileCodingStructure
+  {
+    XuPool          unitPool;
+    CodingStructure cs;
+
+    TileCodingStructure() : cs( unitPool ) {}
+  };
+
+  std::vector<std::unique_ptr<TileCodingStructure>> m_tileCS;       ///< one per tile compressed concurrently
+
+  /// slice compressed on the tile workers, with the search state of the main CU encoder at the start of the slice
+  struct ParallelSlice
+  {
+    Slice*            slice;
+    EncCu::SliceState searchState;
+  };
+
+  bool                                m_compressSlicesInParallel;   ///< the slices of the picture are compressed together
+  std::vector<ParallelSlice>          m_parallelSlices;             ///< slices prepared for xCompressInParallel
 
 public:
   double initializeLambda(const Slice *slice, const int gopId, const int refQP,
@@ -132,6 +156,8 @@ public:
   void    setLosslessSlice(Picture* pcPic, bool b);      ///< Set if the slice is lossless or not
   void    encodeSlice         ( Picture* pcPic, OutputBitstream* pcSubstreams, uint32_t &numBinsCoded );
   void    encodeCtus          ( Picture* pcPic, const bool bCompressEntireSlice, const bool bFastDeltaQP, EncLib* pcEncLib );
+  bool    initParallelSlices  ( const Picture* pcPic );                               ///< decide whether the slices of the picture are compressed concurrently
+  void    compressParallelSlices( Picture* pcPic );                                   ///< compress the slices prepared by compressSlice
   void    checkDisFracMmvd    ( Picture* pcPic, uint32_t startCtuTsAddr, uint32_t boundingCtuTsAddr );
   void    setJointCbCrModes( CodingStructure& cs, const Position topLeftLuma, const Size sizeLuma );
 
@@ -146,6 +172,12 @@ public:
   void    setEncCABACTableIdx (SliceType b)         { m_encCABACTableIdx = b; }
 private:
   double  xGetQPValueAccordingToLambda ( double lambda );
+  void    xExtendSubPicBorders         ( Slice* pcSlice, const SubPic& subPic );
+  void    xRestoreSubPicBorders        ( Slice* pcSlice, const SubPic& subPic );
+  bool    xCanCompressInParallel       ( const Picture& pic ) const;
+  bool    xCanCompressTilesInParallel  ( const Picture& pic ) const;
+  void    xCompressInParallel          ( Picture* pcPic, const std::vector<ParallelSlice>& slices );
+  void    xInitTileCS                  ( CodingStructure& tileCS, const CodingStructure& picCS, Slice* slice, const UnitArea& tileArea );
 
 private:
   std::vector<double>     m_lambdaWeight;
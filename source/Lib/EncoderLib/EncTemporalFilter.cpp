@@ -37,6 +37,7 @@
 
 #include "EncTemporalFilter.h"
 #include "Utilities/VideoIOYuv.h"
+#include "CommonLib/StageProfiler.h"
 #include <math.h>
 
 
@@ -141,6 +142,8 @@ void EncTemporalFilter::init(const int frameSkip, const BitDepths &inputBitDepth
 
 bool EncTemporalFilter::filter(PelStorage *orgPic, int receivedPoc)
 {
+  PROFILE_STAGE( "MCTF" );
+
   bool isFilterThisFrame = false;
   if (m_QP >= 17)  // disable filter for QP < 17
   {
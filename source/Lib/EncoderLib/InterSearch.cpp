@@ -36,6 +36,7 @@
  */
 
 #include "InterSearch.h"
+#include "CommonLib/StageProfiler.h"
 
 
 #include "CommonLib/CommonDef.h"
@@ -114,6 +115,7 @@ InterSearch::InterSearch()
   m_affMVListSize = 0;
   m_affMVListIdx = 0;
   m_uniMvList = nullptr;
+  m_reusedUniMvs = nullptr;
   m_uniMvListSize = 0;
   m_uniMvListIdx = 0;
   m_histBestSbt    = MAX_UCHAR;
@@ -173,6 +175,8 @@ void InterSearch::destroy()
     delete[] m_uniMvList;
     m_uniMvList = nullptr;
   }
+  delete m_reusedUniMvs;
+  m_reusedUniMvs = nullptr;
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
   m_isInitialized = false;
@@ -265,11 +269,49 @@ void InterSearch::init(EncCfg *pcEncCfg, TrQuant *pcTrQuant, int searchRange, in
   {
     m_uniMvList = new BlkUniMvInfo[m_uniMvListMaxSize];
   }
+  if (m_reusedUniMvs == nullptr)
+  {
+    m_reusedUniMvs = new ReusedUniMvs;
+    resetReusedUniMvs();
+  }
   m_uniMvListIdx = 0;
   m_uniMvListSize = 0;
   m_isInitialized = true;
 }
 
+/// copies the slice and CTU level search state (adaptive search ranges, BCW bits, affine and uni-prediction MV
+/// history) of another instance, the cache of reused uni-prediction MVs is kept and reset separately
+void InterSearch::copyState(const InterSearch& other)
+{
+  std::copy_n(&other.m_adaptSR[0][0], MAX_NUM_REF_LIST_ADAPT_SR * MAX_IDX_ADAPT_SR, &m_adaptSR[0][0]);
+  std::copy_n(other.m_estWeightIdxBits, BCW_NUM, m_estWeightIdxBits);
+  m_clipMvInSubPic = other.m_clipMvInSubPic;
+
+  CHECK(m_affMVListMaxSize != other.m_affMVListMaxSize || m_uniMvListMaxSize != other.m_uniMvListMaxSize,
+        "MV history sizes differ");
+  std::copy_n(other.m_affMVList, m_affMVListMaxSize, m_affMVList);
+#if GDR_ENABLED
+  std::copy_n(other.m_affMVListSolid, m_affMVListMaxSize, m_affMVListSolid);
+#endif
+  m_affMVListIdx  = other.m_affMVListIdx;
+  m_affMVListSize = other.m_affMVListSize;
+  std::copy_n(other.m_uniMvList, m_uniMvListMaxSize, m_uniMvList);
+  m_uniMvListIdx  = other.m_uniMvListIdx;
+  m_uniMvListSize = other.m_uniMvListSize;
+}
+
+void InterSearch::saveSliceState(SliceState& state) const
+{
+  std::copy_n(&m_adaptSR[0][0], MAX_NUM_REF_LIST_ADAPT_SR * MAX_IDX_ADAPT_SR, &state.adaptSR[0][0]);
+  state.clipMvInSubPic = m_clipMvInSubPic;
+}
+
+void InterSearch::loadSliceState(const SliceState& state)
+{
+  std::copy_n(&state.adaptSR[0][0], MAX_NUM_REF_LIST_ADAPT_SR * MAX_IDX_ADAPT_SR, &m_adaptSR[0][0]);
+  m_clipMvInSubPic = state.clipMvInSubPic;
+}
+
 void InterSearch::resetSavedAffineMotion()
 {
   for ( int i = 0; i < 2; i++ )
@@ -1611,6 +1653,8 @@ void InterSearch::xSetIntraSearchRange(PredictionUnit& pu, int iRoiWidth, int iR
 
 bool InterSearch::predIBCSearch(CodingUnit& cu, Partitioner& partitioner, const int localSearchRangeX, const int localSearchRangeY, IbcHashMap& ibcHashMap)
 {
+  PROFILE_STAGE( "IbcSearch" );
+
   Mv           cMvSrchRngLT;
   Mv           cMvSrchRngRB;
 
@@ -2687,6 +2731,8 @@ bool InterSearch::predInterHashSearch(CodingUnit& cu, Partitioner& partitioner,
 //! search of the best candidate for inter prediction
 void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
 {
+  PROFILE_STAGE( "MotionEstimation" );
+
   CodingStructure& cs = *cu.cs;
 
   AMVPInfo     amvp[NUM_REF_PIC_LIST_01];
@@ -3236,9 +3282,8 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
         unsigned idx1, idx2, idx3, idx4;
         getAreaIdx(cu.Y(), *cu.slice->getPPS()->pcv, idx1, idx2, idx3, idx4);
         CHECKD(idx3 >= MAX_NUM_SIZES || idx4 >= MAX_NUM_SIZES, "MAX_NUM_SIZES is too small");
-        ::memcpy(&(g_reusedUniMVs[idx1][idx2][idx3][idx4][0][0]), cMvTemp,
-                 sizeof(cMvTemp));
-        g_isReusedUniMVsFilled[idx1][idx2][idx3][idx4] = true;
+        ::memcpy(&(m_reusedUniMvs->mvs[idx1][idx2][idx3][idx4][0][0]), cMvTemp, sizeof(cMvTemp));
+        m_reusedUniMvs->filled[idx1][idx2][idx3][idx4] = true;
       }
       //  Bi-predictive Motion estimation
       if( ( cs.slice->isInterB() ) && ( PU::isBipredRestriction( pu ) == false )
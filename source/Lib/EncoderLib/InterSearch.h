@@ -89,6 +89,13 @@ struct BlkUniMvInfo
   int x, y, w, h;
 };
 
+// uni-prediction MVs found per block position and size, reused when the block is tested again with AMVR
+struct ReusedUniMvs
+{
+  RefSetArray<Mv> mvs[MAX_CU_SIZE_IN_PARTS][MAX_CU_SIZE_IN_PARTS][MAX_NUM_SIZES][MAX_NUM_SIZES];
+  bool            filled[MAX_CU_SIZE_IN_PARTS][MAX_CU_SIZE_IN_PARTS][MAX_NUM_SIZES][MAX_NUM_SIZES];
+};
+
 typedef struct
 {
   Mv acMvAffine4Para[2][3];
@@ -139,6 +146,7 @@ private:
   int             m_uniMvListIdx;
   int             m_uniMvListSize;
   int             m_uniMvListMaxSize;
+  ReusedUniMvs*   m_reusedUniMvs;
   Distortion      m_hevcCost;
 #if GDR_ENABLED
   bool            m_hevcCostOk;
@@ -281,6 +289,8 @@ public:
     }
   }
   void resetUniMvList() { m_uniMvListIdx = 0; m_uniMvListSize = 0; }
+  void resetReusedUniMvs() { std::memset(m_reusedUniMvs->filled, 0, sizeof(m_reusedUniMvs->filled)); }
+  ReusedUniMvs &getReusedUniMvs() { return *m_reusedUniMvs; }
   void insertUniMvCands(CompArea blkArea, RefSetArray<Mv> &cMvTemp)
   {
     BlkUniMvInfo* curMvInfo = m_uniMvList + m_uniMvListIdx;
@@ -364,6 +374,16 @@ public:
   bool isValidBv(PredictionUnit& pu, int xPos, int yPos, int width, int height, int picWidth, int picHeight, int xBv,
                  int yBv, int ctuSize);
   void setClipMvInSubPic(bool flag) { m_clipMvInSubPic = flag; }
+  void copyState(const InterSearch& other);
+
+  /// the part of the search state set up per slice (search range, MV clipping to the subpicture)
+  struct SliceState
+  {
+    int  adaptSR[MAX_NUM_REF_LIST_ADAPT_SR][MAX_IDX_ADAPT_SR];
+    bool clipMvInSubPic;
+  };
+  void saveSliceState(SliceState& state) const;
+  void loadSliceState(const SliceState& state);
 protected:
 
   /// sub-function for motion vector refinement used in fractional-pel accuracy
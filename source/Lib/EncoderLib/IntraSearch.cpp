@@ -36,6 +36,7 @@
  */
 
 #include "IntraSearch.h"
+#include "CommonLib/StageProfiler.h"
 
 #include "EncModeCtrl.h"
 
@@ -504,6 +505,8 @@ bool IntraSearch::isValidIntraPredChroma(PredictionUnit &pu, int lumaDirMode, in
 
 bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, const double bestCostSoFar, bool mtsCheckRangeFlag, int mtsFirstCheckId, int mtsLastCheckId, bool moreProbMTSIdxFirst, CodingStructure* bestCS)
 {
+  PROFILE_STAGE( "IntraLumaSearch" );
+
   CodingStructure &cs  = *cu.cs;
   const SPS       &sps = *cs.sps;
 
@@ -1424,6 +1427,8 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, c
 
 void IntraSearch::estIntraPredChromaQT( CodingUnit &cu, Partitioner &partitioner, const double maxCostAllowed )
 {
+  PROFILE_STAGE( "IntraChromaSearch" );
+
   const ChromaFormat format   = cu.chromaFormat;
   const uint32_t    numberValidComponents = getNumberValidComponents(format);
   CodingStructure &cs = *cu.cs;
@@ -0,0 +1,370 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     MetricEngine.cpp
+    \brief    picture quality metrics of the encoder
+*/
+
+#include "MetricEngine.h"
+
+#include <algorithm>
+#include <cmath>
+
+//! \ingroup EncoderLib
+//! \{
+
+MetricEngine::~MetricEngine()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shutdown = true;
+  }
+  m_wakeUp.notify_all();
+  for (auto &thread: m_threads)
+  {
+    thread.join();
+  }
+}
+
+void MetricEngine::submit(std::vector<std::function<void()>> &&jobs)
+{
+  if (m_threads.empty())
+  {
+    for (int i = 0; i < std::max(1, m_numThreads); i++)
+    {
+      m_threads.emplace_back([this]() { workerLoop(); });
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto &job: jobs)
+    {
+      m_queue.push_back(std::move(job));
+    }
+    m_numPending += jobs.size();
+  }
+  m_wakeUp.notify_all();
+}
+
+void MetricEngine::wait()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (runQueuedJob(lock))
+  {
+  }
+  m_done.wait(lock, [this]() { return m_numPending == 0; });
+}
+
+bool MetricEngine::runQueuedJob(std::unique_lock<std::mutex> &lock)
+{
+  if (m_queue.empty())
+  {
+    return false;
+  }
+  std::function<void()> job = std::move(m_queue.front());
+  m_queue.pop_front();
+
+  lock.unlock();
+  job();
+  lock.lock();
+
+  if (--m_numPending == 0)
+  {
+    m_done.notify_all();
+  }
+  return true;
+}
+
+void MetricEngine::workerLoop()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_wakeUp.wait(lock, [this]() { return m_shutdown || !m_queue.empty(); });
+    if (!runQueuedJob(lock))
+    {
+      return;
+    }
+  }
+}
+
+uint64_t MetricEngine::ssd(const CPelBuf &pic0, const CPelBuf &pic1)
+{
+  CHECK(pic0.width != pic1.width, "Unspecified error");
+  CHECK(pic0.height != pic1.height, "Unspecified error");
+
+  return g_pelBufOP.sumSquaredDiff(pic0.buf, pic0.stride, pic1.buf, pic1.stride, pic0.width, pic0.height);
+}
+
+void MetricEngine::lumaLevelSquaredErrors(const CPelBuf &pic0, const CPelBuf &pic1, const CPelBuf &picLuma0,
+                                          const int scaleX, const int scaleY, std::vector<uint64_t> &hist)
+{
+  CHECK(pic0.width != pic1.width, "Unspecified error");
+  CHECK(pic0.height != pic1.height, "Unspecified error");
+
+  const Pel *src0    = pic0.buf;
+  const Pel *src1    = pic1.buf;
+  const Pel *srcLuma = picLuma0.buf;
+
+  for (int y = 0; y < pic0.height; y++)
+  {
+    for (int x = 0; x < pic0.width; x++)
+    {
+      const int64_t diff = (int64_t) src0[x] - (int64_t) src1[x];
+      hist[srcLuma[x << scaleX]] += uint64_t(diff * diff);
+    }
+    src0 += pic0.stride;
+    src1 += pic1.stride;
+    srcLuma += picLuma0.stride << scaleY;
+  }
+}
+
+double MetricEngine::msssim(const CPelBuf &org, const CPelBuf &rec, const uint32_t bitDepth) const
+{
+  const int MAX_MSSSIM_SCALE  = 5;
+  const int WEIGHTING_MID_TAP = SSIM_FILTER_SIZE / 2;
+  const int NUM_MOMENTS       = 5;
+
+  const int width  = org.width;
+  const int height = org.height;
+
+  uint32_t maxScale;
+
+  // For low resolution videos determine number of scales
+  if (width < 22 || height < 22)
+  {
+    maxScale = 1;
+  }
+  else if (width < 44 || height < 44)
+  {
+    maxScale = 2;
+  }
+  else if (width < 88 || height < 88)
+  {
+    maxScale = 3;
+  }
+  else if (width < 176 || height < 176)
+  {
+    maxScale = 4;
+  }
+  else
+  {
+    maxScale = 5;
+  }
+
+  // Normalized Gaussian mask, 11*11, s.d. 1.5. The mask is separable, the fast evaluation applies it as a horizontal
+  // and a vertical 11-tap filter.
+  double weights[SSIM_FILTER_SIZE][SSIM_FILTER_SIZE];
+  double coeffSum = 0.0;
+  for (int y = 0; y < SSIM_FILTER_SIZE; y++)
+  {
+    for (int x = 0; x < SSIM_FILTER_SIZE; x++)
+    {
+      weights[y][x] =
+        exp(-((y - WEIGHTING_MID_TAP) * (y - WEIGHTING_MID_TAP) + (x - WEIGHTING_MID_TAP) * (x - WEIGHTING_MID_TAP))
+            / (WEIGHTING_MID_TAP - 0.5));
+      coeffSum += weights[y][x];
+    }
+  }
+  for (int y = 0; y < SSIM_FILTER_SIZE; y++)
+  {
+    for (int x = 0; x < SSIM_FILTER_SIZE; x++)
+    {
+      weights[y][x] /= coeffSum;
+    }
+  }
+
+  double taps[SSIM_FILTER_SIZE];
+  double tapSum = 0.0;
+  for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+  {
+    taps[i] = exp(-(i - WEIGHTING_MID_TAP) * (i - WEIGHTING_MID_TAP) / (WEIGHTING_MID_TAP - 0.5));
+    tapSum += taps[i];
+  }
+  for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+  {
+    taps[i] /= tapSum;
+  }
+
+  //Resolution based weights
+  const double exponentWeights[MAX_MSSSIM_SCALE][MAX_MSSSIM_SCALE] = {{1.0,    0,      0,      0,      0     },
+                                                                      {0.1356, 0.8644, 0,      0,      0     },
+                                                                      {0.0711, 0.4530, 0.4760, 0,      0     },
+                                                                      {0.0517, 0.3295, 0.3462, 0.2726, 0     },
+                                                                      {0.0448, 0.2856, 0.3001, 0.2363, 0.1333}};
+
+  //Downsampling of data:
+  std::vector<double> original[MAX_MSSSIM_SCALE];
+  std::vector<double> recon[MAX_MSSSIM_SCALE];
+
+  for (uint32_t scale = 0; scale < maxScale; scale++)
+  {
+    const int scaledHeight = height >> scale;
+    const int scaledWidth  = width >> scale;
+    original[scale].resize(scaledHeight * scaledWidth, double(0));
+    recon[scale].resize(scaledHeight * scaledWidth, double(0));
+  }
+
+  // Initial [0] arrays to be a copy of the source data (but stored in array "double", not Pel array).
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      original[0][y * width + x] = org.at(x, y);
+      recon[0][y * width + x]    = rec.at(x, y);
+    }
+  }
+
+  // Set up other arrays to be average value of each 2x2 sample.
+  for (uint32_t scale = 1; scale < maxScale; scale++)
+  {
+    const int     scaledHeight = height >> scale;
+    const int     scaledWidth  = width >> scale;
+    const double *srcOrg       = original[scale - 1].data();
+    const double *srcRec       = recon[scale - 1].data();
+    const int     srcStride    = 2 * scaledWidth;
+    for (int y = 0; y < scaledHeight; y++)
+    {
+      for (int x = 0; x < scaledWidth; x++)
+      {
+        const int pos = 2 * y * srcStride + 2 * x;
+
+        original[scale][y * scaledWidth + x] =
+          (srcOrg[pos] + srcOrg[pos + 1] + srcOrg[pos + srcStride] + srcOrg[pos + srcStride + 1]) / 4.0;
+        recon[scale][y * scaledWidth + x] =
+          (srcRec[pos] + srcRec[pos + 1] + srcRec[pos + srcStride] + srcRec[pos + srcStride + 1]) / 4.0;
+      }
+    }
+  }
+
+  // Calculate MS-SSIM:
+  const uint32_t maxValue = (1 << bitDepth) - 1;
+  const double   c1       = (0.01 * maxValue) * (0.01 * maxValue);
+  const double   c2       = (0.03 * maxValue) * (0.03 * maxValue);
+
+  double finalMSSSIM = 1.0;
+
+  // ring buffer with the horizontally filtered moments of the last SSIM_FILTER_SIZE lines
+  std::vector<double> moments;
+
+  for (uint32_t scale = 0; scale < maxScale; scale++)
+  {
+    const int scaledHeight    = height >> scale;
+    const int scaledWidth     = width >> scale;
+    const int blocksPerRow    = scaledWidth - SSIM_FILTER_SIZE + 1;
+    const int blocksPerColumn = scaledHeight - SSIM_FILTER_SIZE + 1;
+    const int totalBlocks     = blocksPerRow * blocksPerColumn;
+
+    double meanSSIM = 0.0;
+
+    if (!m_fastMetrics)
+    {
+      // direct evaluation, the window sums are accumulated in raster order
+      for (int blockIndexY = 0; blockIndexY < blocksPerColumn; blockIndexY++)
+      {
+        for (int blockIndexX = 0; blockIndexX < blocksPerRow; blockIndexX++)
+        {
+          double muOrg         = 0.0;
+          double muRec         = 0.0;
+          double muOrigSqr     = 0.0;
+          double muRecSqr      = 0.0;
+          double muOrigMultRec = 0.0;
+
+          for (int y = 0; y < SSIM_FILTER_SIZE; y++)
+          {
+            for (int x = 0; x < SSIM_FILTER_SIZE; x++)
+            {
+              const double gaussianWeight = weights[y][x];
+              const int    sampleOffset   = (blockIndexY + y) * scaledWidth + (blockIndexX + x);
+              const double orgPel         = original[scale][sampleOffset];
+              const double recPel         = recon[scale][sampleOffset];
+
+              muOrg += orgPel * gaussianWeight;
+              muRec += recPel * gaussianWeight;
+              muOrigSqr += orgPel * orgPel * gaussianWeight;
+              muRecSqr += recPel * recPel * gaussianWeight;
+              muOrigMultRec += orgPel * recPel * gaussianWeight;
+            }
+          }
+
+          const double sigmaSqrOrig = muOrigSqr - (muOrg * muOrg);
+          const double sigmaSqrRec  = muRecSqr - (muRec * muRec);
+          const double sigmaOrigRec = muOrigMultRec - (muOrg * muRec);
+
+          double blockSSIMVal = ((2.0 * sigmaOrigRec + c2) / (sigmaSqrOrig + sigmaSqrRec + c2));
+          if (scale == maxScale - 1)
+          {
+            blockSSIMVal *= (2.0 * muOrg * muRec + c1) / (muOrg * muOrg + muRec * muRec + c1);
+          }
+
+          meanSSIM += blockSSIMVal;
+        }
+      }
+    }
+    else if (blocksPerRow > 0 && blocksPerColumn > 0)
+    {
+      // separable evaluation, the SIMD kernels sum the windows of a row in a different order, so the result differs
+      // from the direct evaluation in the last digits
+      const ptrdiff_t lineSize = NUM_MOMENTS * blocksPerRow;
+      moments.resize(SSIM_FILTER_SIZE * lineSize);
+
+      const double *rows[SSIM_FILTER_SIZE];
+
+      for (int y = 0; y < scaledHeight; y++)
+      {
+        g_pelBufOP.ssimMomentsHor(&original[scale][y * scaledWidth], &recon[scale][y * scaledWidth], blocksPerRow,
+                                  taps, &moments[(y % SSIM_FILTER_SIZE) * lineSize], blocksPerRow);
+
+        if (y >= SSIM_FILTER_SIZE - 1)
+        {
+          const int blockIndexY = y - SSIM_FILTER_SIZE + 1;
+          for (int i = 0; i < SSIM_FILTER_SIZE; i++)
+          {
+            rows[i] = &moments[((blockIndexY + i) % SSIM_FILTER_SIZE) * lineSize];
+          }
+          meanSSIM += g_pelBufOP.ssimSumVer(rows, blocksPerRow, blocksPerRow, taps, c1, c2, scale == maxScale - 1);
+        }
+      }
+    }
+
+    meanSSIM /= totalBlocks;
+
+    finalMSSSIM *= pow(meanSSIM, exponentWeights[maxScale - 1][scale]);
+  }
+
+  return finalMSSSIM;
+}
+
+//! \}
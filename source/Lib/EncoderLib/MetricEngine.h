@@ -0,0 +1,103 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     MetricEngine.h
+    \brief    picture quality metrics of the encoder (header)
+*/
+
+#ifndef __METRICENGINE__
+#define __METRICENGINE__
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "CommonLib/Unit.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+/// Computes the picture distortion metrics reported by the encoder (SSD for PSNR, luma level weighted SSD for WPSNR
+/// and MS-SSIM) with the SIMD kernels of PelBufferOps. The metric computations of a picture are queued as jobs and run
+/// by the worker threads of the engine while the caller continues; the results do not depend on the number of threads.
+class MetricEngine
+{
+public:
+  MetricEngine() = default;
+  ~MetricEngine();
+
+  MetricEngine(const MetricEngine &)            = delete;
+  MetricEngine &operator=(const MetricEngine &) = delete;
+
+  /// number of worker threads, must be set before the first jobs are queued
+  void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+  int  getNumThreads() const { return m_numThreads; }
+  /// separable MS-SSIM and per luma level WPSNR accumulation, faster but not bit-exact with the direct evaluation
+  void setFastMetrics(bool fastMetrics) { m_fastMetrics = fastMetrics; }
+  bool getFastMetrics() const { return m_fastMetrics; }
+
+  /// queue jobs, they are started immediately by the worker threads
+  void submit(std::vector<std::function<void()>> &&jobs);
+  /// run queued jobs on the calling thread as well and wait until all jobs are finished
+  void wait();
+
+  static uint64_t ssd(const CPelBuf &pic0, const CPelBuf &pic1);
+  double          msssim(const CPelBuf &org, const CPelBuf &rec, const uint32_t bitDepth) const;
+
+  /// squared errors accumulated per co-located luma level of picLuma0, hist must hold all luma levels
+  static void lumaLevelSquaredErrors(const CPelBuf &pic0, const CPelBuf &pic1, const CPelBuf &picLuma0,
+                                     const int scaleX, const int scaleY, std::vector<uint64_t> &hist);
+
+private:
+  void workerLoop();
+  bool runQueuedJob(std::unique_lock<std::mutex> &lock);
+
+  int  m_numThreads  = 1;
+  bool m_fastMetrics = false;
+
+  std::vector<std::thread>          m_threads;
+  std::mutex                        m_mutex;
+  std::condition_variable           m_wakeUp;
+  std::condition_variable           m_done;
+  std::deque<std::function<void()>> m_queue;
+  size_t                            m_numPending = 0;
+  bool                              m_shutdown   = false;
+};
+
+//! \}
+
+#endif // __METRICENGINE__
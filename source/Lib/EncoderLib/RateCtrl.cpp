@@ -38,6 +38,7 @@
 #include "../CommonLib/ChromaFormat.h"
 
 #include <cmath>
+#include <sstream>
 
 #define LAMBDA_PREC                                           1000000
 
@@ -310,6 +311,7 @@ EncRCGOP::EncRCGOP()
   m_bitsLeft   = 0;
   m_minEstLambda = 0.0;
   m_maxEstLambda = 0.0;
+  m_useFirstPassBits = false;
 }
 
 EncRCGOP::~EncRCGOP()
@@ -317,10 +319,23 @@ EncRCGOP::~EncRCGOP()
   destroy();
 }
 
-void EncRCGOP::create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio)
+void EncRCGOP::create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio, const int *firstPassTargetBits)
 {
   destroy();
-  int targetBits = xEstGOPTargetBits( encRCSeq, numPic );
+  int targetBits = 0;
+  if (firstPassTargetBits != nullptr)
+  {
+    for (int i = 0; i < numPic; i++)
+    {
+      targetBits += firstPassTargetBits[i];
+    }
+    targetBits = std::max(targetBits, 200);
+    useAdaptiveBitsRatio = false;
+  }
+  else
+  {
+    targetBits = xEstGOPTargetBits(encRCSeq, numPic);
+  }
   int bitdepth_luma_scale =
     2 * (encRCSeq->getbitDepth() - 8
       - DISTORTION_PRECISION_ADJUSTMENT(encRCSeq->getbitDepth()));
@@ -531,19 +546,27 @@ void EncRCGOP::create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio)
   }
 
   m_picTargetBitInGOP = new int[numPic];
-  int i;
-  int totalPicRatio = 0;
-  int currPicRatio = 0;
-  for ( i=0; i<numPic; i++ )
+  if (firstPassTargetBits != nullptr)
   {
-    totalPicRatio += encRCSeq->getBitRatio( i );
+    std::copy(firstPassTargetBits, firstPassTargetBits + numPic, m_picTargetBitInGOP);
   }
-  for ( i=0; i<numPic; i++ )
+  else
   {
-    currPicRatio = encRCSeq->getBitRatio( i );
-    m_picTargetBitInGOP[i] = (int)( ((double)targetBits) * currPicRatio / totalPicRatio );
+    int i;
+    int totalPicRatio = 0;
+    int currPicRatio  = 0;
+    for ( i=0; i<numPic; i++ )
+    {
+      totalPicRatio += encRCSeq->getBitRatio( i );
+    }
+    for ( i=0; i<numPic; i++ )
+    {
+      currPicRatio = encRCSeq->getBitRatio( i );
+      m_picTargetBitInGOP[i] = (int)( ((double)targetBits) * currPicRatio / totalPicRatio );
+    }
   }
 
+  m_useFirstPassBits = firstPassTargetBits != nullptr;
   m_encRCSeq    = encRCSeq;
   m_numPic       = numPic;
   m_targetBits   = targetBits;
@@ -658,6 +681,8 @@ EncRCPic::EncRCPic()
   m_picLambda           = 0.0;
   m_picMSE              = 0.0;
   m_validPixelsInPic    = 0;
+  m_totalCostIntra      = 0.0;
+  m_firstPassLCUBits    = nullptr;
 }
 
 EncRCPic::~EncRCPic()
@@ -671,12 +696,14 @@ int EncRCPic::xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP )
   int GOPbitsLeft       = encRCGOP->getBitsLeft();
 
   int i;
+  // with first-pass statistics, the remaining GOP budget is shared like the first pass spent it
+  const bool useFirstPass = encRCGOP->getUseFirstPassBits();
   int currPicPosition = encRCGOP->getNumPic()-encRCGOP->getPicLeft();
-  int currPicRatio    = encRCSeq->getBitRatio( currPicPosition );
+  int currPicRatio    = useFirstPass ? encRCGOP->getTargetBitInGOP( currPicPosition ) : encRCSeq->getBitRatio( currPicPosition );
   int totalPicRatio   = 0;
   for ( i=currPicPosition; i<encRCGOP->getNumPic(); i++ )
   {
-    totalPicRatio += encRCSeq->getBitRatio( i );
+    totalPicRatio += useFirstPass ? encRCGOP->getTargetBitInGOP( i ) : encRCSeq->getBitRatio( i );
   }
 
   targetBits  = int( ((double)GOPbitsLeft) * currPicRatio / totalPicRatio );
@@ -723,13 +750,15 @@ int EncRCPic::xEstPicLowerBound(EncRCSeq* encRCSeq, EncRCGOP* encRCGOP)
   int lowerBound = 0;
   int GOPbitsLeft = encRCGOP->getBitsLeft();
 
+  const bool useFirstPass    = encRCGOP->getUseFirstPassBits();
   const int nextPicPosition = (encRCGOP->getNumPic() - encRCGOP->getPicLeft() + 1) % encRCGOP->getNumPic();
-  const int nextPicRatio = encRCSeq->getBitRatio(nextPicPosition);
+  const int nextPicRatio =
+    useFirstPass ? encRCGOP->getTargetBitInGOP(nextPicPosition) : encRCSeq->getBitRatio(nextPicPosition);
 
   int totalPicRatio = 0;
   for (int i = nextPicPosition; i < encRCGOP->getNumPic(); i++)
   {
-    totalPicRatio += encRCSeq->getBitRatio(i);
+    totalPicRatio += useFirstPass ? encRCGOP->getTargetBitInGOP(i) : encRCSeq->getBitRatio(i);
   }
 
   if (nextPicPosition == 0)
@@ -840,6 +869,7 @@ void EncRCPic::destroy()
   }
   m_encRCSeq = nullptr;
   m_encRCGOP = nullptr;
+  m_firstPassLCUBits = nullptr;
 }
 
 double EncRCPic::estimatePicLambda(std::list<EncRCPic *> &listPreviousPictures, bool isIRAP)
@@ -936,7 +966,15 @@ double EncRCPic::estimatePicLambda(std::list<EncRCPic *> &listPreviousPictures,
       betaLCU  = m_encRCSeq->getPicPara( m_frameLevel ).m_beta;
     }
 
-    m_LCUs[i].m_bitWeight =  m_LCUs[i].m_numberOfPixel * pow( estLambda/alphaLCU, 1.0/betaLCU );
+    if (m_firstPassLCUBits != nullptr)
+    {
+      // two-pass: the first pass measured how the bits of this picture are spread over the CTUs
+      m_LCUs[i].m_bitWeight = (double) (*m_firstPassLCUBits)[i];
+    }
+    else
+    {
+      m_LCUs[i].m_bitWeight = m_LCUs[i].m_numberOfPixel * pow(estLambda / alphaLCU, 1.0 / betaLCU);
+    }
 
     if ( m_LCUs[i].m_bitWeight < 0.01 )
     {
@@ -1426,6 +1464,9 @@ RateCtrl::RateCtrl()
   m_encRCSeq = nullptr;
   m_encRCGOP = nullptr;
   m_encRCPic = nullptr;
+  m_statsPass         = 0;
+  m_firstPassIdx      = 0;
+  m_firstPassBitsLeft = 0;
 }
 
 RateCtrl::~RateCtrl()
@@ -1451,6 +1492,14 @@ void RateCtrl::destroy()
     m_listRCPictures.pop_front();
     delete p;
   }
+  if (m_statsFile.is_open())
+  {
+    m_statsFile.close();
+  }
+  m_firstPassPics.clear();
+  m_statsPass         = 0;
+  m_firstPassIdx      = 0;
+  m_firstPassBitsLeft = 0;
 }
 
 void RateCtrl::init(int totalFrames, int targetBitrate, const Fraction& frameRate, int GOPSize, int intraPeriod,
@@ -1906,15 +1955,38 @@ void RateCtrl::init(int totalFrames, int targetBitrate, const Fraction& frameRat
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCPic( int frameLevel )
+void RateCtrl::initRCPic( int frameLevel, int POC )
 {
   m_encRCPic = new EncRCPic;
   m_encRCPic->create( m_encRCSeq, m_encRCGOP, frameLevel, m_listRCPictures );
+
+  if (getUseFirstPassStats())
+  {
+    const TRCFirstPassPic &firstPass = m_firstPassPics[m_firstPassIdx];
+    CHECK(firstPass.m_POC != POC, "First-pass statistics do not match the coding order of the second pass (POC "
+                                    << firstPass.m_POC << " instead of " << POC << ")");
+    if ((int) firstPass.m_LCUBits.size() == m_encRCSeq->getNumberOfLCU())
+    {
+      m_encRCPic->setFirstPassLCUBits(&firstPass.m_LCUBits);
+    }
+  }
 }
 
 void RateCtrl::initRCGOP( int numberOfPictures )
 {
   m_encRCGOP = new EncRCGOP;
+  if (getUseFirstPassStats() && m_firstPassIdx + numberOfPictures <= m_firstPassPics.size() && m_firstPassBitsLeft > 0)
+  {
+    // scale the first-pass bits so that the pictures still to be coded exactly use up the remaining budget
+    const double scale = (double) m_encRCSeq->getBitsLeft() / (double) m_firstPassBitsLeft;
+    std::vector<int> targetBits(numberOfPictures);
+    for (int i = 0; i < numberOfPictures; i++)
+    {
+      targetBits[i] = std::max(100, (int) (m_firstPassPics[m_firstPassIdx + i].m_bits * scale + 0.5));
+    }
+    m_encRCGOP->create(m_encRCSeq, numberOfPictures, false, targetBits.data());
+    return;
+  }
   bool useAdaptiveBitsRatio = (m_encRCSeq->getAdaptiveBits() > 0) && (m_listRCPictures.size() >= m_encRCSeq->getGOPSize());
   m_encRCGOP->create(m_encRCSeq, numberOfPictures, useAdaptiveBitsRatio);
 }
@@ -1949,6 +2021,81 @@ void RateCtrl::initHrdParam(const GeneralHrdParams* generalHrd, const OlsHrdPara
   msg(NOTICE, "\nHRD - [Initial CPB state %6d] [CPB Size %6d] [Buffering Rate %6d]\n", m_cpbState, m_cpbSize, m_bufferingRate);
 }
 
+void RateCtrl::initStats(int pass, const std::string &fileName)
+{
+  m_statsPass = pass;
+  m_firstPassPics.clear();
+  m_firstPassIdx      = 0;
+  m_firstPassBitsLeft = 0;
+
+  if (pass == 1)
+  {
+    m_statsFile.open(fileName.c_str(), std::ios::out);
+    if (!m_statsFile.is_open())
+    {
+      EXIT("Unable to open rate control statistics file " << fileName << " for writing");
+    }
+    m_statsFile << "# POC level bits headerBits QP lambda MSE costIntra numLCU { LCUBits LCUMSE }\n";
+  }
+  else if (pass == 2)
+  {
+    std::ifstream statsFile(fileName.c_str());
+    if (!statsFile.is_open())
+    {
+      EXIT("Unable to open rate control statistics file " << fileName << " for reading");
+    }
+    std::string line;
+    while (std::getline(statsFile, line))
+    {
+      if (line.empty() || line[0] == '#')
+      {
+        continue;
+      }
+      std::istringstream record(line);
+      TRCFirstPassPic    pic;
+      int                numLCU = 0;
+      record >> pic.m_POC >> pic.m_frameLevel >> pic.m_bits >> pic.m_headerBits >> pic.m_QP >> pic.m_lambda
+        >> pic.m_MSE >> pic.m_costIntra >> numLCU;
+      CHECK(record.fail() || numLCU < 0, "Malformed picture record in rate control statistics file " << fileName);
+      pic.m_LCUBits.resize(numLCU);
+      pic.m_LCUMSE.resize(numLCU);
+      for (int i = 0; i < numLCU; i++)
+      {
+        record >> pic.m_LCUBits[i] >> pic.m_LCUMSE[i];
+      }
+      CHECK(record.fail(), "Malformed CTU record in rate control statistics file " << fileName);
+      m_firstPassBitsLeft += pic.m_bits;
+      m_firstPassPics.push_back(pic);
+    }
+    if ((int) m_firstPassPics.size() < m_encRCSeq->getTotalFrames())
+    {
+      msg(WARNING, "\nWarning: rate control statistics cover %d of %d pictures, single-pass allocation is used for the rest\n",
+          (int) m_firstPassPics.size(), m_encRCSeq->getTotalFrames());
+    }
+  }
+}
+
+void RateCtrl::updateStatsAfterPicture(int POC)
+{
+  if (m_statsPass == 1)
+  {
+    EncRCPic *pic = getRCPic();
+    m_statsFile << POC << " " << pic->getFrameLevel() << " " << pic->getPicActualBits() << " "
+                << pic->getPicActualHeaderBits() << " " << pic->getPicActualQP() << " " << pic->getPicActualLambda()
+                << " " << pic->getPicMSE() << " " << pic->getTotalIntraCost() << " " << pic->getNumberOfLCU();
+    for (int i = 0; i < pic->getNumberOfLCU(); i++)
+    {
+      m_statsFile << " " << pic->getLCU(i).m_actualBits << " " << pic->getLCU(i).m_actualMSE;
+    }
+    m_statsFile << "\n";
+  }
+  else if (getUseFirstPassStats())
+  {
+    m_firstPassBitsLeft -= m_firstPassPics[m_firstPassIdx].m_bits;
+    m_firstPassIdx++;
+  }
+}
+
 void RateCtrl::destroyRCGOP()
 {
   delete m_encRCGOP;
@@ -50,6 +50,7 @@
 
 #include "../EncoderLib/EncCfg.h"
 #include <list>
+#include <fstream>
 
 const int g_RCInvalidQPValue = -999;
 const int g_RCSmoothWindowSizeAlpha = 20;
@@ -84,6 +85,21 @@ struct TRCLCU
   double m_actualMSE;
 };
 
+// per-picture record of the first pass of a two-pass encode, stored in coding order
+struct TRCFirstPassPic
+{
+  int    m_POC;
+  int    m_frameLevel;
+  int    m_bits;
+  int    m_headerBits;
+  int    m_QP;
+  double m_lambda;
+  double m_MSE;
+  double m_costIntra;
+  std::vector<int>    m_LCUBits;
+  std::vector<double> m_LCUMSE;
+};
+
 struct TRCParameter
 {
   double m_alpha;
@@ -192,7 +208,7 @@ public:
   ~EncRCGOP();
 
 public:
-  void create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio);
+  void create(EncRCSeq *encRCSeq, int numPic, bool useAdaptiveBitsRatio, const int *firstPassTargetBits = nullptr);
   void destroy();
   void updateAfterPicture( int bitsCost );
 
@@ -210,10 +226,12 @@ public:
   int  getTargetBitInGOP( int i ) { return m_picTargetBitInGOP[i]; }
   double getMinEstLambda()        { return m_minEstLambda; }
   double getMaxEstLambda()        { return m_maxEstLambda; }
+  bool getUseFirstPassBits()      { return m_useFirstPassBits; }
 
 private:
   EncRCSeq* m_encRCSeq;
   int* m_picTargetBitInGOP;
+  bool m_useFirstPassBits;        // picture targets taken from the first pass instead of the bits ratio
   int m_numPic;
   int m_targetBits;
   int m_picLeft;
@@ -279,6 +297,8 @@ public:
   void setBitLeft(int bits)                               { m_bitsLeft = bits; }
   void setTargetBits( int bits )                          { m_targetBits = bits; m_bitsLeft = bits;}
   void setTotalIntraCost(double cost)                     { m_totalCostIntra = cost; }
+  double getTotalIntraCost()                              { return m_totalCostIntra; }
+  void setFirstPassLCUBits(const std::vector<int> *bits)  { m_firstPassLCUBits = bits; }
   void getLCUInitTargetBits();
 
   int  getPicActualBits()                                 { return m_picActualBits; }
@@ -317,6 +337,7 @@ private:
   double m_picLambda;
   double m_picMSE;
   int m_validPixelsInPic;
+  const std::vector<int> *m_firstPassLCUBits;   // CTU bits of the co-located first-pass picture, if any
 };
 
 class RateCtrl
@@ -330,10 +351,14 @@ public:
             int picHeight, int LCUWidth, int LCUHeight, int bitDepth, int keepHierBits, bool useLCUSeparateModel,
             GOPEntry GOPList[MAX_GOP]);
   void destroy();
-  void initRCPic( int frameLevel );
+  void initRCPic( int frameLevel, int POC );
   void initRCGOP( int numberOfPictures );
   void destroyRCGOP();
 
+  void initStats( int pass, const std::string &fileName );
+  void updateStatsAfterPicture( int POC );
+  bool getUseFirstPassStats() const { return m_statsPass == 2 && m_firstPassIdx < m_firstPassPics.size(); }
+
 public:
   void       setRCQP ( int QP ) { m_RCQP = QP;   }
   int        getRCQP () const   { return m_RCQP; }
@@ -371,6 +396,12 @@ private:
   int        m_cpbState;                // CPB State
   uint32_t       m_cpbSize;                 // CPB size
   uint32_t       m_bufferingRate;           // Buffering rate
+
+  int        m_statsPass;               // 0: single pass, 1: write first-pass statistics, 2: use them
+  std::ofstream m_statsFile;
+  std::vector<TRCFirstPassPic> m_firstPassPics;
+  size_t     m_firstPassIdx;            // first-pass record of the next picture in coding order
+  int64_t    m_firstPassBitsLeft;       // first-pass bits of the pictures not yet coded
 };
 
 #endif
@@ -37,6 +37,10 @@
 
 #include "SEIFilmGrainAnalyzer.h"
 
+#include "CommonLib/ParallelFor.h"
+
+static constexpr int FGA_BAND_HEIGHT = 32;   // number of rows processed by one job in the row-parallel stages
+
 constexpr double FGAnalyser::m_tapFilter[3];
 
 // ====================================================================================================================
@@ -61,18 +65,32 @@ Canny::~Canny()
   // uninit();
 }
 
+// Quantizes the edge direction atan2(gradVer, gradHor) to 0, 45, 90 or 135 degrees. 360 degrees are split into
+// 8 equal parts with the bin boundaries at odd multiples of 22.5 degrees. tan(22.5) = sqrt(2) - 1 and
+// tan(67.5) = sqrt(2) + 1, so comparing the gradient ratio against these boundaries can be done exactly in integers.
+int Canny::quantizeDirection(int gradVer, int gradHor)
+{
+  const int64_t absVer = abs(gradVer);
+  const int64_t absHor = abs(gradHor);
+
+  if ((absVer + absHor) * (absVer + absHor) <= 2 * absHor * absHor)   // |theta| < 22.5 or |theta| > 157.5, or no gradient
+  {
+    return 0;
+  }
+  if (absVer > absHor && (absVer - absHor) * (absVer - absHor) > 2 * absHor * absHor)   // 67.5 < |theta| < 112.5
+  {
+    return 90;
+  }
+  return (gradVer > 0) == (gradHor > 0) ? 45 : 135;
+}
+
 void Canny::gradient(PelStorage *buff1, PelStorage *buff2, unsigned int width, unsigned int height,
                      unsigned int convWidthS, unsigned int convHeightS, unsigned int bitDepth, ComponentID compID)
 {
   /*
   buff1 - magnitude; buff2 - orientation (Only luma in buff2)
   */
-
-  // 360 degrees are split into the 8 equal parts; edge direction is quantized
-  const double edge_threshold_22_5  = 22.5;
-  const double edge_threshold_67_5  = 67.5;
-  const double edge_threshold_112_5 = 112.5;
-  const double edge_threshold_157_5 = 157.5;
+  CHECK(convWidthS != 3 || convHeightS != 3, "Only 3x3 Sobel kernels are supported");
 
   const int maxClpRange = (1 << bitDepth) - 1;
   const int padding     = convWidthS / 2;
@@ -84,76 +102,42 @@ void Canny::gradient(PelStorage *buff1, PelStorage *buff2, unsigned int width, u
 
   buff1->get(compID).extendBorderPel(padding, padding);
 
-  // Gx
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      int acc = 0;
-      for (int x = 0; x < convWidthS; x++)
-      {
-        for (int y = 0; y < convHeightS; y++)
-        {
-          acc += (buff1->get(compID).at(x - convWidthS / 2 + i, y - convHeightS / 2 + j) * m_gx[x][y]);
-        }
-      }
-      tmpBuf1.Y().at(i, j) = acc;
-    }
-  }
+  PelBuf    src      = buff1->get(compID);
+  PelBuf    gradVer  = tmpBuf1.Y();
+  PelBuf    gradHor  = tmpBuf2.Y();
+  PelBuf    dir      = buff2->Y();
+  const int numBands = (height + FGA_BAND_HEIGHT - 1) / FGA_BAND_HEIGHT;
 
-  // Gy
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      int acc = 0;
-      for (int x = 0; x < convWidthS; x++)
-      {
-        for (int y = 0; y < convHeightS; y++)
-        {
-          acc += (buff1->get(compID).at(x - convWidthS / 2 + i, y - convHeightS / 2 + j) * m_gy[x][y]);
-        }
-      }
-      tmpBuf2.Y().at(i, j) = acc;
-    }
-  }
-
-  // magnitude
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      Pel tmp                     = (Pel)((abs(tmpBuf1.Y().at(i, j)) + abs(tmpBuf2.Y().at(i, j))) / 2);
-      buff1->get(compID).at(i, j) = (Pel) Clip3((Pel) 0, (Pel) maxClpRange, tmp);
-    }
-  }
-
-  // edge direction - quantized edge directions
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      double theta = (atan2(tmpBuf1.Y().at(i, j), tmpBuf2.Y().at(i, j)) * 180) / PI;
-
-      /* Convert actual edge direction to approximate value - quantize directions */
-      if (((-edge_threshold_22_5 < theta) && (theta <= edge_threshold_22_5)) || ((edge_threshold_157_5 < theta) || (theta <= -edge_threshold_157_5)))
-      {
-        buff2->get(ComponentID(0)).at(i, j) = 0;
-      }
-      if (((-edge_threshold_157_5 < theta) && (theta <= -edge_threshold_112_5)) || ((edge_threshold_22_5 < theta) && (theta <= edge_threshold_67_5)))
-      {
-        buff2->get(ComponentID(0)).at(i, j) = 45;
-      }
-      if (((-edge_threshold_112_5 < theta) && (theta <= -edge_threshold_67_5)) || ((edge_threshold_67_5 < theta) && (theta <= edge_threshold_112_5)))
-      {
-        buff2->get(ComponentID(0)).at(i, j) = 90;
-      }
-      if (((-edge_threshold_67_5 < theta) && (theta <= -edge_threshold_22_5)) || ((edge_threshold_112_5 < theta) && (theta <= edge_threshold_157_5)))
-      {
-        buff2->get(ComponentID(0)).at(i, j) = 135;
-      }
-    }
-  }
+  // Gx and Gy; all bands have to be complete before the magnitude overwrites the source
+  parallelFor(m_numThreads, numBands,
+              [&](int band)
+              {
+                const int y0 = band * FGA_BAND_HEIGHT;
+                const int h  = std::min<int>(FGA_BAND_HEIGHT, height - y0);
+                g_pelBufOP.sobel3x3(src.bufAt(0, y0), src.stride, gradVer.bufAt(0, y0), gradHor.bufAt(0, y0),
+                                    gradVer.stride, width, h);
+              });
+
+  // magnitude and quantized edge direction
+  parallelFor(m_numThreads, numBands,
+              [&](int band)
+              {
+                const int y0 = band * FGA_BAND_HEIGHT;
+                const int y1 = std::min<int>(y0 + FGA_BAND_HEIGHT, height);
+                for (int y = y0; y < y1; y++)
+                {
+                  const Pel *ver = gradVer.bufAt(0, y);
+                  const Pel *hor = gradHor.bufAt(0, y);
+                  Pel       *mag = src.bufAt(0, y);
+                  Pel       *ori = dir.bufAt(0, y);
+                  for (int x = 0; x < width; x++)
+                  {
+                    Pel tmp = (Pel) ((abs(ver[x]) + abs(hor[x])) / 2);
+                    mag[x]  = (Pel) Clip3((Pel) 0, (Pel) maxClpRange, tmp);
+                    ori[x]  = (Pel) quantizeDirection(ver[x], hor[x]);
+                  }
+                }
+              });
 
   buff1->get(compID).extendBorderPel(padding, padding);   // extend border for the next steps
   tmpBuf1.destroy();
@@ -163,46 +147,46 @@ void Canny::gradient(PelStorage *buff1, PelStorage *buff2, unsigned int width, u
 void Canny::suppressNonMax(PelStorage *buff1, PelStorage *buff2, unsigned int width, unsigned int height,
                            ComponentID compID)
 {
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      int rowShift = 0, colShift = 0;
+  const CPelBuf mag      = buff1->get(compID);
+  PelBuf        dir      = buff2->get(ComponentID(0));
+  const int     numBands = (height + FGA_BAND_HEIGHT - 1) / FGA_BAND_HEIGHT;
 
-      switch (buff2->get(ComponentID(0)).at(i, j))
-      {
-      case 0:
-        rowShift = 1;
-        colShift = 0;
-        break;
-      case 45:
-        rowShift = 1;
-        colShift = 1;
-        break;
-      case 90:
-        rowShift = 0;
-        colShift = 1;
-        break;
-      case 135:
-        rowShift = -1;
-        colShift = 1;
-        break;
-      default: THROW("Unsupported gradient direction."); break;
-      }
-
-      Pel pelCurrent             = buff1->get(compID).at(i, j);
-      Pel pelEdgeDirectionTop    = buff1->get(compID).at(i + rowShift, j + colShift);
-      Pel pelEdgeDirectionBottom = buff1->get(compID).at(i - rowShift, j - colShift);
-      if ((pelCurrent < pelEdgeDirectionTop) || (pelCurrent < pelEdgeDirectionBottom))
-      {
-        buff2->get(ComponentID(0)).at(i, j) = 0;   // supress
-      }
-      else
-      {
-        buff2->get(ComponentID(0)).at(i, j) = buff1->get(compID).at(i, j);   // keep
-      }
-    }
-  }
+  parallelFor(m_numThreads, numBands,
+              [&](int band)
+              {
+                const int y0 = band * FGA_BAND_HEIGHT;
+                const int y1 = std::min<int>(y0 + FGA_BAND_HEIGHT, height);
+                for (int y = y0; y < y1; y++)
+                {
+                  const Pel *cur = mag.bufAt(0, y);
+                  Pel       *ori = dir.bufAt(0, y);
+                  for (int x = 0; x < width; x++)
+                  {
+                    ptrdiff_t offset = 0;   // offset of the neighbour along the edge direction
+
+                    switch (ori[x])
+                    {
+                    case 0: offset = 1; break;
+                    case 45: offset = 1 + mag.stride; break;
+                    case 90: offset = mag.stride; break;
+                    case 135: offset = -1 + mag.stride; break;
+                    default: THROW("Unsupported gradient direction."); break;
+                    }
+
+                    Pel pelCurrent             = cur[x];
+                    Pel pelEdgeDirectionTop    = cur[x + offset];
+                    Pel pelEdgeDirectionBottom = cur[x - offset];
+                    if ((pelCurrent < pelEdgeDirectionTop) || (pelCurrent < pelEdgeDirectionBottom))
+                    {
+                      ori[x] = 0;   // supress
+                    }
+                    else
+                    {
+                      ori[x] = pelCurrent;   // keep
+                    }
+                  }
+                }
+              });
   buff1->get(compID).copyFrom(buff2->get(ComponentID(0)));
 }
 
@@ -212,15 +196,24 @@ void Canny::doubleThreshold(PelStorage *buff, unsigned int width, unsigned int h
   Pel strongPel = ((Pel) 1 << bitDepth) - 1;
   Pel weekPel   = ((Pel) 1 << (bitDepth - 1)) - 1;
 
-  Pel highThreshold = 0;
+  PelBuf    buf      = buff->get(compID);
+  const int numBands = (height + FGA_BAND_HEIGHT - 1) / FGA_BAND_HEIGHT;
+
+  std::vector<Pel> bandMax(numBands, 0);
+  parallelFor(m_numThreads, numBands,
+              [&](int band)
+              {
+                const int y0 = band * FGA_BAND_HEIGHT;
+                const int y1 = std::min<int>(y0 + FGA_BAND_HEIGHT, height);
+                for (int y = y0; y < y1; y++)
+                {
+                  const Pel *row = buf.bufAt(0, y);
+                  bandMax[band]  = std::max(bandMax[band], *std::max_element(row, row + width));
+                }
+              });
+
+  Pel highThreshold = *std::max_element(bandMax.begin(), bandMax.end());
   Pel lowThreshold  = strongPel;
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      highThreshold = std::max<Pel>(highThreshold, buff->get(compID).at(i, j));
-    }
-  }
 
   // global low and high threshold
   lowThreshold = (Pel)(m_lowThresholdRatio * highThreshold);
@@ -229,24 +222,20 @@ void Canny::doubleThreshold(PelStorage *buff, unsigned int width, unsigned int h
           m_highThresholdRatio * lowThreshold);   // Canny recommended a upper:lower ratio between 2:1 and 3:1.
 
   // strong, week, supressed
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      if (buff->get(compID).at(i, j) > highThreshold)
-      {
-        buff->get(compID).at(i, j) = strongPel;
-      }
-      else if (buff->get(compID).at(i, j) <= highThreshold && buff->get(compID).at(i, j) > lowThreshold)
-      {
-        buff->get(compID).at(i, j) = weekPel;
-      }
-      else
-      {
-        buff->get(compID).at(i, j) = 0;
-      }
-    }
-  }
+  parallelFor(m_numThreads, numBands,
+              [&](int band)
+              {
+                const int y0 = band * FGA_BAND_HEIGHT;
+                const int y1 = std::min<int>(y0 + FGA_BAND_HEIGHT, height);
+                for (int y = y0; y < y1; y++)
+                {
+                  Pel *row = buf.bufAt(0, y);
+                  for (int x = 0; x < width; x++)
+                  {
+                    row[x] = row[x] > highThreshold ? strongPel : row[x] > lowThreshold ? weekPel : 0;
+                  }
+                }
+              });
 
   buff->get(compID).extendBorderPel(1, 1);   // extend one pixel on each side for the next step
 }
@@ -257,19 +246,26 @@ void Canny::edgeTracking(PelStorage *buff, unsigned int width, unsigned int heig
   Pel strongPel = ((Pel) 1 << bitDepth) - 1;
   Pel weekPel   = ((Pel) 1 << (bitDepth - 1)) - 1;
 
+  // Promoted samples are seen by the following ones, so the column-wise scan order has to be kept sequential
+  PelBuf          buf    = buff->get(compID);
+  const ptrdiff_t stride = buf.stride;
+
   for (int i = 0; i < width; i++)
   {
-    for (int j = 0; j < height; j++)
+    Pel *col = buf.bufAt(i, 0);
+
+    for (int j = 0; j < height; j++, col += stride)
     {
-      if (buff->get(compID).at(i, j) == weekPel)
+      if (*col == weekPel)
       {
-        bool strong = false;
+        bool       strong = false;
+        const Pel *window = col - (windowHeight / 2) * stride - windowWidth / 2;
 
-        for (int x = 0; x < windowWidth; x++)
+        for (int y = 0; y < windowHeight && !strong; y++, window += stride)
         {
-          for (int y = 0; y < windowHeight; y++)
+          for (int x = 0; x < windowWidth; x++)
           {
-            if (buff->get(compID).at(x - windowWidth / 2 + i, y - windowHeight / 2 + j) == strongPel)
+            if (window[x] == strongPel)
             {
               strong = true;
               break;
@@ -277,14 +273,7 @@ void Canny::edgeTracking(PelStorage *buff, unsigned int width, unsigned int heig
           }
         }
 
-        if (strong)
-        {
-          buff->get(compID).at(i, j) = strongPel;
-        }
-        else
-        {
-          buff->get(compID).at(i, j) = 0;   // supress
-        }
+        *col = strong ? strongPel : 0;   // supress if not connected to a strong edge
       }
     }
   }
@@ -338,51 +327,46 @@ Morph::~Morph()
   // uninit();
 }
 
-int Morph::dilation(PelStorage *buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter)
+// Replaces every sample by matchVal if any sample of its 3x3 neighbourhood equals matchVal
+void Morph::morph(PelStorage *buff, ComponentID compID, Pel matchVal)
 {
-  if (iter == numIter)
-  {
-    return iter;
-  }
-
   unsigned int width      = buff->get(compID).width,
                height     = buff->get(compID).height;   // Width and Height of current frame
-  unsigned int windowSize = m_kernelSize;
-  unsigned int padding    = windowSize / 2;
+  unsigned int padding    = m_kernelSize / 2;
 
-  Pel strongPel = ((Pel) 1 << bitDepth) - 1;
+  CHECK(m_kernelSize != 3, "Only 3x3 kernels are supported");
 
   PelStorage tmpBuf;
   tmpBuf.create(ChromaFormat::_400, Area(0, 0, width, height));
-  tmpBuf.bufs[0].copyFrom(buff->get(compID));
 
   buff->get(compID).extendBorderPel(padding, padding);
 
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      bool strong = false;
-      for (int x = 0; x < windowSize; x++)
-      {
-        for (int y = 0; y < windowSize; y++)
-        {
-          if (buff->get(compID).at(x - windowSize / 2 + i, y - windowSize / 2 + j) == strongPel)
-          {
-            strong = true;
-            break;
-          }
-        }
-      }
-      if (strong)
-      {
-        tmpBuf.get(ComponentID(0)).at(i, j) = strongPel;
-      }
-    }
-  }
+  const CPelBuf src      = buff->get(compID);
+  PelBuf        dst      = tmpBuf.Y();
+  const int     numBands = (height + FGA_BAND_HEIGHT - 1) / FGA_BAND_HEIGHT;
+
+  parallelFor(m_numThreads, numBands,
+              [&](int band)
+              {
+                const int y0 = band * FGA_BAND_HEIGHT;
+                const int h  = std::min<int>(FGA_BAND_HEIGHT, height - y0);
+                g_pelBufOP.morph3x3(src.bufAt(0, y0), src.stride, dst.bufAt(0, y0), dst.stride, width, h, matchVal);
+              });
 
   buff->get(compID).copyFrom(tmpBuf.bufs[0]);
   tmpBuf.destroy();
+}
+
+int Morph::dilation(PelStorage *buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter)
+{
+  if (iter == numIter)
+  {
+    return iter;
+  }
+
+  Pel strongPel = ((Pel) 1 << bitDepth) - 1;
+
+  morph(buff, compID, strongPel);
 
   iter++;
 
@@ -398,42 +382,7 @@ int Morph::erosion(PelStorage *buff, unsigned int bitDepth, ComponentID compID,
     return iter;
   }
 
-  unsigned int width      = buff->get(compID).width,
-               height     = buff->get(compID).height;   // Width and Height of current frame
-  unsigned int windowSize = m_kernelSize;
-  unsigned int padding    = windowSize / 2;
-
-  PelStorage tmpBuf;
-  tmpBuf.create(ChromaFormat::_400, Area(0, 0, width, height));
-  tmpBuf.bufs[0].copyFrom(buff->get(compID));
-
-  buff->get(compID).extendBorderPel(padding, padding);
-
-  for (int i = 0; i < width; i++)
-  {
-    for (int j = 0; j < height; j++)
-    {
-      bool week = false;
-      for (int x = 0; x < windowSize; x++)
-      {
-        for (int y = 0; y < windowSize; y++)
-        {
-          if (buff->get(compID).at(x - windowSize / 2 + i, y - windowSize / 2 + j) == 0)
-          {
-            week = true;
-            break;
-          }
-        }
-      }
-      if (week)
-      {
-        tmpBuf.get(ComponentID(0)).at(i, j) = 0;
-      }
-    }
-  }
-
-  buff->get(compID).copyFrom(tmpBuf.bufs[0]);
-  tmpBuf.destroy();
+  morph(buff, compID, 0);
 
   iter++;
 
@@ -481,6 +430,10 @@ void FGAnalyser::init(const int width, const int height, const int sourcePadding
       }
     }
     m_doAnalysis[i] = doAnalysis[i];
+
+    m_isFirstCutoffEst[i]  = true;
+    m_isFirstScalingEst[i] = true;
+    m_scalingVecAvg[i].clear();
   }
 
   // initialize picture parameters and create buffers
@@ -588,6 +541,13 @@ void FGAnalyser::estimate_grain(Picture *pic)
   estimate_grain_parameters();
 }
 
+void FGAnalyser::setNumThreads(int numThreads)
+{
+  m_numThreads = numThreads;
+  m_edgeDetector.setNumThreads(numThreads);
+  m_morphOperation.setNumThreads(numThreads);
+}
+
 // find flat and low complexity regions of the frame
 void FGAnalyser::findMask()
 {
@@ -683,14 +643,19 @@ void FGAnalyser::suppressLowIntensity(const PelStorage &buff1, PelStorage &buff2
   Pel maxIntensity          = ((Pel) 1 << bitDepth) - 1;
   Pel lowIntensityThreshold = (Pel)(m_lowIntensityRatio * maxIntensity);
 
+  const CPelBuf src = buff1.get(compID);
+  PelBuf        dst = buff2.get(compID);
+
   // strong, week, supressed
-  for (int i = 0; i < width; i++)
+  for (int y = 0; y < height; y++)
   {
-    for (int j = 0; j < height; j++)
+    const Pel *srcRow = src.bufAt(0, y);
+    Pel       *dstRow = dst.bufAt(0, y);
+    for (int x = 0; x < width; x++)
     {
-      if (buff1.get(compID).at(i, j) < lowIntensityThreshold)
+      if (srcRow[x] < lowIntensityThreshold)
       {
-        buff2.get(compID).at(i, j) = maxIntensity;
+        dstRow[x] = maxIntensity;
       }
     }
   }
@@ -735,19 +700,21 @@ void FGAnalyser::upsample(const PelStorage &input, PelStorage &output, Component
   const int width  = input.get(compID).width;
   const int height = input.get(compID).height;
 
-  for (int i = 0; i < width; i++)
+  const CPelBuf src = input.get(compID);
+  PelBuf        dst = output.get(compID);
+
+  for (int j = 0; j < height; j++)
   {
-    for (int j = 0; j < height; j++)
-    {
-      Pel currentPel = input.get(compID).at(i, j);
+    const Pel *srcRow = src.bufAt(0, j);
+    Pel       *dstRow = dst.bufAt(0, j * factor);
 
-      for (int x = 0; x < factor; x++)
-      {
-        for (int y = 0; y < factor; y++)
-        {
-          output.get(compID).at(i * factor + x, j * factor + y) = currentPel;
-        }
-      }
+    for (int i = 0; i < width; i++)
+    {
+      std::fill_n(dstRow + i * factor, factor, srcRow[i]);
+    }
+    for (int y = 1; y < factor; y++)
+    {
+      std::copy_n(dstRow, width * factor, dstRow + y * dst.stride);
     }
   }
 
@@ -762,11 +729,16 @@ void FGAnalyser::combineMasks(PelStorage &buff1, PelStorage &buff2, ComponentID
   const int width  = buff1.get(compID).width;
   const int height = buff1.get(compID).height;
 
-  for (int i = 0; i < width; i++)
+  PelBuf        dst = buff1.get(compID);
+  const CPelBuf src = buff2.get(compID);
+
+  for (int y = 0; y < height; y++)
   {
-    for (int j = 0; j < height; j++)
+    Pel       *dstRow = dst.bufAt(0, y);
+    const Pel *srcRow = src.bufAt(0, y);
+    for (int x = 0; x < width; x++)
     {
-      buff1.get(compID).at(i, j) = (buff1.get(compID).at(i, j) | buff2.get(compID).at(i, j));
+      dstRow[x] |= srcRow[x];
     }
   }
 }
@@ -795,6 +767,15 @@ void FGAnalyser::estimate_grain_parameters()
     blockSize = BLK_32;
   }
 
+  // data collected from one windowSize x windowSize block
+  struct WindowData
+  {
+    bool             hasDctBlock = false;
+    PelMatrix        squaredDctBlock;
+    std::vector<int> mean;
+    std::vector<int> var;
+  };
+
   for (int compIdx = 0; compIdx < getNumberValidComponents(m_chromaFormatIdc); compIdx++)
   {   // loop over components
     ComponentID compID    = ComponentID(compIdx);
@@ -809,50 +790,63 @@ void FGAnalyser::estimate_grain_parameters()
     unsigned int height      = m_workingBuf->getBuf(compID).height;   // Height of current frame
     unsigned int windowSize  = DATA_BASE_SIZE;                      // Size for Film Grain block
     int          bitDepth     = m_bitDepths[channelId];
-    int          detect_edges = 0;
-    int          mean         = 0;
-    int          var          = 0;
 
     std::vector<int>       vec_mean;
     std::vector<int>       vec_var;
     std::vector<PelMatrix> squared_dct_grain_block_list;
 
-    for (int i = 0; i <= width - windowSize; i += windowSize)
-    {   // loop over windowSize x windowSize blocks
-      for (int j = 0; j <= height - windowSize; j += windowSize)
+    // the windows are analysed independently and the results are gathered in raster order afterwards,
+    // so the estimate does not depend on the number of threads
+    const int numWindowsX = width >= windowSize ? (width - windowSize) / windowSize + 1 : 0;
+    const int numWindowsY = height >= windowSize ? (height - windowSize) / windowSize + 1 : 0;
+    std::vector<WindowData> windowData(numWindowsX * numWindowsY);
+
+    parallelFor(m_numThreads, numWindowsX * numWindowsY,
+                [&](int windowIdx)
+                {
+                  const int   i    = (windowIdx / numWindowsY) * windowSize;
+                  const int   j    = (windowIdx % numWindowsY) * windowSize;
+                  WindowData &data = windowData[windowIdx];
+
+                  if (count_edges(*m_maskBuf, windowSize, compID, i, j))   // for flat region without edges
+                  {
+                    // find transformed blocks; cut-off frequency estimation is done on 64 x 64 blocks as low-pass filtering on synthesis side is done on 64 x 64 blocks.
+                    block_transform(*tmpBuff, data.squaredDctBlock, i, j, bitDepth, compID);
+                    data.hasDctBlock = true;
+                  }
+
+                  int step = windowSize / blockSize;
+                  for (int k = 0; k < step; k++)
+                  {
+                    for (int m = 0; m < step; m++)
+                    {
+                      // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
+                      if (count_edges(*m_maskBuf, blockSize, compID, i + k * blockSize, j + m * blockSize))
+                      {
+                        // collect all data for parameter estimation; mean and variance are caluclated on blockSize x blockSize blocks
+                        int mean = meanVar(*m_workingBuf, blockSize, compID, i + k * blockSize, j + m * blockSize, false);
+                        int var  = meanVar(*tmpBuff, blockSize, compID, i + k * blockSize, j + m * blockSize, true);
+                        // regularize high variations; controls excessively fluctuating points
+                        double tmp = 3.0 * pow((double)(var), .5) + .5;
+                        var = (int)tmp;
+                        if (var < (MAX_REAL_SCALE << (bitDepth - BIT_DEPTH_8))) // limit data points to meaningful values. higher variance can be result of not perfect mask estimation (non-flat regions fall in estimation process)
+                        {
+                          data.mean.push_back(mean);   // mean of the filtered frame
+                          data.var.push_back(var);     // variance of the film grain estimate
+                        }
+                      }
+                    }
+                  }
+                });
+
+    for (auto &data: windowData)
+    {
+      if (data.hasDctBlock)
       {
-        detect_edges = count_edges(*m_maskBuf, windowSize, compID, i, j);   // for flat region without edges
-
-        if (detect_edges)   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
-        {
-          // find transformed blocks; cut-off frequency estimation is done on 64 x 64 blocks as low-pass filtering on synthesis side is done on 64 x 64 blocks.
-          block_transform(*tmpBuff, squared_dct_grain_block_list, i, j, bitDepth, compID);
-        }
-
-        int step = windowSize / blockSize;
-        for (int k = 0; k < step; k++)
-        {
-          for (int m = 0; m < step; m++)
-          {
-            detect_edges = count_edges(*m_maskBuf, blockSize, compID, i + k * blockSize, j + m * blockSize);   // for flat region without edges
-
-            if (detect_edges)   // selection of uniform, flat and low-complexity area; extend to other features, e.g., variance.
-            {
-              // collect all data for parameter estimation; mean and variance are caluclated on blockSize x blockSize blocks
-              mean = meanVar(*m_workingBuf, blockSize, compID, i + k * blockSize, j + m * blockSize, false);
-              var  = meanVar(*tmpBuff, blockSize, compID, i + k * blockSize, j + m * blockSize, true);
-              // regularize high variations; controls excessively fluctuating points
-              double tmp = 3.0 * pow((double)(var), .5) + .5;
-              var = (int)tmp;
-              if (var < (MAX_REAL_SCALE << (bitDepth - BIT_DEPTH_8))) // limit data points to meaningful values. higher variance can be result of not perfect mask estimation (non-flat regions fall in estimation process)
-              {
-                vec_mean.push_back(mean);   // mean of the filtered frame
-                vec_var.push_back(var);     // variance of the film grain estimate
-              }
-            }
-          }
-        }
+        squared_dct_grain_block_list.push_back(std::move(data.squaredDctBlock));
       }
+      vec_mean.insert(vec_mean.end(), data.mean.begin(), data.mean.end());
+      vec_var.insert(vec_var.end(), data.var.begin(), data.var.end());
     }
 
     // calculate film grain parameters
@@ -909,7 +903,6 @@ void FGAnalyser::estimate_cutoff_freq(const std::vector<PelMatrix> &blocks, Comp
   PelMatrixDouble mean_squared_dct_grain(DATA_BASE_SIZE, std::vector<double>(DATA_BASE_SIZE));
   std::vector<double> vec_mean_dct_grain_row(DATA_BASE_SIZE, 0.0);
   std::vector<double> vec_mean_dct_grain_col(DATA_BASE_SIZE, 0.0);
-  static bool     isFirstCutoffEst[MAX_NUM_COMPONENT] = {true, true, true };
 
   int num_blocks = (int) blocks.size();
   if (num_blocks < MIN_BLOCKS_FOR_CUTOFF_ESTIMATION)   // if there is no enough 64 x 64 blocks to estimate cut-off freq, skip cut-off freq estimation and use previous parameters
@@ -955,11 +948,11 @@ void FGAnalyser::estimate_cutoff_freq(const std::vector<PelMatrix> &blocks, Comp
 
   if (m_compModel[compID].presentFlag)
   {
-    if (isFirstCutoffEst[compID])   // to avoid averaging with default
+    if (m_isFirstCutoffEst[compID])   // to avoid averaging with default
     {
       m_compModel[compID].intensityValues[0].compModelValue[1] = cutoff_horizontal;
       m_compModel[compID].intensityValues[0].compModelValue[2] = cutoff_vertical;
-      isFirstCutoffEst[compID]                                 = false;
+      m_isFirstCutoffEst[compID]                                 = false;
     }
     else
     {
@@ -1031,82 +1024,69 @@ int FGAnalyser::cutoff_frequency(std::vector<double> &mean)
 }
 
 // DCT-2 64x64 as defined in VVC
-void FGAnalyser::block_transform(const PelStorage &buff, std::vector<PelMatrix> &squared_dct_grain_block_list,
-                                 int offsetX, int offsetY, unsigned int bitDepth, ComponentID compID)
+void FGAnalyser::block_transform(const PelStorage &buff, PelMatrix &squared_dct_grain_block, int offsetX, int offsetY,
+                                 unsigned int bitDepth, ComponentID compID)
 {
-  unsigned int     windowSize       = DATA_BASE_SIZE;               // Size for Film Grain block
+  const int        windowSize        = DATA_BASE_SIZE;               // Size for Film Grain block
   Intermediate_Int max_dynamic_range = (1 << (bitDepth + 6)) - 1;   // Dynamic range after DCT transform for 64x64 block
   Intermediate_Int min_dynamic_range = -((1 << (bitDepth + 6)) - 1);
-  Intermediate_Int sum;
 
-  const TMatrixCoeff *tmp            = g_trCoreDCT2P64[TRANSFORM_FORWARD][0];
+  const TMatrixCoeff *tr              = g_trCoreDCT2P64[TRANSFORM_FORWARD][0];   // row x of the matrix at tr[x * 64]
   const int           transform_scale = 9;   // upscaling of original transform as specified in VVC (for 64x64 block)
   const int add_1st = 1 << (transform_scale - 1);
 
-  TMatrixCoeff tr[DATA_BASE_SIZE][DATA_BASE_SIZE];    // Original
-  TMatrixCoeff trt[DATA_BASE_SIZE][DATA_BASE_SIZE];   // Transpose
-  for (int x = 0; x < DATA_BASE_SIZE; x++)
-  {
-    for (int y = 0; y < DATA_BASE_SIZE; y++)
-    {
-      tr[x][y]  = tmp[x * 64 + y]; /* Matrix Original */
-      trt[y][x] = tmp[x * 64 + y]; /* Matrix Transpose */
-    }
-  }
+  const CPelBuf src = buff.get(compID);
 
-  // DCT transform
-  PelMatrix blockDCT(windowSize, std::vector<Intermediate_Int>(windowSize));
-  PelMatrix blockTmp(windowSize, std::vector<Intermediate_Int>(windowSize));
+  // DCT transform; both stages are dot products over contiguous rows
+  Intermediate_Int blockTmp[DATA_BASE_SIZE * DATA_BASE_SIZE];   // blockTmp[x * 64 + y]
 
-  for (int x = 0; x < windowSize; x++)
+  for (int y = 0; y < windowSize; y++)
   {
-    for (int y = 0; y < windowSize; y++)
+    const Pel *srcRow = src.bufAt(offsetX, offsetY + y);
+    for (int x = 0; x < windowSize; x++)
     {
-      sum = 0;
+      const TMatrixCoeff *trRow = tr + x * DATA_BASE_SIZE;
+      Intermediate_Int    sum   = 0;
       for (int k = 0; k < windowSize; k++)
       {
-        sum += tr[x][k] * buff.get(compID).at(offsetX + k, offsetY + y);
+        sum += trRow[k] * srcRow[k];
       }
-      blockTmp[x][y] = (sum + add_1st) >> transform_scale;
+      blockTmp[x * DATA_BASE_SIZE + y] = (sum + add_1st) >> transform_scale;
     }
   }
 
+  squared_dct_grain_block.assign(windowSize, std::vector<Intermediate_Int>(windowSize));
+
   for (int x = 0; x < windowSize; x++)
   {
+    const Intermediate_Int *tmpRow = blockTmp + x * DATA_BASE_SIZE;
     for (int y = 0; y < windowSize; y++)
     {
-      sum = 0;
+      const TMatrixCoeff *trRow = tr + y * DATA_BASE_SIZE;
+      Intermediate_Int    sum   = 0;
       for (int k = 0; k < windowSize; k++)
       {
-        sum += blockTmp[x][k] * trt[k][y];
+        sum += tmpRow[k] * trRow[k];
       }
-      blockDCT[x][y] = Clip3(min_dynamic_range, max_dynamic_range, (sum + add_1st) >> transform_scale);
-    }
-  }
+      Intermediate_Int coeff = Clip3(min_dynamic_range, max_dynamic_range, (sum + add_1st) >> transform_scale);
 
-  for (int x = 0; x < windowSize; x++)
-  {
-    for (int y = 0; y < windowSize; y++)
-    {
-      blockDCT[x][y] = blockDCT[x][y] * blockDCT[x][y];
+      // store squared transformed block for further analysis
+      squared_dct_grain_block[x][y] = coeff * coeff;
     }
   }
-
-  // store squared transformed block for further analysis
-  squared_dct_grain_block_list.push_back(blockDCT);
 }
 
 // check edges
-int FGAnalyser::count_edges(PelStorage &buffer, int windowSize, ComponentID compID, int offsetX, int offsetY)
+int FGAnalyser::count_edges(const PelStorage &buffer, int windowSize, ComponentID compID, int offsetX, int offsetY)
 {
-  for (int x = 0; x < windowSize; x++)
+  const CPelBuf src = buffer.get(compID);
+
+  for (int y = 0; y < windowSize; y++)
   {
-    for (int y = 0; y < windowSize; y++)
+    const Pel *row = src.bufAt(offsetX, offsetY + y);
+    if (std::any_of(row, row + windowSize, [](Pel v) { return v != 0; }))
     {
-      if (buffer.get(compID).at(offsetX + x, offsetY + y))
-      {
-        return 0;
-      }
+      return 0;
     }
   }
 
@@ -1114,18 +1094,15 @@ int FGAnalyser::count_edges(PelStorage &buffer, int windowSize, ComponentID comp
 }
 
 // calulate mean and variance for windowSize x windowSize block
-int FGAnalyser::meanVar(PelStorage &buffer, int windowSize, ComponentID compID, int offsetX, int offsetY, bool getVar)
+int FGAnalyser::meanVar(const PelStorage &buffer, int windowSize, ComponentID compID, int offsetX, int offsetY, bool getVar)
 {
-  double m = 0, v = 0;
+  const CPelBuf src = buffer.get(compID);
+  int64_t       sum, sumSq;
 
-  for (int x = 0; x < windowSize; x++)
-  {
-    for (int y = 0; y < windowSize; y++)
-    {
-      m += buffer.get(compID).at(offsetX + x, offsetY + y);
-      v += (buffer.get(compID).at(offsetX + x, offsetY + y) * buffer.get(compID).at(offsetX + x, offsetY + y));
-    }
-  }
+  g_pelBufOP.sumAndSumSq(src.bufAt(offsetX, offsetY), src.stride, windowSize, windowSize, sum, sumSq);
+
+  // the integer sums are exact, so converting them gives the same result as accumulating in double
+  double m = (double) sum, v = (double) sumSq;
 
   m = m / (windowSize * windowSize);
   if (getVar)
@@ -1520,45 +1497,45 @@ void FGAnalyser::avg_scaling_vec(std::vector<double> &scalingVec, ComponentID co
   int xmax = (int) scalingVec.back();
   scalingVec.pop_back();
 
-  static std::vector<std::vector<double>> scalingVecAvg(MAX_NUM_COMPONENT, std::vector<double>((int)(1<<bitDepth)));
-  static bool                isFirstScalingEst[MAX_NUM_COMPONENT] = { true, true, true };
+  std::vector<double> &scalingVecAvg = m_scalingVecAvg[compID];
 
-  if (isFirstScalingEst[compID])
+  if (m_isFirstScalingEst[compID])
   {
+    scalingVecAvg.assign(1 << bitDepth, 0.0);
     for (int i = xmin; i <= xmax; i++)
     {
-      scalingVecAvg[compID][i] = scalingVec[i - xmin];
+      scalingVecAvg[i] = scalingVec[i - xmin];
     }
 
-    isFirstScalingEst[compID] = false;
+    m_isFirstScalingEst[compID] = false;
   }
   else
   {
     for (int i = 0; i < scalingVec.size(); i++)
     {
-      scalingVecAvg[compID][i + xmin] += scalingVec[i];
+      scalingVecAvg[i + xmin] += scalingVec[i];
     }
-    for (int i = 0; i < scalingVecAvg[compID].size(); i++)
+    for (int i = 0; i < scalingVecAvg.size(); i++)
     {
-      scalingVecAvg[compID][i] /= 2;
+      scalingVecAvg[i] /= 2;
     }
   }
 
   // re-init scaling vec and add new min and max to be used in other functions
   int index = 0;
-  for (; index < scalingVecAvg[compID].size(); index++)
+  for (; index < scalingVecAvg.size(); index++)
   {
-    if (scalingVecAvg[compID][index])
+    if (scalingVecAvg[index])
     {
       break;
     }
   }
   xmin = index;
 
-  index = (int) scalingVecAvg[compID].size() - 1;
+  index = (int) scalingVecAvg.size() - 1;
   for (; index >=0 ; index--)
   {
-    if (scalingVecAvg[compID][index])
+    if (scalingVecAvg[index])
     {
       break;
     }
@@ -1568,7 +1545,7 @@ void FGAnalyser::avg_scaling_vec(std::vector<double> &scalingVec, ComponentID co
   scalingVec.resize(xmax - xmin + 1);
   for (int i = xmin; i <= xmax; i++)
   {
-    scalingVec[i - xmin] = scalingVecAvg[compID][i];
+    scalingVec[i - xmin] = scalingVecAvg[i];
   }
 
   scalingVec.push_back(xmax);
@@ -97,6 +97,7 @@ public:
   unsigned int      m_convWidthG = 5, m_convHeightG = 5;		  // Pixel's row and col positions for Gauss filtering
 
   void detect_edges(const PelStorage* orig, PelStorage* dest, unsigned int uiBitDepth, ComponentID compID);
+  void setNumThreads(int numThreads) { m_numThreads = numThreads; }
 
 private:
   static const int  m_gx[3][3];                               // Sobel kernel x
@@ -107,6 +108,9 @@ private:
 
   double            m_lowThresholdRatio   = 0.1;               // low threshold rato
   int               m_highThresholdRatio  = 3;                 // high threshold rato
+  int               m_numThreads          = 1;
+
+  static int        quantizeDirection(int gradVer, int gradHor);
 
   void gradient   ( PelStorage* buff1, PelStorage* buff2,
                     unsigned int width, unsigned int height,
@@ -127,9 +131,13 @@ public:
 
   int dilation  (PelStorage* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter = 0);
   int erosion   (PelStorage* buff, unsigned int bitDepth, ComponentID compID, int numIter, int iter = 0);
+  void setNumThreads(int numThreads) { m_numThreads = numThreads; }
 
 private:
   unsigned int m_kernelSize = 3;		// Dilation and erosion kernel size
+  int          m_numThreads = 1;
+
+  void morph    (PelStorage* buff, ComponentID compID, Pel matchVal);
 };
 
 
@@ -155,6 +163,7 @@ public:
   void destroy        ();
   void initBufs       (Picture* pic);
   void estimate_grain (Picture* pic);
+  void setNumThreads  (int numThreads);
 
   int                                     getLog2scaleFactor()  { return m_log2ScaleFactor; };
   SEIFilmGrainCharacteristics::CompModel  getCompModel(int idx) { return m_compModel[idx];  };
@@ -174,6 +183,7 @@ private:
   Canny    m_edgeDetector;
   Morph    m_morphOperation;
   double   m_lowIntensityRatio            = 0.1;                    // supress everything below 0.1*maxIntensityOffset
+  int      m_numThreads                   = 1;
 
   static constexpr double m_tapFilter[3]  = { 1, 2, 1 };
   static constexpr double m_normTap       = 4.0;
@@ -182,6 +192,11 @@ private:
   int                                    m_log2ScaleFactor;
   SEIFilmGrainCharacteristics::CompModel m_compModel[MAX_NUM_COMPONENT];
 
+  // estimates of previous frames, averaged with the current ones to smooth transitions
+  bool                m_isFirstCutoffEst[MAX_NUM_COMPONENT];
+  bool                m_isFirstScalingEst[MAX_NUM_COMPONENT];
+  std::vector<double> m_scalingVecAvg[MAX_NUM_COMPONENT];
+
   PelStorage *m_originalBuf = nullptr;
   PelStorage *m_workingBuf  = nullptr;
   PelStorage *m_maskBuf     = nullptr;
@@ -189,7 +204,7 @@ private:
   void findMask                     ();
 
   void estimate_grain_parameters    ();
-  void block_transform              (const PelStorage& buff1, std::vector<PelMatrix>& squared_dct_grain_block_list, int offsetX, int offsetY, unsigned int bitDepth, ComponentID compID);
+  void block_transform              (const PelStorage& buff1, PelMatrix& squared_dct_grain_block, int offsetX, int offsetY, unsigned int bitDepth, ComponentID compID);
   void estimate_cutoff_freq         (const std::vector<PelMatrix>& blocks, ComponentID compID);
   int  cutoff_frequency             (std::vector<double>& mean);
   void estimate_scaling_factors     (std::vector<int>& data_x, std::vector<int>& data_y, unsigned int bitDepth, ComponentID compID);
@@ -206,8 +221,8 @@ private:
   void confirm_intervals            (std::vector<std::vector<int>>& parameters);
 
   long double ldpow                 (long double n, unsigned p);
-  int         meanVar               (PelStorage& buffer, int windowSize, ComponentID compID, int offsetX, int offsetY, bool getVar);
-  int         count_edges           (PelStorage& buffer, int windowSize, ComponentID compID, int offsetX, int offsetY);
+  int         meanVar               (const PelStorage& buffer, int windowSize, ComponentID compID, int offsetX, int offsetY, bool getVar);
+  int         count_edges           (const PelStorage& buffer, int windowSize, ComponentID compID, int offsetX, int offsetY);
 
   void subsample                    (const PelStorage& input, PelStorage& output, ComponentID compID, const int factor = 2, const int padding = 0) const;
   void upsample                     (const PelStorage& input, PelStorage& output, ComponentID compID, const int factor = 2, const int padding = 0) const;
@@ -0,0 +1,153 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     AsyncYuvWriter.cpp
+    \brief    Background writer for YUV output files
+*/
+
+#include "AsyncYuvWriter.h"
+
+void AsyncYuvWriter::start(int queueSize)
+{
+  CHECK(m_thread.joinable(), "Writer thread already running");
+
+  m_queueSize = queueSize;
+  m_stop      = false;
+
+  if (m_queueSize > 0)
+  {
+    m_thread = std::thread(&AsyncYuvWriter::xWriterThread, this);
+  }
+}
+
+void AsyncYuvWriter::stop()
+{
+  if (m_thread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  m_freeBufs.clear();
+  m_queueSize = 0;
+}
+
+void AsyncYuvWriter::flush()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [this] { return m_queue.empty() && !m_busy; });
+}
+
+void AsyncYuvWriter::write(VideoIOYuv &file, const CPelUnitBuf &pic, const InputColourSpaceConversion ipCSC,
+                           const bool packedYuvOutputMode, int confLeft, int confRight, int confTop, int confBottom,
+                           ChromaFormat format, const bool clipToRec709)
+{
+  if (!m_thread.joinable())
+  {
+    file.write(pic.get(COMPONENT_Y).width, pic.get(COMPONENT_Y).height, pic, ipCSC, packedYuvOutputMode, confLeft,
+               confRight, confTop, confBottom, format, clipToRec709);
+    return;
+  }
+
+  std::shared_ptr<PelStorage> buf;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return (int) m_queue.size() < m_queueSize; });
+
+    if (!m_freeBufs.empty())
+    {
+      buf = std::move(m_freeBufs.back());
+      m_freeBufs.pop_back();
+    }
+  }
+
+  // copy outside the lock so the writer thread is not held up
+  const Area area(Position(), pic.get(COMPONENT_Y));
+  if (!buf)
+  {
+    buf = std::make_shared<PelStorage>();
+  }
+  else if (buf->chromaFormat != pic.chromaFormat || buf->Y().width != area.width || buf->Y().height != area.height)
+  {
+    buf->destroy();
+  }
+  if (buf->bufs.empty())
+  {
+    buf->create(pic.chromaFormat, area);
+  }
+  buf->copyFrom(pic);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue.push_back(
+      { &file, std::move(buf), ipCSC, packedYuvOutputMode, confLeft, confRight, confTop, confBottom, format, clipToRec709 });
+  }
+  m_cond.notify_all();
+}
+
+void AsyncYuvWriter::xWrite(const Job &job)
+{
+  job.file->write(job.pic->Y().width, job.pic->Y().height, *job.pic, job.ipCSC, job.packedYuvOutputMode, job.confLeft,
+                  job.confRight, job.confTop, job.confBottom, job.format, job.clipToRec709);
+}
+
+void AsyncYuvWriter::xWriterThread()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  while (true)
+  {
+    m_cond.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty())
+    {
+      return;   // stop requested and all pictures written
+    }
+
+    Job job = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_busy = true;
+    m_cond.notify_all();
+
+    lock.unlock();
+    xWrite(job);
+    lock.lock();
+
+    m_freeBufs.push_back(std::move(job.pic));
+    m_busy = false;
+    m_cond.notify_all();
+  }
+}
@@ -0,0 +1,96 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     AsyncYuvWriter.h
+    \brief    Background writer for YUV output files (header)
+*/
+
+#ifndef __ASYNCYUVWRITER__
+#define __ASYNCYUVWRITER__
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "VideoIOYuv.h"
+
+/// Writes pictures to YUV files in a background thread.
+/// Each picture is copied into a reference-counted buffer, so the caller can reuse or release its picture as soon as
+/// write() returns. The buffers are recycled once written. The queue is bounded: write() blocks while it is full.
+class AsyncYuvWriter
+{
+public:
+  AsyncYuvWriter() {}
+  ~AsyncYuvWriter() { stop(); }
+
+  void start(int queueSize);   ///< start the writer thread, queueSize 0 makes write() synchronous
+  void stop();                 ///< write all pending pictures and terminate the writer thread
+  void flush();                ///< wait until all pending pictures are written
+
+  /// queue one picture for VideoIOYuv::write(), the output size is the size of the picture
+  void write(VideoIOYuv &file, const CPelUnitBuf &pic, const InputColourSpaceConversion ipCSC,
+             const bool packedYuvOutputMode, int confLeft, int confRight, int confTop, int confBottom,
+             ChromaFormat format, const bool clipToRec709);
+
+private:
+  struct Job
+  {
+    VideoIOYuv                 *file;
+    std::shared_ptr<PelStorage> pic;
+    InputColourSpaceConversion  ipCSC;
+    bool                        packedYuvOutputMode;
+    int                         confLeft;
+    int                         confRight;
+    int                         confTop;
+    int                         confBottom;
+    ChromaFormat                format;
+    bool                        clipToRec709;
+  };
+
+  void xWriterThread();
+  static void xWrite(const Job &job);
+
+  int                                      m_queueSize = 0;
+  std::thread                              m_thread;
+  std::mutex                               m_mutex;
+  std::condition_variable                  m_cond;   ///< signalled on every change of the queue state
+  std::deque<Job>                          m_queue;
+  std::vector<std::shared_ptr<PelStorage>> m_freeBufs;
+  bool                                     m_busy = false;   ///< the writer thread is writing a picture
+  bool                                     m_stop = false;
+};
+
+#endif // __ASYNCYUVWRITER__
@@ -0,0 +1,225 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SharedYuvReader.cpp
+    \brief    YUV input file read once for several consumers
+*/
+
+#include "SharedYuvReader.h"
+
+#include <algorithm>
+
+void SharedYuvReader::open(const std::string &fileName, const BitDepths &fileBitDepth,
+                           const BitDepths &msbExtendedBitDepth, const BitDepths &internalBitDepth,
+                           ChromaFormat fileFormat, ChromaFormat internalFormat, int width, int height,
+                           const InputColourSpaceConversion ipCSC, const bool clipToRec709, int frameSkip,
+                           int temporalSubsampleRatio, int numConsumers, int queueSize)
+{
+  CHECK(numConsumers < 1, "At least one consumer is required");
+  CHECK(queueSize < 1, "The queue size must be at least 1");
+
+  m_file.open(fileName, false, fileBitDepth, msbExtendedBitDepth, internalBitDepth);
+  m_file.skipFrames(frameSkip, width, height, fileFormat);
+
+  m_fileFormat             = fileFormat;
+  m_internalFormat         = internalFormat;
+  m_width                  = width;
+  m_height                 = height;
+  m_ipCSC                  = ipCSC;
+  m_clipToRec709           = clipToRec709;
+  m_temporalSubsampleRatio = temporalSubsampleRatio;
+  m_queueSize              = queueSize;
+
+  m_readBuf.create(internalFormat, Area(0, 0, width, height));
+
+  m_frames.clear();
+  m_firstFrame = 0;
+  m_reading    = false;
+  m_eof        = false;
+  m_numActive  = numConsumers;
+  m_consumers.assign(numConsumers, Consumer());
+  for (auto &consumer: m_consumers)
+  {
+    consumer.active = true;
+  }
+}
+
+void SharedYuvReader::close()
+{
+  m_file.close();
+  m_frames.clear();
+  m_freeFrames.clear();
+  m_consumers.clear();
+  m_readBuf.destroy();
+}
+
+bool SharedYuvReader::xReadFrame(Frame &frame)
+{
+  if (frame.pic.bufs.empty())
+  {
+    frame.pic.create(m_internalFormat, Area(0, 0, m_width, m_height));
+  }
+
+  int noPadding[2] = { 0, 0 };
+  if (!m_file.read(frame.pic, m_readBuf, m_ipCSC, noPadding, m_fileFormat, m_clipToRec709))
+  {
+    return false;
+  }
+  if (m_temporalSubsampleRatio > 1)
+  {
+    m_file.skipFrames(m_temporalSubsampleRatio - 1, m_width, m_height, m_fileFormat);
+  }
+  return true;
+}
+
+void SharedYuvReader::xRelease(int frameIdx)
+{
+  Frame &frame = *m_frames[frameIdx - m_firstFrame];
+  frame.numPending--;
+
+  while (!m_frames.empty() && m_frames.front()->numPending == 0)
+  {
+    m_freeFrames.push_back(std::move(m_frames.front()));
+    m_frames.pop_front();
+    m_firstFrame++;
+  }
+}
+
+bool SharedYuvReader::read(int consumerIdx, PelUnitBuf &dst)
+{
+  Consumer &consumer = m_consumers[consumerIdx];
+  CHECK(!consumer.active, "Reading from a finished consumer");
+
+  const Frame *frame = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (consumer.nextFrame >= m_firstFrame + (int) m_frames.size())
+    {
+      if (m_eof)
+      {
+        consumer.eof = true;
+        return false;
+      }
+      if (m_reading || (int) m_frames.size() >= m_queueSize)
+      {
+        // another consumer is reading, or the slowest one still has to take the oldest picture
+        m_cond.wait(lock);
+        continue;
+      }
+
+      std::unique_ptr<Frame> newFrame;
+      if (!m_freeFrames.empty())
+      {
+        newFrame = std::move(m_freeFrames.back());
+        m_freeFrames.pop_back();
+      }
+      else
+      {
+        newFrame = std::make_unique<Frame>();
+      }
+
+      // the file is only accessed by the consumer that set m_reading, the others can take queued pictures meanwhile
+      m_reading = true;
+      lock.unlock();
+      const bool ok = xReadFrame(*newFrame);
+      lock.lock();
+      m_reading = false;
+
+      if (ok)
+      {
+        newFrame->numPending = m_numActive;
+        m_frames.push_back(std::move(newFrame));
+      }
+      else
+      {
+        m_freeFrames.push_back(std::move(newFrame));
+        m_eof = true;
+      }
+      m_cond.notify_all();
+    }
+
+    frame = m_frames[consumer.nextFrame - m_firstFrame].get();
+  }
+
+  // the picture cannot be released before this consumer has taken it, so it is copied without holding the lock
+  for (uint32_t comp = 0; comp < dst.bufs.size(); comp++)
+  {
+    const ComponentID compID = ComponentID(comp);
+    const CPelBuf     src    = frame->pic.get(compID);
+    PelBuf            buf    = dst.get(compID);
+    CHECK(buf.width < src.width || buf.height < src.height, "Destination smaller than the input picture");
+
+    buf.subBuf(Position(0, 0), Size(src.width, src.height)).copyFrom(src);
+    for (int y = 0; y < src.height; y++)
+    {
+      Pel *row = buf.bufAt(0, y);
+      std::fill(row + src.width, row + buf.width, row[src.width - 1]);
+    }
+    for (int y = src.height; y < buf.height; y++)
+    {
+      std::copy_n(buf.bufAt(0, src.height - 1), buf.width, buf.bufAt(0, y));
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    xRelease(consumer.nextFrame);
+    consumer.nextFrame++;
+  }
+  m_cond.notify_all();
+
+  return true;
+}
+
+void SharedYuvReader::finish(int consumerIdx)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Consumer &consumer = m_consumers[consumerIdx];
+    if (!consumer.active)
+    {
+      return;
+    }
+
+    consumer.active = false;
+    m_numActive--;
+    for (int frameIdx = std::max(consumer.nextFrame, m_firstFrame); frameIdx < m_firstFrame + (int) m_frames.size();)
+    {
+      // releasing may pop frames from the front, which shifts the indices
+      xRelease(frameIdx);
+      frameIdx = std::max(frameIdx + 1, m_firstFrame);
+    }
+  }
+  m_cond.notify_all();
+}
@@ -0,0 +1,114 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2025, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     SharedYuvReader.h
+    \brief    YUV input file read once for several consumers (header)
+*/
+
+#ifndef __SHAREDYUVREADER__
+#define __SHAREDYUVREADER__
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "VideoIOYuv.h"
+
+/// Reads the pictures of an input file once and hands each of them to several consumers running in their own threads.
+/// A picture is read by the first consumer that needs it and kept until all consumers have taken their copy. The
+/// number of buffered pictures is bounded: a consumer that runs ahead waits while the slowest one is queueSize
+/// pictures behind.
+class SharedYuvReader
+{
+public:
+  SharedYuvReader() {}
+  ~SharedYuvReader() { close(); }
+
+  /// open the file, width and height are the picture size in the file, the pictures are converted to the internal
+  /// bit depth and chroma format as VideoIOYuv::read() does
+  void open(const std::string &fileName, const BitDepths &fileBitDepth, const BitDepths &msbExtendedBitDepth,
+            const BitDepths &internalBitDepth, ChromaFormat fileFormat, ChromaFormat internalFormat, int width,
+            int height, const InputColourSpaceConversion ipCSC, const bool clipToRec709, int frameSkip,
+            int temporalSubsampleRatio, int numConsumers, int queueSize);
+  void close();
+
+  /// copy the next picture of the consumer to the top-left of dst and replicate its right and bottom samples into the
+  /// rest of dst, returns false at the end of the file
+  bool read(int consumerIdx, PelUnitBuf &dst);
+  bool isEof(int consumerIdx) const { return m_consumers[consumerIdx].eof; }
+
+  /// the consumer does not read any more pictures, must be called before a consumer stops early
+  void finish(int consumerIdx);
+
+private:
+  struct Frame
+  {
+    PelStorage pic;
+    int        numPending;   ///< number of consumers that have not taken the picture yet
+  };
+
+  struct Consumer
+  {
+    int  nextFrame = 0;   ///< index of the next picture to be read by the consumer
+    bool active    = false;
+    bool eof       = false;
+  };
+
+  bool xReadFrame(Frame &frame);
+  void xRelease(int frameIdx);
+
+  VideoIOYuv                 m_file;
+  ChromaFormat               m_fileFormat;
+  ChromaFormat               m_internalFormat;
+  int                        m_width;
+  int                        m_height;
+  InputColourSpaceConversion m_ipCSC;
+  bool                       m_clipToRec709;
+  int                        m_temporalSubsampleRatio;
+  int                        m_queueSize;
+  PelStorage                 m_readBuf;   ///< picture before colour space conversion
+
+  std::mutex                          m_mutex;
+  std::condition_variable             m_cond;   ///< signalled whenever a picture is read or released
+  std::deque<std::unique_ptr<Frame>>  m_frames;
+  std::vector<std::unique_ptr<Frame>> m_freeFrames;
+  int                                 m_firstFrame = 0;   ///< index of the picture at the front of m_frames
+  int                                 m_numActive  = 0;
+  bool                                m_reading    = false;   ///< a consumer is reading a picture from the file
+  bool                                m_eof        = false;
+  std::vector<Consumer>               m_consumers;
+};
+
+#endif // __SHAREDYUVREADER__
@@ -105,39 +105,12 @@ constexpr int MAX_FILE_BIT_DEPTH = 16;
  */
 static void scalePlane( PelBuf& areaBuf, const int shiftbits, const Pel minval, const Pel maxval)
 {
-  const unsigned width  = areaBuf.width;
-  const unsigned height = areaBuf.height;
-  const ptrdiff_t stride = areaBuf.stride;
-  Pel            *img    = areaBuf.bufAt(0, 0);
-
   if( 0 == shiftbits )
   {
     return;
   }
 
-  if( shiftbits > 0)
-  {
-    for( unsigned y = 0; y < height; y++, img+=stride)
-    {
-      for( unsigned x = 0; x < width; x++)
-      {
-        img[x] <<= shiftbits;
-      }
-    }
-  }
-  else if (shiftbits < 0)
-  {
-    const int shiftbitsr =- shiftbits;
-    const Pel rounding = 1 << (shiftbitsr-1);
-
-    for( unsigned y = 0; y < height; y++, img+=stride)
-    {
-      for( unsigned x = 0; x < width; x++)
-      {
-        img[x] = Clip3(minval, maxval, Pel((img[x] + rounding) >> shiftbitsr));
-      }
-    }
-  }
+  g_pelBufOP.scaleSamples(areaBuf.bufAt(0, 0), areaBuf.stride, areaBuf.width, areaBuf.height, shiftbits, minval, maxval);
 }
 
 
@@ -395,6 +368,7 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
  *
  * @param dst          destination image plane
  * @param fd           input file stream
+ * @param fileBuf      scratch buffer for the file samples, reused between calls
  * @param is16bit      true if input file carries > 8bit data, false otherwise.
  * @param stride444    distance between vertically adjacent pixels of dst.
  * @param width444     width of active area in dst.
@@ -407,7 +381,8 @@ void VideoIOYuv::skipFrames(uint32_t numFrames, uint32_t width, uint32_t height,
  * @param fileBitDepth component bit depth in file
  * @return true for success, false in case of error
  */
-static bool readPlane(Pel *dst, std::istream &fd, bool is16bit, ptrdiff_t stride444, uint32_t width444,
+static bool readPlane(Pel *dst, std::istream &fd, std::vector<uint8_t> &fileBuf, bool is16bit, ptrdiff_t stride444,
+                      uint32_t width444,
                       uint32_t height444, uint32_t pad_x444, uint32_t pad_y444, const ComponentID compID,
                       const ChromaFormat destFormat, const ChromaFormat fileFormat, const uint32_t fileBitDepth)
 {
@@ -428,9 +403,12 @@ static bool readPlane(Pel *dst, std::istream &fd, bool is16bit, ptrdiff_t stride
   const uint32_t fullWidthDest  = widthDest + padDestX;
   const uint32_t fullHeightDest = heightDest + padDestY;
 
-  const uint32_t       strideFile = (width444 * (is16bit ? 2 : 1)) >> csxFile;
-  std::vector<uint8_t> bufVec(strideFile);
-  uint8_t *buf=&(bufVec[0]);
+  const uint32_t strideFile = (width444 * (is16bit ? 2 : 1)) >> csxFile;
+  if (fileBuf.size() < strideFile)
+  {
+    fileBuf.resize(strideFile);
+  }
+  uint8_t *buf = fileBuf.data();
 
   Pel*            pDstPad              = dst + strideDest * heightDest;
   Pel  *pDstBuf              = dst;
@@ -461,6 +439,43 @@ static bool readPlane(Pel *dst, std::istream &fd, bool is16bit, ptrdiff_t stride
       }
     }
   }
+  else if (csxFile == csxDest && csyFile == csyDest)
+  {
+    // same sampling in file and destination: read the whole plane at once and convert it row by row
+    const uint32_t numRows = (height444 + (1 << csyFile) - 1) >> csyFile;
+    const size_t   planeSize = size_t(strideFile) * numRows;
+    if (fileBuf.size() < planeSize)
+    {
+      fileBuf.resize(planeSize);
+    }
+    fd.read(reinterpret_cast<char *>(fileBuf.data()), planeSize);
+    if (fd.eof() || fd.fail())
+    {
+      return false;
+    }
+
+    const uint8_t *fileRow = fileBuf.data();
+    for (uint32_t y = 0; y < numRows; y++, fileRow += strideFile, pDstBuf += dstBufStride)
+    {
+      if (is16bit)
+      {
+        g_pelBufOP.unpackSamples16(fileRow, pDstBuf, widthDest);
+      }
+      else
+      {
+        g_pelBufOP.unpackSamples8(fileRow, pDstBuf, widthDest);
+      }
+
+      // process right hand side padding
+      std::fill(pDstBuf + widthDest, pDstBuf + fullWidthDest, pDstBuf[widthDest - 1]);
+    }
+
+    // process lower padding
+    for (uint32_t y = heightDest; y < fullHeightDest; y++, pDstPad += strideDest)
+    {
+      std::copy_n(pDstPad - strideDest, fullWidthDest, pDstPad);
+    }
+  }
   else
   {
     const uint32_t maskFileY = (1 << csyFile) - 1;
@@ -561,12 +576,14 @@ static bool verifyPlane(Pel *dst, ptrdiff_t stride444, uint32_t width444, uint32
 
   for (uint32_t y = 0; y < fullHeight; y++, dstBuf+= stride)
   {
+    Pel bits = 0;   // accumulate the whole row so the loop vectorises
     for (uint32_t x = 0; x < fullWidth; x++)
     {
-      if ( (dstBuf[x] & mask) != 0)
-      {
-        return false;
-      }
+      bits |= dstBuf[x];
+    }
+    if ((bits & mask) != 0)
+    {
+      return false;
     }
   }
 
@@ -578,6 +595,7 @@ static bool verifyPlane(Pel *dst, ptrdiff_t stride444, uint32_t width444, uint32
  * Write an image plane (width444*height444 pixels) from src into output stream fd.
  *
  * @param fd         output file stream
+ * @param fileBuf    scratch buffer for the file samples, reused between calls
  * @param src        source image
  * @param is16bit    true if input file carries > 8bit data, false otherwise.
  * @param stride444  distance between vertically adjacent pixels of src.
@@ -589,7 +607,8 @@ static bool verifyPlane(Pel *dst, ptrdiff_t stride444, uint32_t width444, uint32
  * @param fileBitDepth component bit depth in file
  * @return true for success, false in case of error
  */
-static bool writePlane(uint32_t orgWidth, uint32_t orgHeight, std::ostream& fd, const Pel* src, const bool is16bit,
+static bool writePlane(uint32_t orgWidth, uint32_t orgHeight, std::ostream& fd, std::vector<uint8_t>& fileBuf,
+                       const Pel* src, const bool is16bit,
                        const ptrdiff_t strideSrc, uint32_t width444, uint32_t height444, const ComponentID compID,
                        const ChromaFormat srcFormat, const ChromaFormat fileFormat, const uint32_t fileBitDepth,
                        const uint32_t packedYUVOutputMode = 0)
@@ -608,8 +627,11 @@ static bool writePlane(uint32_t orgWidth, uint32_t orgHeight, std::ostream& fd,
   const uint32_t strideFile =
     writePYUV ? (orgWidth * fileBitDepth) >> (csxFile + 3) : (orgWidth * (is16bit ? 2 : 1)) >> csxFile;
 
-  std::vector<uint8_t> bufVec(strideFile);
-  uint8_t *buf=&(bufVec[0]);
+  if (fileBuf.size() < strideFile)
+  {
+    fileBuf.resize(strideFile);
+  }
+  uint8_t *buf = fileBuf.data();
 
   const Pel *pSrcBuf         = src;
   const ptrdiff_t srcBufStride    = strideSrc;
@@ -764,6 +786,43 @@ static bool writePlane(uint32_t orgWidth, uint32_t orgHeight, std::ostream& fd,
         }
       }
   }
+  else if (csyFile == csySrc && widthFile * (is16bit ? 2 : 1) <= strideFile)
+  {
+    // same sampling in source and file: convert the whole plane and write it at once
+    const uint32_t maskFileY   = (1 << csyFile) - 1;
+    const uint32_t numRows     = (height444 + maskFileY) >> csyFile;
+    const uint32_t numZeroRows = orgHeight > height444 ? ((orgHeight + maskFileY) >> csyFile) - numRows : 0;
+    const uint32_t rowBytes    = widthFile * (is16bit ? 2 : 1);
+    const size_t   planeSize   = size_t(strideFile) * (numRows + numZeroRows);
+
+    if (fileBuf.size() < planeSize)
+    {
+      fileBuf.resize(planeSize);
+    }
+
+    uint8_t *fileRow = fileBuf.data();
+    for (uint32_t y = 0; y < numRows; y++, pSrcBuf += srcBufStride, fileRow += strideFile)
+    {
+      if (is16bit)
+      {
+        g_pelBufOP.packSamples16(pSrcBuf, fileRow, widthFile);
+      }
+      else
+      {
+        g_pelBufOP.packSamples8(pSrcBuf, fileRow, widthFile);
+      }
+      std::fill(fileRow + rowBytes, fileRow + strideFile, 0);
+    }
+
+    // here height444 and orgHeight are luma heights
+    std::fill_n(fileRow, size_t(strideFile) * numZeroRows, 0);
+
+    fd.write(reinterpret_cast<const char *>(fileBuf.data()), planeSize);
+    if (fd.eof() || fd.fail())
+    {
+      return false;
+    }
+  }
   else
   {
     const uint32_t maskFileY = (1 << csyFile) - 1;
@@ -1086,7 +1145,7 @@ bool VideoIOYuv::read(PelUnitBuf& pic, PelUnitBuf& picOrg, const InputColourSpac
 #if EXTENSION_360_VIDEO
     const ptrdiff_t stride444 = picOrg.get(compID).stride;
 #endif
-    if (!readPlane(dst, m_fileStream, is16bit, stride444, width444, height444, padH444, padV444, compID,
+    if (!readPlane(dst, m_fileStream, m_fileBuf, is16bit, stride444, width444, height444, padH444, padV444, compID,
                    picOrg.chromaFormat, format, m_fileBitdepth[chType]))
     {
       return false;
@@ -1227,8 +1286,9 @@ bool VideoIOYuv::write(uint32_t orgWidth, uint32_t orgHeight, const CPelUnitBuf
     const uint32_t    csy         = ::getComponentScaleY(compID, format);
     const CPelBuf     area        = picO.get(compID);
     const ptrdiff_t   planeOffset = (confLeft >> csx) + (confTop >> csy) * area.stride;
-    if (!writePlane(orgWidth, orgHeight, m_fileStream, area.bufAt(0, 0) + planeOffset, is16bit, area.stride, width444,
-                    height444, compID, picO.chromaFormat, format, m_fileBitdepth[ch], packedYuvOutputMode ? 1 : 0))
+    if (!writePlane(orgWidth, orgHeight, m_fileStream, m_fileBuf, area.bufAt(0, 0) + planeOffset, is16bit,
+                    area.stride, width444, height444, compID, picO.chromaFormat, format, m_fileBitdepth[ch],
+                    packedYuvOutputMode ? 1 : 0))
     {
       retval = false;
     }
@@ -1467,7 +1527,7 @@ bool VideoIOYuv::writeUpscaledPicture(const SPS &sps, const PPS &pps, const CPel
       Picture::rescalePicture({ xScale, yScale }, pic, pps.getScalingWindow(), upscaledPic,
                               afterScaleWindowFullResolution, chromaFormatIdc, sps.getBitDepths(), false, false,
                               sps.getHorCollocatedChromaFlag(), sps.getVerCollocatedChromaFlag(), rescaleForDisplay,
-                              upscaleFilterForDisplay);
+                              upscaleFilterForDisplay, m_rescaleNumThreads);
       ret = write(maxWidth, maxHeight, upscaledPic, ipCSC,
                   packedYuvOutputMode, afterScaleWindowFullResolution.getWindowLeftOffset() * SPS::getWinUnitX(chromaFormatIdc),
                   afterScaleWindowFullResolution.getWindowRightOffset() * SPS::getWinUnitX(chromaFormatIdc),
@@ -70,6 +70,9 @@ private:
   Chroma420LocType m_outLocType            = Chroma420LocType::UNSPECIFIED;
   bool         m_outY4m                = false;
 
+  std::vector<uint8_t> m_fileBuf;   // file samples of one plane, kept to avoid reallocation per frame
+  int                  m_rescaleNumThreads = 1;   // threads used for resampling upscaled output pictures
+
 public:
   VideoIOYuv()           {}
   virtual ~VideoIOYuv()  {}
@@ -83,6 +86,7 @@ public:
             const BitDepths& msbExtendedBitDepth,
             const BitDepths& internalBitDepth);                  ///< open or create file
   void close();                                                  ///< close file
+  void setRescaleNumThreads(int numThreads) { m_rescaleNumThreads = numThreads; }
 #if EXTENSION_360_VIDEO
   void skipFrames(int numFrames, uint32_t width, uint32_t height, ChromaFormat format);
 #else